@@ -60,6 +60,37 @@
 
 #define MCP_SLAVE_ADDR 0x27 
 
+/* Attempts per configuration register before going on without it; a failed
+   attempt is retried, and the driver lowers the clock for a target that
+   keeps failing, so retries also run slower on a poor link */
+#define APP_I2C_ATTEMPTS_MAX    3U
+
+/* Register and value pairs that set up the expander, written in order.  The
+   directions go first: the outputs are driven, from the OLAT reset value,
+   as soon as they are written. */
+static const uint8_t appConfigWrites[][2] =
+{
+    { IODIRA, 0x00 },
+    { IODIRB, 0x00 },
+    { IOCONA, 0x40 },
+    { GPPUA,  0x0F },
+};
+
+/* Index of the write after which every output is driven */
+#define APP_CONFIG_OUTPUTS_DEFINED  1U
+
+#define APP_CONFIG_WRITES       (sizeof(appConfigWrites) / sizeof(appConfigWrites[0]))
+
+/* The burst's copy of the writes, one buffer per queued transfer: the
+   driver takes a non-const buffer and reads it until the transfer ends */
+static uint8_t appConfigBuffers[APP_CONFIG_WRITES][2];
+
+/* Step period of the walking output pattern */
+#define APP_WALK_PERIOD_MS      100U
+
+/* Saved pattern: the pattern, then the outputs, GPIOA first */
+#define APP_PATTERN_SAVED_LENGTH    3U
+
 // *****************************************************************************
 /* Application Data
 
@@ -77,8 +108,6 @@
 
 APP_DATA appData;
 
-uint8_t i, led_pattern = 0;
-
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Callback Functions
@@ -88,10 +117,40 @@ uint8_t i, led_pattern = 0;
 static void APP_I2C_EventHandler( DRV_I2C_TRANSFER_EVENT event,
     DRV_I2C_TRANSFER_HANDLE transferHandle, uintptr_t context)
 {
+    /* The burst writes complete in the order they were queued */
+    if (appData.configPending != 0U)
+    {
+        if (event != DRV_I2C_TRANSFER_EVENT_COMPLETE)
+        {
+            appData.isConfigFailed = true;
+        }
+        else if ((appData.isConfigFailed == false) &&
+            (appData.configReported == APP_CONFIG_OUTPUTS_DEFINED))
+        {
+            SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_OUTPUTS_DEFINED);
+        }
+        else
+        {
+            /* The rest of the configuration */
+        }
+
+        appData.configReported++;
+        appData.configPending--;
+        return;
+    }
+
     appData.transferStatus = event;
 }
 
 
+/* Walk timer, from SYS_TMR_Tasks */
+static void APP_WalkStep( uintptr_t context, uint32_t currTick )
+{
+    appData.outputs = (uint16_t)(1U << appData.walkIndex);
+    appData.walkIndex = (uint8_t)((appData.walkIndex + 1U) & 0x07U);
+}
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Local Functions
@@ -99,58 +158,71 @@ static void APP_I2C_EventHandler( DRV_I2C_TRANSFER_EVENT event,
 // *****************************************************************************
 
 
-bool i2c_write(uint8_t reg, uint8_t data) 
+/* Queues every configuration write at once, from initialization, so they
+   go out while the rest of the system starts; a failed one sends the
+   configuration again a write at a time, with retries */
+static void APP_ConfigBurstStart(void)
 {
-    appData.txBuffer[0] = reg;
-    appData.txBuffer[1] = data;
+    DRV_I2C_TRANSFER_HANDLE handle;
+    uint8_t index;
+    bool interruptState;
+
+    appData.isConfigFailed = false;
+    appData.configReported = 0U;
 
-    DRV_I2C_WriteTransferAdd(appData.i2cHandle, MCP_SLAVE_ADDR, 
-            appData.txBuffer, 2, &appData.transferHandle);
-    
-    if (appData.transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID)
+    /* Counted first, a callback may come before the next add */
+    appData.configPending = (uint8_t)APP_CONFIG_WRITES;
+
+    for (index = 0U; index < APP_CONFIG_WRITES; index++)
     {
-        return false;        
+        appConfigBuffers[index][0] = appConfigWrites[index][0];
+        appConfigBuffers[index][1] = appConfigWrites[index][1];
+
+        DRV_I2C_WriteTransferAdd(appData.i2cHandle, MCP_SLAVE_ADDR,
+                appConfigBuffers[index], 2U, &handle);
+
+        if (handle == DRV_I2C_TRANSFER_HANDLE_INVALID)
+        {
+            interruptState = SYS_INT_Disable();
+
+            appData.configPending -= (uint8_t)(APP_CONFIG_WRITES - index);
+            appData.isConfigFailed = true;
+
+            SYS_INT_Restore(interruptState);
+            break;
+        }
     }
-    
-    SYSTICK_DelayMs(1);
-    while (appData.transferStatus != DRV_I2C_TRANSFER_EVENT_COMPLETE);
-    
-    return true;
+
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_CONFIG_QUEUED);
 }
 
-uint8_t i2c_read(uint8_t reg) 
+
+/* Queues size bytes of txBuffer; the status is reset to PENDING before the
+   add and the callback sets how the write ended */
+static void APP_I2C_WriteStart(size_t size)
 {
-    appData.txBuffer[0] = reg;
-    
-    DRV_I2C_WriteReadTransferAdd(appData.i2cHandle, MCP_SLAVE_ADDR, 
-            appData.txBuffer, 1, appData.rxBuffer, 1, 
-            &appData.transferHandle);
-    
-    if (appData.transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID)
-    {
-        return false;        
-    }
-    SYSTICK_DelayMs(1);
-    while (appData.transferStatus != DRV_I2C_TRANSFER_EVENT_COMPLETE);
-    
-    return true;
+    appData.transferStatus = DRV_I2C_TRANSFER_EVENT_PENDING;
+
+    DRV_I2C_WriteTransferAdd(appData.i2cHandle, MCP_SLAVE_ADDR,
+            appData.txBuffer, size, &appData.transferHandle);
+
+    /* With the driver queue full, the write is started again next time */
+    appData.isWriting = (appData.transferHandle != DRV_I2C_TRANSFER_HANDLE_INVALID);
 }
 
-uint8_t i2c_test(void) 
-{    
-    for (int i=0; i<128; i++)
-    {
-        DRV_I2C_ReadTransferAdd(appData.i2cHandle, i, 
-                appData.rxBuffer, 1, &appData.transferHandle);
+/* The pattern saved by APP_PatternSave, if any; the store answers from RAM */
+static void APP_PatternRestore(void)
+{
+    uint8_t value[APP_PATTERN_SAVED_LENGTH];
+    size_t length;
 
-        if (appData.transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID)
-        {
-            return false;        
-        }
-        SYSTICK_DelayMs(1);
+    if ((SYS_KVS_Get(SYS_KVS_KEY_APP_PATTERN, value, sizeof(value), &length) == false) ||
+        (length != APP_PATTERN_SAVED_LENGTH) || (value[0] > (uint8_t)APP_PATTERN_STATIC))
+    {
+        return;
     }
-    
-    return true;
+
+    APP_PatternSet((APP_PATTERN)value[0], (uint16_t)((uint16_t)value[1] | ((uint16_t)value[2] << 8)));
 }
 
 
@@ -174,6 +246,34 @@ void APP_Initialize ( void )
     appData.state = APP_STATE_INIT;
     appData.i2cHandle       = DRV_HANDLE_INVALID;
     appData.transferHandle  = DRV_I2C_TRANSFER_HANDLE_INVALID;
+
+    appData.pattern         = APP_PATTERN_WALK;
+    appData.outputs         = 0U;
+    appData.outputsWritten  = 0U;
+    appData.walkIndex       = 0U;
+    appData.isWriting       = false;
+    appData.attempts        = 0U;
+    appData.configIndex     = 0U;
+    appData.configPending   = 0U;
+    appData.isConfigFailed  = false;
+    appData.areOutputsKnown = false;
+
+    /* The walk steps on from here; the outputs are written once the
+     * expander is set up */
+    appData.walkTimer = SYS_TMR_CallbackPeriodic(APP_WALK_PERIOD_MS, 0U, APP_WalkStep);
+
+    /* Fast boot: SYS_Initialize brings the driver and its interrupts up
+     * before this; APP_STATE_INIT opens it otherwise */
+    appData.i2cHandle = DRV_I2C_Open( DRV_I2C_INDEX_0, DRV_IO_INTENT_READWRITE);
+
+    if (appData.i2cHandle != DRV_HANDLE_INVALID)
+    {
+        DRV_I2C_TransferEventHandlerSet(appData.i2cHandle, APP_I2C_EventHandler, 0);
+
+        APP_ConfigBurstStart();
+
+        appData.state = APP_STATE_CONFIG_BURST;
+    }
 }
 
 
@@ -187,6 +287,7 @@ void APP_Initialize ( void )
 
 void APP_Tasks ( void )
 {
+    SYS_PROF_BEGIN(SYS_PROF_ID_APP_TASKS);
 
     /* Check the application's current state. */
     switch ( appData.state )
@@ -203,10 +304,6 @@ void APP_Tasks ( void )
                 DRV_I2C_TransferEventHandlerSet(appData.i2cHandle, APP_I2C_EventHandler, 0); 
             
                 appData.state = APP_STATE_SERVICE_TASKS;
-                SYSTICK_TimerStart();
-                
-                printf("\n\r APP_TASK: MCP23017 LS60 Test");
-                                
             }
             else
             {
@@ -216,29 +313,115 @@ void APP_Tasks ( void )
 			break;
         }
 
+        case APP_STATE_CONFIG_BURST:
+        {
+            if (appData.configPending != 0U)
+            {
+                break;
+            }
+
+            if (appData.isConfigFailed == true)
+            {
+                appData.configIndex = 0U;
+                appData.state = APP_STATE_SERVICE_TASKS;
+                break;
+            }
+
+            /* Reported from there */
+            appData.configIndex = (uint8_t)APP_CONFIG_WRITES;
+            appData.state = APP_STATE_SERVICE_TASKS;
+            break;
+        }
+
+        /* One register per call, so the other tasks keep running */
         case APP_STATE_SERVICE_TASKS:
         {
-            i2c_write(GPPUA,  0x0F);    
-            i2c_write(IOCONA, 0x40);    
-            i2c_write(IODIRA, 0x00);    
-            i2c_write(IODIRB, 0x00);    
-            
-            printf("\n\r APP_TASK: MCP23017 Configuration is Done");
-            
+            if (appData.isWriting == true)
+            {
+                if (appData.transferStatus == DRV_I2C_TRANSFER_EVENT_PENDING)
+                {
+                    break;
+                }
+
+                appData.isWriting = false;
+                appData.attempts++;
+
+                if ((appData.transferStatus == DRV_I2C_TRANSFER_EVENT_COMPLETE) ||
+                    (appData.attempts >= APP_I2C_ATTEMPTS_MAX))
+                {
+                    appData.configIndex++;
+                    appData.attempts = 0U;
+                }
+            }
+
+            if (appData.configIndex < APP_CONFIG_WRITES)
+            {
+                appData.txBuffer[0] = appConfigWrites[appData.configIndex][0];
+                appData.txBuffer[1] = appConfigWrites[appData.configIndex][1];
+
+                APP_I2C_WriteStart(2U);
+                break;
+            }
+
+            /* The banner waits for the expander, the outputs come first */
+            SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_CONFIGURED);
+
+            APP_PatternRestore();
+
+            SYS_LOG0("APP_TASK: MCP23017 LS60 Test");
+            SYS_LOG0("APP_TASK: MCP23017 Configuration is Done");
+#if defined(SYS_PROF_ENABLE)
+            {
+                uint32_t outputsUs = 0U;
+                uint32_t initUs = 0U;
+
+                (void) SYS_PROF_BootUsGet(SYS_PROF_BOOT_ID_OUTPUTS_DEFINED, &outputsUs);
+                (void) SYS_PROF_BootUsGet(SYS_PROF_BOOT_ID_INIT_DONE, &initUs);
+
+                SYS_LOG2("APP_TASK: boot, outputs driven at %u us, init done at %u us",
+                    outputsUs, initUs);
+            }
+#endif
+
             appData.state = APP_STATE_IDLE;
             break;
         }
 
+        /* Returns while the outputs are written, the other tasks run
+         * meanwhile */
         case APP_STATE_IDLE:
         {
-            led_pattern = 1 << i;
-            
-            i2c_write(GPIOA,  led_pattern);
-            SYSTICK_DelayMs(100);
-            
-            if(i >= 7)   i=0;
-            
-            else i++;
+            uint16_t outputs;
+
+            if (appData.isWriting == true)
+            {
+                if (appData.transferStatus == DRV_I2C_TRANSFER_EVENT_PENDING)
+                {
+                    break;
+                }
+
+                appData.isWriting = false;
+
+                /* A failed write is sent again below */
+                if (appData.transferStatus == DRV_I2C_TRANSFER_EVENT_COMPLETE)
+                {
+                    appData.outputsWritten = appData.outputsPending;
+                    appData.areOutputsKnown = true;
+                }
+            }
+
+            outputs = appData.outputs;
+
+            if ((appData.areOutputsKnown == false) || (outputs != appData.outputsWritten))
+            {
+                /* IOCON.SEQOP is clear, GPIOB follows GPIOA in one write */
+                appData.txBuffer[0] = GPIOA;
+                appData.txBuffer[1] = (uint8_t)outputs;
+                appData.txBuffer[2] = (uint8_t)(outputs >> 8);
+                appData.outputsPending = outputs;
+
+                APP_I2C_WriteStart(3U);
+            }
 
             break;
         }
@@ -250,6 +433,86 @@ void APP_Tasks ( void )
             break;
         }
     }
+
+    SYS_PROF_END(SYS_PROF_ID_APP_TASKS);
+}
+
+uint32_t APP_IdleUsGet ( void )
+{
+    /* A write in flight is woken by the transfer interrupt */
+    if ((appData.state == APP_STATE_ERROR) || (appData.configPending != 0U) ||
+        ((appData.isWriting == true) && (appData.transferStatus == DRV_I2C_TRANSFER_EVENT_PENDING)))
+    {
+        return SYS_SCHED_IDLE_FOREVER;
+    }
+
+    if ((appData.state != APP_STATE_IDLE) || (appData.isWriting == true) ||
+        (appData.areOutputsKnown == false) || (appData.outputs != appData.outputsWritten))
+    {
+        return 0U;
+    }
+
+    return SYS_SCHED_IDLE_FOREVER;
+}
+
+bool APP_PatternSave ( void )
+{
+    uint8_t value[APP_PATTERN_SAVED_LENGTH];
+
+    value[0] = (uint8_t)appData.pattern;
+    value[1] = (uint8_t)appData.outputs;
+    value[2] = (uint8_t)(appData.outputs >> 8);
+
+    return SYS_KVS_Set(SYS_KVS_KEY_APP_PATTERN, value, sizeof(value));
+}
+
+bool APP_IsActive ( void )
+{
+    return (appData.isWriting == true) || (appData.configPending != 0U);
+}
+
+void APP_PatternSet ( APP_PATTERN pattern, uint16_t outputs )
+{
+    if (pattern == APP_PATTERN_WALK)
+    {
+        appData.walkIndex = 0U;
+        (void) SYS_TMR_ObjectReload(appData.walkTimer, APP_WALK_PERIOD_MS, 0U, APP_WalkStep);
+    }
+    else
+    {
+        (void) SYS_TMR_ObjectStop(appData.walkTimer);
+        appData.outputs = outputs;
+    }
+
+    appData.pattern = pattern;
+}
+
+bool APP_OutputPinSet ( uint8_t pin, bool isHigh )
+{
+    uint16_t pinMask;
+
+    if (pin >= 16U)
+    {
+        return false;
+    }
+
+    pinMask = (uint16_t)(1U << pin);
+
+    if (isHigh == true)
+    {
+        APP_PatternSet(APP_PATTERN_STATIC, appData.outputs | pinMask);
+    }
+    else
+    {
+        APP_PatternSet(APP_PATTERN_STATIC, appData.outputs & (uint16_t)~pinMask);
+    }
+
+    return true;
+}
+
+uint16_t APP_OutputsGet ( void )
+{
+    return appData.outputs;
 }
 
 
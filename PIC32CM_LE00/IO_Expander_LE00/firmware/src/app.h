@@ -63,6 +63,8 @@ typedef enum
 {
     /* Application's state machine's initial state. */
     APP_STATE_INIT=0,
+    /* The configuration writes queued together at initialization */
+    APP_STATE_CONFIG_BURST,
     APP_STATE_SERVICE_TASKS,
     APP_STATE_IDLE,
     APP_STATE_ERROR,
@@ -70,6 +72,23 @@ typedef enum
 
 } APP_STATES;
 
+// *****************************************************************************
+/* Output patterns
+
+  Summary:
+    What drives the outputs of the local MCP23017.
+*/
+
+typedef enum
+{
+    /* One GPIOA output at a time, moving every APP_WALK_PERIOD_MS */
+    APP_PATTERN_WALK = 0,
+
+    /* The outputs keep the value set by APP_PatternSet or APP_OutputPinSet */
+    APP_PATTERN_STATIC,
+
+} APP_PATTERN;
+
 
 // *****************************************************************************
 /* Application Data
@@ -98,9 +117,42 @@ typedef struct
     /* Variable to hold transfer status of every transfer */
     volatile DRV_I2C_TRANSFER_EVENT transferStatus;
 
-    uint8_t txBuffer[2];
-    
-    uint8_t rxBuffer[2];
+    uint8_t txBuffer[3];
+
+    /* A write is queued, the callback has not reported on it yet */
+    bool isWriting;
+
+    /* Failed attempts at the configuration register being written */
+    uint8_t attempts;
+
+    /* Next of the configuration writes */
+    uint8_t configIndex;
+
+    /* Writes of the configuration burst the callback has not reported on,
+     * has, and whether one of them failed */
+    volatile uint8_t configPending;
+
+    volatile uint8_t configReported;
+
+    volatile bool isConfigFailed;
+
+    APP_PATTERN pattern;
+
+    /* Requested outputs, GPIOA in the low byte and GPIOB in the high byte */
+    volatile uint16_t outputs;
+
+    /* Outputs last written to the expander, valid once areOutputsKnown */
+    uint16_t outputsWritten;
+
+    bool areOutputsKnown;
+
+    /* Outputs in the write under way */
+    uint16_t outputsPending;
+
+    /* Next GPIOA output of the walk and the step timer */
+    uint8_t walkIndex;
+
+    SYS_TMR_HANDLE walkTimer;
 
 } APP_DATA;
 
@@ -184,6 +236,86 @@ void APP_Initialize ( void );
 
 void APP_Tasks( void );
 
+/*******************************************************************************
+  Function:
+    uint32_t APP_IdleUsGet ( void )
+
+  Summary:
+    Returns 0 while there is an expander write to start or to complete,
+    SYS_SCHED_IDLE_FOREVER otherwise.
+
+  Remarks:
+    A write in flight waits for the transfer interrupt.  A walk changes the
+    outputs from a SYS_TMR timer, which keeps the scheduler awake on its
+    own.
+*/
+
+uint32_t APP_IdleUsGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_IsActive ( void )
+
+  Summary:
+    True while an expander write is in flight, its bus must keep running.
+*/
+
+bool APP_IsActive ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_PatternSet ( APP_PATTERN pattern, uint16_t outputs )
+
+  Summary:
+    Selects the output pattern; outputs is the static value, unused by a walk.
+
+  Remarks:
+    The expander is written from APP_Tasks, this function does not wait.
+*/
+
+void APP_PatternSet ( APP_PATTERN pattern, uint16_t outputs );
+
+/*******************************************************************************
+  Function:
+    bool APP_PatternSave ( void )
+
+  Summary:
+    Stores the pattern and the outputs in data flash; they are restored once
+    the expander is configured after a reset.
+
+  Returns:
+    false if the store did not take them; they reach the flash shortly
+    after, from the store task.
+*/
+
+bool APP_PatternSave ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_OutputPinSet ( uint8_t pin, bool isHigh )
+
+  Summary:
+    Sets one output, 0-7 on GPIOA and 8-15 on GPIOB, and stops a walk.
+
+  Returns:
+    false if the pin does not exist.
+
+  Remarks:
+    The expander is written from APP_Tasks, this function does not wait.
+*/
+
+bool APP_OutputPinSet ( uint8_t pin, bool isHigh );
+
+/*******************************************************************************
+  Function:
+    uint16_t APP_OutputsGet ( void )
+
+  Summary:
+    Returns the requested outputs, GPIOA in the low byte.
+*/
+
+uint16_t APP_OutputsGet ( void );
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
@@ -0,0 +1,241 @@
+/*******************************************************************************
+  Console Baud Rate Manager Source File
+
+  File Name:
+    app_baud.c
+
+  Summary:
+    Changes the SERCOM3 console rate at run time, as agreed with the host.
+
+  Description:
+    See app_baud.h for the exchange with the host.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_baud.h"
+#include "app_telemetry.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    /* The rate in use is the agreed one */
+    APP_BAUD_STATE_IDLE = 0,
+
+    /* Waiting for the reply to leave at the old rate */
+    APP_BAUD_STATE_DRAIN,
+
+    /* Switched, waiting for the host to repeat the request */
+    APP_BAUD_STATE_CONFIRM,
+
+} APP_BAUD_STATES;
+
+typedef struct
+{
+    APP_BAUD_STATES state;
+
+    uint32_t rate;
+
+    /* Rate to switch to in DRAIN, rate to go back to in CONFIRM */
+    uint32_t otherRate;
+
+    /* SysTick count at the start of DRAIN or CONFIRM */
+    uint32_t stateTick;
+
+    uint32_t changes;
+
+    uint32_t reverts;
+
+} APP_BAUD_DATA;
+
+static APP_BAUD_DATA appBaudData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_BAUD_RateSet( uint32_t baudRate )
+{
+    USART_SERIAL_SETUP serialSetup;
+
+    serialSetup.baudRate = baudRate;
+    serialSetup.parity = USART_PARITY_NONE;
+    serialSetup.dataWidth = USART_DATA_8_BIT;
+    serialSetup.stopBits = USART_STOP_1_BIT;
+
+    (void) SERCOM3_USART_SerialSetup(&serialSetup, 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_BAUD_Initialize ( void )
+{
+    appBaudData.state = APP_BAUD_STATE_IDLE;
+    appBaudData.rate = APP_TELEMETRY_BAUD_RATE;
+    appBaudData.otherRate = APP_TELEMETRY_BAUD_RATE;
+    appBaudData.changes = 0U;
+    appBaudData.reverts = 0U;
+}
+
+void APP_BAUD_Tasks ( void )
+{
+    uint32_t tick = SYSTICK_GetTickCounter();
+    uint32_t baudRate;
+
+    switch ( appBaudData.state )
+    {
+        case APP_BAUD_STATE_DRAIN:
+        {
+            /* The telemetry is held, only the reply and console text are
+             * left to go out */
+            if (((SERCOM3_USART_WriteCountGet() == 0U) && (SERCOM3_USART_TransmitComplete() == true)) ||
+                ((tick - appBaudData.stateTick) >= APP_BAUD_DRAIN_MS))
+            {
+                baudRate = appBaudData.otherRate;
+                appBaudData.otherRate = appBaudData.rate;
+                appBaudData.rate = baudRate;
+
+                APP_BAUD_RateSet(baudRate);
+
+                appBaudData.changes++;
+                appBaudData.stateTick = tick;
+                appBaudData.state = APP_BAUD_STATE_CONFIRM;
+
+                APP_TELEMETRY_Hold(false);
+            }
+            break;
+        }
+
+        case APP_BAUD_STATE_CONFIRM:
+        {
+            if ((tick - appBaudData.stateTick) >= APP_BAUD_CONFIRM_MS)
+            {
+                /* The host did not follow, it still listens at the old rate
+                 * and needs a SNAPSHOT there */
+                appBaudData.rate = appBaudData.otherRate;
+
+                APP_BAUD_RateSet(appBaudData.rate);
+
+                appBaudData.reverts++;
+                appBaudData.state = APP_BAUD_STATE_IDLE;
+
+                APP_TELEMETRY_Hold(false);
+            }
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+uint32_t APP_BAUD_IdleUsGet ( void )
+{
+    switch ( appBaudData.state )
+    {
+        case APP_BAUD_STATE_DRAIN:
+        {
+            return 0U;
+        }
+
+        case APP_BAUD_STATE_CONFIRM:
+        {
+            return SYS_SCHED_MsPeriodIdleUsGet(appBaudData.stateTick, SYSTICK_GetTickCounter(), APP_BAUD_CONFIRM_MS);
+        }
+
+        default:
+        {
+            return SYS_SCHED_IDLE_FOREVER;
+        }
+    }
+}
+
+bool APP_BAUD_IsActive ( void )
+{
+    return (appBaudData.state != APP_BAUD_STATE_IDLE);
+}
+
+bool APP_BAUD_ClockIsSupported ( uint32_t frequency )
+{
+    USART_BAUD_SETUP setup;
+
+    return ((SERCOM3_USART_BaudCalculate(appBaudData.rate, frequency, &setup) == true) &&
+        (setup.sampleErrorPpm <= APP_BAUD_SAMPLE_ERROR_MAX_PPM));
+}
+
+void APP_BAUD_ClockChange ( void )
+{
+    APP_BAUD_RateSet(appBaudData.rate);
+}
+
+bool APP_BAUD_Request ( uint32_t baudRate, USART_BAUD_SETUP* setup )
+{
+    if ((baudRate < APP_BAUD_RATE_MIN) || (baudRate > APP_BAUD_RATE_MAX) ||
+        (SERCOM3_USART_BaudCalculate(baudRate, 0U, setup) == false) ||
+        (setup->sampleErrorPpm > APP_BAUD_SAMPLE_ERROR_MAX_PPM))
+    {
+        return false;
+    }
+
+    if (baudRate == appBaudData.rate)
+    {
+        if (appBaudData.state == APP_BAUD_STATE_DRAIN)
+        {
+            /* Changing to another rate already */
+            return false;
+        }
+
+        /* Confirmed, or nothing to change */
+        appBaudData.state = APP_BAUD_STATE_IDLE;
+        return true;
+    }
+
+    if (appBaudData.state != APP_BAUD_STATE_IDLE)
+    {
+        return false;
+    }
+
+    appBaudData.otherRate = baudRate;
+    appBaudData.stateTick = SYSTICK_GetTickCounter();
+    appBaudData.state = APP_BAUD_STATE_DRAIN;
+
+    APP_TELEMETRY_Hold(true);
+
+    return true;
+}
+
+uint32_t APP_BAUD_RateGet ( void )
+{
+    return appBaudData.rate;
+}
+
+uint32_t APP_BAUD_ChangesGet ( void )
+{
+    return appBaudData.changes;
+}
+
+uint32_t APP_BAUD_RevertsGet ( void )
+{
+    return appBaudData.reverts;
+}
+
+/*******************************************************************************
+ End of File
+ */
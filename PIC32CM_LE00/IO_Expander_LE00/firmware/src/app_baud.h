@@ -0,0 +1,195 @@
+/*******************************************************************************
+  Console Baud Rate Manager Header File
+
+  File Name:
+    app_baud.h
+
+  Summary:
+    Changes the SERCOM3 console rate at run time, as agreed with the host.
+
+  Description:
+    The console starts at APP_TELEMETRY_BAUD_RATE.  The host asks for a new
+    rate with an APP_RPC_OP_BAUD_SET request; the reply gives the rate the
+    baud generator will actually produce and is sent at the old rate.  The
+    telemetry is held until the reply is out, then SERCOM3 switches.
+
+    The host switches on the reply and repeats the request at the new rate.
+    If that does not arrive within APP_BAUD_CONFIRM_MS, the console goes back
+    to the old rate, so a host that cannot follow does not lose the link.
+
+    SERCOM3_USART_BaudCalculate picks the oversampling and the arithmetic or
+    fractional baud generation.  Rates whose stop bit sample error would be
+    over APP_BAUD_SAMPLE_ERROR_MAX_PPM are refused.
+
+*******************************************************************************/
+
+#ifndef _APP_BAUD_H
+#define _APP_BAUD_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Rates the host may ask for; 3 Mbit/s is GCLK0 / 16 */
+#define APP_BAUD_RATE_MIN                   (9600U)
+#define APP_BAUD_RATE_MAX                   (3000000U)
+
+/* Largest stop bit sample error accepted, in millionths of a bit; leaves the
+ * host receiver the same again within the usual budget */
+#define APP_BAUD_SAMPLE_ERROR_MAX_PPM       (100000U)
+
+/* Longest wait for the reply to leave at the old rate */
+#define APP_BAUD_DRAIN_MS                   (100U)
+
+/* Time the host has to confirm the new rate */
+#define APP_BAUD_CONFIRM_MS                 (1000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_BAUD_Initialize ( void )
+
+  Summary:
+    Takes APP_TELEMETRY_BAUD_RATE as the rate in use.
+
+  Remarks:
+    Must be called from SYS_Initialize after APP_TELEMETRY_Initialize.
+*/
+
+void APP_BAUD_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_BAUD_Tasks ( void )
+
+  Summary:
+    Switches SERCOM3 once the transmitter is idle, and goes back to the old
+    rate when the host does not confirm the new one.
+
+  Remarks:
+    Must be called from SYS_Tasks.
+*/
+
+void APP_BAUD_Tasks ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_BAUD_IdleUsGet ( void )
+
+  Summary:
+    Returns the microseconds before a change is undone, 0 while the
+    transmitter drains.
+
+  Remarks:
+    SYS_SCHED_IDLE_FOREVER with no change under way.
+*/
+
+uint32_t APP_BAUD_IdleUsGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_BAUD_IsActive ( void )
+
+  Summary:
+    True while a change is under way, the console must keep running.
+*/
+
+bool APP_BAUD_IsActive ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_BAUD_ClockIsSupported ( uint32_t frequency )
+
+  Summary:
+    True if the rate in use can be kept, within APP_BAUD_SAMPLE_ERROR_MAX_PPM,
+    with SERCOM3 clocked at frequency.
+*/
+
+bool APP_BAUD_ClockIsSupported ( uint32_t frequency );
+
+/*******************************************************************************
+  Function:
+    void APP_BAUD_ClockChange ( void )
+
+  Summary:
+    Sets the rate in use up again once the SERCOM3 clock has changed.
+
+  Remarks:
+    Called by the power service with interrupts disabled.
+*/
+
+void APP_BAUD_ClockChange ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_BAUD_Request ( uint32_t baudRate, USART_BAUD_SETUP* setup )
+
+  Summary:
+    Asks for a console rate, or confirms the rate just switched to.
+
+  Description:
+    Fills setup with the baud generator setting for the rate.  A rate other
+    than the one in use starts a change; the caller must queue its reply
+    before the next APP_BAUD_Tasks.  The rate in use, asked for again while
+    it waits to be confirmed, keeps it.
+
+  Returns:
+    false if the rate is out of range, too inaccurate, or a change to
+    another rate is under way.
+*/
+
+bool APP_BAUD_Request ( uint32_t baudRate, USART_BAUD_SETUP* setup );
+
+/*******************************************************************************
+  Function:
+    Counter getters
+
+  Summary:
+    The rate in use, changes made and changes undone for lack of a
+    confirmation.
+*/
+
+uint32_t APP_BAUD_RateGet ( void );
+
+uint32_t APP_BAUD_ChangesGet ( void );
+
+uint32_t APP_BAUD_RevertsGet ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_BAUD_H */
+
+/*******************************************************************************
+ End of File
+ */
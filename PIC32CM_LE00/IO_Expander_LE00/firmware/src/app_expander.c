@@ -0,0 +1,478 @@
+/*******************************************************************************
+  Multi-Expander Polling Source File
+
+  File Name:
+    app_expander.c
+
+  Summary:
+    Polls the inputs of all downstream MCP23017 expanders on the I2C masters.
+
+  Description:
+    See app_expander.h.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_expander.h"
+#include "app_target.h"
+#include "app_telemetry.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* First MCP23017 address, the expanders on a bus use consecutive addresses */
+#define APP_EXPANDER_BASE_ADDRESS           (0x20U)
+
+/* Addresses available on one bus (MCP23017 A2..A0) */
+#define APP_EXPANDER_ADDRESSES_NUMBER       (8U)
+
+/* Weight of an expander read in every round of its bus */
+#define APP_EXPANDER_WEIGHT_MAX             (4U)
+
+/* MCP23017 GPIOA register (IOCON.BANK = 0), GPIOB follows it */
+#define APP_EXPANDER_REG_GPIOA              (0x12U)
+
+typedef enum
+{
+    APP_EXPANDER_STATE_INIT = 0,
+    APP_EXPANDER_STATE_POLL,
+    APP_EXPANDER_STATE_WAIT,
+    APP_EXPANDER_STATE_ERROR,
+
+} APP_EXPANDER_STATES;
+
+typedef struct
+{
+    /* Bus the expander is assigned to */
+    uint8_t bus;
+
+    /* 7-bit I2C address of the expander on its bus */
+    uint8_t address;
+
+    /* Poll credit, the expander is read when it reaches APP_EXPANDER_WEIGHT_MAX */
+    uint8_t credit;
+
+    /* The expander is read in the current round */
+    bool isDue;
+
+    /* GPIOA and GPIOB read in the current round */
+    uint8_t rxBuffer[2];
+
+    /* Transfer handle of the read in the current round */
+    DRV_I2C_TRANSFER_HANDLE transferHandle;
+
+} APP_EXPANDER_DEVICE;
+
+typedef struct
+{
+    APP_EXPANDER_STATES state;
+
+    /* I2C driver client handle */
+    DRV_HANDLE i2cHandle;
+
+    /* Number of expanders assigned to the bus */
+    uint8_t devicesNumber;
+
+    /* Sum of the weights of the expanders assigned to the bus */
+    uint16_t load;
+
+    /* Number of reads of the current round not completed yet */
+    volatile uint8_t pendingCount;
+
+    /* SysTick count when the current round started */
+    uint32_t roundTick;
+
+} APP_EXPANDER_BUS;
+
+typedef struct
+{
+    /* Register pointer written ahead of every read */
+    uint8_t txBuffer[1];
+
+    /* One bit per bus that completed a round since the last cycle */
+    uint8_t roundDoneMask;
+
+    /* Least time between the starts of two rounds of a bus, 0 for back to
+       back rounds */
+    uint32_t pollPeriodMs;
+
+    APP_EXPANDER_BUS bus[APP_EXPANDER_BUSES_NUMBER];
+
+    APP_EXPANDER_DEVICE device[APP_TARGET_EXPANDERS_NUMBER];
+
+} APP_EXPANDER_DATA;
+
+static APP_EXPANDER_DATA appExpanderData;
+
+/* Poll weight of each expander, 1 (every fourth round) to APP_EXPANDER_WEIGHT_MAX;
+ * it also sets the bus split, so a change here moves expanders to another
+ * bus or address */
+static const uint8_t appExpanderWeight[APP_TARGET_EXPANDERS_NUMBER] =
+{
+    4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U,
+    4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U,
+};
+
+/* I2C driver instance of each bus */
+static const SYS_MODULE_INDEX appExpanderDriverIndex[APP_EXPANDER_BUSES_NUMBER] =
+{
+    DRV_I2C_INDEX_0,
+    DRV_I2C_INDEX_1,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Callback Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_EXPANDER_I2CEventHandler( DRV_I2C_TRANSFER_EVENT event,
+    DRV_I2C_TRANSFER_HANDLE transferHandle, uintptr_t context)
+{
+    APP_EXPANDER_DEVICE* device;
+    uint8_t index;
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        device = &appExpanderData.device[index];
+
+        if (device->transferHandle == transferHandle)
+        {
+            APP_TARGET_InputsUpdate(index, device->rxBuffer[0], device->rxBuffer[1],
+                (event == DRV_I2C_TRANSFER_EVENT_COMPLETE));
+            APP_TELEMETRY_InputsUpdate(index, device->rxBuffer[0], device->rxBuffer[1],
+                (event == DRV_I2C_TRANSFER_EVENT_COMPLETE));
+
+            device->transferHandle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+            appExpanderData.bus[context].pendingCount--;
+            break;
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_EXPANDER_BusAssign( void )
+{
+    uint8_t order[APP_TARGET_EXPANDERS_NUMBER];
+    APP_EXPANDER_DEVICE* device;
+    APP_EXPANDER_BUS* bus;
+    uint8_t index;
+    uint8_t pos;
+    uint8_t busIndex;
+    uint8_t target;
+
+    /* Order the expanders by decreasing weight, stable for equal weights */
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        pos = index;
+
+        while ((pos > 0U) && (appExpanderWeight[order[pos - 1U]] < appExpanderWeight[index]))
+        {
+            order[pos] = order[pos - 1U];
+            pos--;
+        }
+        order[pos] = index;
+    }
+
+    /* Heaviest first, each on the least loaded bus that has a free address */
+    for (pos = 0U; pos < APP_TARGET_EXPANDERS_NUMBER; pos++)
+    {
+        device = &appExpanderData.device[order[pos]];
+        target = APP_EXPANDER_BUSES_NUMBER;
+
+        for (busIndex = 0U; busIndex < APP_EXPANDER_BUSES_NUMBER; busIndex++)
+        {
+            bus = &appExpanderData.bus[busIndex];
+
+            if ((bus->devicesNumber < APP_EXPANDER_ADDRESSES_NUMBER) &&
+                ((target == APP_EXPANDER_BUSES_NUMBER) || (bus->load < appExpanderData.bus[target].load)))
+            {
+                target = busIndex;
+            }
+        }
+
+        bus = &appExpanderData.bus[target];
+
+        device->bus = target;
+        device->address = (uint8_t)(APP_EXPANDER_BASE_ADDRESS + bus->devicesNumber);
+        bus->devicesNumber++;
+        bus->load += appExpanderWeight[order[pos]];
+    }
+}
+
+static void APP_EXPANDER_RoundStart( uint8_t busIndex )
+{
+    APP_EXPANDER_BUS* bus = &appExpanderData.bus[busIndex];
+    APP_EXPANDER_DEVICE* device;
+    uint8_t index;
+    uint8_t count = 0U;
+    bool interruptState;
+
+    /* Select the expanders due in this round */
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        device = &appExpanderData.device[index];
+
+        device->isDue = false;
+
+        if (device->bus == busIndex)
+        {
+            device->credit += appExpanderWeight[index];
+
+            if (device->credit >= APP_EXPANDER_WEIGHT_MAX)
+            {
+                device->credit -= APP_EXPANDER_WEIGHT_MAX;
+                device->isDue = true;
+                count++;
+            }
+        }
+    }
+
+    /* Count all reads up front, completions may arrive while queueing */
+    bus->pendingCount = count;
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        device = &appExpanderData.device[index];
+
+        if ((device->bus != busIndex) || (device->isDue == false))
+        {
+            continue;
+        }
+
+        DRV_I2C_WriteReadTransferAdd(bus->i2cHandle, device->address,
+                appExpanderData.txBuffer, 1, device->rxBuffer, 2,
+                &device->transferHandle);
+
+        if (device->transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID)
+        {
+            /* Rejected or failed immediately, no event will follow */
+            APP_TARGET_InputsUpdate(index, 0U, 0U, false);
+            APP_TELEMETRY_InputsUpdate(index, 0U, 0U, false);
+
+            interruptState = SYS_INT_Disable();
+            bus->pendingCount--;
+            SYS_INT_Restore(interruptState);
+        }
+    }
+}
+
+static void APP_EXPANDER_BusTasks( uint8_t busIndex )
+{
+    APP_EXPANDER_BUS* bus = &appExpanderData.bus[busIndex];
+    uint32_t tick;
+    uint8_t index;
+
+    switch ( bus->state )
+    {
+        case APP_EXPANDER_STATE_INIT:
+        {
+            for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+            {
+                if (appExpanderData.device[index].bus == busIndex)
+                {
+                    SYS_LOG3("APP_EXPANDER: expander %u on bus %u at 0x%02X", index,
+                        busIndex, appExpanderData.device[index].address);
+                }
+            }
+
+            /* Own client, so the reads do not share an event handler with APP */
+            bus->i2cHandle = DRV_I2C_Open( appExpanderDriverIndex[busIndex], DRV_IO_INTENT_READWRITE);
+
+            if(bus->i2cHandle != DRV_HANDLE_INVALID)
+            {
+                DRV_I2C_TransferEventHandlerSet(bus->i2cHandle, APP_EXPANDER_I2CEventHandler, busIndex);
+
+                bus->state = APP_EXPANDER_STATE_POLL;
+            }
+            else
+            {
+                bus->state = APP_EXPANDER_STATE_ERROR;
+            }
+            break;
+        }
+
+        case APP_EXPANDER_STATE_POLL:
+        {
+            if (appExpanderData.pollPeriodMs != 0U)
+            {
+                tick = SYSTICK_GetTickCounter();
+
+                if ((tick - bus->roundTick) < appExpanderData.pollPeriodMs)
+                {
+                    break;
+                }
+
+                bus->roundTick = tick;
+            }
+
+            APP_EXPANDER_RoundStart(busIndex);
+
+            bus->state = APP_EXPANDER_STATE_WAIT;
+            break;
+        }
+
+        case APP_EXPANDER_STATE_WAIT:
+        {
+            if (bus->pendingCount == 0U)
+            {
+                appExpanderData.roundDoneMask |= (uint8_t)(1U << busIndex);
+
+                bus->state = APP_EXPANDER_STATE_POLL;
+            }
+            break;
+        }
+
+        default:
+        {
+            /* A bus in error no longer holds back the cycle count */
+            appExpanderData.roundDoneMask |= (uint8_t)(1U << busIndex);
+            break;
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_EXPANDER_Initialize ( void )
+{
+    uint8_t index;
+
+    appExpanderData.txBuffer[0] = APP_EXPANDER_REG_GPIOA;
+    appExpanderData.roundDoneMask = 0U;
+    appExpanderData.pollPeriodMs = 0U;
+
+    for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+    {
+        appExpanderData.bus[index].state = APP_EXPANDER_STATE_INIT;
+        appExpanderData.bus[index].i2cHandle = DRV_HANDLE_INVALID;
+        appExpanderData.bus[index].devicesNumber = 0U;
+        appExpanderData.bus[index].load = 0U;
+        appExpanderData.bus[index].pendingCount = 0U;
+        appExpanderData.bus[index].roundTick = 0U;
+    }
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        appExpanderData.device[index].credit = 0U;
+        appExpanderData.device[index].isDue = false;
+        appExpanderData.device[index].transferHandle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+    }
+
+    APP_EXPANDER_BusAssign();
+}
+
+void APP_EXPANDER_Tasks ( void )
+{
+    uint8_t index;
+
+    for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+    {
+        APP_EXPANDER_BusTasks(index);
+    }
+
+    if (appExpanderData.roundDoneMask == ((1U << APP_EXPANDER_BUSES_NUMBER) - 1U))
+    {
+        appExpanderData.roundDoneMask = 0U;
+
+        APP_TARGET_CycleComplete();
+        APP_TELEMETRY_CycleComplete();
+    }
+}
+
+uint32_t APP_EXPANDER_IdleUsGet ( void )
+{
+    const APP_EXPANDER_BUS* bus;
+    uint32_t idleUs = SYS_SCHED_IDLE_FOREVER;
+    uint32_t busIdleUs;
+    uint8_t index;
+
+    for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+    {
+        bus = &appExpanderData.bus[index];
+
+        /* A round in progress is woken by the transfer interrupts */
+        if ((bus->state == APP_EXPANDER_STATE_ERROR) ||
+            ((bus->state == APP_EXPANDER_STATE_WAIT) && (bus->pendingCount != 0U)))
+        {
+            continue;
+        }
+
+        if ((bus->state != APP_EXPANDER_STATE_POLL) || (appExpanderData.pollPeriodMs == 0U))
+        {
+            return 0U;
+        }
+
+        busIdleUs = SYS_SCHED_MsPeriodIdleUsGet(bus->roundTick, SYSTICK_GetTickCounter(), appExpanderData.pollPeriodMs);
+
+        if (busIdleUs < idleUs)
+        {
+            idleUs = busIdleUs;
+        }
+    }
+
+    return idleUs;
+}
+
+bool APP_EXPANDER_IsActive ( void )
+{
+    uint8_t index;
+
+    for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+    {
+        if (appExpanderData.bus[index].state == APP_EXPANDER_STATE_WAIT)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void APP_EXPANDER_PollPeriodSet ( uint32_t periodMs )
+{
+    appExpanderData.pollPeriodMs = periodMs;
+}
+
+uint32_t APP_EXPANDER_PollPeriodGet ( void )
+{
+    return appExpanderData.pollPeriodMs;
+}
+
+bool APP_EXPANDER_DeviceGet ( uint8_t index, uint8_t* bus, uint8_t* address )
+{
+    if (index >= APP_TARGET_EXPANDERS_NUMBER)
+    {
+        return false;
+    }
+
+    *bus = appExpanderData.device[index].bus;
+    *address = appExpanderData.device[index].address;
+
+    return true;
+}
+
+SYS_MODULE_INDEX APP_EXPANDER_BusDriverGet ( uint8_t bus )
+{
+    return appExpanderDriverIndex[bus];
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,168 @@
+/*******************************************************************************
+  Multi-Expander Polling Header File
+
+  File Name:
+    app_expander.h
+
+  Summary:
+    Polls the inputs of all downstream MCP23017 expanders on the I2C masters.
+
+  Description:
+    The expanders are spread across both I2C buses (DRV_I2C_INDEX_0 on
+    SERCOM5, DRV_I2C_INDEX_1 on SERCOM2).  Each bus runs its own polling
+    rounds on its own DRV_I2C client and queues all of its reads at once, so
+    the driver chains them back to back and the two buses run in parallel.
+    The results are published to the I2C target register map (app_target.h).
+
+    Every expander has a poll weight: it is read in weight out of
+    APP_EXPANDER_WEIGHT_MAX rounds of its bus.  At initialization the
+    expanders are assigned heaviest first to the bus with the least traffic so
+    far, taking the next free address (0x20 upwards) on that bus.  The
+    resulting wiring is printed on the console at start-up.
+
+    The split is made once, from the weight table, and the expanders have to
+    be wired to match it; it does not follow the traffic at run time.  With
+    the default weights, all equal, each bus gets eight expanders.
+*******************************************************************************/
+
+#ifndef _APP_EXPANDER_H
+#define _APP_EXPANDER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of I2C buses the expanders are spread across */
+#define APP_EXPANDER_BUSES_NUMBER           (2U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_EXPANDER_Initialize ( void )
+
+  Summary:
+    Places the expander polling state machine in its initial state.
+
+  Remarks:
+    Must be called from SYS_Initialize.
+*/
+
+void APP_EXPANDER_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_EXPANDER_Tasks ( void )
+
+  Summary:
+    Runs the expander polling state machine.
+
+  Remarks:
+    Must be called from SYS_Tasks.
+*/
+
+void APP_EXPANDER_Tasks ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_EXPANDER_IdleUsGet ( void )
+
+  Summary:
+    Returns the microseconds before a bus starts its next round.
+
+  Remarks:
+    0 when a round is to be started or has completed, always with the
+    rounds back to back, the default.  A round in progress waits for the
+    transfer interrupts, and every bus in error for nothing:
+    SYS_SCHED_IDLE_FOREVER.
+*/
+
+uint32_t APP_EXPANDER_IdleUsGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_EXPANDER_IsActive ( void )
+
+  Summary:
+    True while a round is in progress, its bus must keep running.
+*/
+
+bool APP_EXPANDER_IsActive ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_EXPANDER_PollPeriodSet ( uint32_t periodMs )
+
+  Summary:
+    Sets the least time between the starts of two rounds of a bus.
+
+  Remarks:
+    0 starts every round as soon as the previous one completes.  A period
+    longer than a round leaves the CPU idle in between.  The period must be
+    below 4294967 ms.
+*/
+
+void APP_EXPANDER_PollPeriodSet ( uint32_t periodMs );
+
+uint32_t APP_EXPANDER_PollPeriodGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_EXPANDER_DeviceGet ( uint8_t index, uint8_t* bus, uint8_t* address )
+
+  Summary:
+    Gives the bus and the 7-bit I2C address an expander was assigned.
+
+  Returns:
+    false if the expander does not exist.
+*/
+
+bool APP_EXPANDER_DeviceGet ( uint8_t index, uint8_t* bus, uint8_t* address );
+
+/*******************************************************************************
+  Function:
+    SYS_MODULE_INDEX APP_EXPANDER_BusDriverGet ( uint8_t bus )
+
+  Summary:
+    Gives the I2C driver instance of a bus, for clients of their own.
+*/
+
+SYS_MODULE_INDEX APP_EXPANDER_BusDriverGet ( uint8_t bus );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_EXPANDER_H */
+
+/*******************************************************************************
+ End of File
+ */
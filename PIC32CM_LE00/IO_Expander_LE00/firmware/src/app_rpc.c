@@ -0,0 +1,847 @@
+/*******************************************************************************
+  Host Request Interface Source File
+
+  File Name:
+    app_rpc.c
+
+  Summary:
+    Binary requests from the host to read and write the expander ports.
+
+  Description:
+    See app_rpc.h for the frame format.  A received request is checked whole
+    and held in a slot; its items are then turned into DRV_I2C transfers on
+    the client this module opens on every expander bus, and the reply is
+    sent once the last transfer has completed.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_rpc.h"
+#include "app_expander.h"
+#include "app_telemetry.h"
+#include "app_baud.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Console bytes taken per APP_RPC_Tasks call */
+#define APP_RPC_READ_BUDGET                 (64U)
+
+/* Console text held for the command shell, a power of two */
+#define APP_RPC_TEXT_BUFFER_SIZE            (64U)
+
+/* The console stays awake this long after the last byte received: the
+ * SERCOM is stopped in standby and would lose the next request */
+#define APP_RPC_CONSOLE_AWAKE_MS            (5000U)
+
+/* Request payload and CRC after COBS encoding, one overhead byte per 254 */
+#define APP_RPC_FRAME_SIZE_MAX              (APP_RPC_REQUEST_SIZE_MAX + 2U + 1U)
+
+/* type, sequence, timestamp, operation, result, count */
+#define APP_RPC_REPLY_HEADER_SIZE           (9U)
+
+#define APP_RPC_REPLY_SIZE_MAX              (APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX)
+
+/* Transfers in flight in total and on one bus; the driver queue sizes
+ * leave room for them next to the polling reads */
+#define APP_RPC_TRANSFERS_MAX               (16U)
+#define APP_RPC_BUS_TRANSFERS_MAX           (8U)
+
+/* Most items in a request */
+#define APP_RPC_ITEMS_MAX                   (32U)
+
+/* MCP23017 GPIOA register (IOCON.BANK = 0), GPIOB follows it */
+#define APP_RPC_REG_GPIOA                   (0x12U)
+
+typedef enum
+{
+    APP_RPC_STATE_INIT = 0,
+    APP_RPC_STATE_RUN,
+    APP_RPC_STATE_ERROR,
+
+} APP_RPC_STATES;
+
+typedef enum
+{
+    APP_RPC_SLOT_FREE = 0,
+
+    /* Waiting for its turn, or its items are being queued */
+    APP_RPC_SLOT_ISSUE,
+
+    /* All items queued, waiting for the transfers to complete */
+    APP_RPC_SLOT_WAIT,
+
+    /* Reply ready, waiting for room in the transmit ring */
+    APP_RPC_SLOT_REPLY,
+
+} APP_RPC_SLOT_STATES;
+
+typedef struct
+{
+    APP_RPC_SLOT_STATES state;
+
+    /* Order of arrival, items are queued one request after the other */
+    uint32_t ticket;
+
+    /* Payload, followed by room for the CRC */
+    uint8_t request[APP_RPC_REQUEST_SIZE_MAX + 2U];
+    uint32_t requestSize;
+
+    uint8_t reply[APP_RPC_REPLY_SIZE_MAX + 2U];
+    uint32_t replySize;
+
+    /* Next item to queue and where it starts in the request and the reply */
+    uint8_t itemIndex;
+    uint32_t requestOffset;
+    uint32_t replyOffset;
+
+    /* Transfers queued and not completed yet */
+    volatile uint8_t pendingCount;
+
+    volatile bool isItemFailed;
+
+} APP_RPC_SLOT;
+
+typedef struct
+{
+    volatile bool isUsed;
+
+    DRV_I2C_TRANSFER_HANDLE transferHandle;
+
+    uint8_t slot;
+
+    uint8_t bus;
+
+    /* Item status in the reply */
+    uint8_t* pStatus;
+
+    /* Register pointer and port of a port write */
+    uint8_t txBuffer[3];
+
+} APP_RPC_TRANSFER;
+
+typedef struct
+{
+    APP_RPC_STATES state;
+
+    /* Own client on every expander bus */
+    DRV_HANDLE i2cHandle[APP_EXPANDER_BUSES_NUMBER];
+
+    volatile uint8_t busTransfers[APP_EXPANDER_BUSES_NUMBER];
+
+    APP_RPC_SLOT slot[APP_RPC_REQUESTS_MAX];
+
+    uint32_t nextTicket;
+
+    APP_RPC_TRANSFER transfer[APP_RPC_TRANSFERS_MAX];
+
+    /* Frame being received, still COBS encoded */
+    uint8_t rxFrame[APP_RPC_FRAME_SIZE_MAX];
+    uint32_t rxFrameSize;
+    bool isInFrame;
+    bool isFrameOverflow;
+
+    /* Decoded frame */
+    uint8_t payload[APP_RPC_FRAME_SIZE_MAX];
+
+    /* Console text for the command shell */
+    uint8_t text[APP_RPC_TEXT_BUFFER_SIZE];
+    uint32_t textInIndex;
+    uint32_t textOutIndex;
+
+    /* SysTick count when the last console byte was received */
+    uint32_t rxTick;
+
+    /* Frames dropped for a bad CRC, bad encoding or length */
+    uint32_t framesRejected;
+
+} APP_RPC_DATA;
+
+static APP_RPC_DATA appRpcData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Callback Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_RPC_I2CEventHandler( DRV_I2C_TRANSFER_EVENT event,
+    DRV_I2C_TRANSFER_HANDLE transferHandle, uintptr_t context)
+{
+    APP_RPC_TRANSFER* transfer;
+    APP_RPC_SLOT* slot;
+    uint8_t index;
+
+    for (index = 0U; index < APP_RPC_TRANSFERS_MAX; index++)
+    {
+        transfer = &appRpcData.transfer[index];
+
+        if ((transfer->isUsed == true) && (transfer->transferHandle == transferHandle))
+        {
+            slot = &appRpcData.slot[transfer->slot];
+
+            if (event == DRV_I2C_TRANSFER_EVENT_COMPLETE)
+            {
+                *transfer->pStatus = APP_RPC_STATUS_OK;
+            }
+            else
+            {
+                *transfer->pStatus = APP_RPC_STATUS_I2C_ERROR;
+                slot->isItemFailed = true;
+            }
+
+            slot->pendingCount--;
+            appRpcData.busTransfers[context]--;
+
+            transfer->transferHandle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+            transfer->isUsed = false;
+            break;
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Returns the decoded size, 0 for a bad encoding or no room in dst */
+static uint32_t APP_RPC_CobsDecode( const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t dstSize )
+{
+    uint32_t index = 0U;
+    uint32_t dstIndex = 0U;
+    uint32_t code;
+
+    while (index < size)
+    {
+        code = src[index];
+
+        if ((code == 0U) || ((index + code) > size) || ((dstIndex + code) > dstSize))
+        {
+            return 0U;
+        }
+
+        (void) memcpy(&dst[dstIndex], &src[index + 1U], code - 1U);
+        dstIndex += code - 1U;
+        index += code;
+
+        if ((code != 0xFFU) && (index < size))
+        {
+            dst[dstIndex] = 0U;
+            dstIndex++;
+        }
+    }
+
+    return dstIndex;
+}
+
+static void APP_RPC_Put32( uint8_t* dst, uint32_t value )
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+static void APP_RPC_ReplyHeaderPut( uint8_t* reply, uint8_t sequence, uint8_t op, uint8_t result, uint8_t count )
+{
+    reply[0] = APP_RPC_FRAME_REPLY;
+    reply[1] = sequence;
+    APP_RPC_Put32(&reply[2], APP_TELEMETRY_TimestampGet());
+    reply[6] = op;
+    reply[7] = result;
+    reply[8] = count;
+}
+
+/* Replies to a request that is not run; lost if the transmit ring is full */
+static void APP_RPC_ErrorReply( uint8_t sequence, uint8_t op, uint8_t result )
+{
+    uint8_t reply[APP_RPC_REPLY_HEADER_SIZE + 2U];
+
+    APP_RPC_ReplyHeaderPut(reply, sequence, op, result, 0U);
+
+    (void) APP_TELEMETRY_FrameWrite(reply, APP_RPC_REPLY_HEADER_SIZE);
+}
+
+/* Request and reply size of the item at offset, false if it is malformed */
+static bool APP_RPC_ItemSizeGet( const uint8_t* request, uint32_t offset, uint32_t size,
+    uint32_t* requestSize, uint32_t* replySize )
+{
+    uint8_t op = request[1];
+    uint32_t length;
+
+    switch (op)
+    {
+        case APP_RPC_OP_WRITE_PORTS:
+        {
+            *requestSize = 3U;
+            *replySize = 1U;
+            break;
+        }
+
+        case APP_RPC_OP_READ_PORTS:
+        {
+            *requestSize = 1U;
+            *replySize = 3U;
+            break;
+        }
+
+        case APP_RPC_OP_BAUD_SET:
+        {
+            *requestSize = 4U;
+            *replySize = 13U;
+            break;
+        }
+
+        default:
+        {
+            if ((offset + 3U) > size)
+            {
+                return false;
+            }
+
+            length = request[offset + 1U] & APP_RPC_SCRIPT_LENGTH_MASK;
+
+            if ((length == 0U) || (length > APP_RPC_SCRIPT_LENGTH_MAX))
+            {
+                return false;
+            }
+
+            if ((request[offset + 1U] & APP_RPC_SCRIPT_READ) != 0U)
+            {
+                *requestSize = 3U;
+                *replySize = 1U + length;
+            }
+            else
+            {
+                *requestSize = 3U + length;
+                *replySize = 1U;
+            }
+            break;
+        }
+    }
+
+    return ((offset + *requestSize) <= size);
+}
+
+/* Checks the whole request before any of it runs */
+static uint8_t APP_RPC_RequestCheck( const uint8_t* request, uint32_t size )
+{
+    uint32_t requestOffset = 3U;
+    uint32_t replyOffset = APP_RPC_REPLY_HEADER_SIZE;
+    uint32_t requestSize;
+    uint32_t replySize;
+    uint32_t item;
+
+    if (size < 3U)
+    {
+        return APP_RPC_RESULT_MALFORMED;
+    }
+
+    if ((request[1] != APP_RPC_OP_WRITE_PORTS) && (request[1] != APP_RPC_OP_READ_PORTS) &&
+        (request[1] != APP_RPC_OP_SCRIPT) && (request[1] != APP_RPC_OP_BAUD_SET))
+    {
+        return APP_RPC_RESULT_UNKNOWN_OP;
+    }
+
+    if ((request[2] == 0U) || (request[2] > APP_RPC_ITEMS_MAX) ||
+        ((request[1] == APP_RPC_OP_BAUD_SET) && (request[2] != 1U)))
+    {
+        return APP_RPC_RESULT_MALFORMED;
+    }
+
+    for (item = 0U; item < request[2]; item++)
+    {
+        if (APP_RPC_ItemSizeGet(request, requestOffset, size, &requestSize, &replySize) == false)
+        {
+            return APP_RPC_RESULT_MALFORMED;
+        }
+
+        requestOffset += requestSize;
+        replyOffset += replySize;
+    }
+
+    if ((requestOffset != size) || (replyOffset > APP_RPC_REPLY_SIZE_MAX))
+    {
+        return APP_RPC_RESULT_MALFORMED;
+    }
+
+    return APP_RPC_RESULT_OK;
+}
+
+/* Answered at once, the reply has to go out before the rate changes */
+static void APP_RPC_BaudReply( const uint8_t* request )
+{
+    uint8_t reply[APP_RPC_REPLY_HEADER_SIZE + 13U + 2U];
+    uint32_t baudRate = (uint32_t)request[3] | ((uint32_t)request[4] << 8) |
+        ((uint32_t)request[5] << 16) | ((uint32_t)request[6] << 24);
+    USART_BAUD_SETUP setup = { 0 };
+    bool isAccepted = APP_BAUD_Request(baudRate, &setup);
+
+    APP_RPC_ReplyHeaderPut(reply, request[0], request[1],
+        (isAccepted == true) ? APP_RPC_RESULT_OK : APP_RPC_RESULT_ITEM_FAILED, 1U);
+
+    reply[APP_RPC_REPLY_HEADER_SIZE] = (isAccepted == true) ? APP_RPC_STATUS_OK : APP_RPC_STATUS_BAUD_REFUSED;
+    APP_RPC_Put32(&reply[APP_RPC_REPLY_HEADER_SIZE + 1U], setup.baudRate);
+    APP_RPC_Put32(&reply[APP_RPC_REPLY_HEADER_SIZE + 5U], (uint32_t)setup.errorPpm);
+    APP_RPC_Put32(&reply[APP_RPC_REPLY_HEADER_SIZE + 9U], setup.sampleErrorPpm);
+
+    (void) APP_TELEMETRY_FrameWrite(reply, APP_RPC_REPLY_HEADER_SIZE + 13U);
+}
+
+static void APP_RPC_RequestReceive( const uint8_t* request, uint32_t size )
+{
+    APP_RPC_SLOT* slot = NULL;
+    uint8_t result = APP_RPC_RequestCheck(request, size);
+    uint8_t index;
+
+    if (result != APP_RPC_RESULT_OK)
+    {
+        APP_RPC_ErrorReply(request[0], (size > 1U) ? request[1] : 0U, result);
+        return;
+    }
+
+    if (request[1] == APP_RPC_OP_BAUD_SET)
+    {
+        APP_RPC_BaudReply(request);
+        return;
+    }
+
+    if (appRpcData.state != APP_RPC_STATE_RUN)
+    {
+        APP_RPC_ErrorReply(request[0], request[1], APP_RPC_RESULT_BUSY);
+        return;
+    }
+
+    for (index = 0U; index < APP_RPC_REQUESTS_MAX; index++)
+    {
+        if (appRpcData.slot[index].state == APP_RPC_SLOT_FREE)
+        {
+            slot = &appRpcData.slot[index];
+            break;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        APP_RPC_ErrorReply(request[0], request[1], APP_RPC_RESULT_BUSY);
+        return;
+    }
+
+    (void) memcpy(slot->request, request, size);
+    slot->requestSize = size;
+    slot->ticket = appRpcData.nextTicket;
+    appRpcData.nextTicket++;
+
+    slot->itemIndex = 0U;
+    slot->requestOffset = 3U;
+    slot->replyOffset = APP_RPC_REPLY_HEADER_SIZE;
+    slot->pendingCount = 0U;
+    slot->isItemFailed = false;
+    slot->state = APP_RPC_SLOT_ISSUE;
+}
+
+static void APP_RPC_FrameReceive( void )
+{
+    uint32_t size;
+    uint16_t crc;
+
+    if (appRpcData.isFrameOverflow == true)
+    {
+        appRpcData.framesRejected++;
+        return;
+    }
+
+    size = APP_RPC_CobsDecode(appRpcData.rxFrame, appRpcData.rxFrameSize,
+        appRpcData.payload, sizeof(appRpcData.payload));
+
+    if (size < 3U)
+    {
+        appRpcData.framesRejected++;
+        return;
+    }
+
+    size -= 2U;
+    crc = (uint16_t)(appRpcData.payload[size] | ((uint16_t)appRpcData.payload[size + 1U] << 8));
+
+    if ((size > APP_RPC_REQUEST_SIZE_MAX) || (crc != APP_TELEMETRY_Crc16(appRpcData.payload, size)))
+    {
+        appRpcData.framesRejected++;
+        return;
+    }
+
+    APP_RPC_RequestReceive(appRpcData.payload, size);
+}
+
+/* Takes the request frames out of the console input, the rest is text */
+static void APP_RPC_ConsoleReceive( void )
+{
+    uint8_t rxBuffer[APP_RPC_READ_BUDGET];
+    uint32_t textFree;
+    uint32_t rxSize;
+    uint32_t index;
+    uint8_t rxByte;
+
+    /* Everything read may be text, take no more than there is room for */
+    textFree = (APP_RPC_TEXT_BUFFER_SIZE - 1U) - ((appRpcData.textInIndex - appRpcData.textOutIndex) & (APP_RPC_TEXT_BUFFER_SIZE - 1U));
+
+    rxSize = (uint32_t)SERCOM3_USART_Read(rxBuffer, (textFree < APP_RPC_READ_BUDGET) ? textFree : APP_RPC_READ_BUDGET);
+
+    if (rxSize != 0U)
+    {
+        appRpcData.rxTick = SYSTICK_GetTickCounter();
+    }
+
+    for (index = 0U; index < rxSize; index++)
+    {
+        rxByte = rxBuffer[index];
+
+        if (appRpcData.isInFrame == false)
+        {
+            if (rxByte == 0U)
+            {
+                appRpcData.isInFrame = true;
+                appRpcData.isFrameOverflow = false;
+                appRpcData.rxFrameSize = 0U;
+            }
+            else
+            {
+                appRpcData.text[appRpcData.textInIndex] = rxByte;
+                appRpcData.textInIndex = (appRpcData.textInIndex + 1U) & (APP_RPC_TEXT_BUFFER_SIZE - 1U);
+            }
+        }
+        else if (rxByte == 0U)
+        {
+            /* Back-to-back delimiters, the frame starts at the second one */
+            if ((appRpcData.rxFrameSize != 0U) || (appRpcData.isFrameOverflow == true))
+            {
+                APP_RPC_FrameReceive();
+                appRpcData.isInFrame = false;
+            }
+        }
+        else if (appRpcData.rxFrameSize < APP_RPC_FRAME_SIZE_MAX)
+        {
+            appRpcData.rxFrame[appRpcData.rxFrameSize] = rxByte;
+            appRpcData.rxFrameSize++;
+        }
+        else
+        {
+            appRpcData.isFrameOverflow = true;
+        }
+    }
+}
+
+/* Queues the transfer of the next item; false if it has to wait for a free
+ * transfer on its bus */
+static bool APP_RPC_ItemIssue( uint8_t slotIndex )
+{
+    APP_RPC_SLOT* slot = &appRpcData.slot[slotIndex];
+    uint8_t* item = &slot->request[slot->requestOffset];
+    uint8_t* status = &slot->reply[slot->replyOffset];
+    APP_RPC_TRANSFER* transfer = NULL;
+    uint32_t requestSize;
+    uint32_t replySize;
+    uint32_t length;
+    uint8_t bus;
+    uint8_t address;
+    uint8_t index;
+    bool interruptState;
+
+    (void) APP_RPC_ItemSizeGet(slot->request, slot->requestOffset, slot->requestSize, &requestSize, &replySize);
+
+    if (APP_EXPANDER_DeviceGet(item[0], &bus, &address) == false)
+    {
+        *status = APP_RPC_STATUS_NO_EXPANDER;
+        slot->isItemFailed = true;
+    }
+    else
+    {
+        if (appRpcData.busTransfers[bus] >= APP_RPC_BUS_TRANSFERS_MAX)
+        {
+            return false;
+        }
+
+        for (index = 0U; index < APP_RPC_TRANSFERS_MAX; index++)
+        {
+            if (appRpcData.transfer[index].isUsed == false)
+            {
+                transfer = &appRpcData.transfer[index];
+                break;
+            }
+        }
+
+        if (transfer == NULL)
+        {
+            return false;
+        }
+
+        transfer->slot = slotIndex;
+        transfer->bus = bus;
+        transfer->pStatus = status;
+        *status = APP_RPC_STATUS_NOT_QUEUED;
+
+        /* Counted up front, the transfer may complete before the add returns */
+        interruptState = SYS_INT_Disable();
+        transfer->isUsed = true;
+        slot->pendingCount++;
+        appRpcData.busTransfers[bus]++;
+        SYS_INT_Restore(interruptState);
+
+        if (slot->request[1] == APP_RPC_OP_WRITE_PORTS)
+        {
+            transfer->txBuffer[0] = APP_RPC_REG_GPIOA;
+            transfer->txBuffer[1] = item[1];
+            transfer->txBuffer[2] = item[2];
+
+            DRV_I2C_WriteTransferAdd(appRpcData.i2cHandle[bus], address,
+                transfer->txBuffer, 3, &transfer->transferHandle);
+        }
+        else if (slot->request[1] == APP_RPC_OP_READ_PORTS)
+        {
+            transfer->txBuffer[0] = APP_RPC_REG_GPIOA;
+
+            DRV_I2C_WriteReadTransferAdd(appRpcData.i2cHandle[bus], address,
+                transfer->txBuffer, 1, &status[1], 2, &transfer->transferHandle);
+        }
+        else
+        {
+            length = item[1] & APP_RPC_SCRIPT_LENGTH_MASK;
+
+            if ((item[1] & APP_RPC_SCRIPT_READ) != 0U)
+            {
+                DRV_I2C_WriteReadTransferAdd(appRpcData.i2cHandle[bus], address,
+                    &item[2], 1, &status[1], length, &transfer->transferHandle);
+            }
+            else
+            {
+                /* Register and data are contiguous in the request */
+                DRV_I2C_WriteTransferAdd(appRpcData.i2cHandle[bus], address,
+                    &item[2], length + 1U, &transfer->transferHandle);
+            }
+        }
+
+        if (transfer->transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID)
+        {
+            /* Rejected or failed immediately, no event will follow */
+            interruptState = SYS_INT_Disable();
+            transfer->isUsed = false;
+            slot->pendingCount--;
+            appRpcData.busTransfers[bus]--;
+            slot->isItemFailed = true;
+            SYS_INT_Restore(interruptState);
+        }
+    }
+
+    slot->itemIndex++;
+    slot->requestOffset += requestSize;
+    slot->replyOffset += replySize;
+
+    return true;
+}
+
+/* Queues the items of the oldest request that has any left */
+static void APP_RPC_RequestIssue( void )
+{
+    APP_RPC_SLOT* slot;
+    uint8_t slotIndex = APP_RPC_REQUESTS_MAX;
+    uint8_t index;
+
+    for (index = 0U; index < APP_RPC_REQUESTS_MAX; index++)
+    {
+        slot = &appRpcData.slot[index];
+
+        if ((slot->state == APP_RPC_SLOT_ISSUE) &&
+            ((slotIndex == APP_RPC_REQUESTS_MAX) ||
+            ((slot->ticket - appRpcData.slot[slotIndex].ticket) > 0x7FFFFFFFU)))
+        {
+            slotIndex = index;
+        }
+    }
+
+    if (slotIndex == APP_RPC_REQUESTS_MAX)
+    {
+        return;
+    }
+
+    slot = &appRpcData.slot[slotIndex];
+
+    while (slot->itemIndex < slot->request[2])
+    {
+        if (APP_RPC_ItemIssue(slotIndex) == false)
+        {
+            return;
+        }
+    }
+
+    slot->replySize = slot->replyOffset;
+    slot->state = APP_RPC_SLOT_WAIT;
+}
+
+static void APP_RPC_ReplySend( void )
+{
+    APP_RPC_SLOT* slot;
+    uint8_t index;
+
+    for (index = 0U; index < APP_RPC_REQUESTS_MAX; index++)
+    {
+        slot = &appRpcData.slot[index];
+
+        if ((slot->state == APP_RPC_SLOT_WAIT) && (slot->pendingCount == 0U))
+        {
+            APP_RPC_ReplyHeaderPut(slot->reply, slot->request[0], slot->request[1],
+                (slot->isItemFailed == true) ? APP_RPC_RESULT_ITEM_FAILED : APP_RPC_RESULT_OK,
+                slot->request[2]);
+
+            slot->state = APP_RPC_SLOT_REPLY;
+        }
+
+        if (slot->state == APP_RPC_SLOT_REPLY)
+        {
+            if (APP_TELEMETRY_FrameWrite(slot->reply, slot->replySize) == true)
+            {
+                slot->state = APP_RPC_SLOT_FREE;
+            }
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_RPC_Initialize ( void )
+{
+    uint8_t index;
+
+    (void) memset(&appRpcData, 0, sizeof(appRpcData));
+
+    appRpcData.state = APP_RPC_STATE_INIT;
+
+    for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+    {
+        appRpcData.i2cHandle[index] = DRV_HANDLE_INVALID;
+    }
+
+    for (index = 0U; index < APP_RPC_TRANSFERS_MAX; index++)
+    {
+        appRpcData.transfer[index].transferHandle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+    }
+}
+
+void APP_RPC_Tasks ( void )
+{
+    uint8_t index;
+
+    switch ( appRpcData.state )
+    {
+        case APP_RPC_STATE_INIT:
+        {
+            for (index = 0U; index < APP_EXPANDER_BUSES_NUMBER; index++)
+            {
+                appRpcData.i2cHandle[index] = DRV_I2C_Open(APP_EXPANDER_BusDriverGet(index), DRV_IO_INTENT_READWRITE);
+
+                if (appRpcData.i2cHandle[index] == DRV_HANDLE_INVALID)
+                {
+                    appRpcData.state = APP_RPC_STATE_ERROR;
+                    return;
+                }
+
+                DRV_I2C_TransferEventHandlerSet(appRpcData.i2cHandle[index], APP_RPC_I2CEventHandler, index);
+            }
+
+            appRpcData.state = APP_RPC_STATE_RUN;
+            break;
+        }
+
+        case APP_RPC_STATE_RUN:
+        {
+            APP_RPC_ConsoleReceive();
+            APP_RPC_RequestIssue();
+            APP_RPC_ReplySend();
+            break;
+        }
+
+        default:
+        {
+            /* Requests are answered busy, the console text still passes */
+            APP_RPC_ConsoleReceive();
+            break;
+        }
+    }
+}
+
+uint32_t APP_RPC_IdleUsGet ( void )
+{
+    const APP_RPC_SLOT* slot;
+    uint8_t index;
+
+    if ((appRpcData.state == APP_RPC_STATE_INIT) ||
+        (appRpcData.textInIndex != appRpcData.textOutIndex) ||
+        (SERCOM3_USART_ReadCountGet() != 0U))
+    {
+        return 0U;
+    }
+
+    /* A request waiting for its transfers is woken by their interrupts */
+    for (index = 0U; index < APP_RPC_REQUESTS_MAX; index++)
+    {
+        slot = &appRpcData.slot[index];
+
+        if ((slot->state == APP_RPC_SLOT_ISSUE) || (slot->state == APP_RPC_SLOT_REPLY) ||
+            ((slot->state == APP_RPC_SLOT_WAIT) && (slot->pendingCount == 0U)))
+        {
+            return 0U;
+        }
+    }
+
+    return SYS_SCHED_IDLE_FOREVER;
+}
+
+bool APP_RPC_IsActive ( void )
+{
+    uint8_t index;
+
+    for (index = 0U; index < APP_RPC_REQUESTS_MAX; index++)
+    {
+        if (appRpcData.slot[index].state != APP_RPC_SLOT_FREE)
+        {
+            return true;
+        }
+    }
+
+    /* Part of a frame received, bytes still going out, or a host that may
+     * send again soon */
+    return ((appRpcData.isInFrame == true) ||
+        (SERCOM3_USART_WriteCountGet() != 0U) ||
+        (SERCOM3_USART_TransmitComplete() == false) ||
+        ((SYSTICK_GetTickCounter() - appRpcData.rxTick) < APP_RPC_CONSOLE_AWAKE_MS));
+}
+
+size_t APP_RPC_ConsoleRead ( uint8_t* pRdBuffer, const size_t size )
+{
+    size_t nBytesRead = 0U;
+
+    while ((nBytesRead < size) && (appRpcData.textOutIndex != appRpcData.textInIndex))
+    {
+        pRdBuffer[nBytesRead] = appRpcData.text[appRpcData.textOutIndex];
+        appRpcData.textOutIndex = (appRpcData.textOutIndex + 1U) & (APP_RPC_TEXT_BUFFER_SIZE - 1U);
+        nBytesRead++;
+    }
+
+    return nBytesRead;
+}
+
+/*******************************************************************************
+ End of File
+ */
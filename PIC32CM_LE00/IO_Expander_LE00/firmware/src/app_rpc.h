@@ -0,0 +1,195 @@
+/*******************************************************************************
+  Host Request Interface Header File
+
+  File Name:
+    app_rpc.h
+
+  Summary:
+    Binary requests from the host to read and write the expander ports.
+
+  Description:
+    Requests come in on the SERCOM3 console as frames of the same kind as
+    the telemetry: 0x00, COBS(payload, CRC-16/CCITT-FALSE of the payload,
+    little endian), 0x00.  Anything outside a frame is console text and goes
+    on to the command shell.  All fields are little endian.
+
+    Request payload:
+
+        sequence (u8), operation (u8), count (u8), items
+
+        WRITE_PORTS  0x01  expander (u8), port (u16)
+        READ_PORTS   0x02  expander (u8)
+        SCRIPT       0x03  expander (u8), control (u8), register (u8),
+                           data (length bytes, writes only)
+        BAUD_SET     0x04  console rate (u32), one item only
+
+    A port is GPIOA in the low byte and GPIOB in the high byte.  Bit 7 of a
+    script control byte makes the step a read; bits 0-4 give the length,
+    1 to APP_RPC_SCRIPT_LENGTH_MAX registers from the one given.
+
+    Reply payload, a telemetry frame of type APP_RPC_FRAME_REPLY:
+
+        type (u8), sequence (u8), timestamp in us (u32), operation (u8),
+        result (u8), count (u8), items
+
+        WRITE_PORTS        status (u8)
+        READ_PORTS         status (u8), port (u16)
+        SCRIPT             status (u8), then length bytes for a read step
+        BAUD_SET           status (u8), rate made (u32), rate error in ppm
+                           (i32), stop bit sample error in ppm (u32)
+
+    Every item is one DRV_I2C transfer to the expander; items of a request
+    are queued on the expander buses together.  Up to APP_RPC_REQUESTS_MAX
+    requests may be outstanding.  They are queued in the order received, so
+    requests to the same expander take effect in order, but replies come
+    back as requests complete and are matched by sequence number.
+
+    BAUD_SET is answered at once and changes the console rate as described
+    in app_baud.h; requests still outstanding should be waited for first.
+
+    firmware/tools/expander_rpc.py is a host client.
+
+*******************************************************************************/
+
+#ifndef _APP_RPC_H
+#define _APP_RPC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_RPC_OP_WRITE_PORTS              (0x01U)
+#define APP_RPC_OP_READ_PORTS               (0x02U)
+#define APP_RPC_OP_SCRIPT                   (0x03U)
+#define APP_RPC_OP_BAUD_SET                 (0x04U)
+
+#define APP_RPC_FRAME_REPLY                 (0x10U)
+
+/* Reply result */
+#define APP_RPC_RESULT_OK                   (0x00U)
+#define APP_RPC_RESULT_ITEM_FAILED          (0x01U)
+#define APP_RPC_RESULT_MALFORMED            (0x80U)
+#define APP_RPC_RESULT_BUSY                 (0x81U)
+#define APP_RPC_RESULT_UNKNOWN_OP           (0x82U)
+
+/* Item status */
+#define APP_RPC_STATUS_OK                   (0x00U)
+#define APP_RPC_STATUS_I2C_ERROR            (0x01U)
+#define APP_RPC_STATUS_NO_EXPANDER          (0x02U)
+#define APP_RPC_STATUS_NOT_QUEUED           (0x03U)
+#define APP_RPC_STATUS_BAUD_REFUSED         (0x04U)
+
+#define APP_RPC_SCRIPT_READ                 (0x80U)
+#define APP_RPC_SCRIPT_LENGTH_MASK          (0x1FU)
+#define APP_RPC_SCRIPT_LENGTH_MAX           (16U)
+
+/* Outstanding requests and the largest request payload */
+#define APP_RPC_REQUESTS_MAX                (4U)
+#define APP_RPC_REQUEST_SIZE_MAX            (128U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_RPC_Initialize ( void )
+
+  Summary:
+    Places the request handler in its initial state.
+
+  Remarks:
+    Must be called from SYS_Initialize after APP_EXPANDER_Initialize.
+*/
+
+void APP_RPC_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_RPC_Tasks ( void )
+
+  Summary:
+    Reads the console, queues the transfers of received requests and sends
+    the replies of completed ones.
+
+  Remarks:
+    Must be called from SYS_Tasks.  Does not wait for the bus or the
+    console.
+*/
+
+void APP_RPC_Tasks ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_RPC_IdleUsGet ( void )
+
+  Summary:
+    Returns 0 while there is console input or a request step to process,
+    SYS_SCHED_IDLE_FOREVER otherwise.
+*/
+
+uint32_t APP_RPC_IdleUsGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_RPC_IsActive ( void )
+
+  Summary:
+    True while the console or an expander bus must keep running.
+
+  Remarks:
+    Active while a request is in progress, part of a frame is received,
+    console bytes are still to be sent, and for APP_RPC_CONSOLE_AWAKE_MS
+    after the last byte received.  SYS_POWER does not enter standby then.
+*/
+
+bool APP_RPC_IsActive ( void );
+
+/*******************************************************************************
+  Function:
+    size_t APP_RPC_ConsoleRead ( uint8_t* pRdBuffer, const size_t size )
+
+  Summary:
+    Reads the console text with the request frames taken out.
+
+  Description:
+    Same contract as SERCOM3_USART_Read, for the command shell.
+*/
+
+size_t APP_RPC_ConsoleRead ( uint8_t* pRdBuffer, const size_t size );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_RPC_H */
+
+/*******************************************************************************
+ End of File
+ */
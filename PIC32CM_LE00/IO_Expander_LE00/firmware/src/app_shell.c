@@ -0,0 +1,694 @@
+/*******************************************************************************
+  Console Command Shell Source File
+
+  File Name:
+    app_shell.c
+
+  Summary:
+    Commands typed on the SERCOM3 console.
+
+  Description:
+    See app_shell.h for the commands.  Every command returns at once: pin and
+    pattern changes are applied by APP_Tasks and a benchmark is run by
+    APP_SHELL_Tasks, so a command never holds up the polling loop.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "app_shell.h"
+#include "app.h"
+#include "app_target.h"
+#include "app_telemetry.h"
+#include "app_baud.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_SHELL_BENCH_MS_DEFAULT          (1000U)
+#define APP_SHELL_BENCH_MS_MAX              (60000U)
+
+#define APP_SHELL_POLL_MS_MAX               (60000U)
+
+#define APP_SHELL_KV_STRESS_MAX             (100000U)
+
+typedef struct
+{
+    bool isBenchRunning;
+
+    /* Length of the benchmark and its start */
+    uint32_t benchMs;
+    uint32_t benchStartTick;
+    uint32_t benchStartCycles;
+
+    /* Main loop passes and the longest time between two of them */
+    uint32_t benchPasses;
+    uint32_t benchLastUs;
+    uint32_t benchMaxPassUs;
+
+    /* SERCOM3 receive errors seen by "stats" so far */
+    USART_ERROR rxErrors;
+
+    /* Store writes "kv stress" has still to make, and the last one */
+    uint32_t kvStressLeft;
+    uint32_t kvStressValue;
+
+} APP_SHELL_DATA;
+
+static APP_SHELL_DATA appShellData;
+
+static void APP_SHELL_PinCommand( int argc, char** argv );
+static void APP_SHELL_PatternCommand( int argc, char** argv );
+static void APP_SHELL_StatsCommand( int argc, char** argv );
+static void APP_SHELL_BenchCommand( int argc, char** argv );
+static void APP_SHELL_BaudCommand( int argc, char** argv );
+static void APP_SHELL_SchedCommand( int argc, char** argv );
+static void APP_SHELL_PowerCommand( int argc, char** argv );
+static void APP_SHELL_KvCommand( int argc, char** argv );
+#if defined(SYS_PROF_ENABLE)
+static void APP_SHELL_ProfCommand( int argc, char** argv );
+#endif
+
+static const SYS_CMD_DESCRIPTOR appShellCmdTbl[] =
+{
+    {"pin",     APP_SHELL_PinCommand,       "pin set <0-15> <0|1> | pin get <expander> <0-15>"},
+    {"pattern", APP_SHELL_PatternCommand,   "pattern walk | off | save | <outputs, GPIOA in the low byte>"},
+    {"stats",   APP_SHELL_StatsCommand,     "polling, telemetry and console counters"},
+    {"bench",   APP_SHELL_BenchCommand,     "bench start [ms] - polling cycle rate and main loop passes"},
+    {"baud",    APP_SHELL_BaudCommand,      "console rate and baud generator setting"},
+    {"sched",   APP_SHELL_SchedCommand,     "sched [clear] - task run times, jitter and misses"},
+    {"power",   APP_SHELL_PowerCommand,     "power [clear | standby on|off | poll <ms> | level auto|low|high] - busy, idle and standby time, performance level"},
+    {"kv",      APP_SHELL_KvCommand,        "kv [get <key> | set <key> <hex bytes> | del <key> | stress <writes>] - data flash store"},
+#if defined(SYS_PROF_ENABLE)
+    {"prof",    APP_SHELL_ProfCommand,      "prof [clear | boot] - code region times in cycles, log2 histograms, boot trace"},
+#endif
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Decimal, or hexadecimal with 0x; false unless the whole word is a number
+ * no greater than max */
+static bool APP_SHELL_NumberGet( const char* str, uint32_t max, uint32_t* value )
+{
+    char* end;
+    unsigned long number;
+
+    if ((str[0] < '0') || (str[0] > '9'))
+    {
+        return false;
+    }
+
+    number = strtoul(str, &end, 0);
+
+    if ((*end != '\0') || (number > max))
+    {
+        return false;
+    }
+
+    *value = (uint32_t)number;
+
+    return true;
+}
+
+static void APP_SHELL_PinCommand( int argc, char** argv )
+{
+    uint32_t expander;
+    uint32_t pin;
+    uint32_t level;
+    uint16_t port;
+    bool isOnline;
+
+    if ((argc == 4) && (strcmp(argv[1], "set") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], 15U, &pin) == true) &&
+        (APP_SHELL_NumberGet(argv[3], 1U, &level) == true))
+    {
+        (void)APP_OutputPinSet((uint8_t)pin, (level != 0U));
+
+        SYS_CMD_PRINT("outputs 0x%04X\r\n", APP_OutputsGet());
+    }
+    else if ((argc == 4) && (strcmp(argv[1], "get") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], APP_TARGET_EXPANDERS_NUMBER - 1U, &expander) == true) &&
+        (APP_SHELL_NumberGet(argv[3], 15U, &pin) == true))
+    {
+        isOnline = APP_TELEMETRY_PortGet((uint8_t)expander, &port);
+
+        SYS_CMD_PRINT("expander %u pin %u = %u%s\r\n", (unsigned int)expander, (unsigned int)pin,
+            (unsigned int)((port >> pin) & 1U), (isOnline == true) ? "" : " (offline, last read)");
+    }
+    else
+    {
+        SYS_CMD_MESSAGE("usage: pin set <0-15> <0|1> | pin get <expander> <0-15>\r\n");
+    }
+}
+
+static void APP_SHELL_PatternCommand( int argc, char** argv )
+{
+    uint32_t outputs;
+
+    if ((argc == 2) && (strcmp(argv[1], "walk") == 0))
+    {
+        APP_PatternSet(APP_PATTERN_WALK, 0U);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "off") == 0))
+    {
+        APP_PatternSet(APP_PATTERN_STATIC, 0U);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "save") == 0))
+    {
+        SYS_CMD_MESSAGE((APP_PatternSave() == true) ? "saved\r\n" : "not saved\r\n");
+    }
+    else if ((argc == 2) && (APP_SHELL_NumberGet(argv[1], 0xFFFFU, &outputs) == true))
+    {
+        APP_PatternSet(APP_PATTERN_STATIC, (uint16_t)outputs);
+    }
+    else
+    {
+        SYS_CMD_MESSAGE("usage: pattern walk | off | save | <outputs>\r\n");
+    }
+}
+
+static void APP_SHELL_StatsCommand( int argc, char** argv )
+{
+    uint16_t port;
+    uint16_t online = 0U;
+    uint8_t index;
+
+    (void)argc;
+    (void)argv;
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        if (APP_TELEMETRY_PortGet(index, &port) == true)
+        {
+            online |= (uint16_t)(1U << index);
+        }
+    }
+
+    appShellData.rxErrors |= SERCOM3_USART_ErrorGet();
+
+    SYS_CMD_PRINT("cycles %lu, online 0x%04X, outputs 0x%04X\r\n",
+        (unsigned long)APP_TELEMETRY_CyclesGet(), online, APP_OutputsGet());
+
+    SYS_CMD_PRINT("dropped: frames %lu, console bytes %lu, log records %lu, replies %lu\r\n",
+        (unsigned long)APP_TELEMETRY_FramesDroppedGet(),
+        (unsigned long)SERCOM3_USART_WriteOverflowCountGet(),
+        (unsigned long)SYS_LOG_DroppedCountGet(),
+        (unsigned long)SYS_CMD_DroppedCountGet());
+
+    SYS_CMD_PRINT("console receive errors 0x%02X, timers %lu (%lu at most)\r\n", appShellData.rxErrors,
+        (unsigned long)SYS_TMR_ObjectsUsedGet(), (unsigned long)SYS_TMR_ObjectsUsedMaxGet());
+
+    SYS_CMD_MESSAGE("read errors:");
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        SYS_CMD_PRINT(" %u", APP_TELEMETRY_ReadErrorsGet(index));
+    }
+
+    SYS_CMD_MESSAGE("\r\n");
+}
+
+static void APP_SHELL_BaudCommand( int argc, char** argv )
+{
+    static const char* const sampleRates[] = { "16x arithmetic", "16x fractional",
+        "8x arithmetic", "8x fractional", "3x arithmetic" };
+    USART_BAUD_SETUP setup;
+
+    (void)argc;
+    (void)argv;
+
+    SERCOM3_USART_BaudSetupGet(&setup);
+
+    SYS_CMD_PRINT("rate %lu, made %lu (%ld ppm), %s, BAUD 0x%04X\r\n",
+        (unsigned long)APP_BAUD_RateGet(), (unsigned long)setup.baudRate, (long)setup.errorPpm,
+        (setup.sampleRate < 5U) ? sampleRates[setup.sampleRate] : "?", setup.baudValue);
+
+    SYS_CMD_PRINT("stop bit sample error %lu ppm, changes %lu, reverted %lu\r\n",
+        (unsigned long)setup.sampleErrorPpm, (unsigned long)APP_BAUD_ChangesGet(),
+        (unsigned long)APP_BAUD_RevertsGet());
+}
+
+static void APP_SHELL_SchedCommand( int argc, char** argv )
+{
+    const SYS_SCHED_TASK* task;
+    SYS_SCHED_STATS stats;
+    size_t index;
+
+    if ((argc == 2) && (strcmp(argv[1], "clear") == 0))
+    {
+        SYS_SCHED_StatsClear();
+        return;
+    }
+
+    if (argc != 1)
+    {
+        SYS_CMD_MESSAGE("usage: sched [clear]\r\n");
+        return;
+    }
+
+    SYS_CMD_MESSAGE("task       period   runs  run avg/max  jitter avg/max  over  late  skip (us)\r\n");
+
+    for (index = 0U; index < SYS_SCHED_TasksNumberGet(); index++)
+    {
+        task = SYS_SCHED_TaskGet(index);
+        (void) SYS_SCHED_StatsGet(index, &stats);
+
+        if (stats.runs == 0U)
+        {
+            /* Nothing to average */
+            stats.runs = 1U;
+        }
+
+        SYS_CMD_PRINT("%-10s %6lu %6lu %5lu/%-6lu %6lu/%-7lu %5lu %5lu %5lu\r\n",
+            task->name, (unsigned long)task->periodUs, (unsigned long)stats.runs,
+            (unsigned long)(stats.runTotalUs / stats.runs), (unsigned long)stats.runMaxUs,
+            (unsigned long)(stats.jitterTotalUs / stats.runs), (unsigned long)stats.jitterMaxUs,
+            (unsigned long)stats.overruns, (unsigned long)stats.deadlineMisses,
+            (unsigned long)stats.releasesSkipped);
+    }
+}
+
+static void APP_SHELL_PowerCommand( int argc, char** argv )
+{
+    SYS_POWER_STATS stats;
+    uint32_t pollMs;
+    uint32_t idlePermille = 0U;
+    uint32_t standbyPermille = 0U;
+    uint32_t busyPermille;
+    uint32_t levelPermille[SYS_POWER_LEVELS_NUMBER] = { 0U, 0U };
+
+    if ((argc == 2) && (strcmp(argv[1], "clear") == 0))
+    {
+        SYS_POWER_StatsClear();
+        return;
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "level") == 0) && (strcmp(argv[2], "auto") == 0))
+    {
+        SYS_POWER_GovernorEnable(true);
+        return;
+    }
+
+    /* A fixed level turns the governor off */
+    if ((argc == 3) && (strcmp(argv[1], "level") == 0) &&
+        ((strcmp(argv[2], "low") == 0) || (strcmp(argv[2], "high") == 0)))
+    {
+        SYS_POWER_GovernorEnable(false);
+
+        if (SYS_POWER_LevelSet((strcmp(argv[2], "low") == 0) ?
+            SYS_POWER_LEVEL_LOW : SYS_POWER_LEVEL_HIGH) == false)
+        {
+            SYS_CMD_MESSAGE("level not changed, a transfer is active or the console rate needs the high level\r\n");
+        }
+
+        return;
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "standby") == 0) &&
+        ((strcmp(argv[2], "on") == 0) || (strcmp(argv[2], "off") == 0)))
+    {
+        SYS_POWER_StandbyEnable(strcmp(argv[2], "on") == 0);
+        return;
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "poll") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], APP_SHELL_POLL_MS_MAX, &pollMs) == true))
+    {
+        APP_EXPANDER_PollPeriodSet(pollMs);
+        return;
+    }
+
+    if (argc != 1)
+    {
+        SYS_CMD_MESSAGE("usage: power [clear | standby on|off | poll <0-60000 ms> | level auto|low|high]\r\n");
+        return;
+    }
+
+    SYS_POWER_StatsGet(&stats);
+
+    if (stats.elapsedUs != 0U)
+    {
+        idlePermille = (uint32_t)((stats.idleUs * 1000U) / stats.elapsedUs);
+        standbyPermille = (uint32_t)((stats.standbyUs * 1000U) / stats.elapsedUs);
+        levelPermille[SYS_POWER_LEVEL_LOW] = (uint32_t)((stats.levelUs[SYS_POWER_LEVEL_LOW] * 1000U) / stats.elapsedUs);
+        levelPermille[SYS_POWER_LEVEL_HIGH] = (uint32_t)((stats.levelUs[SYS_POWER_LEVEL_HIGH] * 1000U) / stats.elapsedUs);
+    }
+
+    /* Standby is counted by the RTC, the rest by SysTick */
+    busyPermille = ((idlePermille + standbyPermille) < 1000U) ? (1000U - idlePermille - standbyPermille) : 0U;
+
+    SYS_CMD_PRINT("standby %s, poll period %lu ms, over %lu ms\r\n",
+        (SYS_POWER_StandbyIsEnabled() == true) ? "on" : "off",
+        (unsigned long)APP_EXPANDER_PollPeriodGet(), (unsigned long)(stats.elapsedUs / 1000U));
+
+    SYS_CMD_PRINT("busy %lu.%lu%%, idle %lu.%lu%% (%lu), standby %lu.%lu%% (%lu, %lu woken early)\r\n",
+        (unsigned long)(busyPermille / 10U), (unsigned long)(busyPermille % 10U),
+        (unsigned long)(idlePermille / 10U), (unsigned long)(idlePermille % 10U),
+        (unsigned long)stats.idles,
+        (unsigned long)(standbyPermille / 10U), (unsigned long)(standbyPermille % 10U),
+        (unsigned long)stats.standbys, (unsigned long)stats.wakeEarly);
+
+    SYS_CMD_PRINT("standby wake latency max %lu us\r\n", (unsigned long)stats.wakeLatencyMaxUs);
+
+    SYS_CMD_PRINT("level %s (%s), %lu MHz, load %lu.%lu%%; low %lu.%lu%%, high %lu.%lu%% of the time\r\n",
+        (SYS_POWER_LevelGet() == SYS_POWER_LEVEL_LOW) ? "low" : "high",
+        (SYS_POWER_GovernorIsEnabled() == true) ? "auto" : "fixed",
+        (unsigned long)(CLOCK_Gclk0FrequencyGet() / 1000000U),
+        (unsigned long)(SYS_POWER_LoadGet() / 10U), (unsigned long)(SYS_POWER_LoadGet() % 10U),
+        (unsigned long)(levelPermille[SYS_POWER_LEVEL_LOW] / 10U), (unsigned long)(levelPermille[SYS_POWER_LEVEL_LOW] % 10U),
+        (unsigned long)(levelPermille[SYS_POWER_LEVEL_HIGH] / 10U), (unsigned long)(levelPermille[SYS_POWER_LEVEL_HIGH] % 10U));
+
+    SYS_CMD_PRINT("level changes %lu (%lu held off), transition avg/max %lu/%lu us\r\n",
+        (unsigned long)stats.levelChanges, (unsigned long)stats.levelChangesHeld,
+        (unsigned long)((stats.levelChanges != 0U) ? (stats.levelChangeTotalUs / stats.levelChanges) : 0U),
+        (unsigned long)stats.levelChangeMaxUs);
+}
+
+/* Hexadecimal digits, two per byte; false unless the whole word is */
+static bool APP_SHELL_BytesGet( const char* str, uint8_t* bytes, size_t size, size_t* length )
+{
+    size_t index = 0U;
+    uint32_t digit;
+    uint8_t value = 0U;
+    char c;
+
+    while (str[index] != '\0')
+    {
+        c = str[index];
+
+        if ((c >= '0') && (c <= '9'))
+        {
+            digit = (uint32_t)c - (uint32_t)'0';
+        }
+        else if ((c >= 'a') && (c <= 'f'))
+        {
+            digit = (uint32_t)c - (uint32_t)'a' + 10U;
+        }
+        else if ((c >= 'A') && (c <= 'F'))
+        {
+            digit = (uint32_t)c - (uint32_t)'A' + 10U;
+        }
+        else
+        {
+            return false;
+        }
+
+        if ((index / 2U) >= size)
+        {
+            return false;
+        }
+
+        value = (uint8_t)((value << 4) | digit);
+
+        if ((index % 2U) == 1U)
+        {
+            bytes[index / 2U] = value;
+        }
+
+        index++;
+    }
+
+    *length = index / 2U;
+
+    return ((index % 2U) == 0U);
+}
+
+static void APP_SHELL_KvCommand( int argc, char** argv )
+{
+    static const char digits[] = "0123456789ABCDEF";
+    SYS_KVS_STATS stats;
+    uint8_t value[SYS_KVS_VALUE_MAX];
+    char text[(2U * SYS_KVS_VALUE_MAX) + 1U];
+    size_t length;
+    size_t index;
+    uint32_t key;
+
+    if ((argc == 3) && (strcmp(argv[1], "get") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], SYS_KVS_KEYS_NUMBER - 1U, &key) == true))
+    {
+        if (SYS_KVS_Get(key, value, sizeof(value), &length) == false)
+        {
+            SYS_CMD_PRINT("key %u has no value\r\n", (unsigned int)key);
+            return;
+        }
+
+        for (index = 0U; index < length; index++)
+        {
+            text[2U * index] = digits[value[index] >> 4];
+            text[(2U * index) + 1U] = digits[value[index] & 0x0FU];
+        }
+
+        text[2U * length] = '\0';
+
+        SYS_CMD_PRINT("key %u = %s (%u bytes)\r\n", (unsigned int)key, text, (unsigned int)length);
+        return;
+    }
+
+    if ((argc == 4) && (strcmp(argv[1], "set") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], SYS_KVS_KEYS_NUMBER - 1U, &key) == true) &&
+        (APP_SHELL_BytesGet(argv[3], value, sizeof(value), &length) == true))
+    {
+        SYS_CMD_MESSAGE((SYS_KVS_Set(key, value, length) == true) ? "queued\r\n" : "not queued\r\n");
+        return;
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "del") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], SYS_KVS_KEYS_NUMBER - 1U, &key) == true))
+    {
+        SYS_CMD_MESSAGE((SYS_KVS_Delete(key) == true) ? "deleted\r\n" : "not deleted\r\n");
+        return;
+    }
+
+    /* Back to back writes, one log record each; "bench" and "sched" show
+     * what they do to the other tasks */
+    if ((argc == 3) && (strcmp(argv[1], "stress") == 0) &&
+        (APP_SHELL_NumberGet(argv[2], APP_SHELL_KV_STRESS_MAX, &appShellData.kvStressLeft) == true))
+    {
+        return;
+    }
+
+    if (argc != 1)
+    {
+        SYS_CMD_MESSAGE("usage: kv [get <key> | set <key> <hex bytes> | del <key> | stress <writes>]\r\n");
+        return;
+    }
+
+    SYS_KVS_StatsGet(&stats);
+
+    SYS_CMD_PRINT("writes %lu (%lu copies, %lu skipped), erases %lu, failures %lu, rows erased %lu\r\n",
+        (unsigned long)stats.writes, (unsigned long)stats.copies, (unsigned long)stats.writesSkipped,
+        (unsigned long)stats.erases, (unsigned long)stats.failures, (unsigned long)stats.rowsErased);
+
+    SYS_CMD_PRINT("pending %lu%s, at boot: records %lu, torn pages %lu\r\n",
+        (unsigned long)stats.pending, (stats.isStopped == true) ? " (stopped)" : "",
+        (unsigned long)stats.bootRecords, (unsigned long)stats.bootTorn);
+}
+
+#if defined(SYS_PROF_ENABLE)
+/* From SYSTICK_TimerStart; the outputs and the configuration usually come
+ * before or around the end of the initialization */
+static void APP_SHELL_ProfBootShow( void )
+{
+    uint32_t id;
+    uint32_t us;
+
+    SYS_CMD_MESSAGE("boot phase          us\r\n");
+
+    for (id = 0U; id < SYS_PROF_BootPhasesNumberGet(); id++)
+    {
+        if (SYS_PROF_BootUsGet(id, &us) == true)
+        {
+            SYS_CMD_PRINT("%-14s %8lu\r\n", SYS_PROF_BootNameGet(id), (unsigned long)us);
+        }
+        else
+        {
+            SYS_CMD_PRINT("%-14s        -\r\n", SYS_PROF_BootNameGet(id));
+        }
+    }
+}
+
+static void APP_SHELL_ProfCommand( int argc, char** argv )
+{
+    SYS_PROF_STATS stats;
+    uint32_t id;
+    uint32_t bucket;
+
+    if ((argc == 2) && (strcmp(argv[1], "boot") == 0))
+    {
+        APP_SHELL_ProfBootShow();
+        return;
+    }
+
+    if ((argc == 2) && (strcmp(argv[1], "clear") == 0))
+    {
+        SYS_PROF_StatsClear();
+        return;
+    }
+
+    if (argc != 1)
+    {
+        SYS_CMD_MESSAGE("usage: prof [clear | boot]\r\n");
+        return;
+    }
+
+    SYS_CMD_PRINT("%lu cycles/us, empty region %lu cycles taken off\r\n",
+        (unsigned long)(SYSTICK_TimerFrequencyGet() / 1000000U), (unsigned long)SYS_PROF_OverheadGet());
+    SYS_CMD_MESSAGE("region          count     min     avg     max (cycles)\r\n");
+
+    for (id = 0U; id < SYS_PROF_RegionsNumberGet(); id++)
+    {
+        (void) SYS_PROF_StatsGet(id, &stats);
+
+        SYS_CMD_PRINT("%-12s %8lu %7lu %7lu %7lu\r\n", SYS_PROF_NameGet(id),
+            (unsigned long)stats.count, (unsigned long)stats.minCycles,
+            (unsigned long)((stats.count != 0U) ? (stats.totalCycles / stats.count) : 0U),
+            (unsigned long)stats.maxCycles);
+
+        if (stats.count == 0U)
+        {
+            continue;
+        }
+
+        /* Bucket n: 2^n cycles up, the last one open ended */
+        SYS_CMD_MESSAGE("  2^n:count");
+
+        for (bucket = 0U; bucket < SYS_PROF_BUCKETS; bucket++)
+        {
+            if (stats.histogram[bucket] != 0U)
+            {
+                SYS_CMD_PRINT(" %lu%s:%lu", (unsigned long)bucket,
+                    (bucket == (SYS_PROF_BUCKETS - 1U)) ? "+" : "",
+                    (unsigned long)stats.histogram[bucket]);
+            }
+        }
+
+        SYS_CMD_MESSAGE("\r\n");
+    }
+}
+#endif
+
+static void APP_SHELL_BenchCommand( int argc, char** argv )
+{
+    uint32_t benchMs = APP_SHELL_BENCH_MS_DEFAULT;
+
+    if ((argc < 2) || (argc > 3) || (strcmp(argv[1], "start") != 0) ||
+        ((argc == 3) && (APP_SHELL_NumberGet(argv[2], APP_SHELL_BENCH_MS_MAX, &benchMs) == false)) ||
+        (benchMs == 0U))
+    {
+        SYS_CMD_MESSAGE("usage: bench start [1-60000 ms]\r\n");
+        return;
+    }
+
+    if (appShellData.isBenchRunning == true)
+    {
+        SYS_CMD_MESSAGE("bench already running\r\n");
+        return;
+    }
+
+    appShellData.benchMs = benchMs;
+    appShellData.benchStartTick = SYSTICK_GetTickCounter();
+    appShellData.benchStartCycles = APP_TELEMETRY_CyclesGet();
+    appShellData.benchPasses = 0U;
+    appShellData.benchLastUs = APP_TELEMETRY_TimestampGet();
+    appShellData.benchMaxPassUs = 0U;
+    appShellData.isBenchRunning = true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_SHELL_Initialize ( void )
+{
+    (void) memset(&appShellData, 0, sizeof(appShellData));
+
+    appShellData.isBenchRunning = false;
+
+    (void) SYS_CMD_ADDGRP(appShellCmdTbl, (int)(sizeof(appShellCmdTbl) / sizeof(appShellCmdTbl[0])),
+        "app", "I/O expander commands");
+}
+
+uint32_t APP_SHELL_IdleUsGet ( void )
+{
+    /* A benchmark counts the main loop passes; a stress write waits for
+     * the store, which its task and the NVMCTRL interrupt empty */
+    if ((appShellData.isBenchRunning == true) ||
+        ((appShellData.kvStressLeft != 0U) && (SYS_KVS_IsBusy() == false)))
+    {
+        return 0U;
+    }
+
+    return SYS_SCHED_IDLE_FOREVER;
+}
+
+void APP_SHELL_Tasks ( void )
+{
+    uint32_t elapsedMs;
+    uint32_t cycles;
+    uint32_t nowUs;
+
+    if ((appShellData.kvStressLeft != 0U) && (SYS_KVS_IsBusy() == false))
+    {
+        appShellData.kvStressLeft--;
+        appShellData.kvStressValue++;
+
+        if (SYS_KVS_Set(SYS_KVS_KEY_SHELL_STRESS, &appShellData.kvStressValue,
+            sizeof(appShellData.kvStressValue)) == false)
+        {
+            appShellData.kvStressLeft = 0U;
+        }
+
+        SYS_LOG2("APP_SHELL: kv stress write %u, %u left", appShellData.kvStressValue, appShellData.kvStressLeft);
+    }
+
+    if (appShellData.isBenchRunning == false)
+    {
+        return;
+    }
+
+    nowUs = APP_TELEMETRY_TimestampGet();
+
+    if ((nowUs - appShellData.benchLastUs) > appShellData.benchMaxPassUs)
+    {
+        appShellData.benchMaxPassUs = nowUs - appShellData.benchLastUs;
+    }
+
+    appShellData.benchLastUs = nowUs;
+    appShellData.benchPasses++;
+
+    elapsedMs = SYSTICK_GetTickCounter() - appShellData.benchStartTick;
+
+    if (elapsedMs < appShellData.benchMs)
+    {
+        return;
+    }
+
+    cycles = APP_TELEMETRY_CyclesGet() - appShellData.benchStartCycles;
+
+    SYS_CMD_PRINT("bench %lu ms: %lu cycles (%lu/s), %lu loop passes (%lu/s), longest pass %lu us\r\n",
+        (unsigned long)elapsedMs,
+        (unsigned long)cycles, (unsigned long)(((uint64_t)cycles * 1000U) / elapsedMs),
+        (unsigned long)appShellData.benchPasses,
+        (unsigned long)(((uint64_t)appShellData.benchPasses * 1000U) / elapsedMs),
+        (unsigned long)appShellData.benchMaxPassUs);
+
+    appShellData.isBenchRunning = false;
+}
+
+/*******************************************************************************
+ End of File
+ */
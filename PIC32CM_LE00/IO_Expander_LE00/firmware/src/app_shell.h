@@ -0,0 +1,103 @@
+/*******************************************************************************
+  Console Command Shell Header File
+
+  File Name:
+    app_shell.h
+
+  Summary:
+    Commands typed on the SERCOM3 console.
+
+  Description:
+    Registers the application commands with the command processor service:
+
+        pin set <0-15> <0|1>        sets an output of the local MCP23017
+        pin get <expander> <0-15>   shows a polled input
+        pattern walk|off|<value>    walking output, all low, or a static value
+        stats                       polling, telemetry and console counters
+        bench start [ms]            measures the polling cycle rate and the
+                                    main loop passes, 1000 ms by default
+        baud                        console rate and baud generator setting
+        sched [clear]               run time, release jitter, overruns and
+                                    missed deadlines of the scheduled tasks
+
+    "help" lists them.  Replies are plain text and share the console with
+    the telemetry frames and log records.
+
+*******************************************************************************/
+
+#ifndef _APP_SHELL_H
+#define _APP_SHELL_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_SHELL_Initialize ( void )
+
+  Summary:
+    Registers the application commands.
+
+  Remarks:
+    Must be called from SYS_Initialize after SYS_CMD_Initialize.
+*/
+
+void APP_SHELL_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_SHELL_Tasks ( void )
+
+  Summary:
+    Runs a benchmark started by "bench start" and reports it when done.
+
+  Remarks:
+    Must be called from SYS_Tasks.  Every call counts as one main loop pass.
+*/
+
+void APP_SHELL_Tasks ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_SHELL_IdleUsGet ( void )
+
+  Summary:
+    Returns 0 while a benchmark runs, SYS_SCHED_IDLE_FOREVER otherwise.
+*/
+
+uint32_t APP_SHELL_IdleUsGet ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_SHELL_H */
+
+/*******************************************************************************
+ End of File
+ */
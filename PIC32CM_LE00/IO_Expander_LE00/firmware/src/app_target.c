@@ -0,0 +1,183 @@
+/*******************************************************************************
+  I2C Target Register Map Source File
+
+  File Name:
+    app_target.c
+
+  Summary:
+    Aggregated expander register map served on the SERCOM1 I2C target.
+
+  Description:
+    See app_target.h for the register layout and the access protocol.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_target.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Register map being filled by the expander polling layer */
+    uint8_t cycleMap[APP_TARGET_REG_MAP_SIZE];
+
+    /* Register map of the last completed polling cycle, served to the host */
+    uint8_t regMap[APP_TARGET_REG_MAP_SIZE];
+
+    /* Copy of the register map taken when addressed for reading */
+    uint8_t txBuffer[APP_TARGET_REG_MAP_SIZE];
+
+    /* Register pointer, auto-incremented on every byte read */
+    uint8_t regPointer;
+
+    /* The next byte written by the host is the register pointer */
+    bool isRegPointerPending;
+
+} APP_TARGET_DATA;
+
+static APP_TARGET_DATA appTargetData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Callback Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool APP_TARGET_I2CEventHandler( SERCOM_I2C_SLAVE_TRANSFER_EVENT event, uintptr_t contextHandle )
+{
+    bool isAck = true;
+    uint8_t rxData;
+
+    switch(event)
+    {
+        case SERCOM_I2C_SLAVE_TRANSFER_EVENT_ADDR_MATCH:
+        {
+            if (SERCOM1_I2C_TransferDirGet() == SERCOM_I2C_SLAVE_TRANSFER_DIR_WRITE)
+            {
+                appTargetData.isRegPointerPending = true;
+            }
+            else
+            {
+                /* The map is only published with interrupts disabled, the copy
+                 * holds a single polling cycle */
+                (void) memcpy(appTargetData.txBuffer, appTargetData.regMap, sizeof(appTargetData.txBuffer));
+            }
+            break;
+        }
+
+        case SERCOM_I2C_SLAVE_TRANSFER_EVENT_RX_READY:
+        {
+            rxData = SERCOM1_I2C_ReadByte();
+
+            if (appTargetData.isRegPointerPending == true)
+            {
+                appTargetData.regPointer = rxData;
+                appTargetData.isRegPointerPending = false;
+            }
+            else
+            {
+                /* The register map is read-only */
+                isAck = false;
+            }
+            break;
+        }
+
+        case SERCOM_I2C_SLAVE_TRANSFER_EVENT_TX_READY:
+        {
+            if (appTargetData.regPointer < APP_TARGET_REG_MAP_SIZE)
+            {
+                SERCOM1_I2C_WriteByte(appTargetData.txBuffer[appTargetData.regPointer]);
+                appTargetData.regPointer++;
+            }
+            else
+            {
+                SERCOM1_I2C_WriteByte(0xFFU);
+            }
+            break;
+        }
+
+        case SERCOM_I2C_SLAVE_TRANSFER_EVENT_ERROR:
+        {
+            (void) SERCOM1_I2C_ErrorGet();
+            break;
+        }
+
+        default:
+        {
+            /* Nothing to do on a stop condition */
+            break;
+        }
+    }
+
+    return isAck;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_TARGET_Initialize ( void )
+{
+    (void) memset(appTargetData.cycleMap, 0, sizeof(appTargetData.cycleMap));
+    (void) memset(appTargetData.regMap, 0, sizeof(appTargetData.regMap));
+
+    appTargetData.regPointer = 0U;
+    appTargetData.isRegPointerPending = false;
+
+    SERCOM1_I2C_CallbackRegister(APP_TARGET_I2CEventHandler, 0);
+}
+
+void APP_TARGET_InputsUpdate ( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline )
+{
+    uint8_t onlineMask = (uint8_t)(1U << (index & 0x07U));
+    uint8_t* pOnline;
+    bool interruptState;
+
+    if (index >= APP_TARGET_EXPANDERS_NUMBER)
+    {
+        return;
+    }
+
+    pOnline = &appTargetData.cycleMap[APP_TARGET_REG_ONLINE + (index >> 3)];
+
+    interruptState = SYS_INT_Disable();
+
+    if (isOnline == true)
+    {
+        appTargetData.cycleMap[APP_TARGET_REG_INPUTS + (2U * index)] = gpioA;
+        appTargetData.cycleMap[APP_TARGET_REG_INPUTS + (2U * index) + 1U] = gpioB;
+        *pOnline |= onlineMask;
+    }
+    else
+    {
+        *pOnline &= (uint8_t)~onlineMask;
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_TARGET_CycleComplete ( void )
+{
+    bool interruptState = SYS_INT_Disable();
+
+    appTargetData.cycleMap[APP_TARGET_REG_SEQUENCE]++;
+    (void) memcpy(appTargetData.regMap, appTargetData.cycleMap, sizeof(appTargetData.regMap));
+
+    SYS_INT_Restore(interruptState);
+}
+
+/*******************************************************************************
+ End of File
+ */
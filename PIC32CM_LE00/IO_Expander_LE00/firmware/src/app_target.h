@@ -0,0 +1,125 @@
+/*******************************************************************************
+  I2C Target Register Map Header File
+
+  File Name:
+    app_target.h
+
+  Summary:
+    Aggregated expander register map served on the SERCOM1 I2C target.
+
+  Description:
+    The board answers on SERCOM1 as an I2C target and exposes the input state
+    of every downstream MCP23017 in one contiguous, read-only register block:
+
+        0x00 + 2*n      GPIOA of expander n
+        0x01 + 2*n      GPIOB of expander n
+        ONLINE          one bit per expander, set while it answers on the bus
+        SEQUENCE        incremented after every completed polling cycle
+
+    A host writes the register pointer as the first byte of a write and then
+    reads any number of bytes; the pointer auto-increments and reads past the
+    end of the map return 0xFF.  The inputs of a polling cycle are gathered
+    apart and published together with the new SEQUENCE value when the cycle
+    completes, and the published map is copied when the target is addressed
+    for reading, so a multi-byte read always returns the values of a single
+    polling cycle.
+*******************************************************************************/
+
+#ifndef _APP_TARGET_H
+#define _APP_TARGET_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of downstream expanders mirrored in the register map (multiple of 8) */
+#define APP_TARGET_EXPANDERS_NUMBER         (16U)
+
+/* Register map layout */
+#define APP_TARGET_REG_INPUTS               (0x00U)
+#define APP_TARGET_REG_ONLINE               (APP_TARGET_REG_INPUTS + (2U * APP_TARGET_EXPANDERS_NUMBER))
+#define APP_TARGET_REG_SEQUENCE             (APP_TARGET_REG_ONLINE + (APP_TARGET_EXPANDERS_NUMBER / 8U))
+#define APP_TARGET_REG_MAP_SIZE             (APP_TARGET_REG_SEQUENCE + 1U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_TARGET_Initialize ( void )
+
+  Summary:
+    Clears the register map and registers the SERCOM1 I2C target callback.
+
+  Remarks:
+    Must be called from SYS_Initialize after SERCOM1_I2C_Initialize.
+*/
+
+void APP_TARGET_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_TARGET_InputsUpdate ( uint8_t index, uint8_t gpioA, uint8_t gpioB,
+                                   bool isOnline )
+
+  Summary:
+    Stores the last read input state of one downstream expander.
+
+  Remarks:
+    The previous GPIO values are kept when isOnline is false.  The host sees
+    the update after the next APP_TARGET_CycleComplete.  May be called from
+    task or interrupt context.
+*/
+
+void APP_TARGET_InputsUpdate ( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline );
+
+/*******************************************************************************
+  Function:
+    void APP_TARGET_CycleComplete ( void )
+
+  Summary:
+    Marks the end of a polling cycle by incrementing the sequence register.
+
+  Remarks:
+    Publishes the inputs stored since the previous call to the host, together
+    with the new sequence value, with interrupts disabled.
+*/
+
+void APP_TARGET_CycleComplete ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_TARGET_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,476 @@
+/*******************************************************************************
+  Pin-State Telemetry Source File
+
+  File Name:
+    app_telemetry.c
+
+  Summary:
+    Streams the expander input state as framed binary telemetry on SERCOM3.
+
+  Description:
+    See app_telemetry.h for the frame format.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_telemetry.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* SNAPSHOT and STATS period */
+#define APP_TELEMETRY_PERIOD_MS             (1000U)
+
+/* type, sequence, timestamp */
+#define APP_TELEMETRY_HEADER_SIZE           (6U)
+
+/* Largest frame body is STATS */
+#define APP_TELEMETRY_PAYLOAD_SIZE_MAX      (APP_TELEMETRY_HEADER_SIZE + 16U + (2U * APP_TARGET_EXPANDERS_NUMBER))
+
+/* Payload and CRC, one COBS overhead byte per 254 bytes, two delimiters */
+#define APP_TELEMETRY_FRAME_SIZE_MAX        (APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX + 2U + 1U + 2U)
+
+#if (APP_TELEMETRY_PAYLOAD_SIZE_MAX > APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX)
+#error "Telemetry frames must fit APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX"
+#endif
+
+#if (APP_TARGET_EXPANDERS_NUMBER > 16U)
+#error "The telemetry online and changed masks hold 16 expanders"
+#endif
+
+typedef struct
+{
+    /* GPIOA in the low byte, GPIOB in the high byte */
+    uint16_t port[APP_TARGET_EXPANDERS_NUMBER];
+
+    /* One bit per expander, set while it answers on the bus */
+    uint16_t online;
+
+} APP_TELEMETRY_STATE;
+
+typedef struct
+{
+    /* Last read results, written by the expander polling layer */
+    volatile APP_TELEMETRY_STATE inputs;
+
+    /* Failed reads per expander */
+    volatile uint16_t readErrors[APP_TARGET_EXPANDERS_NUMBER];
+
+    /* State at the end of the last polling cycle */
+    APP_TELEMETRY_STATE cycleState;
+
+    /* A cycle ended since the last DELTA or SNAPSHOT */
+    bool isCyclePending;
+
+    /* Polling cycles completed */
+    uint32_t cycles;
+
+    /* State the host has after the last frame sent */
+    APP_TELEMETRY_STATE sentState;
+
+    /* A SNAPSHOT was sent, DELTA frames may follow */
+    bool isSynced;
+
+    /* No frames while the console rate changes */
+    bool isHeld;
+
+    /* Sequence number of the next frame */
+    uint8_t sequence;
+
+    /* Frames that did not fit in the SERCOM3 transmit ring */
+    uint32_t framesDropped;
+
+    /* SysTick counts of the last SNAPSHOT and STATS frames */
+    uint32_t snapshotTick;
+    uint32_t statsTick;
+
+    uint8_t payload[APP_TELEMETRY_PAYLOAD_SIZE_MAX + 2U];
+
+    uint8_t frame[APP_TELEMETRY_FRAME_SIZE_MAX];
+
+} APP_TELEMETRY_DATA;
+
+static APP_TELEMETRY_DATA appTelemetryData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t APP_TELEMETRY_Put16( uint32_t index, uint16_t value )
+{
+    appTelemetryData.payload[index] = (uint8_t)value;
+    appTelemetryData.payload[index + 1U] = (uint8_t)(value >> 8);
+
+    return index + 2U;
+}
+
+static uint32_t APP_TELEMETRY_Put32( uint32_t index, uint32_t value )
+{
+    index = APP_TELEMETRY_Put16(index, (uint16_t)value);
+
+    return APP_TELEMETRY_Put16(index, (uint16_t)(value >> 16));
+}
+
+static uint32_t APP_TELEMETRY_HeaderPut( uint8_t type )
+{
+    appTelemetryData.payload[0] = type;
+    appTelemetryData.payload[1] = appTelemetryData.sequence;
+
+    return APP_TELEMETRY_Put32(2U, APP_TELEMETRY_TimestampGet());
+}
+
+/* CRC-16/CCITT-FALSE, bytewise without a table */
+uint16_t APP_TELEMETRY_Crc16( const uint8_t* data, uint32_t size )
+{
+    uint16_t crc = 0xFFFFU;
+    uint16_t x;
+    uint32_t index;
+
+    for (index = 0U; index < size; index++)
+    {
+        x = (uint16_t)((crc >> 8) ^ data[index]);
+        x ^= (uint16_t)(x >> 4);
+        crc = (uint16_t)((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
+    }
+
+    return crc;
+}
+
+/* Consistent Overhead Byte Stuffing: dst receives size + size / 254 + 1
+ * bytes, none of them zero */
+static uint32_t APP_TELEMETRY_CobsEncode( const uint8_t* src, uint32_t size, uint8_t* dst )
+{
+    uint32_t codeIndex = 0U;
+    uint32_t dstIndex = 1U;
+    uint32_t index;
+    uint8_t code = 1U;
+
+    for (index = 0U; index < size; index++)
+    {
+        if (src[index] != 0U)
+        {
+            dst[dstIndex] = src[index];
+            dstIndex++;
+            code++;
+        }
+
+        if ((src[index] == 0U) || (code == 0xFFU))
+        {
+            dst[codeIndex] = code;
+            codeIndex = dstIndex;
+            dstIndex++;
+            code = 1U;
+        }
+    }
+
+    dst[codeIndex] = code;
+
+    return dstIndex;
+}
+
+static bool APP_TELEMETRY_FrameSend( uint32_t payloadSize )
+{
+    if (APP_TELEMETRY_FrameWrite(appTelemetryData.payload, payloadSize) == false)
+    {
+        appTelemetryData.framesDropped++;
+        return false;
+    }
+
+    appTelemetryData.sequence++;
+
+    return true;
+}
+
+static bool APP_TELEMETRY_SnapshotSend( void )
+{
+    APP_TELEMETRY_STATE* state = &appTelemetryData.cycleState;
+    uint32_t size = APP_TELEMETRY_HeaderPut(APP_TELEMETRY_FRAME_SNAPSHOT);
+    uint32_t index;
+
+    size = APP_TELEMETRY_Put32(size, appTelemetryData.cycles);
+    size = APP_TELEMETRY_Put16(size, state->online);
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        size = APP_TELEMETRY_Put16(size, state->port[index]);
+    }
+
+    return APP_TELEMETRY_FrameSend(size);
+}
+
+/* Returns true when the host is up to date, whether or not a frame was needed */
+static bool APP_TELEMETRY_DeltaSend( void )
+{
+    APP_TELEMETRY_STATE* state = &appTelemetryData.cycleState;
+    APP_TELEMETRY_STATE* sent = &appTelemetryData.sentState;
+    uint32_t size = APP_TELEMETRY_HeaderPut(APP_TELEMETRY_FRAME_DELTA);
+    uint32_t flagsIndex = size;
+    uint32_t changedIndex = size + 1U;
+    uint16_t changed = 0U;
+    uint32_t index;
+
+    size += 3U;
+    appTelemetryData.payload[flagsIndex] = 0U;
+
+    if (state->online != sent->online)
+    {
+        appTelemetryData.payload[flagsIndex] = (uint8_t)APP_TELEMETRY_DELTA_ONLINE;
+        size = APP_TELEMETRY_Put16(size, state->online);
+    }
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        if (state->port[index] != sent->port[index])
+        {
+            changed |= (uint16_t)(1U << index);
+            size = APP_TELEMETRY_Put16(size, state->port[index]);
+        }
+    }
+
+    if ((changed == 0U) && (appTelemetryData.payload[flagsIndex] == 0U))
+    {
+        /* Unchanged ports cost nothing */
+        return true;
+    }
+
+    (void)APP_TELEMETRY_Put16(changedIndex, changed);
+
+    return APP_TELEMETRY_FrameSend(size);
+}
+
+static bool APP_TELEMETRY_StatsSend( void )
+{
+    uint32_t size = APP_TELEMETRY_HeaderPut(APP_TELEMETRY_FRAME_STATS);
+    uint32_t index;
+
+    size = APP_TELEMETRY_Put32(size, appTelemetryData.cycles);
+    size = APP_TELEMETRY_Put32(size, appTelemetryData.framesDropped);
+    size = APP_TELEMETRY_Put32(size, SERCOM3_USART_WriteOverflowCountGet());
+    size = APP_TELEMETRY_Put32(size, SYS_LOG_DroppedCountGet());
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        size = APP_TELEMETRY_Put16(size, appTelemetryData.readErrors[index]);
+    }
+
+    return APP_TELEMETRY_FrameSend(size);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_TELEMETRY_Initialize ( void )
+{
+    USART_SERIAL_SETUP serialSetup;
+
+    (void) memset(&appTelemetryData, 0, sizeof(appTelemetryData));
+
+    appTelemetryData.isCyclePending = false;
+    appTelemetryData.isSynced = false;
+
+    serialSetup.baudRate = APP_TELEMETRY_BAUD_RATE;
+    serialSetup.parity = USART_PARITY_NONE;
+    serialSetup.dataWidth = USART_DATA_8_BIT;
+    serialSetup.stopBits = USART_STOP_1_BIT;
+
+    (void) SERCOM3_USART_SerialSetup(&serialSetup, 0U);
+}
+
+void APP_TELEMETRY_Tasks ( void )
+{
+    uint32_t tick = SYSTICK_GetTickCounter();
+
+    if (appTelemetryData.isHeld == true)
+    {
+        return;
+    }
+
+    if (appTelemetryData.isCyclePending == true)
+    {
+        if ((appTelemetryData.isSynced == false) ||
+            ((tick - appTelemetryData.snapshotTick) >= APP_TELEMETRY_PERIOD_MS))
+        {
+            if (APP_TELEMETRY_SnapshotSend() == true)
+            {
+                appTelemetryData.sentState = appTelemetryData.cycleState;
+                appTelemetryData.isSynced = true;
+                appTelemetryData.snapshotTick = tick;
+            }
+        }
+        else if (APP_TELEMETRY_DeltaSend() == true)
+        {
+            appTelemetryData.sentState = appTelemetryData.cycleState;
+        }
+        else
+        {
+            /* Not sent, the changes go out with the next DELTA */
+        }
+
+        appTelemetryData.isCyclePending = false;
+    }
+
+    if ((tick - appTelemetryData.statsTick) >= APP_TELEMETRY_PERIOD_MS)
+    {
+        if (APP_TELEMETRY_StatsSend() == true)
+        {
+            appTelemetryData.statsTick = tick;
+        }
+    }
+}
+
+uint32_t APP_TELEMETRY_IdleUsGet ( void )
+{
+    if (appTelemetryData.isHeld == true)
+    {
+        return SYS_SCHED_IDLE_FOREVER;
+    }
+
+    if (appTelemetryData.isCyclePending == true)
+    {
+        return 0U;
+    }
+
+    return SYS_SCHED_MsPeriodIdleUsGet(appTelemetryData.statsTick, SYSTICK_GetTickCounter(), APP_TELEMETRY_PERIOD_MS);
+}
+
+void APP_TELEMETRY_Hold ( bool isHeld )
+{
+    appTelemetryData.isHeld = isHeld;
+
+    /* The host lost the state with the rate change */
+    appTelemetryData.isSynced = false;
+}
+
+void APP_TELEMETRY_InputsUpdate ( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline )
+{
+    uint16_t onlineMask = (uint16_t)(1U << index);
+    bool interruptState;
+
+    if (index >= APP_TARGET_EXPANDERS_NUMBER)
+    {
+        return;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    if (isOnline == true)
+    {
+        appTelemetryData.inputs.port[index] = (uint16_t)(((uint16_t)gpioB << 8) | gpioA);
+        appTelemetryData.inputs.online |= onlineMask;
+    }
+    else
+    {
+        appTelemetryData.inputs.online &= (uint16_t)~onlineMask;
+        appTelemetryData.readErrors[index]++;
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_TELEMETRY_CycleComplete ( void )
+{
+    bool interruptState = SYS_INT_Disable();
+    uint8_t index;
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        appTelemetryData.cycleState.port[index] = appTelemetryData.inputs.port[index];
+    }
+    appTelemetryData.cycleState.online = appTelemetryData.inputs.online;
+
+    SYS_INT_Restore(interruptState);
+
+    appTelemetryData.cycles++;
+    appTelemetryData.isCyclePending = true;
+}
+
+bool APP_TELEMETRY_FrameWrite ( uint8_t* payload, uint32_t payloadSize )
+{
+    uint16_t crc;
+    uint32_t frameSize;
+
+    if (payloadSize > APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX)
+    {
+        return false;
+    }
+
+    crc = APP_TELEMETRY_Crc16(payload, payloadSize);
+    payload[payloadSize] = (uint8_t)crc;
+    payload[payloadSize + 1U] = (uint8_t)(crc >> 8);
+
+    appTelemetryData.frame[0] = 0U;
+    frameSize = 1U + APP_TELEMETRY_CobsEncode(payload, payloadSize + 2U, &appTelemetryData.frame[1]);
+    appTelemetryData.frame[frameSize] = 0U;
+    frameSize++;
+
+    if (SERCOM3_USART_WriteFreeBufferCountGet() < frameSize)
+    {
+        return false;
+    }
+
+    (void)SERCOM3_USART_Write(appTelemetryData.frame, frameSize);
+
+    return true;
+}
+
+uint32_t APP_TELEMETRY_TimestampGet ( void )
+{
+    return SYSTICK_TimestampUs32Get();
+}
+
+bool APP_TELEMETRY_PortGet ( uint8_t index, uint16_t* port )
+{
+    bool interruptState;
+    bool isOnline;
+
+    if ((index >= APP_TARGET_EXPANDERS_NUMBER) || (port == NULL))
+    {
+        return false;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    *port = appTelemetryData.inputs.port[index];
+    isOnline = ((appTelemetryData.inputs.online & (1U << index)) != 0U);
+
+    SYS_INT_Restore(interruptState);
+
+    return isOnline;
+}
+
+uint32_t APP_TELEMETRY_CyclesGet ( void )
+{
+    return appTelemetryData.cycles;
+}
+
+uint32_t APP_TELEMETRY_FramesDroppedGet ( void )
+{
+    return appTelemetryData.framesDropped;
+}
+
+uint16_t APP_TELEMETRY_ReadErrorsGet ( uint8_t index )
+{
+    if (index >= APP_TARGET_EXPANDERS_NUMBER)
+    {
+        return 0U;
+    }
+
+    return appTelemetryData.readErrors[index];
+}
+
+/*******************************************************************************
+ End of File
+ */
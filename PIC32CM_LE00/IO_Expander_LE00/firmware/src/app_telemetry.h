@@ -0,0 +1,245 @@
+/*******************************************************************************
+  Pin-State Telemetry Header File
+
+  File Name:
+    app_telemetry.h
+
+  Summary:
+    Streams the expander input state as framed binary telemetry on SERCOM3.
+
+  Description:
+    Every frame is COBS encoded and enclosed in 0x00 delimiters, so it can
+    share the SERCOM3 console with text and SYS_LOG records.  Before encoding,
+    a frame is a payload followed by a CRC-16/CCITT-FALSE (poly 0x1021, init
+    0xFFFF) of the payload, little endian.  All fields are little endian:
+
+        type (u8), sequence (u8), timestamp in us (u32), body
+
+        SNAPSHOT  0x01  cycle (u32), online (u16), port[16] (u16)
+        DELTA     0x02  flags (u8), changed (u16), [online (u16)],
+                        port (u16) for every bit set in changed
+        STATS     0x03  cycles (u32), frames dropped (u32), console bytes
+                        dropped (u32), log records dropped (u32),
+                        read errors[16] (u16)
+
+    A port is GPIOA of the expander in the low byte and GPIOB in the high byte.
+    A DELTA is relative to the last frame sent; bit 0 of flags says the online
+    mask follows.  Cycles without any change send nothing.  The sequence
+    number counts sent frames, so a gap tells the host to wait for the next
+    SNAPSHOT.  A frame that does not fit in the SERCOM3 transmit ring is not
+    sent and its changes go out with the next DELTA.
+
+    Frame types 0x10 and up are replies to host requests (see app_rpc.h);
+    their second byte is the request sequence, not the telemetry sequence.
+
+    firmware/tools/telemetry_decode.py decodes live streams and captures.
+
+*******************************************************************************/
+
+#ifndef _APP_TELEMETRY_H
+#define _APP_TELEMETRY_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "definitions.h"
+#include "app_target.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Console rate needed for a full change of all ports on every 1 ms cycle */
+#define APP_TELEMETRY_BAUD_RATE             (921600U)
+
+#define APP_TELEMETRY_FRAME_SNAPSHOT        (0x01U)
+#define APP_TELEMETRY_FRAME_DELTA           (0x02U)
+#define APP_TELEMETRY_FRAME_STATS           (0x03U)
+
+#define APP_TELEMETRY_DELTA_ONLINE          (0x01U)
+
+/* Largest payload APP_TELEMETRY_FrameWrite takes, without the CRC */
+#define APP_TELEMETRY_FRAME_PAYLOAD_SIZE_MAX    (160U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_TELEMETRY_Initialize ( void )
+
+  Summary:
+    Clears the telemetry state and sets the console to APP_TELEMETRY_BAUD_RATE.
+
+  Remarks:
+    Must be called from SYS_Initialize after SERCOM3_USART_Initialize.
+*/
+
+void APP_TELEMETRY_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_TELEMETRY_Tasks ( void )
+
+  Summary:
+    Sends the frames due: a DELTA after a cycle with changes, and a SNAPSHOT
+    and a STATS frame once a second.
+
+  Remarks:
+    Must be called from SYS_Tasks.
+*/
+
+void APP_TELEMETRY_Tasks ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_TELEMETRY_IdleUsGet ( void )
+
+  Summary:
+    Returns the microseconds before a frame is due, 0 after a cycle to
+    report.
+
+  Remarks:
+    SYS_SCHED_IDLE_FOREVER while held.
+*/
+
+uint32_t APP_TELEMETRY_IdleUsGet ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_TELEMETRY_InputsUpdate ( uint8_t index, uint8_t gpioA,
+                                      uint8_t gpioB, bool isOnline )
+
+  Summary:
+    Records the result of one expander read.
+
+  Remarks:
+    Same contract as APP_TARGET_InputsUpdate; failed reads are counted.  May
+    be called from task or interrupt context.
+*/
+
+void APP_TELEMETRY_InputsUpdate ( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline );
+
+/*******************************************************************************
+  Function:
+    void APP_TELEMETRY_CycleComplete ( void )
+
+  Summary:
+    Takes the state at the end of a polling cycle for the next DELTA.
+*/
+
+void APP_TELEMETRY_CycleComplete ( void );
+
+/*******************************************************************************
+  Function:
+    void APP_TELEMETRY_Hold ( bool isHeld )
+
+  Summary:
+    Stops sending frames while the console rate changes; the first frame
+    after that is a SNAPSHOT.
+
+  Remarks:
+    Frames written with APP_TELEMETRY_FrameWrite are not held.
+*/
+
+void APP_TELEMETRY_Hold ( bool isHeld );
+
+/*******************************************************************************
+  Function:
+    bool APP_TELEMETRY_FrameWrite ( uint8_t* payload, uint32_t payloadSize )
+
+  Summary:
+    Appends the CRC to the payload, COBS encodes it and queues the frame on
+    SERCOM3 whole or not at all.
+
+  Returns:
+    false if the frame did not fit in the transmit ring.
+
+  Remarks:
+    payload needs two bytes of room after payloadSize for the CRC.  Frames
+    written by other modules do not take a telemetry sequence number.  Task
+    context only.
+*/
+
+bool APP_TELEMETRY_FrameWrite ( uint8_t* payload, uint32_t payloadSize );
+
+/*******************************************************************************
+  Function:
+    uint16_t APP_TELEMETRY_Crc16 ( const uint8_t* data, uint32_t size )
+
+  Summary:
+    CRC-16/CCITT-FALSE of the frames.
+*/
+
+uint16_t APP_TELEMETRY_Crc16 ( const uint8_t* data, uint32_t size );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_TELEMETRY_TimestampGet ( void )
+
+  Summary:
+    SYSTICK_TimestampUs32Get, as sent in the frame header; wraps every 71
+    minutes.
+*/
+
+uint32_t APP_TELEMETRY_TimestampGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_TELEMETRY_PortGet ( uint8_t index, uint16_t* port )
+
+  Summary:
+    Gives the last port value read from an expander, GPIOA in the low byte.
+
+  Returns:
+    true while the expander answers; false if it is offline or does not exist.
+*/
+
+bool APP_TELEMETRY_PortGet ( uint8_t index, uint16_t* port );
+
+/*******************************************************************************
+  Function:
+    Counter getters
+
+  Summary:
+    Polling cycles completed, frames not sent for lack of room, and failed
+    reads of one expander; the same counters the STATS frame carries.
+*/
+
+uint32_t APP_TELEMETRY_CyclesGet ( void );
+
+uint32_t APP_TELEMETRY_FramesDroppedGet ( void );
+
+uint16_t APP_TELEMETRY_ReadErrorsGet ( uint8_t index );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_TELEMETRY_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -80,6 +80,73 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Deferred Log System Service Configuration Options (ring size in 32-bit
+ * words, a power of two) */
+#define SYS_LOG_BUFFER_WORDS                  256U
+
+/* Command Processor System Service Configuration Options: characters taken
+ * per SYS_CMD_Tasks call, longest line, most words per line */
+#define SYS_CMD_READ_BUDGET                   16U
+#define SYS_CMD_MAX_LENGTH                    80U
+#define SYS_CMD_MAX_ARGS                      8U
+#define SYS_CMD_GROUPS_MAX                    4U
+#define SYS_CMD_PRINT_BUFFER_SIZE             128U
+
+/* Task Scheduler System Service Configuration Options: longest task table */
+#define SYS_SCHED_TASKS_MAX                   12U
+
+/* Timer System Service Configuration Options: timer objects in the pool */
+#define SYS_TMR_MAX_CLIENT_OBJECTS            16U
+
+/* Power System Service Configuration Options: standby at start-up, shortest
+ * idle time worth a standby, longest standby between two scheduler passes */
+#define SYS_POWER_STANDBY_ENABLE              false
+#define SYS_POWER_STANDBY_MIN_US              2000U
+#define SYS_POWER_STANDBY_MAX_MS              1000U
+
+/* Performance level governor at start-up, its window, busy share of a
+ * window, in per cent, below which it drops to the low level and above
+ * which it goes back up, and the flash read wait states of each level.
+ * Both levels run at PL2, as PL0 does not allow a 16 MHz CPU clock.  The
+ * high level's are the two the clock configuration generated for 48 MHz,
+ * which SYS_Initialize sets too; the low level keeps them, being valid at
+ * any lower clock, until fewer are checked against the datasheet table */
+#define SYS_POWER_GOVERNOR_ENABLE             false
+#define SYS_POWER_GOVERNOR_WINDOW_MS          100U
+#define SYS_POWER_GOVERNOR_DOWN_PERCENT       15U
+#define SYS_POWER_GOVERNOR_UP_PERCENT         60U
+#define SYS_POWER_HIGH_RWS                    2U
+#define SYS_POWER_LOW_RWS                     SYS_POWER_HIGH_RWS
+
+/* Profiler System Service Configuration Options: defined to build the
+ * regions in, log2 histogram buckets, and the region ids */
+#define SYS_PROF_ENABLE
+#define SYS_PROF_BUCKETS                      20U
+#define SYS_PROF_REGIONS_NUMBER               5U
+#define SYS_PROF_ID_DRV_I2C_SUBMIT            0U
+#define SYS_PROF_ID_SERCOM5_ISR               1U
+#define SYS_PROF_ID_APP_TASKS                 2U
+#define SYS_PROF_ID_STDIO_WRITE               3U
+#define SYS_PROF_ID_LOG_WRITE                 4U
+
+/* Boot trace phases, in the order they are normally reached */
+#define SYS_PROF_BOOT_PHASES_NUMBER           8U
+#define SYS_PROF_BOOT_ID_CLOCK                0U
+#define SYS_PROF_BOOT_ID_EXPANDER_I2C         1U
+#define SYS_PROF_BOOT_ID_CONFIG_QUEUED        2U
+#define SYS_PROF_BOOT_ID_PERIPHERALS          3U
+#define SYS_PROF_BOOT_ID_SERVICES             4U
+#define SYS_PROF_BOOT_ID_INIT_DONE            5U
+#define SYS_PROF_BOOT_ID_OUTPUTS_DEFINED      6U
+#define SYS_PROF_BOOT_ID_CONFIGURED           7U
+
+/* Key/Value Store System Service Configuration Options: keys, rows kept
+ * erased ahead of the writes, and the keys in use */
+#define SYS_KVS_KEYS_NUMBER                   16U
+#define SYS_KVS_RESERVE_ROWS                  2U
+#define SYS_KVS_KEY_APP_PATTERN               0U
+#define SYS_KVS_KEY_SHELL_STRESS              1U
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -88,12 +155,44 @@ extern "C" {
 // *****************************************************************************
 /* I2C Driver Instance 0 Configuration Options */
 #define DRV_I2C_INDEX_0                       0
-#define DRV_I2C_CLIENTS_NUMBER_IDX0           1
-#define DRV_I2C_QUEUE_SIZE_IDX0               2
-#define DRV_I2C_CLOCK_SPEED_IDX0              400
+#define DRV_I2C_CLIENTS_NUMBER_IDX0           3
+#define DRV_I2C_QUEUE_SIZE_IDX0               18
+#define DRV_I2C_CLOCK_SPEED_IDX0              400000
+
+/* I2C Driver Instance 1 Configuration Options */
+#define DRV_I2C_INDEX_1                       1
+#define DRV_I2C_CLIENTS_NUMBER_IDX1           2
+#define DRV_I2C_QUEUE_SIZE_IDX1               16
+#define DRV_I2C_CLOCK_SPEED_IDX1              400000
+
+/* Bit-banged I2C lanes on PA12 (SCL), PA13 and PA14 (SDA), driver instances
+   2 and 3: defined to bring up TC0, the lanes and their driver instances.
+   No module opens them yet, so they are left out and the pins stay free. */
+/* #define I2C_BB_ENABLE */
+
+/* I2C Driver Instance 2 Configuration Options (bit-banged lane 0) */
+#define DRV_I2C_INDEX_2                       2
+#define DRV_I2C_CLIENTS_NUMBER_IDX2           1
+#define DRV_I2C_QUEUE_SIZE_IDX2               8
+#define DRV_I2C_CLOCK_SPEED_IDX2              50000
+
+/* I2C Driver Instance 3 Configuration Options (bit-banged lane 1) */
+#define DRV_I2C_INDEX_3                       3
+#define DRV_I2C_CLIENTS_NUMBER_IDX3           1
+#define DRV_I2C_QUEUE_SIZE_IDX3               8
+#define DRV_I2C_CLOCK_SPEED_IDX3              50000
 
 /* I2C Driver Common Configuration Options */
-#define DRV_I2C_INSTANCES_NUMBER              1
+#define DRV_I2C_INSTANCES_NUMBER              4
+
+/* Per-address link quality tracking: a device's clock is halved once for every
+   DRV_I2C_LINK_ERRORS_DOWN errors, at most DRV_I2C_LINK_LEVELS_MAX times, and
+   doubled again after a clean window of transfers */
+#define DRV_I2C_LINKS_NUMBER                  8
+#define DRV_I2C_LINK_ERRORS_DOWN              2
+#define DRV_I2C_LINK_LEVELS_MAX               2
+#define DRV_I2C_LINK_CLEAN_WINDOW             64
+#define DRV_I2C_LINK_CLEAN_WINDOW_MAX         4096
 
 
 
@@ -50,7 +50,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "peripheral/sercom/usart/plib_sercom3_usart.h"
+#include "peripheral/dmac/plib_dmac.h"
 #include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "peripheral/dsu/plib_dsu.h"
 #include "peripheral/evsys/plib_evsys.h"
 #include "bsp/bsp.h"
 #include "peripheral/pm/plib_pm.h"
@@ -58,12 +60,30 @@
 #include "peripheral/clock/plib_clock.h"
 #include "peripheral/nvic/plib_nvic.h"
 #include "peripheral/systick/plib_systick.h"
+#include "peripheral/sercom/i2c_slave/plib_sercom1_i2c_slave.h"
+#include "peripheral/sercom/i2c_master/plib_sercom2_i2c_master.h"
 #include "peripheral/sercom/i2c_master/plib_sercom5_i2c_master.h"
+#include "peripheral/tc/plib_tc0.h"
+#include "peripheral/rtc/plib_rtc.h"
+#include "peripheral/i2c_bb/plib_i2c_bb.h"
 #include "driver/i2c/drv_i2c.h"
 #include "system/int/sys_int.h"
 #include "osal/osal.h"
 #include "system/debug/sys_debug.h"
+#include "system/log/sys_log.h"
+#include "system/command/sys_command.h"
+#include "system/sched/sys_sched.h"
+#include "system/tmr/sys_tmr.h"
+#include "system/power/sys_power.h"
+#include "system/prof/sys_prof.h"
+#include "system/kvs/sys_kvs.h"
 #include "app.h"
+#include "app_target.h"
+#include "app_expander.h"
+#include "app_telemetry.h"
+#include "app_shell.h"
+#include "app_rpc.h"
+#include "app_baud.h"
 
 
 
@@ -191,6 +211,12 @@ typedef struct
     /* I2C0 Driver Object */
     SYS_MODULE_OBJ drvI2C0;
 
+    SYS_MODULE_OBJ drvI2C1;
+
+    SYS_MODULE_OBJ drvI2C2;
+
+    SYS_MODULE_OBJ drvI2C3;
+
 
 } SYSTEM_OBJECTS;
 
@@ -514,6 +514,81 @@ void DRV_I2C_Close( const DRV_HANDLE handle );
 
 bool DRV_I2C_TransferSetup( const DRV_HANDLE handle, DRV_I2C_TRANSFER_SETUP* setup);
 
+// *****************************************************************************
+/* Function:
+    uint32_t DRV_I2C_LinkClockSpeedGet( const DRV_HANDLE handle, const uint16_t address )
+
+   Summary:
+    Gets the clock speed the driver currently uses for a target.
+
+   Description:
+    The driver tracks NAK and bus errors per target address.  Repeated errors
+    halve the clock used for that target, up to DRV_I2C_LINK_LEVELS_MAX times,
+    and a window of clean transfers raises it again towards the clock speed
+    set for the client through DRV_I2C_TransferSetup.  This function returns
+    the clock speed the next transfer to the target will run at.
+
+   Precondition:
+    DRV_I2C_Open must have been called to obtain a valid opened device handle.
+
+   Parameters:
+    handle  - A valid open-instance handle, returned from the driver's
+              open routine
+    address - Target address
+
+   Returns:
+    Clock speed in Hz, or 0 if the handle is not valid.
+
+  Example:
+    <code>
+    if (DRV_I2C_LinkClockSpeedGet(myI2CHandle, 0x20) < 400000)
+    {
+        // Target 0x20 has been slowed down after errors
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t DRV_I2C_LinkClockSpeedGet( const DRV_HANDLE handle, const uint16_t address );
+
+// *****************************************************************************
+/* Function:
+    void DRV_I2C_ClockChange( void )
+
+   Summary:
+    Has every instance set its clock up again after a peripheral clock change.
+
+   Description:
+    The bus clock of an instance is worked out from the peripheral clock when
+    the clock speed changes.  After the generator feeding the SERCOMs and
+    TC0 has changed frequency, this function makes the next transfer of
+    every instance set its clock up again from the new frequency.
+
+   Precondition:
+    DRV_I2C_Initialize must have been called for every instance.  No
+    transfer may be in progress, and the clock must not change again
+    before the next transfer of each instance has started.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    CLOCK_Gclk0SourceSet(CLOCK_GCLK0_SOURCE_OSC16M);
+    DRV_I2C_ClockChange();
+    </code>
+
+  Remarks:
+    Chained transfers are not staged until the setup has been applied.
+*/
+
+void DRV_I2C_ClockChange( void );
+
 // *****************************************************************************
 /* Function:
     DRV_I2C_ERROR DRV_I2C_ErrorGet( const DRV_I2C_TRANSFER_HANDLE transferHandle )
@@ -81,12 +81,14 @@
     settings dynamically.
 
   Remarks:
-    None.
+    Clock speeds up to 400 kHz select Standard/Fast-mode, up to 1 MHz select
+    Fast-mode Plus and up to 3.4 MHz select High-speed mode, where every
+    transfer is preceded by the master code sent in Fast-mode.
 */
 
 typedef struct
 {
-    /* clock speed */
+    /* clock speed in Hz */
     uint32_t clockSpeed;
 
 } DRV_I2C_TRANSFER_SETUP;
@@ -135,6 +137,8 @@ typedef bool (* DRV_I2C_PLIB_TRANSFER_SETUP)(DRV_I2C_TRANSFER_SETUP* setup, uint
 
 typedef void (* DRV_I2C_PLIB_CALLBACK_REGISTER)(DRV_I2C_PLIB_CALLBACK, uintptr_t);
 
+typedef bool (* DRV_I2C_PLIB_NEXT_TRANSFER_SET)( uint16_t, uint8_t *, uint32_t, uint8_t *, uint32_t );
+
 typedef struct
 {
     int32_t         i2cInt0;
@@ -195,6 +199,10 @@ typedef struct
     /* I2C PLib callback register API */
     DRV_I2C_PLIB_CALLBACK_REGISTER              callbackRegister;
 
+    /* I2C PLib API to stage the transfer that follows the ongoing one.
+     * Optional, NULL if the PLib cannot chain transfers. */
+    DRV_I2C_PLIB_NEXT_TRANSFER_SET              nextTransferSet;
+
 } DRV_I2C_PLIB_INTERFACE;
 
 // *****************************************************************************
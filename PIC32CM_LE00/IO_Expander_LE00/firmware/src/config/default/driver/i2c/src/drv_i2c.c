@@ -48,6 +48,7 @@
 #include "configuration.h"
 #include "driver/i2c/drv_i2c.h"
 #include "system/debug/sys_debug.h"
+#include "system/prof/sys_prof.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -344,6 +345,153 @@ static void _DRV_I2C_RemoveClientTransfersFromList(
     }
 }
 
+static DRV_I2C_LINK_OBJ* _DRV_I2C_LinkGet(DRV_I2C_OBJ* dObj, uint16_t address)
+{
+    uint32_t linkIndex;
+
+    for (linkIndex = 0; linkIndex < DRV_I2C_LINKS_NUMBER; linkIndex++)
+    {
+        if (dObj->links[linkIndex].address == address)
+        {
+            return &dObj->links[linkIndex];
+        }
+    }
+
+    return NULL;
+}
+
+static DRV_I2C_LINK_OBJ* _DRV_I2C_LinkAllocate(DRV_I2C_OBJ* dObj, uint16_t address)
+{
+    DRV_I2C_LINK_OBJ* link = NULL;
+    uint32_t linkIndex;
+
+    /* Take a free entry, or else one whose target still runs at full speed */
+    for (linkIndex = 0; linkIndex < DRV_I2C_LINKS_NUMBER; linkIndex++)
+    {
+        if (dObj->links[linkIndex].address == DRV_I2C_LINK_ADDRESS_NONE)
+        {
+            link = &dObj->links[linkIndex];
+            break;
+        }
+
+        if ((link == NULL) && (dObj->links[linkIndex].level == 0U))
+        {
+            link = &dObj->links[linkIndex];
+        }
+    }
+
+    if (link != NULL)
+    {
+        link->address       = address;
+        link->level         = 0U;
+        link->errorCount    = 0U;
+        link->cleanCount    = 0U;
+        link->cleanWindow   = DRV_I2C_LINK_CLEAN_WINDOW;
+        link->isProbing     = false;
+    }
+
+    return link;
+}
+
+static uint32_t _DRV_I2C_LinkClockSpeedGet(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ* clientObj, uint16_t address)
+{
+    DRV_I2C_LINK_OBJ* link = _DRV_I2C_LinkGet(dObj, address);
+    uint32_t clockSpeed = clientObj->transferSetup.clockSpeed;
+
+    if (link != NULL)
+    {
+        clockSpeed >>= link->level;
+    }
+
+    return clockSpeed;
+}
+
+static void _DRV_I2C_LinkUpdate(DRV_I2C_OBJ* dObj, uint16_t address, DRV_I2C_ERROR errors)
+{
+    DRV_I2C_LINK_OBJ* link = _DRV_I2C_LinkGet(dObj, address);
+
+    if (errors != DRV_I2C_ERROR_NONE)
+    {
+        if (link == NULL)
+        {
+            link = _DRV_I2C_LinkAllocate(dObj, address);
+
+            if (link == NULL)
+            {
+                /* Every entry tracks a degraded target, leave this one alone */
+                return;
+            }
+        }
+
+        link->cleanCount = 0U;
+        link->errorCount++;
+
+        if (link->errorCount >= DRV_I2C_LINK_ERRORS_DOWN)
+        {
+            link->errorCount = 0U;
+
+            if (link->level < DRV_I2C_LINK_LEVELS_MAX)
+            {
+                link->level++;
+            }
+
+            if (link->isProbing == true)
+            {
+                /* The faster clock did not hold, wait longer before probing again */
+                if (link->cleanWindow < DRV_I2C_LINK_CLEAN_WINDOW_MAX)
+                {
+                    link->cleanWindow *= 2U;
+                }
+
+                link->isProbing = false;
+            }
+        }
+    }
+    else if (link != NULL)
+    {
+        link->cleanCount++;
+
+        if (link->cleanCount >= link->cleanWindow)
+        {
+            link->cleanCount = 0U;
+            link->errorCount = 0U;
+
+            if (link->level == 0U)
+            {
+                /* Clean at the client clock speed, stop tracking */
+                link->address = DRV_I2C_LINK_ADDRESS_NONE;
+            }
+            else
+            {
+                link->level--;
+                link->isProbing = true;
+            }
+        }
+    }
+    else
+    {
+        /* Untracked target completed without errors */
+    }
+}
+
+static void _DRV_I2C_TransferSetupApply(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ* clientObj, uint16_t address)
+{
+    DRV_I2C_TRANSFER_SETUP setup;
+
+    /* Client clock speed, lowered for targets with a poor link */
+    setup.clockSpeed = _DRV_I2C_LinkClockSpeedGet(dObj, clientObj, address);
+
+    /* Check if the transfer setup for this transfer is different than the current transfer setup */
+    if (dObj->currentTransferSetup.clockSpeed != setup.clockSpeed)
+    {
+        /* Set the new transfer setup */
+        if (dObj->i2cPlib->transferSetup(&setup, 0) == true)
+        {
+            dObj->currentTransferSetup.clockSpeed = setup.clockSpeed;
+        }
+    }
+}
+
 static void _DRV_I2C_ClientCallback(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ* clientObj, DRV_I2C_TRANSFER_OBJ* transferObj)
 {
     DRV_I2C_TRANSFER_EVENT event;
@@ -360,6 +508,8 @@ static void _DRV_I2C_ClientCallback(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ* clien
         transferObj->event = DRV_I2C_TRANSFER_EVENT_ERROR;
     }
 
+    _DRV_I2C_LinkUpdate(dObj, transferObj->slaveAddress, transferObj->errors);
+
     /* Save the transfer handle and event locally before freeing the transfer object*/
     event = transferObj->event;
     transferHandle = transferObj->transferHandle;
@@ -399,14 +549,7 @@ static void _DRV_I2C_NextTransferInitiate(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ*
             clientObj = &((DRV_I2C_CLIENT_OBJ *)gDrvI2CObj[((transferObj->clientHandle & DRV_I2C_INSTANCE_MASK) >> 8)].clientObjPool)
                         [transferObj->clientHandle & DRV_I2C_INDEX_MASK];
 
-            /* Check if the transfer setup for this client is different than the current transfer setup */
-            if (dObj->currentTransferSetup.clockSpeed != clientObj->transferSetup.clockSpeed)
-            {
-                /* Set the new transfer setup */
-                dObj->i2cPlib->transferSetup(&clientObj->transferSetup, 0);
-
-                dObj->currentTransferSetup.clockSpeed = clientObj->transferSetup.clockSpeed;
-            }
+            _DRV_I2C_TransferSetupApply(dObj, clientObj, transferObj->slaveAddress);
 
             switch(transferObj->flag)
             {
@@ -435,6 +578,77 @@ static void _DRV_I2C_NextTransferInitiate(DRV_I2C_OBJ* dObj, DRV_I2C_CLIENT_OBJ*
     }while(transferStatus == false);
 }
 
+static void _DRV_I2C_NextTransferStage(DRV_I2C_OBJ* dObj)
+{
+    DRV_I2C_TRANSFER_OBJ* transferObj = _DRV_I2C_TransferObjListGet(dObj);
+    DRV_I2C_CLIENT_OBJ* clientObj = NULL;
+    bool transferStatus = false;
+
+    /* Stage the second transfer in the list with the PLIB so that it is
+     * started from the PLIB interrupt as soon as the head completes */
+    if((dObj->i2cPlib->nextTransferSet == NULL) || (dObj->stagedTransferObj != NULL))
+    {
+        return;
+    }
+
+    if((transferObj == NULL) || (transferObj->currentState != DRV_I2C_TRANSFER_OBJ_IS_PROCESSING))
+    {
+        return;
+    }
+
+    transferObj = transferObj->next;
+
+    if((transferObj == NULL) || (transferObj->currentState != DRV_I2C_TRANSFER_OBJ_IS_IN_QUEUE))
+    {
+        return;
+    }
+
+    // Get the client object that owns this buffer
+    clientObj = &((DRV_I2C_CLIENT_OBJ *)gDrvI2CObj[((transferObj->clientHandle & DRV_I2C_INSTANCE_MASK) >> 8)].clientObjPool)
+                [transferObj->clientHandle & DRV_I2C_INDEX_MASK];
+
+    /* The PLIB does not change the transfer setup between chained transfers */
+    if (dObj->currentTransferSetup.clockSpeed != _DRV_I2C_LinkClockSpeedGet(dObj, clientObj, transferObj->slaveAddress))
+    {
+        return;
+    }
+
+    switch(transferObj->flag)
+    {
+        case DRV_I2C_TRANSFER_OBJ_FLAG_READ:
+            transferStatus = dObj->i2cPlib->nextTransferSet(transferObj->slaveAddress, NULL, 0, transferObj->readBuffer, transferObj->readSize);
+            break;
+
+        case DRV_I2C_TRANSFER_OBJ_FLAG_WRITE:
+            transferStatus = dObj->i2cPlib->nextTransferSet(transferObj->slaveAddress, transferObj->writeBuffer, transferObj->writeSize, NULL, 0);
+            break;
+
+        case DRV_I2C_TRANSFER_OBJ_FLAG_WRITE_READ:
+            transferStatus = dObj->i2cPlib->nextTransferSet(transferObj->slaveAddress, transferObj->writeBuffer, transferObj->writeSize, transferObj->readBuffer, transferObj->readSize);
+            break;
+
+        default:
+            /* Other transfers are started by _DRV_I2C_NextTransferInitiate */
+            break;
+    }
+
+    if (transferStatus == true)
+    {
+        transferObj->currentState = DRV_I2C_TRANSFER_OBJ_IS_PROCESSING;
+        dObj->stagedTransferObj = transferObj;
+    }
+}
+
+static void _DRV_I2C_StagedTransferRevert(DRV_I2C_OBJ* dObj)
+{
+    /* The PLIB dropped the staged transfer, put it back in the queue */
+    if (dObj->stagedTransferObj != NULL)
+    {
+        dObj->stagedTransferObj->currentState = DRV_I2C_TRANSFER_OBJ_IS_IN_QUEUE;
+        dObj->stagedTransferObj = NULL;
+    }
+}
+
 static void _DRV_I2C_PLibCallbackHandler( uintptr_t contextHandle )
 {
     DRV_I2C_OBJ* dObj = (DRV_I2C_OBJ *)contextHandle;
@@ -448,6 +662,17 @@ static void _DRV_I2C_PLibCallbackHandler( uintptr_t contextHandle )
         return;
     }
 
+    /* The PLIB has already started the staged transfer, unless the completed
+     * transfer failed */
+    if (dObj->i2cPlib->errorGet() != DRV_I2C_ERROR_NONE)
+    {
+        _DRV_I2C_StagedTransferRevert(dObj);
+    }
+    else
+    {
+        dObj->stagedTransferObj = NULL;
+    }
+
     // Get the transfer object at the head of the list
     transferObj = _DRV_I2C_TransferObjListGet(dObj);
 
@@ -467,6 +692,8 @@ static void _DRV_I2C_PLibCallbackHandler( uintptr_t contextHandle )
     }
 
     _DRV_I2C_NextTransferInitiate(dObj, clientObj);
+
+    _DRV_I2C_NextTransferStage(dObj);
 }
 
 // *****************************************************************************
@@ -482,6 +709,7 @@ SYS_MODULE_OBJ DRV_I2C_Initialize(
 {
     DRV_I2C_OBJ* dObj     = NULL;
     DRV_I2C_INIT* i2cInit = (DRV_I2C_INIT*)init;
+    uint32_t linkIndex;
 
     /* Validate the request */
     if(drvIndex >= DRV_I2C_INSTANCES_NUMBER)
@@ -518,6 +746,7 @@ SYS_MODULE_OBJ DRV_I2C_Initialize(
     dObj->transferObjPool                   = (DRV_I2C_TRANSFER_OBJ*)i2cInit->transferObjPool;
     dObj->transferObjPoolSize               = i2cInit->transferObjPoolSize;
     dObj->transferObjList                   = (DRV_I2C_TRANSFER_OBJ*)NULL;
+    dObj->stagedTransferObj                 = (DRV_I2C_TRANSFER_OBJ*)NULL;
     dObj->nClients                          = 0;
     dObj->isExclusive                       = false;
     dObj->interruptNestingCount             = 0;
@@ -525,6 +754,11 @@ SYS_MODULE_OBJ DRV_I2C_Initialize(
     dObj->initI2CClockSpeed                 = i2cInit->clockSpeed;
     dObj->currentTransferSetup.clockSpeed   = i2cInit->clockSpeed;
 
+    for (linkIndex = 0; linkIndex < DRV_I2C_LINKS_NUMBER; linkIndex++)
+    {
+        dObj->links[linkIndex].address = DRV_I2C_LINK_ADDRESS_NONE;
+    }
+
     /* Register a callback with the underlying PLIB.
      * dObj as a context parameter will be used to distinguish the events
      * from different instances. */
@@ -741,6 +975,45 @@ bool DRV_I2C_TransferSetup( const DRV_HANDLE handle, DRV_I2C_TRANSFER_SETUP* set
     return true;
 }
 
+void DRV_I2C_ClockChange( void )
+{
+    uint32_t drvIndex;
+
+    /* No clock speed is 0, the next _DRV_I2C_TransferSetupApply sets it */
+    for (drvIndex = 0U; drvIndex < DRV_I2C_INSTANCES_NUMBER; drvIndex++)
+    {
+        gDrvI2CObj[drvIndex].currentTransferSetup.clockSpeed = 0U;
+    }
+}
+
+uint32_t DRV_I2C_LinkClockSpeedGet( const DRV_HANDLE handle, const uint16_t address )
+{
+    DRV_I2C_CLIENT_OBJ* clientObj = NULL;
+    DRV_I2C_OBJ* dObj = NULL;
+    uint32_t clockSpeed;
+
+    /* Validate the driver handle */
+    clientObj = _DRV_I2C_DriverHandleValidate(handle);
+
+    if(clientObj == NULL)
+    {
+        return 0;
+    }
+
+    dObj = &gDrvI2CObj[clientObj->drvIndex];
+
+    if(_DRV_I2C_ResourceLock(dObj) == false)
+    {
+        return 0;
+    }
+
+    clockSpeed = _DRV_I2C_LinkClockSpeedGet(dObj, clientObj, address);
+
+    _DRV_I2C_ResourceUnlock(dObj);
+
+    return clockSpeed;
+}
+
 DRV_I2C_ERROR DRV_I2C_ErrorGet( const DRV_I2C_TRANSFER_HANDLE transferHandle )
 {
     DRV_I2C_OBJ* dObj = NULL;
@@ -796,6 +1069,7 @@ static void _DRV_I2C_WriteReadTransferAdd (
     DRV_I2C_OBJ* dObj = NULL;
     DRV_I2C_TRANSFER_OBJ* transferObj = NULL;
     bool transferError = false;
+    SYS_PROF_BEGIN(SYS_PROF_ID_DRV_I2C_SUBMIT);
 
     /* Validate the transfer handle */
     if (transferHandle == NULL)
@@ -871,14 +1145,7 @@ static void _DRV_I2C_WriteReadTransferAdd (
     {
         /* This is the first request in the queue, hence initiate a PLIB transfer */
 
-        /* Check if the transfer setup for this client is different than the current transfer setup */
-        if (dObj->currentTransferSetup.clockSpeed != clientObj->transferSetup.clockSpeed)
-        {
-            /* Set the new transfer setup */
-            dObj->i2cPlib->transferSetup(&clientObj->transferSetup, 0);
-
-            dObj->currentTransferSetup.clockSpeed = clientObj->transferSetup.clockSpeed;
-        }
+        _DRV_I2C_TransferSetupApply(dObj, clientObj, transferObj->slaveAddress);
 
         transferObj->currentState = DRV_I2C_TRANSFER_OBJ_IS_PROCESSING;
 
@@ -935,8 +1202,16 @@ static void _DRV_I2C_WriteReadTransferAdd (
             _DRV_I2C_RemoveTransferObjFromList(dObj);
         }
     }
+    else
+    {
+        /* A transfer is ongoing, hand this one to the PLIB if it is next in line */
+        _DRV_I2C_NextTransferStage(dObj);
+    }
 
     _DRV_I2C_ResourceUnlock(dObj);
+
+    /* Requests turned away above are not counted */
+    SYS_PROF_END(SYS_PROF_ID_DRV_I2C_SUBMIT);
 }
 
 void DRV_I2C_ReadTransferAdd(
@@ -1008,6 +1283,9 @@ void DRV_I2C_QueuePurge(const DRV_HANDLE handle)
         /* Abort the ongoing transfer with the PLIB */
         dObj->i2cPlib->transferAbort();
 
+        /* The PLIB drops the staged transfer along with the ongoing one */
+        _DRV_I2C_StagedTransferRevert(dObj);
+
         /* Remove the transfer object at the top of the list */
         _DRV_I2C_RemoveTransferObjFromList(dObj);
 
@@ -1021,6 +1299,8 @@ void DRV_I2C_QueuePurge(const DRV_HANDLE handle)
     {
         /* Since top of the queue is updated, force start the next transfer in the queue if any */
         _DRV_I2C_NextTransferInitiate(dObj, clientObj);
+
+        _DRV_I2C_NextTransferStage(dObj);
     }
 
     _DRV_I2C_ResourceUnlock(dObj);
@@ -64,6 +64,9 @@
 
 #define DRV_I2C_TOKEN_MAX                       (0xFFFF)
 
+/* Address of an unused link quality entry */
+#define DRV_I2C_LINK_ADDRESS_NONE               (0xFFFFU)
+
 // *****************************************************************************
 /* I2C Transfer Object Flags
 
@@ -173,6 +176,46 @@ typedef struct _DRV_I2C_TRANSFER_OBJ
 
 } DRV_I2C_TRANSFER_OBJ;
 
+// *****************************************************************************
+/* I2C Link Quality Object
+
+  Summary:
+    Tracks transfer errors for one target address.
+
+  Description:
+    An entry is taken when a target first fails a transfer.  Every
+    DRV_I2C_LINK_ERRORS_DOWN errors without a clean window in between halve
+    the clock used for that target.  A clean window of cleanWindow
+    consecutive good transfers doubles it again; if that probe fails, the
+    window needed before the next probe is doubled.  The entry is released
+    once the target is clean at the client's own clock speed.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Target address, DRV_I2C_LINK_ADDRESS_NONE when the entry is free */
+    uint16_t                        address;
+
+    /* Number of times the client clock speed is halved for this target */
+    uint8_t                         level;
+
+    /* Errors since the last clean window or step down */
+    uint8_t                         errorCount;
+
+    /* Consecutive good transfers */
+    uint16_t                        cleanCount;
+
+    /* Good transfers needed before probing the next faster clock */
+    uint16_t                        cleanWindow;
+
+    /* The last level change was a step up */
+    bool                            isProbing;
+
+} DRV_I2C_LINK_OBJ;
+
 // *****************************************************************************
 /* I2C Driver Instance Object
 
@@ -227,6 +270,12 @@ typedef struct
     /* Linked list of transfer objects */
     DRV_I2C_TRANSFER_OBJ*       transferObjList;
 
+    /* Transfer object staged with the PLIB behind the one at the head of the list */
+    DRV_I2C_TRANSFER_OBJ*       stagedTransferObj;
+
+    /* Link quality of the targets that recently failed a transfer */
+    DRV_I2C_LINK_OBJ            links[DRV_I2C_LINKS_NUMBER];
+
     /* Instance specific token counter used to generate unique client/transfer handles */
     uint16_t                    i2cTokenCount;
 
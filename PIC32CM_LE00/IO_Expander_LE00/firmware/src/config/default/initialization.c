@@ -113,6 +113,9 @@ const DRV_I2C_PLIB_INTERFACE drvI2C0PLibAPI = {
 
     /* I2C PLib Callback Register */
     .callbackRegister = (DRV_I2C_PLIB_CALLBACK_REGISTER)SERCOM5_I2C_CallbackRegister,
+
+    /* I2C PLib Next Transfer Set function */
+    .nextTransferSet = (DRV_I2C_PLIB_NEXT_TRANSFER_SET)SERCOM5_I2C_NextTransferSet,
 };
 
 
@@ -155,6 +158,235 @@ const DRV_I2C_INIT drvI2C0InitData =
 
 // </editor-fold>
 
+// <editor-fold defaultstate="collapsed" desc="DRV_I2C Instance 1 Initialization Data">
+
+/* I2C Client Objects Pool */
+static DRV_I2C_CLIENT_OBJ drvI2C1ClientObjPool[DRV_I2C_CLIENTS_NUMBER_IDX1];
+
+/* I2C Transfer Objects Pool */
+static DRV_I2C_TRANSFER_OBJ drvI2C1TransferObj[DRV_I2C_QUEUE_SIZE_IDX1];
+
+/* I2C PLib Interface Initialization */
+const DRV_I2C_PLIB_INTERFACE drvI2C1PLibAPI = {
+
+    /* I2C PLib Transfer Read Add function */
+    .read = (DRV_I2C_PLIB_READ)SERCOM2_I2C_Read,
+
+    /* I2C PLib Transfer Write Add function */
+    .write = (DRV_I2C_PLIB_WRITE)SERCOM2_I2C_Write,
+
+
+    /* I2C PLib Transfer Write Read Add function */
+    .writeRead = (DRV_I2C_PLIB_WRITE_READ)SERCOM2_I2C_WriteRead,
+
+    /*I2C PLib Transfer Abort function */
+    .transferAbort = (DRV_I2C_PLIB_TRANSFER_ABORT)SERCOM2_I2C_TransferAbort,
+
+    /* I2C PLib Transfer Status function */
+    .errorGet = (DRV_I2C_PLIB_ERROR_GET)SERCOM2_I2C_ErrorGet,
+
+    /* I2C PLib Transfer Setup function */
+    .transferSetup = (DRV_I2C_PLIB_TRANSFER_SETUP)SERCOM2_I2C_TransferSetup,
+
+    /* I2C PLib Callback Register */
+    .callbackRegister = (DRV_I2C_PLIB_CALLBACK_REGISTER)SERCOM2_I2C_CallbackRegister,
+
+    /* I2C PLib Next Transfer Set function */
+    .nextTransferSet = (DRV_I2C_PLIB_NEXT_TRANSFER_SET)SERCOM2_I2C_NextTransferSet,
+};
+
+
+const DRV_I2C_INTERRUPT_SOURCES drvI2C1InterruptSources =
+{
+    /* Peripheral has more than one interrupt vector */
+    .isSingleIntSrc                        = false,
+
+    /* Peripheral interrupt lines */
+    .intSources.multi.i2cInt0          = SERCOM2_0_IRQn,
+    .intSources.multi.i2cInt1          = SERCOM2_1_IRQn,
+    .intSources.multi.i2cInt2          = SERCOM2_2_IRQn,
+    .intSources.multi.i2cInt3          = SERCOM2_OTHER_IRQn,
+};
+
+/* I2C Driver Initialization Data */
+const DRV_I2C_INIT drvI2C1InitData =
+{
+    /* I2C PLib API */
+    .i2cPlib = &drvI2C1PLibAPI,
+
+    /* I2C Number of clients */
+    .numClients = DRV_I2C_CLIENTS_NUMBER_IDX1,
+
+    /* I2C Client Objects Pool */
+    .clientObjPool = (uintptr_t)&drvI2C1ClientObjPool[0],
+
+    /* I2C TWI Queue Size */
+    .transferObjPoolSize = DRV_I2C_QUEUE_SIZE_IDX1,
+
+    /* I2C Transfer Objects */
+    .transferObjPool = (uintptr_t)&drvI2C1TransferObj[0],
+
+    /* I2C interrupt sources */
+    .interruptSources = &drvI2C1InterruptSources,
+
+    /* I2C Clock Speed */
+    .clockSpeed = DRV_I2C_CLOCK_SPEED_IDX1,
+};
+
+// </editor-fold>
+
+#if defined(I2C_BB_ENABLE)
+
+// <editor-fold defaultstate="collapsed" desc="DRV_I2C Instance 2 Initialization Data">
+
+/* I2C Client Objects Pool */
+static DRV_I2C_CLIENT_OBJ drvI2C2ClientObjPool[DRV_I2C_CLIENTS_NUMBER_IDX2];
+
+/* I2C Transfer Objects Pool */
+static DRV_I2C_TRANSFER_OBJ drvI2C2TransferObj[DRV_I2C_QUEUE_SIZE_IDX2];
+
+/* I2C PLib Interface Initialization */
+const DRV_I2C_PLIB_INTERFACE drvI2C2PLibAPI = {
+
+    /* I2C PLib Transfer Read Add function */
+    .read = (DRV_I2C_PLIB_READ)I2C_BB0_Read,
+
+    /* I2C PLib Transfer Write Add function */
+    .write = (DRV_I2C_PLIB_WRITE)I2C_BB0_Write,
+
+
+    /* I2C PLib Transfer Write Read Add function */
+    .writeRead = (DRV_I2C_PLIB_WRITE_READ)I2C_BB0_WriteRead,
+
+    /*I2C PLib Transfer Abort function */
+    .transferAbort = (DRV_I2C_PLIB_TRANSFER_ABORT)I2C_BB0_TransferAbort,
+
+    /* I2C PLib Transfer Status function */
+    .errorGet = (DRV_I2C_PLIB_ERROR_GET)I2C_BB0_ErrorGet,
+
+    /* I2C PLib Transfer Setup function */
+    .transferSetup = (DRV_I2C_PLIB_TRANSFER_SETUP)I2C_BB0_TransferSetup,
+
+    /* I2C PLib Callback Register */
+    .callbackRegister = (DRV_I2C_PLIB_CALLBACK_REGISTER)I2C_BB0_CallbackRegister,
+
+    /* No staging support, the driver starts queued transfers from the callback */
+    .nextTransferSet = NULL,
+};
+
+
+const DRV_I2C_INTERRUPT_SOURCES drvI2C2InterruptSources =
+{
+    /* Peripheral has single interrupt vector */
+    .isSingleIntSrc                        = true,
+
+    /* Peripheral interrupt line, shared by all bit-banged lanes */
+    .intSources.i2cInterrupt             = TC0_IRQn,
+};
+
+/* I2C Driver Initialization Data */
+const DRV_I2C_INIT drvI2C2InitData =
+{
+    /* I2C PLib API */
+    .i2cPlib = &drvI2C2PLibAPI,
+
+    /* I2C Number of clients */
+    .numClients = DRV_I2C_CLIENTS_NUMBER_IDX2,
+
+    /* I2C Client Objects Pool */
+    .clientObjPool = (uintptr_t)&drvI2C2ClientObjPool[0],
+
+    /* I2C TWI Queue Size */
+    .transferObjPoolSize = DRV_I2C_QUEUE_SIZE_IDX2,
+
+    /* I2C Transfer Objects */
+    .transferObjPool = (uintptr_t)&drvI2C2TransferObj[0],
+
+    /* I2C interrupt sources */
+    .interruptSources = &drvI2C2InterruptSources,
+
+    /* I2C Clock Speed */
+    .clockSpeed = DRV_I2C_CLOCK_SPEED_IDX2,
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="DRV_I2C Instance 3 Initialization Data">
+
+/* I2C Client Objects Pool */
+static DRV_I2C_CLIENT_OBJ drvI2C3ClientObjPool[DRV_I2C_CLIENTS_NUMBER_IDX3];
+
+/* I2C Transfer Objects Pool */
+static DRV_I2C_TRANSFER_OBJ drvI2C3TransferObj[DRV_I2C_QUEUE_SIZE_IDX3];
+
+/* I2C PLib Interface Initialization */
+const DRV_I2C_PLIB_INTERFACE drvI2C3PLibAPI = {
+
+    /* I2C PLib Transfer Read Add function */
+    .read = (DRV_I2C_PLIB_READ)I2C_BB1_Read,
+
+    /* I2C PLib Transfer Write Add function */
+    .write = (DRV_I2C_PLIB_WRITE)I2C_BB1_Write,
+
+
+    /* I2C PLib Transfer Write Read Add function */
+    .writeRead = (DRV_I2C_PLIB_WRITE_READ)I2C_BB1_WriteRead,
+
+    /*I2C PLib Transfer Abort function */
+    .transferAbort = (DRV_I2C_PLIB_TRANSFER_ABORT)I2C_BB1_TransferAbort,
+
+    /* I2C PLib Transfer Status function */
+    .errorGet = (DRV_I2C_PLIB_ERROR_GET)I2C_BB1_ErrorGet,
+
+    /* I2C PLib Transfer Setup function */
+    .transferSetup = (DRV_I2C_PLIB_TRANSFER_SETUP)I2C_BB1_TransferSetup,
+
+    /* I2C PLib Callback Register */
+    .callbackRegister = (DRV_I2C_PLIB_CALLBACK_REGISTER)I2C_BB1_CallbackRegister,
+
+    /* No staging support, the driver starts queued transfers from the callback */
+    .nextTransferSet = NULL,
+};
+
+
+const DRV_I2C_INTERRUPT_SOURCES drvI2C3InterruptSources =
+{
+    /* Peripheral has single interrupt vector */
+    .isSingleIntSrc                        = true,
+
+    /* Peripheral interrupt line, shared by all bit-banged lanes */
+    .intSources.i2cInterrupt             = TC0_IRQn,
+};
+
+/* I2C Driver Initialization Data */
+const DRV_I2C_INIT drvI2C3InitData =
+{
+    /* I2C PLib API */
+    .i2cPlib = &drvI2C3PLibAPI,
+
+    /* I2C Number of clients */
+    .numClients = DRV_I2C_CLIENTS_NUMBER_IDX3,
+
+    /* I2C Client Objects Pool */
+    .clientObjPool = (uintptr_t)&drvI2C3ClientObjPool[0],
+
+    /* I2C TWI Queue Size */
+    .transferObjPoolSize = DRV_I2C_QUEUE_SIZE_IDX3,
+
+    /* I2C Transfer Objects */
+    .transferObjPool = (uintptr_t)&drvI2C3TransferObj[0],
+
+    /* I2C interrupt sources */
+    .interruptSources = &drvI2C3InterruptSources,
+
+    /* I2C Clock Speed */
+    .clockSpeed = DRV_I2C_CLOCK_SPEED_IDX3,
+};
+
+// </editor-fold>
+
+#endif
+
 
 
 // *****************************************************************************
@@ -171,6 +403,149 @@ SYSTEM_OBJECTS sysObj;
 // *****************************************************************************
 // *****************************************************************************
 
+// <editor-fold defaultstate="collapsed" desc="SYS_CMD Initialization Data">
+
+/* Console text with the host request frames taken out, replies through the
+ * SERCOM3 ring buffer */
+const SYS_CMD_API sysCmdAPI =
+{
+    .read = (SYS_CMD_READ)APP_RPC_ConsoleRead,
+
+    .write = (SYS_CMD_WRITE)SERCOM3_USART_Write,
+
+    .writeFreeBufferCountGet = (SYS_CMD_WRITE_FREE_GET)SERCOM3_USART_WriteFreeBufferCountGet,
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="SYS_TMR Initialization Data">
+
+const SYS_TMR_INIT sysTmrInit =
+{
+    /* SysTick 1 ms interrupt count */
+    .tickGet = SYSTICK_GetTickCounter,
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="SYS_POWER Initialization Data">
+
+/* Modules with transfers that standby would stall; idle mode is entered
+ * instead while any of them is active */
+static const SYS_POWER_ACTIVE_GET sysPowerActive[] =
+{
+    APP_IsActive,
+    APP_EXPANDER_IsActive,
+    APP_RPC_IsActive,
+    APP_BAUD_IsActive,
+    SYS_KVS_IsBusy,
+#if defined(I2C_BB_ENABLE)
+    I2C_BB_IsActive,
+#endif
+};
+
+/* Modules clocked from generator 0, set up again when a level change moves
+ * it between 48 and 16 MHz: the console checks its rate can be kept and the
+ * bit-banged lanes that their timer tick is not too short, the I2C masters
+ * work from either */
+static const SYS_POWER_CLOCK_CLIENT sysPowerClockClients[] =
+{
+    { APP_BAUD_ClockIsSupported,    APP_BAUD_ClockChange },
+    { NULL,                         DRV_I2C_ClockChange },
+#if defined(I2C_BB_ENABLE)
+    { I2C_BB_ClockIsSupported,      I2C_BB_ClockChange },
+#endif
+};
+
+const SYS_POWER_INIT sysPowerInit =
+{
+    .activeGet = sysPowerActive,
+
+    .activeNumber = sizeof(sysPowerActive) / sizeof(sysPowerActive[0]),
+
+    .clockClients = sysPowerClockClients,
+
+    .clockClientsNumber = sizeof(sysPowerClockClients) / sizeof(sysPowerClockClients[0]),
+};
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="SYS_PROF Initialization Data">
+
+#if defined(SYS_PROF_ENABLE)
+
+/* By SYS_PROF_ID_ value */
+static const char* const sysProfNames[SYS_PROF_REGIONS_NUMBER] =
+{
+    "i2c submit",
+    "sercom5 isr",
+    "app",
+    "stdio write",
+    "log write",
+};
+
+/* By SYS_PROF_BOOT_ID_ value */
+static const char* const sysProfBootNames[SYS_PROF_BOOT_PHASES_NUMBER] =
+{
+    "clock",
+    "expander i2c",
+    "config queued",
+    "peripherals",
+    "services",
+    "init done",
+    "outputs",
+    "configured",
+};
+
+const SYS_PROF_INIT sysProfInit =
+{
+    .names = sysProfNames,
+
+    .bootNames = sysProfBootNames,
+};
+
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="SYS_SCHED Initialization Data">
+
+/* Times in microseconds.  The background tasks poll the console and the I2C
+ * transfers and run on every pass; the budgets are what each is expected to
+ * take at most, so the "sched" command shows which one holds up the rest.
+ * The idle column tells the scheduler when it may sleep: every task has
+ * one, so a periodic task with nothing to do does not wake it up. */
+static const SYS_SCHED_TASK sysSchedTasks[] =
+{
+    /* name         task                    period  phase   deadline budget  idle */
+    { "log",        SYS_LOG_Tasks,          0U,     0U,     0U,     200U,   SYS_LOG_IdleUsGet },
+    { "rpc",        APP_RPC_Tasks,          0U,     0U,     0U,     300U,   APP_RPC_IdleUsGet },
+    { "expander",   APP_EXPANDER_Tasks,     0U,     0U,     0U,     100U,   APP_EXPANDER_IdleUsGet },
+    { "telemetry",  APP_TELEMETRY_Tasks,    0U,     0U,     0U,     300U,   APP_TELEMETRY_IdleUsGet },
+    { "shell",      APP_SHELL_Tasks,        0U,     0U,     0U,     50U,    APP_SHELL_IdleUsGet },
+    { "tmr",        SYS_TMR_Tasks,          1000U,  0U,     1000U,  100U,   SYS_TMR_IdleUsGet },
+    { "baud",       APP_BAUD_Tasks,         1000U,  0U,     500U,   50U,    APP_BAUD_IdleUsGet },
+    { "cmd",        SYS_CMD_Tasks,          2000U,  250U,   2000U,  1000U,  SYS_CMD_IdleUsGet },
+    { "app",        APP_Tasks,              10000U, 500U,   5000U,  200U,   APP_IdleUsGet },
+    { "kvs",        SYS_KVS_Tasks,          0U,     0U,     0U,     100U,   SYS_KVS_IdleUsGet },
+    { "power",      SYS_POWER_Tasks,        0U,     0U,     0U,     300U,   SYS_POWER_IdleUsGet },
+};
+
+const SYS_SCHED_INIT sysSchedInit =
+{
+    .tasks = sysSchedTasks,
+
+    .tasksNumber = sizeof(sysSchedTasks) / sizeof(sysSchedTasks[0]),
+
+    /* SysTick, started in SYS_Initialize */
+    .timeGet = SYSTICK_TimestampUs32Get,
+
+    /* Standby or idle mode, SysTick is moved on by the time in standby */
+    .sleep = SYS_POWER_Sleep,
+};
+
+// </editor-fold>
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -225,7 +600,7 @@ void SYS_Initialize ( void* data )
     PM_Initialize();
 
 
-    NVMCTRL_REGS->NVMCTRL_CTRLB = NVMCTRL_CTRLB_RWS(2);
+    NVMCTRL_REGS->NVMCTRL_CTRLB = NVMCTRL_CTRLB_RWS(SYS_POWER_HIGH_RWS);
 
     STDIO_BufferModeSet();
 
@@ -235,28 +610,91 @@ void SYS_Initialize ( void* data )
 
     CLOCK_Initialize();
 
+    /* The boot trace counts from here, with the 48 MHz clock up */
+	SYSTICK_TimerInitialize();
+    SYSTICK_TimerStart();
+#if defined(SYS_PROF_ENABLE)
+    SYS_PROF_Initialize(&sysProfInit);
+#endif
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_CLOCK);
+
+    /* Fast boot: the expander lane comes up first, with the interrupts, and
+     * APP_Initialize puts its configuration on the bus; it goes out while
+     * the rest initializes.  The other interrupt sources stay quiet until
+     * their peripherals enable them. */
+    SERCOM5_I2C_Initialize();
+
+    /* Initialize I2C0 Driver Instance */
+    sysObj.drvI2C0 = DRV_I2C_Initialize(DRV_I2C_INDEX_0, (SYS_MODULE_INIT *)&drvI2C0InitData);
 
+    /* APP_Initialize starts the walk timer */
+    SYS_TMR_Initialize(&sysTmrInit);
+
+    NVIC_Initialize();
+
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_EXPANDER_I2C);
+
+    APP_Initialize();
+
+    DMAC_Initialize();
 
     SERCOM3_USART_Initialize();
 
     NVMCTRL_Initialize();
 
+    DSU_Initialize();
+
     EVSYS_Initialize();
 
 	BSP_Initialize();
-	SYSTICK_TimerInitialize();
-    SERCOM5_I2C_Initialize();
+    SERCOM1_I2C_Initialize();
 
+    SERCOM2_I2C_Initialize();
 
-    /* Initialize I2C0 Driver Instance */
-    sysObj.drvI2C0 = DRV_I2C_Initialize(DRV_I2C_INDEX_0, (SYS_MODULE_INIT *)&drvI2C0InitData);
+    RTC_Initialize();
 
+#if defined(I2C_BB_ENABLE)
+    TC0_TimerInitialize();
 
+    I2C_BB_Initialize();
+#endif
 
-    APP_Initialize();
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_PERIPHERALS);
 
+    SYS_LOG_Initialize();
 
-    NVIC_Initialize();
+    (void) SYS_CMD_Initialize(&sysCmdAPI);
+
+    SYS_POWER_Initialize(&sysPowerInit);
+
+    /* Reads the data flash, the erases and writes are left to its task;
+     * the store refuses every call if it fails */
+    (void) SYS_KVS_Initialize();
+
+
+    /* Initialize I2C1 Driver Instance */
+    sysObj.drvI2C1 = DRV_I2C_Initialize(DRV_I2C_INDEX_1, (SYS_MODULE_INIT *)&drvI2C1InitData);
+
+#if defined(I2C_BB_ENABLE)
+    /* Initialize I2C2 Driver Instance */
+    sysObj.drvI2C2 = DRV_I2C_Initialize(DRV_I2C_INDEX_2, (SYS_MODULE_INIT *)&drvI2C2InitData);
+
+    /* Initialize I2C3 Driver Instance */
+    sysObj.drvI2C3 = DRV_I2C_Initialize(DRV_I2C_INDEX_3, (SYS_MODULE_INIT *)&drvI2C3InitData);
+#endif
+
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_SERVICES);
+
+    APP_TARGET_Initialize();
+    APP_EXPANDER_Initialize();
+    APP_TELEMETRY_Initialize();
+    APP_SHELL_Initialize();
+    APP_RPC_Initialize();
+    APP_BAUD_Initialize();
+
+    (void) SYS_SCHED_Initialize(&sysSchedInit);
+
+    SYS_PROF_BOOT_MARK(SYS_PROF_BOOT_ID_INIT_DONE);
 
     /* MISRAC 2012 deviation block end */
 }
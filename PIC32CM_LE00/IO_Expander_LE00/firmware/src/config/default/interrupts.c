@@ -85,7 +85,6 @@ extern void SVCall_Handler             ( void ) __attribute__((weak, alias("Dumm
 extern void PendSV_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SYSTEM_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void WDT_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void RTC_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EIC_EXTINT_0_Handler       ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EIC_EXTINT_1_Handler       ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EIC_EXTINT_2_Handler       ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -96,12 +95,6 @@ extern void EIC_EXTINT_6_Handler       ( void ) __attribute__((weak, alias("Dumm
 extern void EIC_EXTINT_7_Handler       ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EIC_OTHER_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void FREQM_Handler              ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void NVMCTRL_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_0_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_1_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_2_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_3_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_OTHER_Handler         ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void USB_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EVSYS_0_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EVSYS_1_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -116,23 +109,10 @@ extern void SERCOM0_0_Handler          ( void ) __attribute__((weak, alias("Dumm
 extern void SERCOM0_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM0_2_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM0_OTHER_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM1_0_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM1_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM1_2_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM1_OTHER_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM2_0_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM2_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM2_2_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM2_OTHER_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM3_0_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM3_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM3_2_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SERCOM3_OTHER_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM4_0_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM4_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM4_2_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM4_OTHER_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void TC0_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TC1_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TC2_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TCC0_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -170,7 +150,7 @@ const H3DeviceVectors exception_table=
     .pfnSysTick_Handler            = SysTick_Handler,
     .pfnSYSTEM_Handler             = SYSTEM_Handler,
     .pfnWDT_Handler                = WDT_Handler,
-    .pfnRTC_Handler                = RTC_Handler,
+    .pfnRTC_Handler                = RTC_InterruptHandler,
     .pfnEIC_EXTINT_0_Handler       = EIC_EXTINT_0_Handler,
     .pfnEIC_EXTINT_1_Handler       = EIC_EXTINT_1_Handler,
     .pfnEIC_EXTINT_2_Handler       = EIC_EXTINT_2_Handler,
@@ -181,12 +161,12 @@ const H3DeviceVectors exception_table=
     .pfnEIC_EXTINT_7_Handler       = EIC_EXTINT_7_Handler,
     .pfnEIC_OTHER_Handler          = EIC_OTHER_Handler,
     .pfnFREQM_Handler              = FREQM_Handler,
-    .pfnNVMCTRL_Handler            = NVMCTRL_Handler,
-    .pfnDMAC_0_Handler             = DMAC_0_Handler,
-    .pfnDMAC_1_Handler             = DMAC_1_Handler,
-    .pfnDMAC_2_Handler             = DMAC_2_Handler,
-    .pfnDMAC_3_Handler             = DMAC_3_Handler,
-    .pfnDMAC_OTHER_Handler         = DMAC_OTHER_Handler,
+    .pfnNVMCTRL_Handler            = NVMCTRL_InterruptHandler,
+    .pfnDMAC_0_Handler             = DMAC_InterruptHandler,
+    .pfnDMAC_1_Handler             = DMAC_InterruptHandler,
+    .pfnDMAC_2_Handler             = DMAC_InterruptHandler,
+    .pfnDMAC_3_Handler             = DMAC_InterruptHandler,
+    .pfnDMAC_OTHER_Handler         = DMAC_InterruptHandler,
     .pfnUSB_Handler                = USB_Handler,
     .pfnEVSYS_0_Handler            = EVSYS_0_Handler,
     .pfnEVSYS_1_Handler            = EVSYS_1_Handler,
@@ -201,18 +181,18 @@ const H3DeviceVectors exception_table=
     .pfnSERCOM0_1_Handler          = SERCOM0_1_Handler,
     .pfnSERCOM0_2_Handler          = SERCOM0_2_Handler,
     .pfnSERCOM0_OTHER_Handler      = SERCOM0_OTHER_Handler,
-    .pfnSERCOM1_0_Handler          = SERCOM1_0_Handler,
-    .pfnSERCOM1_1_Handler          = SERCOM1_1_Handler,
-    .pfnSERCOM1_2_Handler          = SERCOM1_2_Handler,
-    .pfnSERCOM1_OTHER_Handler      = SERCOM1_OTHER_Handler,
-    .pfnSERCOM2_0_Handler          = SERCOM2_0_Handler,
-    .pfnSERCOM2_1_Handler          = SERCOM2_1_Handler,
-    .pfnSERCOM2_2_Handler          = SERCOM2_2_Handler,
-    .pfnSERCOM2_OTHER_Handler      = SERCOM2_OTHER_Handler,
-    .pfnSERCOM3_0_Handler          = SERCOM3_0_Handler,
-    .pfnSERCOM3_1_Handler          = SERCOM3_1_Handler,
-    .pfnSERCOM3_2_Handler          = SERCOM3_2_Handler,
-    .pfnSERCOM3_OTHER_Handler      = SERCOM3_OTHER_Handler,
+    .pfnSERCOM1_0_Handler          = SERCOM1_I2C_InterruptHandler,
+    .pfnSERCOM1_1_Handler          = SERCOM1_I2C_InterruptHandler,
+    .pfnSERCOM1_2_Handler          = SERCOM1_I2C_InterruptHandler,
+    .pfnSERCOM1_OTHER_Handler      = SERCOM1_I2C_InterruptHandler,
+    .pfnSERCOM2_0_Handler          = SERCOM2_I2C_InterruptHandler,
+    .pfnSERCOM2_1_Handler          = SERCOM2_I2C_InterruptHandler,
+    .pfnSERCOM2_2_Handler          = SERCOM2_I2C_InterruptHandler,
+    .pfnSERCOM2_OTHER_Handler      = SERCOM2_I2C_InterruptHandler,
+    .pfnSERCOM3_0_Handler          = SERCOM3_USART_InterruptHandler,
+    .pfnSERCOM3_1_Handler          = SERCOM3_USART_InterruptHandler,
+    .pfnSERCOM3_2_Handler          = SERCOM3_USART_InterruptHandler,
+    .pfnSERCOM3_OTHER_Handler      = SERCOM3_USART_InterruptHandler,
     .pfnSERCOM4_0_Handler          = SERCOM4_0_Handler,
     .pfnSERCOM4_1_Handler          = SERCOM4_1_Handler,
     .pfnSERCOM4_2_Handler          = SERCOM4_2_Handler,
@@ -221,7 +201,7 @@ const H3DeviceVectors exception_table=
     .pfnSERCOM5_1_Handler          = SERCOM5_I2C_InterruptHandler,
     .pfnSERCOM5_2_Handler          = SERCOM5_I2C_InterruptHandler,
     .pfnSERCOM5_OTHER_Handler      = SERCOM5_I2C_InterruptHandler,
-    .pfnTC0_Handler                = TC0_Handler,
+    .pfnTC0_Handler                = TC0_TimerInterruptHandler,
     .pfnTC1_Handler                = TC1_Handler,
     .pfnTC2_Handler                = TC2_Handler,
     .pfnTCC0_Handler               = TCC0_Handler,
@@ -61,7 +61,14 @@ void Reset_Handler (void);
 void NonMaskableInt_Handler (void);
 void HardFault_Handler (void);
 void SysTick_Handler (void);
+void RTC_InterruptHandler (void);
+void NVMCTRL_InterruptHandler (void);
+void DMAC_InterruptHandler (void);
+void SERCOM1_I2C_InterruptHandler (void);
+void SERCOM2_I2C_InterruptHandler (void);
+void SERCOM3_USART_InterruptHandler (void);
 void SERCOM5_I2C_InterruptHandler (void);
+void TC0_TimerInterruptHandler (void);
 
 
 
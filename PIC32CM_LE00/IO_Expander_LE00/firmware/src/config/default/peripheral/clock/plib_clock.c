@@ -48,12 +48,14 @@
 static void OSCCTRL_Initialize(void)
 {
     /**************** OSC16M IniTialization *************/
-    OSCCTRL_REGS->OSCCTRL_OSC16MCTRL = OSCCTRL_OSC16MCTRL_FSEL(0x0U) | OSCCTRL_OSC16MCTRL_ENABLE_Msk;
+    /* 16 MHz, the generator 0 source at the low performance level */
+    OSCCTRL_REGS->OSCCTRL_OSC16MCTRL = OSCCTRL_OSC16MCTRL_FSEL(0x3U) | OSCCTRL_OSC16MCTRL_ENABLE_Msk;
 }
 
 static void OSC32KCTRL_Initialize(void)
 {
-    OSC32KCTRL_REGS->OSC32KCTRL_RTCCTRL = OSC32KCTRL_RTCCTRL_RTCSEL(0U);
+    /* RTC from the 32.768 kHz OSCULP32K output, it keeps counting in standby */
+    OSC32KCTRL_REGS->OSC32KCTRL_RTCCTRL = OSC32KCTRL_RTCCTRL_RTCSEL(1U);
 }
 
 static void DFLL48M_Initialize(void)
@@ -113,6 +115,20 @@ void CLOCK_Initialize (void)
 
 
 
+    /* Selection of the Generator and write Lock for SERCOM1_CORE */
+    GCLK_REGS->GCLK_PCHCTRL[18] = GCLK_PCHCTRL_GEN(0x0)  | GCLK_PCHCTRL_CHEN_Msk;
+
+    while ((GCLK_REGS->GCLK_PCHCTRL[18] & GCLK_PCHCTRL_CHEN_Msk) != GCLK_PCHCTRL_CHEN_Msk)
+    {
+        /* Wait for synchronization */
+    }
+    /* Selection of the Generator and write Lock for SERCOM2_CORE */
+    GCLK_REGS->GCLK_PCHCTRL[19] = GCLK_PCHCTRL_GEN(0x0)  | GCLK_PCHCTRL_CHEN_Msk;
+
+    while ((GCLK_REGS->GCLK_PCHCTRL[19] & GCLK_PCHCTRL_CHEN_Msk) != GCLK_PCHCTRL_CHEN_Msk)
+    {
+        /* Wait for synchronization */
+    }
     /* Selection of the Generator and write Lock for SERCOM3_CORE */
     GCLK_REGS->GCLK_PCHCTRL[20] = GCLK_PCHCTRL_GEN(0x0)  | GCLK_PCHCTRL_CHEN_Msk;
 
@@ -127,9 +143,52 @@ void CLOCK_Initialize (void)
     {
         /* Wait for synchronization */
     }
+    /* Selection of the Generator and write Lock for TC0 TC1 */
+    GCLK_REGS->GCLK_PCHCTRL[23] = GCLK_PCHCTRL_GEN(0x0)  | GCLK_PCHCTRL_CHEN_Msk;
+
+    while ((GCLK_REGS->GCLK_PCHCTRL[23] & GCLK_PCHCTRL_CHEN_Msk) != GCLK_PCHCTRL_CHEN_Msk)
+    {
+        /* Wait for synchronization */
+    }
+
+
+}
+
+void CLOCK_DFLL48MEnable (bool enable)
+{
+    /* The open loop value loaded by DFLL48M_Initialize is kept */
+    OSCCTRL_REGS->OSCCTRL_DFLLCTRL = (enable == true) ? OSCCTRL_DFLLCTRL_ENABLE_Msk : 0U;
+
+    while((OSCCTRL_REGS->OSCCTRL_STATUS & OSCCTRL_STATUS_DFLLRDY_Msk) != OSCCTRL_STATUS_DFLLRDY_Msk)
+    {
+        /* Waiting for the Ready state */
+    }
+}
+
+void CLOCK_Gclk0SourceSet (CLOCK_GCLK0_SOURCE source)
+{
+    uint32_t src = (source == CLOCK_GCLK0_SOURCE_DFLL48M) ? GCLK_GENCTRL_SRC_DFLL48M_Val : GCLK_GENCTRL_SRC_OSC16M_Val;
 
+    GCLK_REGS->GCLK_GENCTRL[0] = GCLK_GENCTRL_DIV(1U) | GCLK_GENCTRL_SRC(src) | GCLK_GENCTRL_GENEN_Msk;
 
+    while((GCLK_REGS->GCLK_SYNCBUSY & GCLK_SYNCBUSY_GENCTRL0_Msk) == GCLK_SYNCBUSY_GENCTRL0_Msk)
+    {
+        /* wait for the Generator 0 synchronization */
+    }
 }
 
+uint32_t CLOCK_Gclk0FrequencyGet (void)
+{
+    uint32_t fsel;
+
+    if ((GCLK_REGS->GCLK_GENCTRL[0] & GCLK_GENCTRL_SRC_Msk) == GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_OSC16M_Val))
+    {
+        /* 4, 8, 12 or 16 MHz */
+        fsel = ((uint32_t)OSCCTRL_REGS->OSCCTRL_OSC16MCTRL & OSCCTRL_OSC16MCTRL_FSEL_Msk) >> OSCCTRL_OSC16MCTRL_FSEL_Pos;
 
+        return (fsel + 1U) * 4000000U;
+    }
 
+    /* DIV is 1 */
+    return 48000000U;
+}
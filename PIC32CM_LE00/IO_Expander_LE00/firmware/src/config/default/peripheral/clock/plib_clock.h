@@ -50,6 +50,7 @@
 /* This section lists the other files that are included in this file.
 */
 #include <stdint.h>
+#include <stdbool.h>
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
@@ -58,6 +59,27 @@ extern "C" {
 
 void CLOCK_Initialize (void);
 
+/* Generator 0 clocks the CPU, SysTick, the SERCOMs and TC0 */
+typedef enum
+{
+    CLOCK_GCLK0_SOURCE_DFLL48M = 0,
+
+    /* At the frequency CLOCK_Initialize selected */
+    CLOCK_GCLK0_SOURCE_OSC16M,
+
+} CLOCK_GCLK0_SOURCE;
+
+/* The DFLL48M needs performance level 2; disable it only once generator 0
+ * has moved off it */
+void CLOCK_DFLL48MEnable (bool enable);
+
+/* Switches generator 0 without a glitch; the caller sees to the
+ * performance level, the flash wait states and the peripheral rates */
+void CLOCK_Gclk0SourceSet (CLOCK_GCLK0_SOURCE source);
+
+/* Generator 0 frequency in Hz, read back from its source */
+uint32_t CLOCK_Gclk0FrequencyGet (void);
+
 
 
 
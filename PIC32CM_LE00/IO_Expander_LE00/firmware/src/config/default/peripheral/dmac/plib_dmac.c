@@ -0,0 +1,287 @@
+/*******************************************************************************
+  Direct Memory Access Controller (DMAC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dmac.c
+
+  Summary
+    DMAC PLIB Implementation File.
+
+  Description
+    This file defines the interface to the DMAC peripheral library. This
+    library provides access to and control of the DMAC channels used by the
+    application, with descriptors kept in SRAM.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "interrupts.h"
+#include "plib_dmac.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* First descriptor of each channel, the DMAC fetches it from BASEADDR */
+static dmac_descriptor_registers_t descriptor_section[DMAC_CHANNELS_NUMBER] __ALIGNED(8);
+
+/* Descriptor state saved by the DMAC when a channel is suspended or stopped */
+static dmac_descriptor_registers_t write_back_section[DMAC_CHANNELS_NUMBER] __ALIGNED(8);
+
+static DMAC_CH_OBJECT dmacChannelObj[DMAC_CHANNELS_NUMBER];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC PLib Interface Implementations
+// *****************************************************************************
+// *****************************************************************************
+
+void DMAC_Initialize( void )
+{
+    uint32_t channel;
+
+    /* Disable the DMAC module */
+    DMAC_REGS->DMAC_CTRL &= (uint16_t)(~DMAC_CTRL_DMAENABLE_Msk);
+
+    /* Reset the DMAC module */
+    DMAC_REGS->DMAC_CTRL = (uint16_t)DMAC_CTRL_SWRST_Msk;
+
+    while((DMAC_REGS->DMAC_CTRL & DMAC_CTRL_SWRST_Msk) != 0U)
+    {
+        /* Wait for the reset to complete */
+    }
+
+    (void)memset(descriptor_section, 0, sizeof(descriptor_section));
+    (void)memset(write_back_section, 0, sizeof(write_back_section));
+
+    for (channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        dmacChannelObj[channel].callback = NULL;
+        dmacChannelObj[channel].context = 0U;
+        dmacChannelObj[channel].busyStatus = false;
+    }
+
+    /* Update the Base address and Write Back address register */
+    DMAC_REGS->DMAC_BASEADDR = (uint32_t)descriptor_section;
+    DMAC_REGS->DMAC_WRBADDR  = (uint32_t)write_back_section;
+
+    /* Update the Priority Control register */
+    DMAC_REGS->DMAC_PRICTRL0 = DMAC_PRICTRL0_LVLPRI0(0UL) | DMAC_PRICTRL0_RRLVLEN0_Msk;
+
+    /***************** Configure DMA channel 0 ********************/
+
+    DMAC_REGS->DMAC_CHID = 0U;
+
+    /* Beat per SERCOM3 TX trigger (DRE), priority level 0 */
+    DMAC_REGS->DMAC_CHCTRLB = DMAC_CHCTRLB_TRIGACT_BEAT | DMAC_CHCTRLB_TRIGSRC(SERCOM3_DMAC_ID_TX) | DMAC_CHCTRLB_LVL(0UL);
+
+    /* Byte beats from memory to the peripheral, interrupt at the end of the block */
+    descriptor_section[0].DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+
+    DMAC_REGS->DMAC_CHINTENSET = (uint8_t)(DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
+    /* Enable the DMAC module & Priority Level 0 */
+    DMAC_REGS->DMAC_CTRL = (uint16_t)(DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk);
+}
+
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK eventHandler, const uintptr_t contextHandle )
+{
+    dmacChannelObj[channel].callback = eventHandler;
+
+    dmacChannelObj[channel].context  = contextHandle;
+}
+
+/* Moves blockSize bytes (in units of the configured beat size) with the
+ * channel's default descriptor. srcAddr/destAddr are start addresses. */
+bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    uint8_t beatSize;
+    uint32_t beatCount;
+    uint16_t btctrl;
+    bool returnStatus = false;
+
+    if ((dmacChannelObj[channel].busyStatus == false) && (blockSize > 0U))
+    {
+        btctrl = descriptor_section[channel].DMAC_BTCTRL;
+
+        beatSize = (uint8_t)((btctrl & DMAC_BTCTRL_BEATSIZE_Msk) >> DMAC_BTCTRL_BEATSIZE_Pos);
+
+        beatCount = (uint32_t)blockSize >> beatSize;
+
+        if ((beatCount > 0U) && (beatCount <= 0xFFFFU))
+        {
+            dmacChannelObj[channel].busyStatus = true;
+
+            /* An incrementing address is given as the end of the block */
+            if ((btctrl & DMAC_BTCTRL_SRCINC_Msk) != 0U)
+            {
+                descriptor_section[channel].DMAC_SRCADDR = (uint32_t)srcAddr + (uint32_t)blockSize;
+            }
+            else
+            {
+                descriptor_section[channel].DMAC_SRCADDR = (uint32_t)srcAddr;
+            }
+
+            if ((btctrl & DMAC_BTCTRL_DSTINC_Msk) != 0U)
+            {
+                descriptor_section[channel].DMAC_DSTADDR = (uint32_t)destAddr + (uint32_t)blockSize;
+            }
+            else
+            {
+                descriptor_section[channel].DMAC_DSTADDR = (uint32_t)destAddr;
+            }
+
+            descriptor_section[channel].DMAC_BTCNT = (uint16_t)beatCount;
+
+            descriptor_section[channel].DMAC_DESCADDR = 0U;
+
+            DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+            DMAC_REGS->DMAC_CHCTRLA |= (uint8_t)DMAC_CHCTRLA_ENABLE_Msk;
+
+            returnStatus = true;
+        }
+    }
+
+    return returnStatus;
+}
+
+/* Starts a transfer from a caller-built descriptor chain. The first
+ * descriptor is copied into the descriptor section; the ones it links to via
+ * DESCADDR are fetched in place and must stay valid until completion. */
+bool DMAC_ChannelLinkedListTransfer( DMAC_CHANNEL channel, dmac_descriptor_registers_t * channelDesc )
+{
+    bool returnStatus = false;
+
+    if ((dmacChannelObj[channel].busyStatus == false) && (channelDesc != NULL))
+    {
+        dmacChannelObj[channel].busyStatus = true;
+
+        (void)memcpy(&descriptor_section[channel], channelDesc, sizeof(dmac_descriptor_registers_t));
+
+        DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+        DMAC_REGS->DMAC_CHCTRLA |= (uint8_t)DMAC_CHCTRLA_ENABLE_Msk;
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel )
+{
+    return dmacChannelObj[channel].busyStatus;
+}
+
+void DMAC_ChannelDisable( DMAC_CHANNEL channel )
+{
+    DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+    DMAC_REGS->DMAC_CHCTRLA &= (uint8_t)(~DMAC_CHCTRLA_ENABLE_Msk);
+
+    while((DMAC_REGS->DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U)
+    {
+        /* Wait till the channel is disabled */
+    }
+
+    dmacChannelObj[channel].busyStatus = false;
+}
+
+/* Beats moved so far in a single-descriptor transfer */
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel )
+{
+    return (uint16_t)(descriptor_section[channel].DMAC_BTCNT - write_back_section[channel].DMAC_BTCNT);
+}
+
+/* Serves one channel per call, the lowest numbered one with a pending flag.
+ * Safe to call from thread context with interrupts masked to poll a channel
+ * to completion. */
+void DMAC_InterruptHandler( void )
+{
+    DMAC_CH_OBJECT  *dmacChObj;
+    DMAC_TRANSFER_EVENT event = DMAC_TRANSFER_EVENT_NONE;
+    uint8_t channel;
+    uint8_t channelId;
+    uint8_t chanIntFlagStatus;
+
+    /* Save the channel ID selected by the interrupted code */
+    channelId = DMAC_REGS->DMAC_CHID;
+
+    /* Get the DMAC channel number for this interrupt */
+    channel = (uint8_t)(DMAC_REGS->DMAC_INTPEND & DMAC_INTPEND_ID_Msk);
+
+    if (channel < DMAC_CHANNELS_NUMBER)
+    {
+        dmacChObj = &dmacChannelObj[channel];
+
+        DMAC_REGS->DMAC_CHID = channel;
+
+        chanIntFlagStatus = DMAC_REGS->DMAC_CHINTFLAG & (uint8_t)(DMAC_CHINTFLAG_TERR_Msk | DMAC_CHINTFLAG_TCMPL_Msk);
+
+        if ((chanIntFlagStatus & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+        {
+            /* The channel is disabled by hardware on a transfer error */
+            event = DMAC_TRANSFER_EVENT_ERROR;
+        }
+        else if ((chanIntFlagStatus & DMAC_CHINTFLAG_TCMPL_Msk) != 0U)
+        {
+            event = DMAC_TRANSFER_EVENT_COMPLETE;
+        }
+        else
+        {
+            /* Nothing pending */
+        }
+
+        /* Clear the serviced flags */
+        DMAC_REGS->DMAC_CHINTFLAG = chanIntFlagStatus;
+
+        DMAC_REGS->DMAC_CHID = channelId;
+
+        if (event != DMAC_TRANSFER_EVENT_NONE)
+        {
+            dmacChObj->busyStatus = false;
+
+            if (dmacChObj->callback != NULL)
+            {
+                dmacChObj->callback(event, dmacChObj->context);
+            }
+        }
+    }
+}
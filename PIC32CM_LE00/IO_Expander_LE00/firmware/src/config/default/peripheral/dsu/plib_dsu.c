@@ -0,0 +1,90 @@
+/*******************************************************************************
+  Device Service Unit (DSU) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dsu.c
+
+  Summary
+    DSU PLIB Implementation File.
+
+  Description
+    This file defines the interface to the DSU peripheral library.  Only the
+    CRC32 of a memory range is used, run by the DSU while the CPU waits.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "plib_dsu.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DSU Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void DSU_Initialize( void )
+{
+    /* Clearing an unprotected peripheral is an error, check first */
+    if ((PAC_REGS->PAC_STATUSB & PAC_STATUSB_DSU_Msk) == PAC_STATUSB_DSU_Msk)
+    {
+        PAC_REGS->PAC_WRCTRL = PAC_WRCTRL_PERID(ID_DSU) | PAC_WRCTRL_KEY(PAC_WRCTRL_KEY_CLR_Val);
+    }
+}
+
+bool DSU_CRCCalculate( uint32_t addr, uint32_t length, uint32_t seed, uint32_t* crc )
+{
+    /* DONE and BERR are cleared by writing them */
+    DSU_REGS->DSU_STATUSA = DSU_STATUSA_DONE_Msk | DSU_STATUSA_BERR_Msk;
+
+    DSU_REGS->DSU_DATA = seed;
+    DSU_REGS->DSU_ADDR = addr & DSU_ADDR_ADDR_Msk;
+    DSU_REGS->DSU_LENGTH = length & DSU_LENGTH_LENGTH_Msk;
+    DSU_REGS->DSU_CTRL = DSU_CTRL_CRC_Msk;
+
+    while ((DSU_REGS->DSU_STATUSA & DSU_STATUSA_DONE_Msk) != DSU_STATUSA_DONE_Msk)
+    {
+        /* Wait for the DSU to read the range */
+    }
+
+    if ((DSU_REGS->DSU_STATUSA & DSU_STATUSA_BERR_Msk) == DSU_STATUSA_BERR_Msk)
+    {
+        return false;
+    }
+
+    *crc = DSU_REGS->DSU_DATA;
+
+    return true;
+}
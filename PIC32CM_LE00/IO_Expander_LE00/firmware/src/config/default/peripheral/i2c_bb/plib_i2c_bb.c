@@ -0,0 +1,747 @@
+/*******************************************************************************
+  Bit-Banged I2C Master Peripheral Library Source File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_i2c_bb.c
+
+  Summary
+    Bit-banged I2C master on PORT pins, timed by TC0.
+
+  Description
+    Every SCL bit is split into four TC0 ticks:
+
+      phase 0  SCL low : each lane presents its SDA level
+      phase 1          : SCL released
+      phase 2  SCL high: port sampled once; stretching holds this phase,
+                         otherwise data/ACK bits are latched and START, repeated
+                         START and STOP edges are produced on SDA
+      phase 3          : SCL pulled low, bit and byte counters advanced
+
+    All lanes share the phases, so a lane can begin a transfer while another
+    one is in the middle of a byte and the timer runs only while at least one
+    lane is busy.  Lines are driven through PORT_GroupOutputEnable and released
+    through PORT_GroupInputEnable with the output latch held low.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "plib_i2c_bb.h"
+#include "peripheral/tc/plib_tc0.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    I2C_BB_STATE_IDLE,
+    I2C_BB_STATE_START,
+    I2C_BB_STATE_START_SENT,
+    I2C_BB_STATE_ADDR,
+    I2C_BB_STATE_WRITE,
+    I2C_BB_STATE_READ,
+    I2C_BB_STATE_STOP,
+
+} I2C_BB_STATE;
+
+typedef struct
+{
+    uint32_t                sdaMask;
+
+    volatile I2C_BB_STATE   state;
+
+    uint8_t                 addrByte;
+
+    uint8_t                 shift;
+
+    uint8_t                 bitIndex;
+
+    uint8_t*                writeBuffer;
+
+    uint32_t                writeSize;
+
+    uint32_t                writeCount;
+
+    uint8_t*                readBuffer;
+
+    uint32_t                readSize;
+
+    uint32_t                readCount;
+
+    volatile I2C_BB_ERROR   error;
+
+    I2C_BB_CALLBACK         callback;
+
+    uintptr_t               context;
+
+} I2C_BB_LANE_OBJ;
+
+typedef struct
+{
+    uint32_t                phase;
+
+    uint32_t                stretchTicks;
+
+    volatile bool           isClockRunning;
+
+    uint32_t                clkSpeed;
+
+    /* TC0 clock the period was worked out from */
+    uint32_t                srcClkFreq;
+
+    I2C_BB_LANE_OBJ         lane[I2C_BB_LANES_NUMBER];
+
+} I2C_BB_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static I2C_BB_OBJ i2cBBObj;
+
+static const uint32_t i2cBBSdaMask[I2C_BB_LANES_NUMBER] =
+{
+    I2C_BB_SDA0_MASK,
+    I2C_BB_SDA1_MASK,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void I2C_BB_ClockStop( void )
+{
+    TC0_TimerStop();
+
+    i2cBBObj.isClockRunning = false;
+
+    i2cBBObj.phase = 0U;
+}
+
+/* SCL held low by a target for too long: give up on every busy lane */
+static void I2C_BB_BusFail( void )
+{
+    uint32_t laneIndex;
+    uint32_t doneMask = 0U;
+
+    PORT_GroupInputEnable(I2C_BB_PORT_GROUP, I2C_BB_SCL_MASK);
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_LANE_OBJ* lane = &i2cBBObj.lane[laneIndex];
+
+        if (lane->state != I2C_BB_STATE_IDLE)
+        {
+            PORT_GroupInputEnable(I2C_BB_PORT_GROUP, lane->sdaMask);
+            lane->error = I2C_BB_ERROR_BUS;
+            lane->state = I2C_BB_STATE_IDLE;
+            doneMask |= (1UL << laneIndex);
+        }
+    }
+
+    I2C_BB_ClockStop();
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        if (((doneMask & (1UL << laneIndex)) != 0U) && (i2cBBObj.lane[laneIndex].callback != NULL))
+        {
+            i2cBBObj.lane[laneIndex].callback(i2cBBObj.lane[laneIndex].context);
+        }
+    }
+}
+
+/* Phase 0: present SDA while SCL is low */
+static void I2C_BB_DataSetup( void )
+{
+    uint32_t laneIndex;
+    uint32_t lowMask = 0U;
+    uint32_t releaseMask = 0U;
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_LANE_OBJ* lane = &i2cBBObj.lane[laneIndex];
+
+        switch (lane->state)
+        {
+            case I2C_BB_STATE_START:
+                releaseMask |= lane->sdaMask;
+                break;
+
+            case I2C_BB_STATE_ADDR:
+            case I2C_BB_STATE_WRITE:
+                if ((lane->bitIndex < 8U) && ((lane->shift & 0x80U) == 0U))
+                {
+                    lowMask |= lane->sdaMask;
+                }
+                else
+                {
+                    /* A one, or the ACK slot driven by the target */
+                    releaseMask |= lane->sdaMask;
+                }
+                break;
+
+            case I2C_BB_STATE_READ:
+                if ((lane->bitIndex == 8U) && (lane->readCount < lane->readSize))
+                {
+                    /* ACK every byte but the last one */
+                    lowMask |= lane->sdaMask;
+                }
+                else
+                {
+                    releaseMask |= lane->sdaMask;
+                }
+                break;
+
+            case I2C_BB_STATE_STOP:
+                lowMask |= lane->sdaMask;
+                break;
+
+            default:
+                /* Idle lanes keep SDA released */
+                break;
+        }
+    }
+
+    PORT_GroupOutputEnable(I2C_BB_PORT_GROUP, lowMask);
+    PORT_GroupInputEnable(I2C_BB_PORT_GROUP, releaseMask);
+}
+
+/* Phase 2: SCL is high, latch bits and produce START/STOP edges */
+static void I2C_BB_DataSample( uint32_t port )
+{
+    uint32_t laneIndex;
+    uint32_t lowMask = 0U;
+    uint32_t releaseMask = 0U;
+    uint32_t doneMask = 0U;
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_LANE_OBJ* lane = &i2cBBObj.lane[laneIndex];
+        bool isHigh = ((port & lane->sdaMask) != 0U);
+
+        switch (lane->state)
+        {
+            case I2C_BB_STATE_START:
+                lowMask |= lane->sdaMask;
+                lane->state = I2C_BB_STATE_START_SENT;
+                break;
+
+            case I2C_BB_STATE_ADDR:
+            case I2C_BB_STATE_WRITE:
+                if (lane->bitIndex == 8U)
+                {
+                    if (isHigh == true)
+                    {
+                        lane->error = I2C_BB_ERROR_NAK;
+                    }
+                }
+                else if (((lane->shift & 0x80U) != 0U) && (isHigh == false))
+                {
+                    lane->error = I2C_BB_ERROR_BUS;
+                }
+                else
+                {
+                    /* Bit went out as presented */
+                }
+                break;
+
+            case I2C_BB_STATE_READ:
+                if (lane->bitIndex < 8U)
+                {
+                    lane->shift = (uint8_t)((uint32_t)lane->shift << 1U) | (isHigh ? 1U : 0U);
+                }
+                break;
+
+            case I2C_BB_STATE_STOP:
+                releaseMask |= lane->sdaMask;
+                lane->state = I2C_BB_STATE_IDLE;
+                doneMask |= (1UL << laneIndex);
+                break;
+
+            default:
+                /* Nothing to do for idle lanes */
+                break;
+        }
+    }
+
+    PORT_GroupOutputEnable(I2C_BB_PORT_GROUP, lowMask);
+    PORT_GroupInputEnable(I2C_BB_PORT_GROUP, releaseMask);
+
+    /* Callbacks may queue the next transfer on the same lane */
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        if (((doneMask & (1UL << laneIndex)) != 0U) && (i2cBBObj.lane[laneIndex].callback != NULL))
+        {
+            i2cBBObj.lane[laneIndex].callback(i2cBBObj.lane[laneIndex].context);
+        }
+    }
+}
+
+/* Pick what follows a completed byte */
+static void I2C_BB_ByteComplete( I2C_BB_LANE_OBJ* lane )
+{
+    lane->bitIndex = 0U;
+
+    if ((lane->state == I2C_BB_STATE_ADDR) && ((lane->addrByte & 0x01U) != 0U))
+    {
+        lane->state = I2C_BB_STATE_READ;
+    }
+    else if (lane->state == I2C_BB_STATE_READ)
+    {
+        if (lane->readCount >= lane->readSize)
+        {
+            lane->state = I2C_BB_STATE_STOP;
+        }
+    }
+    else if (lane->writeCount < lane->writeSize)
+    {
+        lane->state = I2C_BB_STATE_WRITE;
+        lane->shift = lane->writeBuffer[lane->writeCount];
+        lane->writeCount++;
+    }
+    else if (lane->readSize > 0U)
+    {
+        /* Repeated START with the read address */
+        lane->addrByte |= 0x01U;
+        lane->state = I2C_BB_STATE_START;
+    }
+    else
+    {
+        lane->state = I2C_BB_STATE_STOP;
+    }
+}
+
+/* Phase 3: advance every lane by one bit; returns true while any lane is busy */
+static bool I2C_BB_BitAdvance( void )
+{
+    uint32_t laneIndex;
+    bool isActive = false;
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_LANE_OBJ* lane = &i2cBBObj.lane[laneIndex];
+
+        switch (lane->state)
+        {
+            case I2C_BB_STATE_START_SENT:
+                lane->state = I2C_BB_STATE_ADDR;
+                lane->shift = lane->addrByte;
+                lane->bitIndex = 0U;
+                break;
+
+            case I2C_BB_STATE_ADDR:
+            case I2C_BB_STATE_WRITE:
+            case I2C_BB_STATE_READ:
+                if (lane->error != I2C_BB_ERROR_NONE)
+                {
+                    lane->state = I2C_BB_STATE_STOP;
+                    break;
+                }
+
+                lane->bitIndex++;
+
+                if (lane->state != I2C_BB_STATE_READ)
+                {
+                    lane->shift = (uint8_t)((uint32_t)lane->shift << 1U);
+                }
+                else if (lane->bitIndex == 8U)
+                {
+                    lane->readBuffer[lane->readCount] = lane->shift;
+                    lane->readCount++;
+                }
+                else
+                {
+                    /* Still shifting in */
+                }
+
+                if (lane->bitIndex > 8U)
+                {
+                    I2C_BB_ByteComplete(lane);
+                }
+                break;
+
+            default:
+                /* A START still waits for SCL high, STOP lanes finish in
+                   phase 2 and idle lanes do nothing */
+                break;
+        }
+
+        if (lane->state != I2C_BB_STATE_IDLE)
+        {
+            isActive = true;
+        }
+    }
+
+    return isActive;
+}
+
+static void I2C_BB_TimerTick( TC_TIMER_STATUS status, uintptr_t context )
+{
+    uint32_t port;
+
+    switch (i2cBBObj.phase)
+    {
+        case 0U:
+            I2C_BB_DataSetup();
+            i2cBBObj.phase = 1U;
+            break;
+
+        case 1U:
+            PORT_GroupInputEnable(I2C_BB_PORT_GROUP, I2C_BB_SCL_MASK);
+            i2cBBObj.stretchTicks = 0U;
+            i2cBBObj.phase = 2U;
+            break;
+
+        case 2U:
+            port = PORT_GroupRead(I2C_BB_PORT_GROUP);
+
+            if ((port & I2C_BB_SCL_MASK) == 0U)
+            {
+                /* Clock stretched by a target, hold this phase */
+                i2cBBObj.stretchTicks++;
+
+                if (i2cBBObj.stretchTicks > I2C_BB_STRETCH_TICKS_MAX)
+                {
+                    I2C_BB_BusFail();
+                }
+                break;
+            }
+
+            I2C_BB_DataSample(port);
+            i2cBBObj.phase = 3U;
+            break;
+
+        default:
+            if (I2C_BB_BitAdvance() == true)
+            {
+                PORT_GroupOutputEnable(I2C_BB_PORT_GROUP, I2C_BB_SCL_MASK);
+                i2cBBObj.phase = 0U;
+            }
+            else
+            {
+                /* Bus idle, SCL stays released */
+                I2C_BB_ClockStop();
+            }
+            break;
+    }
+}
+
+static bool I2C_BB_TransferStart( uint32_t laneIndex, uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength )
+{
+    I2C_BB_LANE_OBJ* lane;
+
+    if (laneIndex >= I2C_BB_LANES_NUMBER)
+    {
+        return false;
+    }
+
+    lane = &i2cBBObj.lane[laneIndex];
+
+    if ((lane->state != I2C_BB_STATE_IDLE) || (address > 0x7FU) ||
+        ((wrLength != 0U) && (wrData == NULL)) || ((rdLength != 0U) && (rdData == NULL)))
+    {
+        return false;
+    }
+
+    lane->writeBuffer = wrData;
+    lane->writeSize = wrLength;
+    lane->writeCount = 0U;
+    lane->readBuffer = rdData;
+    lane->readSize = rdLength;
+    lane->readCount = 0U;
+    lane->error = I2C_BB_ERROR_NONE;
+
+    /* Pure reads address the target for read straight away */
+    lane->addrByte = (uint8_t)(address << 1U);
+
+    if ((wrLength == 0U) && (rdLength != 0U))
+    {
+        lane->addrByte |= 0x01U;
+    }
+
+    /* Publish last, the timer interrupt picks the lane up from here */
+    lane->state = I2C_BB_STATE_START;
+
+    if (i2cBBObj.isClockRunning == false)
+    {
+        i2cBBObj.isClockRunning = true;
+        i2cBBObj.phase = 0U;
+        TC0_TimerStart();
+    }
+
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: I2C_BB Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void I2C_BB_Initialize( void )
+{
+    uint32_t laneIndex;
+    uint32_t pinMask = I2C_BB_SCL_MASK;
+    I2C_BB_TRANSFER_SETUP setup;
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        i2cBBObj.lane[laneIndex].sdaMask = i2cBBSdaMask[laneIndex];
+        i2cBBObj.lane[laneIndex].state = I2C_BB_STATE_IDLE;
+        i2cBBObj.lane[laneIndex].error = I2C_BB_ERROR_NONE;
+        i2cBBObj.lane[laneIndex].callback = NULL;
+        pinMask |= i2cBBSdaMask[laneIndex];
+    }
+
+    /* Latch low, lines released: driving a line is only a direction change */
+    PORT_GroupWrite(I2C_BB_PORT_GROUP, pinMask, 0U);
+    PORT_GroupInputEnable(I2C_BB_PORT_GROUP, pinMask);
+
+    i2cBBObj.phase = 0U;
+    i2cBBObj.isClockRunning = false;
+    i2cBBObj.clkSpeed = 0U;
+    i2cBBObj.srcClkFreq = 0U;
+
+    setup.clkSpeed = I2C_BB_CLOCK_SPEED_DEFAULT;
+    (void)I2C_BB_TransferSetup(0U, &setup, 0U);
+
+    TC0_TimerCallbackRegister(I2C_BB_TimerTick, 0U);
+}
+
+bool I2C_BB_Read( uint32_t lane, uint16_t address, uint8_t* rdData, uint32_t rdLength )
+{
+    if (rdLength == 0U)
+    {
+        return false;
+    }
+
+    return I2C_BB_TransferStart(lane, address, NULL, 0U, rdData, rdLength);
+}
+
+bool I2C_BB_Write( uint32_t lane, uint16_t address, uint8_t* wrData, uint32_t wrLength )
+{
+    return I2C_BB_TransferStart(lane, address, wrData, wrLength, NULL, 0U);
+}
+
+bool I2C_BB_WriteRead( uint32_t lane, uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength )
+{
+    return I2C_BB_TransferStart(lane, address, wrData, wrLength, rdData, rdLength);
+}
+
+bool I2C_BB_IsBusy( uint32_t lane )
+{
+    return ((lane < I2C_BB_LANES_NUMBER) && (i2cBBObj.lane[lane].state != I2C_BB_STATE_IDLE));
+}
+
+bool I2C_BB_IsActive( void )
+{
+    return i2cBBObj.isClockRunning;
+}
+
+/* Drops the lane without a STOP condition or a callback, like the SERCOM PLIB */
+void I2C_BB_TransferAbort( uint32_t lane )
+{
+    if (lane < I2C_BB_LANES_NUMBER)
+    {
+        i2cBBObj.lane[lane].state = I2C_BB_STATE_IDLE;
+        i2cBBObj.lane[lane].error = I2C_BB_ERROR_NONE;
+        PORT_GroupInputEnable(I2C_BB_PORT_GROUP, i2cBBObj.lane[lane].sdaMask);
+    }
+}
+
+I2C_BB_ERROR I2C_BB_ErrorGet( uint32_t lane )
+{
+    I2C_BB_ERROR error = I2C_BB_ERROR_NONE;
+
+    if (lane < I2C_BB_LANES_NUMBER)
+    {
+        error = i2cBBObj.lane[lane].error;
+    }
+
+    return error;
+}
+
+/* SCL is shared, so the speed can only change while every other lane is idle */
+bool I2C_BB_TransferSetup( uint32_t lane, I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq )
+{
+    uint32_t laneIndex;
+    uint32_t period;
+
+    if ((lane >= I2C_BB_LANES_NUMBER) || (setup == NULL) ||
+        (setup->clkSpeed == 0U) || (setup->clkSpeed > I2C_BB_CLOCK_SPEED_MAX))
+    {
+        return false;
+    }
+
+    if (srcClkFreq == 0U)
+    {
+        srcClkFreq = TC0_TimerFrequencyGet();
+    }
+
+    if ((setup->clkSpeed == i2cBBObj.clkSpeed) && (srcClkFreq == i2cBBObj.srcClkFreq))
+    {
+        return true;
+    }
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        if ((laneIndex != lane) && (i2cBBObj.lane[laneIndex].state != I2C_BB_STATE_IDLE))
+        {
+            return false;
+        }
+    }
+
+    /* Four timer ticks per SCL period */
+    period = srcClkFreq / (4U * setup->clkSpeed);
+
+    if ((period < I2C_BB_TICK_CYCLES_MIN) || (period > 0x10000U))
+    {
+        return false;
+    }
+
+    TC0_Timer16bitPeriodSet((uint16_t)(period - 1U));
+
+    i2cBBObj.clkSpeed = setup->clkSpeed;
+    i2cBBObj.srcClkFreq = srcClkFreq;
+
+    return true;
+}
+
+bool I2C_BB_ClockIsSupported( uint32_t frequency )
+{
+    uint32_t clkSpeed = (i2cBBObj.clkSpeed != 0U) ? i2cBBObj.clkSpeed : I2C_BB_CLOCK_SPEED_DEFAULT;
+
+    return ((frequency / (4U * clkSpeed)) >= I2C_BB_TICK_CYCLES_MIN);
+}
+
+void I2C_BB_ClockChange( void )
+{
+    I2C_BB_TRANSFER_SETUP setup;
+
+    setup.clkSpeed = i2cBBObj.clkSpeed;
+
+    (void)I2C_BB_TransferSetup(0U, &setup, 0U);
+}
+
+void I2C_BB_CallbackRegister( uint32_t lane, I2C_BB_CALLBACK callback, uintptr_t contextHandle )
+{
+    if (lane < I2C_BB_LANES_NUMBER)
+    {
+        i2cBBObj.lane[lane].callback = callback;
+        i2cBBObj.lane[lane].context = contextHandle;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Per-Lane Interface
+// *****************************************************************************
+// *****************************************************************************
+
+bool I2C_BB0_Read( uint16_t address, uint8_t* rdData, uint32_t rdLength )
+{
+    return I2C_BB_Read(0U, address, rdData, rdLength);
+}
+
+bool I2C_BB0_Write( uint16_t address, uint8_t* wrData, uint32_t wrLength )
+{
+    return I2C_BB_Write(0U, address, wrData, wrLength);
+}
+
+bool I2C_BB0_WriteRead( uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength )
+{
+    return I2C_BB_WriteRead(0U, address, wrData, wrLength, rdData, rdLength);
+}
+
+void I2C_BB0_TransferAbort( void )
+{
+    I2C_BB_TransferAbort(0U);
+}
+
+I2C_BB_ERROR I2C_BB0_ErrorGet( void )
+{
+    return I2C_BB_ErrorGet(0U);
+}
+
+bool I2C_BB0_TransferSetup( I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq )
+{
+    return I2C_BB_TransferSetup(0U, setup, srcClkFreq);
+}
+
+void I2C_BB0_CallbackRegister( I2C_BB_CALLBACK callback, uintptr_t contextHandle )
+{
+    I2C_BB_CallbackRegister(0U, callback, contextHandle);
+}
+
+bool I2C_BB1_Read( uint16_t address, uint8_t* rdData, uint32_t rdLength )
+{
+    return I2C_BB_Read(1U, address, rdData, rdLength);
+}
+
+bool I2C_BB1_Write( uint16_t address, uint8_t* wrData, uint32_t wrLength )
+{
+    return I2C_BB_Write(1U, address, wrData, wrLength);
+}
+
+bool I2C_BB1_WriteRead( uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength )
+{
+    return I2C_BB_WriteRead(1U, address, wrData, wrLength, rdData, rdLength);
+}
+
+void I2C_BB1_TransferAbort( void )
+{
+    I2C_BB_TransferAbort(1U);
+}
+
+I2C_BB_ERROR I2C_BB1_ErrorGet( void )
+{
+    return I2C_BB_ErrorGet(1U);
+}
+
+bool I2C_BB1_TransferSetup( I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq )
+{
+    return I2C_BB_TransferSetup(1U, setup, srcClkFreq);
+}
+
+void I2C_BB1_CallbackRegister( I2C_BB_CALLBACK callback, uintptr_t contextHandle )
+{
+    I2C_BB_CallbackRegister(1U, callback, contextHandle);
+}
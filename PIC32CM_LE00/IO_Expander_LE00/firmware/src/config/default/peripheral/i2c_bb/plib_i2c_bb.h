@@ -0,0 +1,229 @@
+/*******************************************************************************
+  Bit-Banged I2C Master Peripheral Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_i2c_bb.h
+
+  Summary
+    Bit-banged I2C master on PORT pins, timed by TC0.
+
+  Description
+    This file defines the interface to the bit-banged I2C master library.
+    Several SDA lines (lanes) share one SCL line and are clocked in lockstep
+    from the TC0 interrupt, so every lane behaves as an independent I2C bus
+    while costing a single timer interrupt per quarter bit.  Each lane exposes
+    the same set of functions as a SERCOM I2C master PLIB so that it can be
+    plugged into the I2C driver through DRV_I2C_PLIB_INTERFACE.
+
+    The lines are driven open-drain: the output latch is held low and a line
+    is pulled low by making the pin an output and released by making it an
+    input.  External pull-up resistors are required on SCL and on every SDA.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_I2C_BB_H
+#define PLIB_I2C_BB_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "device.h"
+#include "peripheral/port/plib_port.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Preprocessor macros
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of SDA lanes sharing the SCL line */
+#define I2C_BB_LANES_NUMBER             (2U)
+
+/* PORT group holding SCL and all SDA lines */
+#define I2C_BB_PORT_GROUP               PORT_GROUP_0
+
+/* SCL on PA12, SDA lanes on PA13 and PA14 */
+#define I2C_BB_SCL_MASK                 (1UL << 12U)
+#define I2C_BB_SDA0_MASK                (1UL << 13U)
+#define I2C_BB_SDA1_MASK                (1UL << 14U)
+
+/* Default and maximum SCL frequency in Hz.  A bit takes four timer ticks, so
+   a START hold or STOP setup lasts one tick; 50 kHz keeps that tick at 5 us,
+   above the 4.7 us Standard-mode minimum. */
+#define I2C_BB_CLOCK_SPEED_DEFAULT      (50000U)
+#define I2C_BB_CLOCK_SPEED_MAX          (50000U)
+
+/* Fewest CPU cycles a timer tick may last.  TC0 counts generator 0, which
+   also clocks the CPU, and the tick interrupt takes about 100 cycles with two
+   lanes, estimated rather than measured: a shorter tick would leave the main
+   loop next to nothing while a lane is busy.  At 50 kHz a tick is 240 cycles
+   at 48 MHz, but 80 at 16 MHz. */
+#define I2C_BB_TICK_CYCLES_MIN          (160U)
+
+/* Timer ticks SCL may be stretched by a target before the transfer fails */
+#define I2C_BB_STRETCH_TICKS_MAX        (2000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Bit-Banged I2C Error
+
+  Summary:
+    Defines the errors reported by a lane.
+
+  Description:
+    The values line up with DRV_I2C_ERROR so that the error get functions can
+    be used directly in the driver PLIB interface.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* No error */
+    I2C_BB_ERROR_NONE,
+
+    /* Target did not acknowledge */
+    I2C_BB_ERROR_NAK,
+
+    /* SDA did not follow a released level, or SCL stretched too long */
+    I2C_BB_ERROR_BUS,
+
+} I2C_BB_ERROR;
+
+// *****************************************************************************
+/* Bit-Banged I2C Transfer Setup
+
+  Summary:
+    I2C transfer setup data structure.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* I2C clock speed */
+    uint32_t clkSpeed;
+
+} I2C_BB_TRANSFER_SETUP;
+
+// *****************************************************************************
+/* Bit-Banged I2C Callback
+
+  Summary:
+    Called from the TC0 interrupt when a lane finishes a transfer.
+
+  Remarks:
+    None.
+*/
+
+typedef void (*I2C_BB_CALLBACK) ( uintptr_t contextHandle );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void I2C_BB_Initialize( void );
+
+bool I2C_BB_Read( uint32_t lane, uint16_t address, uint8_t* rdData, uint32_t rdLength );
+
+bool I2C_BB_Write( uint32_t lane, uint16_t address, uint8_t* wrData, uint32_t wrLength );
+
+bool I2C_BB_WriteRead( uint32_t lane, uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength );
+
+bool I2C_BB_IsBusy( uint32_t lane );
+
+/* True while TC0 clocks any lane, until the tick after the last STOP */
+bool I2C_BB_IsActive( void );
+
+void I2C_BB_TransferAbort( uint32_t lane );
+
+I2C_BB_ERROR I2C_BB_ErrorGet( uint32_t lane );
+
+bool I2C_BB_TransferSetup( uint32_t lane, I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq );
+
+/* Power service clock client: true if the lanes keep their speed with TC0
+   clocked at frequency, I2C_BB_TICK_CYCLES_MIN or more per tick */
+bool I2C_BB_ClockIsSupported( uint32_t frequency );
+
+/* Works the TC0 period out again for the new generator 0 frequency, with
+   interrupts disabled and every lane idle */
+void I2C_BB_ClockChange( void );
+
+void I2C_BB_CallbackRegister( uint32_t lane, I2C_BB_CALLBACK callback, uintptr_t contextHandle );
+
+/* Per-lane entry points matching DRV_I2C_PLIB_INTERFACE */
+bool I2C_BB0_Read( uint16_t address, uint8_t* rdData, uint32_t rdLength );
+bool I2C_BB0_Write( uint16_t address, uint8_t* wrData, uint32_t wrLength );
+bool I2C_BB0_WriteRead( uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength );
+void I2C_BB0_TransferAbort( void );
+I2C_BB_ERROR I2C_BB0_ErrorGet( void );
+bool I2C_BB0_TransferSetup( I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq );
+void I2C_BB0_CallbackRegister( I2C_BB_CALLBACK callback, uintptr_t contextHandle );
+
+bool I2C_BB1_Read( uint16_t address, uint8_t* rdData, uint32_t rdLength );
+bool I2C_BB1_Write( uint16_t address, uint8_t* wrData, uint32_t wrLength );
+bool I2C_BB1_WriteRead( uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength );
+void I2C_BB1_TransferAbort( void );
+I2C_BB_ERROR I2C_BB1_ErrorGet( void );
+bool I2C_BB1_TransferSetup( I2C_BB_TRANSFER_SETUP* setup, uint32_t srcClkFreq );
+void I2C_BB1_CallbackRegister( I2C_BB_CALLBACK callback, uintptr_t contextHandle );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif /* PLIB_I2C_BB_H */
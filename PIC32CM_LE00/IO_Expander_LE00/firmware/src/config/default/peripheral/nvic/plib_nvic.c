@@ -57,6 +57,44 @@ void NVIC_Initialize( void )
 
     /* Enable the interrupt sources and configure the priorities as configured
      * from within the "Interrupt Manager" of MHC. */
+    NVIC_SetPriority(RTC_IRQn, 3);
+    NVIC_EnableIRQ(RTC_IRQn);
+    NVIC_SetPriority(NVMCTRL_IRQn, 3);
+    NVIC_EnableIRQ(NVMCTRL_IRQn);
+    NVIC_SetPriority(DMAC_0_IRQn, 3);
+    NVIC_EnableIRQ(DMAC_0_IRQn);
+    NVIC_SetPriority(DMAC_1_IRQn, 3);
+    NVIC_EnableIRQ(DMAC_1_IRQn);
+    NVIC_SetPriority(DMAC_2_IRQn, 3);
+    NVIC_EnableIRQ(DMAC_2_IRQn);
+    NVIC_SetPriority(DMAC_3_IRQn, 3);
+    NVIC_EnableIRQ(DMAC_3_IRQn);
+    NVIC_SetPriority(DMAC_OTHER_IRQn, 3);
+    NVIC_EnableIRQ(DMAC_OTHER_IRQn);
+    NVIC_SetPriority(SERCOM1_0_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM1_0_IRQn);
+    NVIC_SetPriority(SERCOM1_1_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM1_1_IRQn);
+    NVIC_SetPriority(SERCOM1_2_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM1_2_IRQn);
+    NVIC_SetPriority(SERCOM1_OTHER_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM1_OTHER_IRQn);
+    NVIC_SetPriority(SERCOM2_0_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM2_0_IRQn);
+    NVIC_SetPriority(SERCOM2_1_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM2_1_IRQn);
+    NVIC_SetPriority(SERCOM2_2_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM2_2_IRQn);
+    NVIC_SetPriority(SERCOM2_OTHER_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM2_OTHER_IRQn);
+    NVIC_SetPriority(SERCOM3_0_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM3_0_IRQn);
+    NVIC_SetPriority(SERCOM3_1_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM3_1_IRQn);
+    NVIC_SetPriority(SERCOM3_2_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM3_2_IRQn);
+    NVIC_SetPriority(SERCOM3_OTHER_IRQn, 3);
+    NVIC_EnableIRQ(SERCOM3_OTHER_IRQn);
     NVIC_SetPriority(SERCOM5_0_IRQn, 3);
     NVIC_EnableIRQ(SERCOM5_0_IRQn);
     NVIC_SetPriority(SERCOM5_1_IRQn, 3);
@@ -65,6 +103,8 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(SERCOM5_2_IRQn);
     NVIC_SetPriority(SERCOM5_OTHER_IRQn, 3);
     NVIC_EnableIRQ(SERCOM5_OTHER_IRQn);
+    NVIC_SetPriority(TC0_IRQn, 3);
+    NVIC_EnableIRQ(TC0_IRQn);
 
 
 
@@ -57,6 +57,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
+static NVMCTRL_CALLBACK_OBJECT nvmctrlCallbackObj;
 
 void NVMCTRL_Initialize(void)
 {
@@ -64,11 +65,33 @@ void NVMCTRL_Initialize(void)
     NVMCTRL_REGS->NVMCTRL_CTRLC = NVMCTRL_CTRLC_MANW_Msk;
 }
 
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context )
+{
+    nvmctrlCallbackObj.callback_fn = callback;
+    nvmctrlCallbackObj.context = context;
+}
+
+/* DONE is only enabled while a command runs, the handler turns it off */
+void NVMCTRL_InterruptHandler( void )
+{
+    NVMCTRL_REGS->NVMCTRL_INTENCLR = NVMCTRL_INTENCLR_DONE_Msk;
+
+    if (nvmctrlCallbackObj.callback_fn != NULL)
+    {
+        nvmctrlCallbackObj.callback_fn(nvmctrlCallbackObj.context);
+    }
+}
+
 void NVMCTRL_CacheInvalidate(void)
 {
     NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_INVALL | NVMCTRL_CTRLA_CMDEX_KEY;
 }
 
+void NVMCTRL_ReadWaitStatesSet( uint32_t waitStates )
+{
+    NVMCTRL_REGS->NVMCTRL_CTRLB = (NVMCTRL_REGS->NVMCTRL_CTRLB & ~NVMCTRL_CTRLB_RWS_Msk) | NVMCTRL_CTRLB_RWS(waitStates);
+}
+
 bool NVMCTRL_Read( uint32_t *data, uint32_t length, const uint32_t address )
 {
     uint32_t *pAddress = (uint32_t *)address;
@@ -98,7 +121,9 @@ bool NVMCTRL_PageWrite( uint32_t *data, const uint32_t address )
      /* Set address and command */
     NVMCTRL_REGS->NVMCTRL_ADDR |= address;
 
+    NVMCTRL_REGS->NVMCTRL_INTFLAG = NVMCTRL_INTFLAG_DONE_Msk;
     NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_WP_Val | NVMCTRL_CTRLA_CMDEX_KEY;
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_DONE_Msk;
 
     return true;
 }
@@ -113,7 +138,9 @@ bool NVMCTRL_RowErase( uint32_t address )
     /* Set address and command */
     NVMCTRL_REGS->NVMCTRL_ADDR |= address;
 
+    NVMCTRL_REGS->NVMCTRL_INTFLAG = NVMCTRL_INTFLAG_DONE_Msk;
     NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_ER_Val | NVMCTRL_CTRLA_CMDEX_KEY;
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_DONE_Msk;
 
     return true;
 }
@@ -148,7 +175,9 @@ bool NVMCTRL_PageBufferCommit( const uint32_t address)
      /* Set address and command */
     NVMCTRL_REGS->NVMCTRL_ADDR |= address;
 
+    NVMCTRL_REGS->NVMCTRL_INTFLAG = NVMCTRL_INTFLAG_DONE_Msk;
     NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_WP_Val | NVMCTRL_CTRLA_CMDEX_KEY;
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_DONE_Msk;
 
 
     return true;
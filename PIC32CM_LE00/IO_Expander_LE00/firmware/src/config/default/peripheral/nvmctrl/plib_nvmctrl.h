@@ -92,6 +92,16 @@
 
 typedef uint8_t NVMCTRL_ERROR;
 
+/* Called from the NVMCTRL interrupt when a page write or a row erase is
+ * done; NVMCTRL_ErrorGet tells how it ended */
+typedef void (*NVMCTRL_CALLBACK)( uintptr_t context );
+
+typedef struct
+{
+    NVMCTRL_CALLBACK callback_fn;
+    uintptr_t context;
+} NVMCTRL_CALLBACK_OBJECT;
+
 typedef enum
 {
     NVMCTRL_MEMORY_REGION_APPLICATION = NVMCTRL_NSULCK_ANS_Msk,
@@ -128,6 +138,11 @@ void NVMCTRL_SecureRegionUnlock (NVMCTRL_SECURE_MEMORY_REGION region);
 
 void NVMCTRL_CacheInvalidate ( void );
 
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context );
+
+/* Flash read wait states, the other CTRLB settings kept */
+void NVMCTRL_ReadWaitStatesSet ( uint32_t waitStates );
+
 bool NVMCTRL_PageBufferWrite( uint32_t *data, const uint32_t address);
 
 bool NVMCTRL_PageBufferCommit( const uint32_t address);
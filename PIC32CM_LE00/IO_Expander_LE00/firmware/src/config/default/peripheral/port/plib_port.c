@@ -71,7 +71,16 @@
 void PORT_Initialize(void)
 {
    /************************** GROUP 0 Initialization *************************/
-
+   PORT_REGS->GROUP[0].PORT_PINCFG[8] = 0x1U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[9] = 0x1U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[12] = 0x2U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[13] = 0x2U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[14] = 0x2U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[16] = 0x1U;
+   PORT_REGS->GROUP[0].PORT_PINCFG[17] = 0x1U;
+
+   PORT_REGS->GROUP[0].PORT_PMUX[4] = 0x33U;
+   PORT_REGS->GROUP[0].PORT_PMUX[8] = 0x22U;
 
    /************************** GROUP 1 Initialization *************************/
    PORT_REGS->GROUP[1].PORT_PINCFG[20] = 0x1U;
@@ -0,0 +1,170 @@
+/*******************************************************************************
+  Real Time Counter (RTC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_rtc.c
+
+  Summary
+    RTC PLIB Implementation File.
+
+  Description
+    This file defines the interface to the RTC peripheral library.  The RTC
+    runs as a 32-bit counter (mode 0) at 32.768 kHz from OSCULP32K, with the
+    single compare used as a wake-up from standby.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "interrupts.h"
+#include "plib_rtc.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* OSC32KCTRL.RTCCTRL selects the 32.768 kHz output of OSCULP32K */
+#define RTC_COUNTER_CLOCK_FREQUENCY     (32768U)
+
+static RTC_OBJECT rtcObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: RTC Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void RTC_Initialize( void )
+{
+    RTC_REGS->MODE0.RTC_CTRLA = RTC_MODE0_CTRLA_SWRST_Msk;
+
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_SWRST_Msk) == RTC_MODE0_SYNCBUSY_SWRST_Msk)
+    {
+        /* Wait for Synchronization after Software Reset */
+    }
+
+    /* 32-bit counter, free running, count readable at any time */
+    RTC_REGS->MODE0.RTC_CTRLA = (uint16_t)(RTC_MODE0_CTRLA_MODE_COUNT32 | RTC_MODE0_CTRLA_PRESCALER_DIV1 | RTC_MODE0_CTRLA_COUNTSYNC_Msk);
+
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_COUNTSYNC_Msk) == RTC_MODE0_SYNCBUSY_COUNTSYNC_Msk)
+    {
+        /* Wait for Synchronization */
+    }
+
+    /* Clear all interrupt flags */
+    RTC_REGS->MODE0.RTC_INTFLAG = (uint16_t)RTC_MODE0_INTFLAG_Msk;
+
+    rtcObj.callback = NULL;
+}
+
+void RTC_Timer32Start( void )
+{
+    RTC_REGS->MODE0.RTC_CTRLA |= (uint16_t)RTC_MODE0_CTRLA_ENABLE_Msk;
+
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_ENABLE_Msk) == RTC_MODE0_SYNCBUSY_ENABLE_Msk)
+    {
+        /* Wait for Synchronization */
+    }
+}
+
+void RTC_Timer32Stop( void )
+{
+    RTC_REGS->MODE0.RTC_CTRLA &= (uint16_t)(~RTC_MODE0_CTRLA_ENABLE_Msk);
+
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_ENABLE_Msk) == RTC_MODE0_SYNCBUSY_ENABLE_Msk)
+    {
+        /* Wait for Synchronization */
+    }
+}
+
+uint32_t RTC_Timer32CounterGet( void )
+{
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_COUNT_Msk) == RTC_MODE0_SYNCBUSY_COUNT_Msk)
+    {
+        /* Wait for Synchronization */
+    }
+
+    return RTC_REGS->MODE0.RTC_COUNT;
+}
+
+void RTC_Timer32Compare0Set( uint32_t compareValue )
+{
+    RTC_REGS->MODE0.RTC_COMP0 = compareValue;
+
+    while((RTC_REGS->MODE0.RTC_SYNCBUSY & RTC_MODE0_SYNCBUSY_COMP0_Msk) == RTC_MODE0_SYNCBUSY_COMP0_Msk)
+    {
+        /* Wait for Synchronization */
+    }
+}
+
+uint32_t RTC_Timer32FrequencyGet( void )
+{
+    return RTC_COUNTER_CLOCK_FREQUENCY;
+}
+
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interrupt )
+{
+    /* A match from before must not end the next wait at once */
+    RTC_REGS->MODE0.RTC_INTFLAG = (uint16_t)interrupt;
+
+    RTC_REGS->MODE0.RTC_INTENSET = (uint16_t)interrupt;
+}
+
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interrupt )
+{
+    RTC_REGS->MODE0.RTC_INTENCLR = (uint16_t)interrupt;
+}
+
+void RTC_Timer32CallbackRegister( RTC_TIMER32_CALLBACK callback, uintptr_t context )
+{
+    rtcObj.callback = callback;
+
+    rtcObj.context = context;
+}
+
+void RTC_InterruptHandler( void )
+{
+    RTC_TIMER32_INT_MASK intCause = (RTC_TIMER32_INT_MASK)RTC_REGS->MODE0.RTC_INTFLAG;
+
+    /* Clear interrupt flags */
+    RTC_REGS->MODE0.RTC_INTFLAG = (uint16_t)RTC_MODE0_INTFLAG_Msk;
+
+    if (rtcObj.callback != NULL)
+    {
+        rtcObj.callback(intCause, rtcObj.context);
+    }
+}
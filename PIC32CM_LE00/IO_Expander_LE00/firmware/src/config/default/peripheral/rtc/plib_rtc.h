@@ -0,0 +1,127 @@
+/*******************************************************************************
+  Real Time Counter (RTC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_rtc.h
+
+  Summary
+    RTC PLIB Header File.
+
+  Description
+    This file defines the interface to the RTC peripheral library.  The RTC
+    runs as a 32-bit counter (mode 0) at 32.768 kHz from OSCULP32K, with the
+    single compare used as a wake-up from standby.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_RTC_H      // Guards against multiple inclusion
+#define PLIB_RTC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    RTC_TIMER32_INT_MASK_CMP0 = RTC_MODE0_INTENSET_CMP0_Msk,
+
+    RTC_TIMER32_INT_MASK_OVF = RTC_MODE0_INTENSET_OVF_Msk,
+
+    /* Force the compiler to reserve 32-bit memory for each enum */
+    RTC_TIMER32_INT_MASK_INVALID = 0xFFFFFFFFU
+
+} RTC_TIMER32_INT_MASK;
+
+typedef void (*RTC_TIMER32_CALLBACK)( RTC_TIMER32_INT_MASK intCause, uintptr_t context );
+
+typedef struct
+{
+    RTC_TIMER32_CALLBACK callback;
+
+    uintptr_t context;
+
+} RTC_OBJECT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void RTC_Initialize( void );
+
+void RTC_Timer32Start( void );
+
+void RTC_Timer32Stop( void );
+
+/* Waits for the count to synchronize, up to a few 32.768 kHz periods */
+uint32_t RTC_Timer32CounterGet( void );
+
+void RTC_Timer32Compare0Set( uint32_t compareValue );
+
+uint32_t RTC_Timer32FrequencyGet( void );
+
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interrupt );
+
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interrupt );
+
+void RTC_Timer32CallbackRegister( RTC_TIMER32_CALLBACK callback, uintptr_t context );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif /* PLIB_RTC_H */
@@ -0,0 +1,874 @@
+/*******************************************************************************
+  Serial Communication Interface Inter-Integrated Circuit (SERCOM I2C) Library
+  Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_sercom2_i2c.c
+
+  Summary:
+    SERCOM I2C PLIB Implementation file
+
+  Description:
+    This file defines the interface to the SERCOM I2C peripheral library.
+    This library provides access to and control of the associated peripheral
+    instance.
+
+*******************************************************************************/
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "interrupts.h"
+#include "plib_sercom2_i2c_master.h"
+#include "peripheral/clock/plib_clock.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+
+#define SERCOM2_I2CM_SPEED_HZ           400000
+
+/* SERCOM2 I2C baud value */
+#define SERCOM2_I2CM_BAUD_VALUE         (0x34U)
+
+/* Master code (0000 1xxx) sent in Fast-mode ahead of every High-speed transfer */
+#define SERCOM2_I2CM_MASTER_CODE        (0x0EU)
+
+/* SCL speed used to send the master code of a High-speed transfer */
+#define SERCOM2_I2CM_HS_MASTER_CODE_SPEED_HZ    400000U
+
+/* floor(fGCLK / fSCL - fGCLK * 100ns) in integer arithmetic. Both quotients
+ * are split into integer and fractional parts, the fractional parts are
+ * compared by cross multiplication (fSCL <= 1 MHz keeps this exact). */
+#define SERCOM2_I2CM_BAUD_TERM(gclk, scl)   (((gclk) / (scl)) - ((gclk) / 10000000U) - \
+                                            ((((uint64_t)((gclk) % (scl)) * 10000000U) < ((uint64_t)((gclk) % 10000000U) * (scl))) ? 1U : 0U))
+
+/* Standard, FM and FM+ baud: floor(fGCLK / fSCL - (fGCLK * 100ns + 10)), 0 if negative */
+#define SERCOM2_I2CM_BAUD_RAW(gclk, scl)    ((SERCOM2_I2CM_BAUD_TERM(gclk, scl) > 10U) ? (SERCOM2_I2CM_BAUD_TERM(gclk, scl) - 10U) : 0U)
+
+/* Up to 400 kHz: BAUD<7:0> determines both SCL_L and SCL_H */
+#define SERCOM2_I2CM_BAUD_SM_FM(raw)        (((raw) > (0xFFU * 2U)) ? 0xFFU : (((raw) <= 1U) ? 1U : ((raw) / 2U)))
+
+/* Fm+: BAUDLOW<15:8>:BAUD<7:0> with SCL_L:SCL_H of 2:1, limited to 0xFF:0x7F */
+#define SERCOM2_I2CM_BAUD_FMP(raw)          (((raw) >= 382U) ? ((0xFFUL << 8U) | 0x7FU) : (((raw) <= 3U) ? ((2UL << 8U) | 1U) : \
+                                            (((((raw) * 2U) / 3U) << 8U) | ((raw) / 3U))))
+
+/* High-speed: fSCL = fGCLK / (2 + HSBAUD + HSBAUDLOW), divider rounded up so
+ * SCL never runs faster than requested, SCL_L:SCL_H of 2:1 */
+#define SERCOM2_I2CM_HS_DIV(gclk, scl)      (((gclk) + (scl) - 1U) / (scl))
+#define SERCOM2_I2CM_HS_TOTAL(gclk, scl)    (((SERCOM2_I2CM_HS_DIV(gclk, scl) - 2U) > (0xFFU + 0x7FU)) ? (0xFFU + 0x7FU) : \
+                                            (SERCOM2_I2CM_HS_DIV(gclk, scl) - 2U))
+#define SERCOM2_I2CM_BAUD_HS(gclk, scl)     (SERCOM_I2CM_BAUD_HSBAUD(SERCOM2_I2CM_HS_TOTAL(gclk, scl) / 3U) | \
+                                            SERCOM_I2CM_BAUD_HSBAUDLOW(SERCOM2_I2CM_HS_TOTAL(gclk, scl) - (SERCOM2_I2CM_HS_TOTAL(gclk, scl) / 3U)))
+
+/* Complete BAUD register value. Folds to a constant for constant arguments. */
+#define SERCOM2_I2CM_BAUD(gclk, scl)        (((scl) <= 400000U) ? SERCOM2_I2CM_BAUD_SM_FM(SERCOM2_I2CM_BAUD_RAW(gclk, scl)) : \
+                                            (((scl) <= 1000000U) ? SERCOM2_I2CM_BAUD_FMP(SERCOM2_I2CM_BAUD_RAW(gclk, scl)) : \
+                                            (SERCOM2_I2CM_BAUD_SM_FM(SERCOM2_I2CM_BAUD_RAW(gclk, SERCOM2_I2CM_HS_MASTER_CODE_SPEED_HZ)) | SERCOM2_I2CM_BAUD_HS(gclk, scl))))
+
+/* Baud values of the commonly used clock configurations, resolved at compile time */
+static const struct
+{
+    uint32_t srcClkFreq;
+    uint32_t i2cClkSpeed;
+    uint32_t baudValue;
+
+} sercom2I2CBaudTable[] =
+{
+    { 48000000U,  100000U, SERCOM2_I2CM_BAUD(48000000U,  100000U) },
+    { 48000000U,  400000U, SERCOM2_I2CM_BAUD(48000000U,  400000U) },
+    { 48000000U, 1000000U, SERCOM2_I2CM_BAUD(48000000U, 1000000U) },
+    { 48000000U, 1700000U, SERCOM2_I2CM_BAUD(48000000U, 1700000U) },
+    { 48000000U, 3400000U, SERCOM2_I2CM_BAUD(48000000U, 3400000U) },
+    { 16000000U,  100000U, SERCOM2_I2CM_BAUD(16000000U,  100000U) },
+    { 16000000U,  400000U, SERCOM2_I2CM_BAUD(16000000U,  400000U) },
+    { 16000000U, 1000000U, SERCOM2_I2CM_BAUD(16000000U, 1000000U) },
+    { 16000000U, 1700000U, SERCOM2_I2CM_BAUD(16000000U, 1700000U) },
+    { 16000000U, 3400000U, SERCOM2_I2CM_BAUD(16000000U, 3400000U) },
+};
+
+
+static SERCOM_I2C_OBJ sercom2I2CObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SERCOM2 I2C Implementation
+// *****************************************************************************
+// *****************************************************************************
+// *****************************************************************************
+
+void SERCOM2_I2C_Initialize(void)
+{
+    /* Reset the module */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA = SERCOM_I2CM_CTRLA_SWRST_Msk ;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Enable smart mode */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLB = SERCOM_I2CM_CTRLB_SMEN_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Baud rate - Master Baud Rate*/
+    SERCOM2_REGS->I2CM.SERCOM_BAUD = SERCOM2_I2CM_BAUD_VALUE;
+
+    /* Set Operation Mode (Master), SDA Hold time, run in stand by and i2c master enable */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA = SERCOM_I2CM_CTRLA_MODE_I2C_MASTER | SERCOM_I2CM_CTRLA_SDAHOLD_75NS | SERCOM_I2CM_CTRLA_SPEED_SM | SERCOM_I2CM_CTRLA_SCLSM(0UL) | SERCOM_I2CM_CTRLA_ENABLE_Msk ;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Initial Bus State: IDLE */
+    SERCOM2_REGS->I2CM.SERCOM_STATUS = (uint16_t)SERCOM_I2CM_STATUS_BUSSTATE(0x01UL);
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Initialize the SERCOM2 PLib Object */
+    sercom2I2CObj.error = SERCOM_I2C_ERROR_NONE;
+    sercom2I2CObj.state = SERCOM_I2C_STATE_IDLE;
+    sercom2I2CObj.nextTransferPending = false;
+
+    /* Enable all Interrupts */
+    SERCOM2_REGS->I2CM.SERCOM_INTENSET = (uint8_t)SERCOM_I2CM_INTENSET_Msk;
+}
+
+static bool SERCOM2_I2C_CalculateBaudValue(uint32_t srcClkFreq, uint32_t i2cClkSpeed, uint32_t* baudVal)
+{
+    uint32_t index;
+
+    /* Reference clock frequency must be atleast two times the baud rate */
+    if (srcClkFreq < (2U * i2cClkSpeed))
+    {
+        return false;
+    }
+
+    if (i2cClkSpeed > 3400000U)
+    {
+        return false;
+    }
+
+    for (index = 0U; index < (sizeof(sercom2I2CBaudTable) / sizeof(sercom2I2CBaudTable[0])); index++)
+    {
+        if ((sercom2I2CBaudTable[index].srcClkFreq == srcClkFreq) && (sercom2I2CBaudTable[index].i2cClkSpeed == i2cClkSpeed))
+        {
+            *baudVal = sercom2I2CBaudTable[index].baudValue;
+            return true;
+        }
+    }
+
+    if ((i2cClkSpeed > 1000000U) && (SERCOM2_I2CM_HS_DIV(srcClkFreq, i2cClkSpeed) < (2U + 3U)))
+    {
+        /* HSBAUD and HSBAUDLOW cannot be 0 */
+        return false;
+    }
+
+    *baudVal = SERCOM2_I2CM_BAUD(srcClkFreq, i2cClkSpeed);
+
+    return true;
+}
+
+bool SERCOM2_I2C_TransferSetup(SERCOM_I2C_TRANSFER_SETUP* setup, uint32_t srcClkFreq )
+{
+    uint32_t baudValue;
+    uint32_t i2cClkSpeed;
+    uint32_t i2cSpeedMode = 0;
+
+    if (setup == NULL)
+    {
+        return false;
+    }
+
+    i2cClkSpeed = setup->clkSpeed;
+
+    if( srcClkFreq == 0U)
+    {
+        /* Generator 0, 48 MHz or 16 MHz */
+        srcClkFreq = CLOCK_Gclk0FrequencyGet();
+    }
+
+    if (SERCOM2_I2C_CalculateBaudValue(srcClkFreq, i2cClkSpeed, &baudValue) == false)
+    {
+        return false;
+    }
+
+    if (i2cClkSpeed > 1000000U)
+    {
+        i2cSpeedMode = 2U;
+    }
+    else if (i2cClkSpeed > 400000U)
+    {
+        i2cSpeedMode = 1U;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Disable the I2C before changing the I2C clock speed */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA &= ~SERCOM_I2CM_CTRLA_ENABLE_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+
+    /* Baud rate - Master Baud Rate*/
+    SERCOM2_REGS->I2CM.SERCOM_BAUD = baudValue;
+
+    /* High-speed mode requires SCL clock stretching after the ACK bit (SCLSM = 1) */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA  = ((SERCOM2_REGS->I2CM.SERCOM_CTRLA & ~(SERCOM_I2CM_CTRLA_SPEED_Msk | SERCOM_I2CM_CTRLA_SCLSM_Msk)) | (SERCOM_I2CM_CTRLA_SPEED(i2cSpeedMode)) | (SERCOM_I2CM_CTRLA_SCLSM((i2cSpeedMode == 2U) ? 1UL : 0UL)));
+
+    /* Re-enable the I2C module */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA |= SERCOM_I2CM_CTRLA_ENABLE_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+
+    /* Since the I2C module was disabled, re-initialize the bus state to IDLE */
+    SERCOM2_REGS->I2CM.SERCOM_STATUS = (uint16_t)SERCOM_I2CM_STATUS_BUSSTATE(0x01UL);
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    return true;
+}
+
+void SERCOM2_I2C_CallbackRegister(SERCOM_I2C_CALLBACK callback, uintptr_t contextHandle)
+{
+    sercom2I2CObj.callback = callback;
+
+    sercom2I2CObj.context  = contextHandle;
+}
+
+
+static void SERCOM2_I2C_SendAddress(uint16_t address, bool dir)
+{
+    /* If operation is I2C read */
+    if(dir)
+    {
+        /* <xxxx-xxxR> <read-data> <P> */
+
+        /* Next state will be to read data */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_READ;
+    }
+    else
+    {
+        /* <xxxx-xxxW> <write-data> <P> */
+
+        /* Next state will be to write data */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_WRITE;
+    }
+
+
+    if(sercom2I2CObj.isHighSpeed == true)
+    {
+        /* With SCLSM = 1 the ACK/NACK of a byte is sent before the interrupt,
+         * so a single byte read must be NAK'ed up front */
+        if((dir == true) && (sercom2I2CObj.readSize == 1U))
+        {
+            SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+            /* Wait for synchronization */
+            while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+            {
+                /* Do nothing */
+            }
+        }
+
+        /* Repeated start in High-speed mode */
+        SERCOM2_REGS->I2CM.SERCOM_ADDR = ((uint32_t)address << 1U) | (dir ? 1UL :0UL) | SERCOM_I2CM_ADDR_HS_Msk;
+    }
+    else
+    {
+        SERCOM2_REGS->I2CM.SERCOM_ADDR = ((uint32_t)address << 1U) | (dir ? 1UL :0UL);
+    }
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+}
+
+static void SERCOM2_I2C_ReadFastCountSet(void)
+{
+    /* The last byte is NAK'ed (and the one before it in High-speed mode,
+     * SCLSM = 1), every byte ahead of those takes the interrupt fast path */
+    size_t tailCount = (sercom2I2CObj.isHighSpeed == true) ? 2U : 1U;
+
+    sercom2I2CObj.readFastCount = (sercom2I2CObj.readSize > tailCount) ? (sercom2I2CObj.readSize - tailCount) : 0U;
+}
+
+static void SERCOM2_I2C_InitiateTransfer(uint16_t address, bool dir)
+{
+    sercom2I2CObj.writeCount = 0U;
+    sercom2I2CObj.readCount = 0U;
+
+    /* Clear all flags */
+    SERCOM2_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
+
+    /* Smart mode enabled with SCLSM = 0, - ACK is set to send while receiving the data */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLB &= ~SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+
+    if(sercom2I2CObj.txMasterCode == true)
+    {
+        /* Send the master code in Fast-mode. It is NAK'ed by all slaves and
+         * followed by a repeated start in High-speed mode. */
+        sercom2I2CObj.txMasterCode = false;
+
+        sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_ADDR_HS;
+
+        SERCOM2_REGS->I2CM.SERCOM_ADDR = (uint32_t)sercom2I2CObj.masterCode;
+
+        /* Wait for synchronization */
+        while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        SERCOM2_I2C_SendAddress(address, dir);
+    }
+}
+
+static bool SERCOM2_I2C_XferSetup(
+    uint16_t address,
+    uint8_t* wrData,
+    uint32_t wrLength,
+    uint8_t* rdData,
+    uint32_t rdLength,
+    bool dir,
+    bool isHighSpeed
+)
+{
+    /* Check for ongoing transfer */
+    if(sercom2I2CObj.state != SERCOM_I2C_STATE_IDLE)
+    {
+        return false;
+    }
+
+    sercom2I2CObj.address        = address;
+    sercom2I2CObj.readBuffer     = rdData;
+    sercom2I2CObj.readSize       = rdLength;
+    sercom2I2CObj.writeBuffer    = wrData;
+    sercom2I2CObj.writeSize      = wrLength;
+    sercom2I2CObj.transferDir    = dir;
+    sercom2I2CObj.isHighSpeed    = isHighSpeed;
+    sercom2I2CObj.txMasterCode   = isHighSpeed;
+    sercom2I2CObj.masterCode     = SERCOM2_I2CM_MASTER_CODE;
+    sercom2I2CObj.error          = SERCOM_I2C_ERROR_NONE;
+
+    SERCOM2_I2C_ReadFastCountSet();
+
+
+    SERCOM2_I2C_InitiateTransfer(address, dir);
+
+    return true;
+}
+
+static void SERCOM2_I2C_NextTransferLoad(void)
+{
+    sercom2I2CObj.address        = sercom2I2CObj.nextTransfer.address;
+    sercom2I2CObj.readBuffer     = sercom2I2CObj.nextTransfer.readBuffer;
+    sercom2I2CObj.readSize       = sercom2I2CObj.nextTransfer.readSize;
+    sercom2I2CObj.writeBuffer    = sercom2I2CObj.nextTransfer.writeBuffer;
+    sercom2I2CObj.writeSize      = sercom2I2CObj.nextTransfer.writeSize;
+    sercom2I2CObj.transferDir    = (sercom2I2CObj.writeSize == 0U);
+    sercom2I2CObj.txMasterCode   = sercom2I2CObj.isHighSpeed;
+    sercom2I2CObj.error          = SERCOM_I2C_ERROR_NONE;
+
+    SERCOM2_I2C_ReadFastCountSet();
+
+    sercom2I2CObj.nextTransferPending = false;
+}
+
+static bool SERCOM2_I2C_IsRestartPending(void)
+{
+    /* A staged transfer to the same slave continues with a repeated start
+     * instead of a stop, the bus is not released in between */
+    return ((sercom2I2CObj.nextTransferPending == true) && (sercom2I2CObj.nextTransfer.address == sercom2I2CObj.address));
+}
+
+static void SERCOM2_I2C_NextTransferRestart(void)
+{
+    SERCOM2_I2C_NextTransferLoad();
+
+    sercom2I2CObj.writeCount = 0U;
+    sercom2I2CObj.readCount = 0U;
+
+    /* The NAK for the last byte of a read is already sent, ACK the data of the next read */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLB &= ~SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Writing ADDR while the bus is owned issues the repeated start. In
+     * High-speed mode the bus stays in High-speed mode, no master code. */
+    SERCOM2_I2C_SendAddress(sercom2I2CObj.address, sercom2I2CObj.transferDir);
+}
+
+static bool SERCOM2_I2C_IsHighSpeedMode(void)
+{
+    return ((SERCOM2_REGS->I2CM.SERCOM_CTRLA & SERCOM_I2CM_CTRLA_SPEED_Msk) == SERCOM_I2CM_CTRLA_SPEED(2UL));
+}
+
+bool SERCOM2_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength)
+{
+    return SERCOM2_I2C_XferSetup(address, NULL, 0, rdData, rdLength, true, SERCOM2_I2C_IsHighSpeedMode());
+}
+
+bool SERCOM2_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength)
+{
+    return SERCOM2_I2C_XferSetup(address, wrData, wrLength, NULL, 0, false, SERCOM2_I2C_IsHighSpeedMode());
+}
+
+bool SERCOM2_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
+{
+    return SERCOM2_I2C_XferSetup(address, wrData, wrLength, rdData, rdLength, false, SERCOM2_I2C_IsHighSpeedMode());
+}
+
+bool SERCOM2_I2C_NextTransferSet(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
+{
+    /* A single transfer can be staged and only behind an ongoing transfer.
+     * Must be called with the SERCOM2 interrupts disabled. */
+    if((sercom2I2CObj.nextTransferPending == true) || (sercom2I2CObj.state == SERCOM_I2C_STATE_IDLE))
+    {
+        return false;
+    }
+
+    if((wrLength == 0U) && (rdLength == 0U))
+    {
+        return false;
+    }
+
+    sercom2I2CObj.nextTransfer.address      = address;
+    sercom2I2CObj.nextTransfer.writeBuffer  = wrData;
+    sercom2I2CObj.nextTransfer.writeSize    = wrLength;
+    sercom2I2CObj.nextTransfer.readBuffer   = rdData;
+    sercom2I2CObj.nextTransfer.readSize     = rdLength;
+
+    sercom2I2CObj.nextTransferPending = true;
+
+    return true;
+}
+
+bool SERCOM2_I2C_IsBusy(void)
+{
+    bool isBusy = true;
+    if((sercom2I2CObj.state == SERCOM_I2C_STATE_IDLE))
+    {
+        if(((SERCOM2_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_BUSSTATE_Msk) == SERCOM_I2CM_STATUS_BUSSTATE(0x01U)))
+        {
+           isBusy = false;
+        }
+    }
+    return isBusy;
+}
+
+SERCOM_I2C_ERROR SERCOM2_I2C_ErrorGet(void)
+{
+    return sercom2I2CObj.error;
+}
+
+void SERCOM2_I2C_TransferAbort( void )
+{
+    sercom2I2CObj.error = SERCOM_I2C_ERROR_NONE;
+
+    // Reset the plib to IDLE state
+    sercom2I2CObj.state = SERCOM_I2C_STATE_IDLE;
+
+    /* The staged transfer is dropped along with the ongoing one */
+    sercom2I2CObj.nextTransferPending = false;
+
+    /* Disable the I2C module */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA &= ~SERCOM_I2CM_CTRLA_ENABLE_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Re-enable the I2C module */
+    SERCOM2_REGS->I2CM.SERCOM_CTRLA |= SERCOM_I2CM_CTRLA_ENABLE_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Since the I2C module was disabled, re-initialize the bus state to IDLE */
+    SERCOM2_REGS->I2CM.SERCOM_STATUS = (uint16_t)SERCOM_I2CM_STATUS_BUSSTATE(0x01UL);
+
+    /* Wait for synchronization */
+    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+}
+
+/* Runs from flash, entered from the RAM resident handler below for everything
+ * but a data byte in the middle of a transfer */
+static void __attribute__((long_call, noinline)) SERCOM2_I2C_InterruptSlowPath(uint16_t status)
+{
+    bool transferRestarted = false;
+
+    /* Checks if the arbitration lost in multi-master scenario */
+    if((status & SERCOM_I2CM_STATUS_ARBLOST_Msk) == SERCOM_I2CM_STATUS_ARBLOST_Msk)
+    {
+        /* Set Error status */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom2I2CObj.error = SERCOM_I2C_ERROR_BUS;
+
+    }
+    /* Check for Bus Error during transmission */
+    else if((status & SERCOM_I2CM_STATUS_BUSERR_Msk) == SERCOM_I2CM_STATUS_BUSERR_Msk)
+    {
+        /* Set Error status */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom2I2CObj.error = SERCOM_I2C_ERROR_BUS;
+    }
+    /* Checks slave acknowledge for address or data */
+    else if(((status & SERCOM_I2CM_STATUS_RXNACK_Msk) == SERCOM_I2CM_STATUS_RXNACK_Msk) &&
+            (sercom2I2CObj.state != SERCOM_I2C_STATE_TRANSFER_ADDR_HS))
+    {
+        sercom2I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom2I2CObj.error = SERCOM_I2C_ERROR_NAK;
+    }
+    else
+    {
+        switch(sercom2I2CObj.state)
+        {
+            case SERCOM_I2C_REINITIATE_TRANSFER:
+
+                if (sercom2I2CObj.writeSize != 0U)
+                {
+                    /* Initiate Write transfer */
+                    SERCOM2_I2C_InitiateTransfer(sercom2I2CObj.address, false);
+                }
+                else
+                {
+                    /* Initiate Read transfer */
+                    SERCOM2_I2C_InitiateTransfer(sercom2I2CObj.address, true);
+                }
+
+                break;
+
+
+            case SERCOM_I2C_STATE_IDLE:
+
+                break;
+
+            case SERCOM_I2C_STATE_TRANSFER_ADDR_HS:
+
+                /* Master code is sent (and NAK'ed), switch to High-speed mode */
+                if (sercom2I2CObj.writeSize != 0U)
+                {
+                    SERCOM2_I2C_SendAddress(sercom2I2CObj.address, false);
+                }
+                else
+                {
+                    SERCOM2_I2C_SendAddress(sercom2I2CObj.address, true);
+                }
+
+                break;
+
+
+
+            case SERCOM_I2C_STATE_TRANSFER_WRITE:
+
+                if (sercom2I2CObj.writeCount == (sercom2I2CObj.writeSize))
+                {
+                    if(sercom2I2CObj.readSize != 0U)
+                    {
+                        if(sercom2I2CObj.isHighSpeed == true)
+                        {
+                            /* Repeated start stays in High-speed mode, no master code required */
+                            SERCOM2_I2C_SendAddress(sercom2I2CObj.address, true);
+                        }
+                        else
+                        {
+                            /* Write 7bit address with direction (ADDR.ADDR[0]) equal to 1*/
+                            SERCOM2_REGS->I2CM.SERCOM_ADDR =  ((uint32_t)(sercom2I2CObj.address) << 1U) | (uint32_t)I2C_TRANSFER_READ;
+
+                            /* No synchronization wait, the next access to a synchronized
+                             * register is a byte time away in the next interrupt */
+                            sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_READ;
+                        }
+                    }
+                    else if(SERCOM2_I2C_IsRestartPending() == true)
+                    {
+                        SERCOM2_I2C_NextTransferRestart();
+
+                        transferRestarted = true;
+                    }
+                    else
+                    {
+                        /* The wait for the bus to go idle below also covers the synchronization */
+                        SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
+
+                        sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                    }
+                }
+                /* Write next byte */
+                else
+                {
+                    SERCOM2_REGS->I2CM.SERCOM_DATA = sercom2I2CObj.writeBuffer[sercom2I2CObj.writeCount];
+                    sercom2I2CObj.writeCount++;
+                }
+
+                break;
+
+            case SERCOM_I2C_STATE_TRANSFER_READ:
+
+                if((sercom2I2CObj.readCount == (sercom2I2CObj.readSize - 1U)) && (SERCOM2_I2C_IsRestartPending() == true))
+                {
+                    /* Repeated start once the last byte is read below */
+                    transferRestarted = true;
+
+                    if(sercom2I2CObj.isHighSpeed == false)
+                    {
+                        /* NAK the last byte, smart mode sends it when DATA is read */
+                        SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+                        /* Wait for synchronization */
+                        while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                        {
+                            /* Do nothing */
+                        }
+                    }
+                }
+                else if((sercom2I2CObj.isHighSpeed == true) && (sercom2I2CObj.readCount == (sercom2I2CObj.readSize - 1U)))
+                {
+                    /* SCLSM = 1: the last byte is already NAK'ed, only send the stop condition */
+                    SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
+
+                    /* Wait for synchronization */
+                    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
+                    }
+
+                    sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                }
+                else if((sercom2I2CObj.isHighSpeed == true) && ((sercom2I2CObj.readCount + 2U) == sercom2I2CObj.readSize))
+                {
+                    /* SCLSM = 1: the NAK for the last byte goes out as soon as it is received */
+                    SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+                    /* Wait for synchronization */
+                    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
+                    }
+                }
+                else if(sercom2I2CObj.isHighSpeed == true)
+                {
+                    /* Do nothing */
+                }
+                else if(sercom2I2CObj.readCount == (sercom2I2CObj.readSize - 1U))
+                {
+                    /* Set NACK and send stop condition to the slave from master */
+                    SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk | SERCOM_I2CM_CTRLB_CMD(3UL);
+
+                    /* Wait for synchronization */
+                    while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
+                    }
+
+                    sercom2I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                }
+
+                /* Read the received data, the branches above that write CTRLB
+                 * have already waited for its synchronization */
+                sercom2I2CObj.readBuffer[sercom2I2CObj.readCount] = (uint8_t) SERCOM2_REGS->I2CM.SERCOM_DATA;
+                sercom2I2CObj.readCount++;
+
+                if(transferRestarted == true)
+                {
+                    SERCOM2_I2C_NextTransferRestart();
+                }
+
+                break;
+
+            default:
+
+                /* Do nothing */
+                break;
+        }
+    }
+
+    /* Error Status */
+    if(sercom2I2CObj.state == SERCOM_I2C_STATE_ERROR)
+    {
+        /* Reset the PLib objects and Interrupts */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_IDLE;
+
+        /* Do not chain onto a failed transfer, the client restarts the staged one */
+        sercom2I2CObj.nextTransferPending = false;
+
+        /* Generate STOP condition */
+        SERCOM2_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
+
+        /* Wait for synchronization */
+        while((SERCOM2_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+
+
+        SERCOM2_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
+
+        if (sercom2I2CObj.callback != NULL)
+        {
+            sercom2I2CObj.callback(sercom2I2CObj.context);
+        }
+    }
+    /* Transfer Complete */
+    else if(sercom2I2CObj.state == SERCOM_I2C_STATE_TRANSFER_DONE)
+    {
+        /* Reset the PLib objects and interrupts */
+        sercom2I2CObj.state = SERCOM_I2C_STATE_IDLE;
+        sercom2I2CObj.error = SERCOM_I2C_ERROR_NONE;
+
+        SERCOM2_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
+
+        /* Wait for the NAK and STOP bit to be transmitted out and I2C state machine to rest in IDLE state */
+        while((SERCOM2_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_BUSSTATE_Msk) != SERCOM_I2CM_STATUS_BUSSTATE(0x01U))
+        {
+            /* Do nothing */
+        }
+
+        /* Start the staged transfer before the completion is reported */
+        if(sercom2I2CObj.nextTransferPending == true)
+        {
+            SERCOM2_I2C_NextTransferLoad();
+
+            SERCOM2_I2C_InitiateTransfer(sercom2I2CObj.address, sercom2I2CObj.transferDir);
+        }
+
+        if(sercom2I2CObj.callback != NULL)
+        {
+            sercom2I2CObj.callback(sercom2I2CObj.context);
+        }
+
+    }
+    else if(transferRestarted == true)
+    {
+        /* The staged transfer is already on the bus, report the completed one */
+        if(sercom2I2CObj.callback != NULL)
+        {
+            sercom2I2CObj.callback(sercom2I2CObj.context);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/* Placed in RAM so the per-byte path runs without flash wait states. STATUS is
+ * read once, and a byte in the middle of a transfer only moves DATA: nothing
+ * else is written, so there is no synchronization to wait for. */
+RAMFUNC void SERCOM2_I2C_InterruptHandler(void)
+{
+    uint16_t status;
+    SERCOM_I2C_STATE state;
+
+    if(SERCOM2_REGS->I2CM.SERCOM_INTENSET != 0U)
+    {
+        status = SERCOM2_REGS->I2CM.SERCOM_STATUS;
+        state = sercom2I2CObj.state;
+
+        if((status & (SERCOM_I2CM_STATUS_ARBLOST_Msk | SERCOM_I2CM_STATUS_BUSERR_Msk | SERCOM_I2CM_STATUS_RXNACK_Msk)) != 0U)
+        {
+            SERCOM2_I2C_InterruptSlowPath(status);
+        }
+        else if((state == SERCOM_I2C_STATE_TRANSFER_WRITE) && (sercom2I2CObj.writeCount < sercom2I2CObj.writeSize))
+        {
+            SERCOM2_REGS->I2CM.SERCOM_DATA = sercom2I2CObj.writeBuffer[sercom2I2CObj.writeCount];
+            sercom2I2CObj.writeCount++;
+        }
+        else if((state == SERCOM_I2C_STATE_TRANSFER_READ) && (sercom2I2CObj.readCount < sercom2I2CObj.readFastCount))
+        {
+            sercom2I2CObj.readBuffer[sercom2I2CObj.readCount] = (uint8_t)SERCOM2_REGS->I2CM.SERCOM_DATA;
+            sercom2I2CObj.readCount++;
+        }
+        else
+        {
+            SERCOM2_I2C_InterruptSlowPath(status);
+        }
+    }
+}
@@ -50,6 +50,8 @@
 
 #include "interrupts.h"
 #include "plib_sercom5_i2c_master.h"
+#include "peripheral/clock/plib_clock.h"
+#include "system/prof/sys_prof.h"
 
 
 // *****************************************************************************
@@ -64,6 +66,62 @@
 /* SERCOM5 I2C baud value */
 #define SERCOM5_I2CM_BAUD_VALUE         (0x34U)
 
+/* Master code (0000 1xxx) sent in Fast-mode ahead of every High-speed transfer */
+#define SERCOM5_I2CM_MASTER_CODE        (0x0EU)
+
+/* SCL speed used to send the master code of a High-speed transfer */
+#define SERCOM5_I2CM_HS_MASTER_CODE_SPEED_HZ    400000U
+
+/* floor(fGCLK / fSCL - fGCLK * 100ns) in integer arithmetic. Both quotients
+ * are split into integer and fractional parts, the fractional parts are
+ * compared by cross multiplication (fSCL <= 1 MHz keeps this exact). */
+#define SERCOM5_I2CM_BAUD_TERM(gclk, scl)   (((gclk) / (scl)) - ((gclk) / 10000000U) - \
+                                            ((((uint64_t)((gclk) % (scl)) * 10000000U) < ((uint64_t)((gclk) % 10000000U) * (scl))) ? 1U : 0U))
+
+/* Standard, FM and FM+ baud: floor(fGCLK / fSCL - (fGCLK * 100ns + 10)), 0 if negative */
+#define SERCOM5_I2CM_BAUD_RAW(gclk, scl)    ((SERCOM5_I2CM_BAUD_TERM(gclk, scl) > 10U) ? (SERCOM5_I2CM_BAUD_TERM(gclk, scl) - 10U) : 0U)
+
+/* Up to 400 kHz: BAUD<7:0> determines both SCL_L and SCL_H */
+#define SERCOM5_I2CM_BAUD_SM_FM(raw)        (((raw) > (0xFFU * 2U)) ? 0xFFU : (((raw) <= 1U) ? 1U : ((raw) / 2U)))
+
+/* Fm+: BAUDLOW<15:8>:BAUD<7:0> with SCL_L:SCL_H of 2:1, limited to 0xFF:0x7F */
+#define SERCOM5_I2CM_BAUD_FMP(raw)          (((raw) >= 382U) ? ((0xFFUL << 8U) | 0x7FU) : (((raw) <= 3U) ? ((2UL << 8U) | 1U) : \
+                                            (((((raw) * 2U) / 3U) << 8U) | ((raw) / 3U))))
+
+/* High-speed: fSCL = fGCLK / (2 + HSBAUD + HSBAUDLOW), divider rounded up so
+ * SCL never runs faster than requested, SCL_L:SCL_H of 2:1 */
+#define SERCOM5_I2CM_HS_DIV(gclk, scl)      (((gclk) + (scl) - 1U) / (scl))
+#define SERCOM5_I2CM_HS_TOTAL(gclk, scl)    (((SERCOM5_I2CM_HS_DIV(gclk, scl) - 2U) > (0xFFU + 0x7FU)) ? (0xFFU + 0x7FU) : \
+                                            (SERCOM5_I2CM_HS_DIV(gclk, scl) - 2U))
+#define SERCOM5_I2CM_BAUD_HS(gclk, scl)     (SERCOM_I2CM_BAUD_HSBAUD(SERCOM5_I2CM_HS_TOTAL(gclk, scl) / 3U) | \
+                                            SERCOM_I2CM_BAUD_HSBAUDLOW(SERCOM5_I2CM_HS_TOTAL(gclk, scl) - (SERCOM5_I2CM_HS_TOTAL(gclk, scl) / 3U)))
+
+/* Complete BAUD register value. Folds to a constant for constant arguments. */
+#define SERCOM5_I2CM_BAUD(gclk, scl)        (((scl) <= 400000U) ? SERCOM5_I2CM_BAUD_SM_FM(SERCOM5_I2CM_BAUD_RAW(gclk, scl)) : \
+                                            (((scl) <= 1000000U) ? SERCOM5_I2CM_BAUD_FMP(SERCOM5_I2CM_BAUD_RAW(gclk, scl)) : \
+                                            (SERCOM5_I2CM_BAUD_SM_FM(SERCOM5_I2CM_BAUD_RAW(gclk, SERCOM5_I2CM_HS_MASTER_CODE_SPEED_HZ)) | SERCOM5_I2CM_BAUD_HS(gclk, scl))))
+
+/* Baud values of the commonly used clock configurations, resolved at compile time */
+static const struct
+{
+    uint32_t srcClkFreq;
+    uint32_t i2cClkSpeed;
+    uint32_t baudValue;
+
+} sercom5I2CBaudTable[] =
+{
+    { 48000000U,  100000U, SERCOM5_I2CM_BAUD(48000000U,  100000U) },
+    { 48000000U,  400000U, SERCOM5_I2CM_BAUD(48000000U,  400000U) },
+    { 48000000U, 1000000U, SERCOM5_I2CM_BAUD(48000000U, 1000000U) },
+    { 48000000U, 1700000U, SERCOM5_I2CM_BAUD(48000000U, 1700000U) },
+    { 48000000U, 3400000U, SERCOM5_I2CM_BAUD(48000000U, 3400000U) },
+    { 16000000U,  100000U, SERCOM5_I2CM_BAUD(16000000U,  100000U) },
+    { 16000000U,  400000U, SERCOM5_I2CM_BAUD(16000000U,  400000U) },
+    { 16000000U, 1000000U, SERCOM5_I2CM_BAUD(16000000U, 1000000U) },
+    { 16000000U, 1700000U, SERCOM5_I2CM_BAUD(16000000U, 1700000U) },
+    { 16000000U, 3400000U, SERCOM5_I2CM_BAUD(16000000U, 3400000U) },
+};
+
 
 static SERCOM_I2C_OBJ sercom5I2CObj;
 
@@ -118,6 +176,7 @@ void SERCOM5_I2C_Initialize(void)
     /* Initialize the SERCOM5 PLib Object */
     sercom5I2CObj.error = SERCOM_I2C_ERROR_NONE;
     sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
+    sercom5I2CObj.nextTransferPending = false;
 
     /* Enable all Interrupts */
     SERCOM5_REGS->I2CM.SERCOM_INTENSET = (uint8_t)SERCOM_I2CM_INTENSET_Msk;
@@ -125,10 +184,7 @@ void SERCOM5_I2C_Initialize(void)
 
 static bool SERCOM5_I2C_CalculateBaudValue(uint32_t srcClkFreq, uint32_t i2cClkSpeed, uint32_t* baudVal)
 {
-    uint32_t baudValue = 0U;
-    float fSrcClkFreq = (float)srcClkFreq;
-    float fI2cClkSpeed = (float)i2cClkSpeed;
-    float fBaudValue = 0.0f;
+    uint32_t index;
 
     /* Reference clock frequency must be atleast two times the baud rate */
     if (srcClkFreq < (2U * i2cClkSpeed))
@@ -136,54 +192,28 @@ static bool SERCOM5_I2C_CalculateBaudValue(uint32_t srcClkFreq, uint32_t i2cClkS
         return false;
     }
 
-    if (i2cClkSpeed <= 1000000U)
-    {
-        /* Standard, FM and FM+ baud calculation */
-        fBaudValue = (fSrcClkFreq / fI2cClkSpeed) - ((fSrcClkFreq * (100.0f / 1000000000.0f)) + 10.0f);
-        baudValue = (uint32_t)fBaudValue;
-    }
-    else
+    if (i2cClkSpeed > 3400000U)
     {
         return false;
     }
-    if (i2cClkSpeed <= 400000U)
+
+    for (index = 0U; index < (sizeof(sercom5I2CBaudTable) / sizeof(sercom5I2CBaudTable[0])); index++)
     {
-        /* For I2C clock speed upto 400 kHz, the value of BAUD<7:0> determines both SCL_L and SCL_H with SCL_L = SCL_H */
-        if (baudValue > (0xFFU * 2U))
-        {
-            /* Set baud rate to the minimum possible value */
-            baudValue = 0xFFU;
-        }
-        else if (baudValue <= 1U)
-        {
-            /* Baud value cannot be 0. Set baud rate to maximum possible value */
-            baudValue = 1U;
-        }
-        else
+        if ((sercom5I2CBaudTable[index].srcClkFreq == srcClkFreq) && (sercom5I2CBaudTable[index].i2cClkSpeed == i2cClkSpeed))
         {
-            baudValue /= 2U;
+            *baudVal = sercom5I2CBaudTable[index].baudValue;
+            return true;
         }
     }
-    else
+
+    if ((i2cClkSpeed > 1000000U) && (SERCOM5_I2CM_HS_DIV(srcClkFreq, i2cClkSpeed) < (2U + 3U)))
     {
-        /* To maintain the ratio of SCL_L:SCL_H to 2:1, the max value of BAUD_LOW<15:8>:BAUD<7:0> can be 0xFF:0x7F. Hence BAUD_LOW + BAUD can not exceed 255+127 = 382 */
-        if (baudValue >= 382U)
-        {
-            /* Set baud rate to the minimum possible value while maintaining SCL_L:SCL_H to 2:1 */
-            baudValue = (0xFFUL << 8U) | (0x7FU);
-        }
-        else if (baudValue <= 3U)
-        {
-            /* Baud value cannot be 0. Set baud rate to maximum possible value while maintaining SCL_L:SCL_H to 2:1 */
-            baudValue = (2UL << 8U) | 1U;
-        }
-        else
-        {
-            /* For Fm+ mode, I2C SCL_L:SCL_H to 2:1 */
-            baudValue  = ((((baudValue * 2U)/3U) << 8U) | (baudValue/3U));
-        }
+        /* HSBAUD and HSBAUDLOW cannot be 0 */
+        return false;
     }
-    *baudVal = baudValue;
+
+    *baudVal = SERCOM5_I2CM_BAUD(srcClkFreq, i2cClkSpeed);
+
     return true;
 }
 
@@ -202,7 +232,8 @@ bool SERCOM5_I2C_TransferSetup(SERCOM_I2C_TRANSFER_SETUP* setup, uint32_t srcClk
 
     if( srcClkFreq == 0U)
     {
-        srcClkFreq = 48000000UL;
+        /* Generator 0, 48 MHz or 16 MHz */
+        srcClkFreq = CLOCK_Gclk0FrequencyGet();
     }
 
     if (SERCOM5_I2C_CalculateBaudValue(srcClkFreq, i2cClkSpeed, &baudValue) == false)
@@ -210,10 +241,18 @@ bool SERCOM5_I2C_TransferSetup(SERCOM_I2C_TRANSFER_SETUP* setup, uint32_t srcClk
         return false;
     }
 
-    if (i2cClkSpeed > 400000U)
+    if (i2cClkSpeed > 1000000U)
+    {
+        i2cSpeedMode = 2U;
+    }
+    else if (i2cClkSpeed > 400000U)
     {
         i2cSpeedMode = 1U;
     }
+    else
+    {
+        /* Do nothing */
+    }
 
     /* Disable the I2C before changing the I2C clock speed */
     SERCOM5_REGS->I2CM.SERCOM_CTRLA &= ~SERCOM_I2CM_CTRLA_ENABLE_Msk;
@@ -228,7 +267,8 @@ bool SERCOM5_I2C_TransferSetup(SERCOM_I2C_TRANSFER_SETUP* setup, uint32_t srcClk
     /* Baud rate - Master Baud Rate*/
     SERCOM5_REGS->I2CM.SERCOM_BAUD = baudValue;
 
-    SERCOM5_REGS->I2CM.SERCOM_CTRLA  = ((SERCOM5_REGS->I2CM.SERCOM_CTRLA & ~SERCOM_I2CM_CTRLA_SPEED_Msk) | (SERCOM_I2CM_CTRLA_SPEED(i2cSpeedMode)));
+    /* High-speed mode requires SCL clock stretching after the ACK bit (SCLSM = 1) */
+    SERCOM5_REGS->I2CM.SERCOM_CTRLA  = ((SERCOM5_REGS->I2CM.SERCOM_CTRLA & ~(SERCOM_I2CM_CTRLA_SPEED_Msk | SERCOM_I2CM_CTRLA_SCLSM_Msk)) | (SERCOM_I2CM_CTRLA_SPEED(i2cSpeedMode)) | (SERCOM_I2CM_CTRLA_SCLSM((i2cSpeedMode == 2U) ? 1UL : 0UL)));
 
     /* Re-enable the I2C module */
     SERCOM5_REGS->I2CM.SERCOM_CTRLA |= SERCOM_I2CM_CTRLA_ENABLE_Msk;
@@ -279,7 +319,28 @@ static void SERCOM5_I2C_SendAddress(uint16_t address, bool dir)
     }
 
 
-    SERCOM5_REGS->I2CM.SERCOM_ADDR = ((uint32_t)address << 1U) | (dir ? 1UL :0UL);
+    if(sercom5I2CObj.isHighSpeed == true)
+    {
+        /* With SCLSM = 1 the ACK/NACK of a byte is sent before the interrupt,
+         * so a single byte read must be NAK'ed up front */
+        if((dir == true) && (sercom5I2CObj.readSize == 1U))
+        {
+            SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+            /* Wait for synchronization */
+            while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+            {
+                /* Do nothing */
+            }
+        }
+
+        /* Repeated start in High-speed mode */
+        SERCOM5_REGS->I2CM.SERCOM_ADDR = ((uint32_t)address << 1U) | (dir ? 1UL :0UL) | SERCOM_I2CM_ADDR_HS_Msk;
+    }
+    else
+    {
+        SERCOM5_REGS->I2CM.SERCOM_ADDR = ((uint32_t)address << 1U) | (dir ? 1UL :0UL);
+    }
 
     /* Wait for synchronization */
     while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
@@ -289,6 +350,15 @@ static void SERCOM5_I2C_SendAddress(uint16_t address, bool dir)
 
 }
 
+static void SERCOM5_I2C_ReadFastCountSet(void)
+{
+    /* The last byte is NAK'ed (and the one before it in High-speed mode,
+     * SCLSM = 1), every byte ahead of those takes the interrupt fast path */
+    size_t tailCount = (sercom5I2CObj.isHighSpeed == true) ? 2U : 1U;
+
+    sercom5I2CObj.readFastCount = (sercom5I2CObj.readSize > tailCount) ? (sercom5I2CObj.readSize - tailCount) : 0U;
+}
+
 static void SERCOM5_I2C_InitiateTransfer(uint16_t address, bool dir)
 {
     sercom5I2CObj.writeCount = 0U;
@@ -307,7 +377,26 @@ static void SERCOM5_I2C_InitiateTransfer(uint16_t address, bool dir)
     }
 
 
-    SERCOM5_I2C_SendAddress(address, dir);
+    if(sercom5I2CObj.txMasterCode == true)
+    {
+        /* Send the master code in Fast-mode. It is NAK'ed by all slaves and
+         * followed by a repeated start in High-speed mode. */
+        sercom5I2CObj.txMasterCode = false;
+
+        sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_ADDR_HS;
+
+        SERCOM5_REGS->I2CM.SERCOM_ADDR = (uint32_t)sercom5I2CObj.masterCode;
+
+        /* Wait for synchronization */
+        while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        SERCOM5_I2C_SendAddress(address, dir);
+    }
 }
 
 static bool SERCOM5_I2C_XferSetup(
@@ -333,29 +422,106 @@ static bool SERCOM5_I2C_XferSetup(
     sercom5I2CObj.writeSize      = wrLength;
     sercom5I2CObj.transferDir    = dir;
     sercom5I2CObj.isHighSpeed    = isHighSpeed;
+    sercom5I2CObj.txMasterCode   = isHighSpeed;
+    sercom5I2CObj.masterCode     = SERCOM5_I2CM_MASTER_CODE;
     sercom5I2CObj.error          = SERCOM_I2C_ERROR_NONE;
 
+    SERCOM5_I2C_ReadFastCountSet();
+
 
     SERCOM5_I2C_InitiateTransfer(address, dir);
 
     return true;
 }
 
+static void SERCOM5_I2C_NextTransferLoad(void)
+{
+    sercom5I2CObj.address        = sercom5I2CObj.nextTransfer.address;
+    sercom5I2CObj.readBuffer     = sercom5I2CObj.nextTransfer.readBuffer;
+    sercom5I2CObj.readSize       = sercom5I2CObj.nextTransfer.readSize;
+    sercom5I2CObj.writeBuffer    = sercom5I2CObj.nextTransfer.writeBuffer;
+    sercom5I2CObj.writeSize      = sercom5I2CObj.nextTransfer.writeSize;
+    sercom5I2CObj.transferDir    = (sercom5I2CObj.writeSize == 0U);
+    sercom5I2CObj.txMasterCode   = sercom5I2CObj.isHighSpeed;
+    sercom5I2CObj.error          = SERCOM_I2C_ERROR_NONE;
+
+    SERCOM5_I2C_ReadFastCountSet();
+
+    sercom5I2CObj.nextTransferPending = false;
+}
+
+static bool SERCOM5_I2C_IsRestartPending(void)
+{
+    /* A staged transfer to the same slave continues with a repeated start
+     * instead of a stop, the bus is not released in between */
+    return ((sercom5I2CObj.nextTransferPending == true) && (sercom5I2CObj.nextTransfer.address == sercom5I2CObj.address));
+}
+
+static void SERCOM5_I2C_NextTransferRestart(void)
+{
+    SERCOM5_I2C_NextTransferLoad();
+
+    sercom5I2CObj.writeCount = 0U;
+    sercom5I2CObj.readCount = 0U;
+
+    /* The NAK for the last byte of a read is already sent, ACK the data of the next read */
+    SERCOM5_REGS->I2CM.SERCOM_CTRLB &= ~SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Writing ADDR while the bus is owned issues the repeated start. In
+     * High-speed mode the bus stays in High-speed mode, no master code. */
+    SERCOM5_I2C_SendAddress(sercom5I2CObj.address, sercom5I2CObj.transferDir);
+}
+
+static bool SERCOM5_I2C_IsHighSpeedMode(void)
+{
+    return ((SERCOM5_REGS->I2CM.SERCOM_CTRLA & SERCOM_I2CM_CTRLA_SPEED_Msk) == SERCOM_I2CM_CTRLA_SPEED(2UL));
+}
+
 bool SERCOM5_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength)
 {
-    return SERCOM5_I2C_XferSetup(address, NULL, 0, rdData, rdLength, true, false);
+    return SERCOM5_I2C_XferSetup(address, NULL, 0, rdData, rdLength, true, SERCOM5_I2C_IsHighSpeedMode());
 }
 
 bool SERCOM5_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength)
 {
-    return SERCOM5_I2C_XferSetup(address, wrData, wrLength, NULL, 0, false, false);
+    return SERCOM5_I2C_XferSetup(address, wrData, wrLength, NULL, 0, false, SERCOM5_I2C_IsHighSpeedMode());
 }
 
 bool SERCOM5_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
 {
-    return SERCOM5_I2C_XferSetup(address, wrData, wrLength, rdData, rdLength, false, false);
+    return SERCOM5_I2C_XferSetup(address, wrData, wrLength, rdData, rdLength, false, SERCOM5_I2C_IsHighSpeedMode());
 }
 
+bool SERCOM5_I2C_NextTransferSet(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
+{
+    /* A single transfer can be staged and only behind an ongoing transfer.
+     * Must be called with the SERCOM5 interrupts disabled. */
+    if((sercom5I2CObj.nextTransferPending == true) || (sercom5I2CObj.state == SERCOM_I2C_STATE_IDLE))
+    {
+        return false;
+    }
+
+    if((wrLength == 0U) && (rdLength == 0U))
+    {
+        return false;
+    }
+
+    sercom5I2CObj.nextTransfer.address      = address;
+    sercom5I2CObj.nextTransfer.writeBuffer  = wrData;
+    sercom5I2CObj.nextTransfer.writeSize    = wrLength;
+    sercom5I2CObj.nextTransfer.readBuffer   = rdData;
+    sercom5I2CObj.nextTransfer.readSize     = rdLength;
+
+    sercom5I2CObj.nextTransferPending = true;
+
+    return true;
+}
 
 bool SERCOM5_I2C_IsBusy(void)
 {
@@ -382,6 +548,9 @@ void SERCOM5_I2C_TransferAbort( void )
     // Reset the plib to IDLE state
     sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
 
+    /* The staged transfer is dropped along with the ongoing one */
+    sercom5I2CObj.nextTransferPending = false;
+
     /* Disable the I2C module */
     SERCOM5_REGS->I2CM.SERCOM_CTRLA &= ~SERCOM_I2CM_CTRLA_ENABLE_Msk;
 
@@ -410,188 +579,300 @@ void SERCOM5_I2C_TransferAbort( void )
     }
 }
 
-void SERCOM5_I2C_InterruptHandler(void)
+/* Runs from flash, entered from the RAM resident handler below for everything
+ * but a data byte in the middle of a transfer */
+static void __attribute__((long_call, noinline)) SERCOM5_I2C_InterruptSlowPath(uint16_t status)
 {
-    if(SERCOM5_REGS->I2CM.SERCOM_INTENSET != 0U)
+    bool transferRestarted = false;
+
+    /* Checks if the arbitration lost in multi-master scenario */
+    if((status & SERCOM_I2CM_STATUS_ARBLOST_Msk) == SERCOM_I2CM_STATUS_ARBLOST_Msk)
     {
-        /* Checks if the arbitration lost in multi-master scenario */
-        if((SERCOM5_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_ARBLOST_Msk) == SERCOM_I2CM_STATUS_ARBLOST_Msk)
-        {
-            /* Set Error status */
-            sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
-            sercom5I2CObj.error = SERCOM_I2C_ERROR_BUS;
+        /* Set Error status */
+        sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom5I2CObj.error = SERCOM_I2C_ERROR_BUS;
 
-        }
-        /* Check for Bus Error during transmission */
-        else if((SERCOM5_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_BUSERR_Msk) == SERCOM_I2CM_STATUS_BUSERR_Msk)
-        {
-            /* Set Error status */
-            sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
-            sercom5I2CObj.error = SERCOM_I2C_ERROR_BUS;
-        }
-        /* Checks slave acknowledge for address or data */
-        else if((SERCOM5_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_RXNACK_Msk) == SERCOM_I2CM_STATUS_RXNACK_Msk)
-        {
-            sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
-            sercom5I2CObj.error = SERCOM_I2C_ERROR_NAK;
-        }
-        else
+    }
+    /* Check for Bus Error during transmission */
+    else if((status & SERCOM_I2CM_STATUS_BUSERR_Msk) == SERCOM_I2CM_STATUS_BUSERR_Msk)
+    {
+        /* Set Error status */
+        sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom5I2CObj.error = SERCOM_I2C_ERROR_BUS;
+    }
+    /* Checks slave acknowledge for address or data */
+    else if(((status & SERCOM_I2CM_STATUS_RXNACK_Msk) == SERCOM_I2CM_STATUS_RXNACK_Msk) &&
+            (sercom5I2CObj.state != SERCOM_I2C_STATE_TRANSFER_ADDR_HS))
+    {
+        sercom5I2CObj.state = SERCOM_I2C_STATE_ERROR;
+        sercom5I2CObj.error = SERCOM_I2C_ERROR_NAK;
+    }
+    else
+    {
+        switch(sercom5I2CObj.state)
         {
-            switch(sercom5I2CObj.state)
-            {
-                case SERCOM_I2C_REINITIATE_TRANSFER:
-
-                    if (sercom5I2CObj.writeSize != 0U)
-                    {
-                        /* Initiate Write transfer */
-                        SERCOM5_I2C_InitiateTransfer(sercom5I2CObj.address, false);
-                    }
-                    else
-                    {
-                        /* Initiate Read transfer */
-                        SERCOM5_I2C_InitiateTransfer(sercom5I2CObj.address, true);
-                    }
+            case SERCOM_I2C_REINITIATE_TRANSFER:
 
-                    break;
+                if (sercom5I2CObj.writeSize != 0U)
+                {
+                    /* Initiate Write transfer */
+                    SERCOM5_I2C_InitiateTransfer(sercom5I2CObj.address, false);
+                }
+                else
+                {
+                    /* Initiate Read transfer */
+                    SERCOM5_I2C_InitiateTransfer(sercom5I2CObj.address, true);
+                }
 
+                break;
 
-                case SERCOM_I2C_STATE_IDLE:
 
-                    break;
+            case SERCOM_I2C_STATE_IDLE:
 
+                break;
 
+            case SERCOM_I2C_STATE_TRANSFER_ADDR_HS:
 
-                case SERCOM_I2C_STATE_TRANSFER_WRITE:
+                /* Master code is sent (and NAK'ed), switch to High-speed mode */
+                if (sercom5I2CObj.writeSize != 0U)
+                {
+                    SERCOM5_I2C_SendAddress(sercom5I2CObj.address, false);
+                }
+                else
+                {
+                    SERCOM5_I2C_SendAddress(sercom5I2CObj.address, true);
+                }
 
-                    if (sercom5I2CObj.writeCount == (sercom5I2CObj.writeSize))
-                    {
-                        if(sercom5I2CObj.readSize != 0U)
-                        {
+                break;
 
-                            /* Write 7bit address with direction (ADDR.ADDR[0]) equal to 1*/
-                            SERCOM5_REGS->I2CM.SERCOM_ADDR =  ((uint32_t)(sercom5I2CObj.address) << 1U) | (uint32_t)I2C_TRANSFER_READ;
 
-                            /* Wait for synchronization */
-                            while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
-                            {
-                                /* Do nothing */
-                            }
 
-                            sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_READ;
+            case SERCOM_I2C_STATE_TRANSFER_WRITE:
 
+                if (sercom5I2CObj.writeCount == (sercom5I2CObj.writeSize))
+                {
+                    if(sercom5I2CObj.readSize != 0U)
+                    {
+                        if(sercom5I2CObj.isHighSpeed == true)
+                        {
+                            /* Repeated start stays in High-speed mode, no master code required */
+                            SERCOM5_I2C_SendAddress(sercom5I2CObj.address, true);
                         }
                         else
                         {
-                            SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
-
-                            /* Wait for synchronization */
-                            while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
-                            {
-                                /* Do nothing */
-                            }
-
+                            /* Write 7bit address with direction (ADDR.ADDR[0]) equal to 1*/
+                            SERCOM5_REGS->I2CM.SERCOM_ADDR =  ((uint32_t)(sercom5I2CObj.address) << 1U) | (uint32_t)I2C_TRANSFER_READ;
 
-                            sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                            /* No synchronization wait, the next access to a synchronized
+                             * register is a byte time away in the next interrupt */
+                            sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_READ;
                         }
                     }
-                    /* Write next byte */
+                    else if(SERCOM5_I2C_IsRestartPending() == true)
+                    {
+                        SERCOM5_I2C_NextTransferRestart();
+
+                        transferRestarted = true;
+                    }
                     else
                     {
-                        SERCOM5_REGS->I2CM.SERCOM_DATA = sercom5I2CObj.writeBuffer[sercom5I2CObj.writeCount];
-                        sercom5I2CObj.writeCount++;
-                        /* Wait for synchronization */
-                            while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
-                            {
-                                /* Do nothing */
-                            }
+                        /* The wait for the bus to go idle below also covers the synchronization */
+                        SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
+
+                        sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
                     }
+                }
+                /* Write next byte */
+                else
+                {
+                    SERCOM5_REGS->I2CM.SERCOM_DATA = sercom5I2CObj.writeBuffer[sercom5I2CObj.writeCount];
+                    sercom5I2CObj.writeCount++;
+                }
 
-                    break;
+                break;
 
-                case SERCOM_I2C_STATE_TRANSFER_READ:
+            case SERCOM_I2C_STATE_TRANSFER_READ:
 
-                    if(sercom5I2CObj.readCount == (sercom5I2CObj.readSize - 1U))
+                if((sercom5I2CObj.readCount == (sercom5I2CObj.readSize - 1U)) && (SERCOM5_I2C_IsRestartPending() == true))
+                {
+                    /* Repeated start once the last byte is read below */
+                    transferRestarted = true;
+
+                    if(sercom5I2CObj.isHighSpeed == false)
                     {
-                        /* Set NACK and send stop condition to the slave from master */
-                        SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk | SERCOM_I2CM_CTRLB_CMD(3UL);
+                        /* NAK the last byte, smart mode sends it when DATA is read */
+                        SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
 
                         /* Wait for synchronization */
                         while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
                         {
                             /* Do nothing */
                         }
+                    }
+                }
+                else if((sercom5I2CObj.isHighSpeed == true) && (sercom5I2CObj.readCount == (sercom5I2CObj.readSize - 1U)))
+                {
+                    /* SCLSM = 1: the last byte is already NAK'ed, only send the stop condition */
+                    SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
 
-                        sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                    /* Wait for synchronization */
+                    while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
                     }
 
+                    sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                }
+                else if((sercom5I2CObj.isHighSpeed == true) && ((sercom5I2CObj.readCount + 2U) == sercom5I2CObj.readSize))
+                {
+                    /* SCLSM = 1: the NAK for the last byte goes out as soon as it is received */
+                    SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk;
+
                     /* Wait for synchronization */
-                        while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
-                        {
-                            /* Do nothing */
-                        }
+                    while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
+                    }
+                }
+                else if(sercom5I2CObj.isHighSpeed == true)
+                {
+                    /* Do nothing */
+                }
+                else if(sercom5I2CObj.readCount == (sercom5I2CObj.readSize - 1U))
+                {
+                    /* Set NACK and send stop condition to the slave from master */
+                    SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_ACKACT_Msk | SERCOM_I2CM_CTRLB_CMD(3UL);
 
-                    /* Read the received data */
-                    sercom5I2CObj.readBuffer[sercom5I2CObj.readCount] = (uint8_t) SERCOM5_REGS->I2CM.SERCOM_DATA;
-                    sercom5I2CObj.readCount++;
+                    /* Wait for synchronization */
+                    while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
+                    {
+                        /* Do nothing */
+                    }
 
-                    break;
+                    sercom5I2CObj.state = SERCOM_I2C_STATE_TRANSFER_DONE;
+                }
 
-                default:
+                /* Read the received data, the branches above that write CTRLB
+                 * have already waited for its synchronization */
+                sercom5I2CObj.readBuffer[sercom5I2CObj.readCount] = (uint8_t) SERCOM5_REGS->I2CM.SERCOM_DATA;
+                sercom5I2CObj.readCount++;
 
-                    /* Do nothing */
-                    break;
-            }
+                if(transferRestarted == true)
+                {
+                    SERCOM5_I2C_NextTransferRestart();
+                }
+
+                break;
+
+            default:
+
+                /* Do nothing */
+                break;
         }
+    }
+
+    /* Error Status */
+    if(sercom5I2CObj.state == SERCOM_I2C_STATE_ERROR)
+    {
+        /* Reset the PLib objects and Interrupts */
+        sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
+
+        /* Do not chain onto a failed transfer, the client restarts the staged one */
+        sercom5I2CObj.nextTransferPending = false;
 
-        /* Error Status */
-        if(sercom5I2CObj.state == SERCOM_I2C_STATE_ERROR)
+        /* Generate STOP condition */
+        SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
+
+        /* Wait for synchronization */
+        while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
         {
-            /* Reset the PLib objects and Interrupts */
-            sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
+            /* Do nothing */
+        }
 
-            /* Generate STOP condition */
-            SERCOM5_REGS->I2CM.SERCOM_CTRLB |= SERCOM_I2CM_CTRLB_CMD(3UL);
 
-            /* Wait for synchronization */
-            while((SERCOM5_REGS->I2CM.SERCOM_SYNCBUSY) != 0U)
-            {
-                /* Do nothing */
-            }
+        SERCOM5_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
 
+        if (sercom5I2CObj.callback != NULL)
+        {
+            sercom5I2CObj.callback(sercom5I2CObj.context);
+        }
+    }
+    /* Transfer Complete */
+    else if(sercom5I2CObj.state == SERCOM_I2C_STATE_TRANSFER_DONE)
+    {
+        /* Reset the PLib objects and interrupts */
+        sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
+        sercom5I2CObj.error = SERCOM_I2C_ERROR_NONE;
 
-            SERCOM5_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
+        SERCOM5_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
 
-            if (sercom5I2CObj.callback != NULL)
-            {
-                sercom5I2CObj.callback(sercom5I2CObj.context);
-            }
+        /* Wait for the NAK and STOP bit to be transmitted out and I2C state machine to rest in IDLE state */
+        while((SERCOM5_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_BUSSTATE_Msk) != SERCOM_I2CM_STATUS_BUSSTATE(0x01U))
+        {
+            /* Do nothing */
         }
-        /* Transfer Complete */
-        else if(sercom5I2CObj.state == SERCOM_I2C_STATE_TRANSFER_DONE)
+
+        /* Start the staged transfer before the completion is reported */
+        if(sercom5I2CObj.nextTransferPending == true)
         {
-            /* Reset the PLib objects and interrupts */
-            sercom5I2CObj.state = SERCOM_I2C_STATE_IDLE;
-            sercom5I2CObj.error = SERCOM_I2C_ERROR_NONE;
+            SERCOM5_I2C_NextTransferLoad();
 
-            SERCOM5_REGS->I2CM.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CM_INTFLAG_Msk;
+            SERCOM5_I2C_InitiateTransfer(sercom5I2CObj.address, sercom5I2CObj.transferDir);
+        }
 
-            /* Wait for the NAK and STOP bit to be transmitted out and I2C state machine to rest in IDLE state */
-            while((SERCOM5_REGS->I2CM.SERCOM_STATUS & SERCOM_I2CM_STATUS_BUSSTATE_Msk) != SERCOM_I2CM_STATUS_BUSSTATE(0x01U))
-            {
-                /* Do nothing */
-            }
+        if(sercom5I2CObj.callback != NULL)
+        {
+            sercom5I2CObj.callback(sercom5I2CObj.context);
+        }
 
-            if(sercom5I2CObj.callback != NULL)
-            {
-                sercom5I2CObj.callback(sercom5I2CObj.context);
-            }
+    }
+    else if(transferRestarted == true)
+    {
+        /* The staged transfer is already on the bus, report the completed one */
+        if(sercom5I2CObj.callback != NULL)
+        {
+            sercom5I2CObj.callback(sercom5I2CObj.context);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/* Placed in RAM so the per-byte path runs without flash wait states. STATUS is
+ * read once, and a byte in the middle of a transfer only moves DATA: nothing
+ * else is written, so there is no synchronization to wait for. */
+RAMFUNC void SERCOM5_I2C_InterruptHandler(void)
+{
+    uint16_t status;
+    SERCOM_I2C_STATE state;
+    SYS_PROF_BEGIN(SYS_PROF_ID_SERCOM5_ISR);
+
+    if(SERCOM5_REGS->I2CM.SERCOM_INTENSET != 0U)
+    {
+        status = SERCOM5_REGS->I2CM.SERCOM_STATUS;
+        state = sercom5I2CObj.state;
 
+        if((status & (SERCOM_I2CM_STATUS_ARBLOST_Msk | SERCOM_I2CM_STATUS_BUSERR_Msk | SERCOM_I2CM_STATUS_RXNACK_Msk)) != 0U)
+        {
+            SERCOM5_I2C_InterruptSlowPath(status);
+        }
+        else if((state == SERCOM_I2C_STATE_TRANSFER_WRITE) && (sercom5I2CObj.writeCount < sercom5I2CObj.writeSize))
+        {
+            SERCOM5_REGS->I2CM.SERCOM_DATA = sercom5I2CObj.writeBuffer[sercom5I2CObj.writeCount];
+            sercom5I2CObj.writeCount++;
+        }
+        else if((state == SERCOM_I2C_STATE_TRANSFER_READ) && (sercom5I2CObj.readCount < sercom5I2CObj.readFastCount))
+        {
+            sercom5I2CObj.readBuffer[sercom5I2CObj.readCount] = (uint8_t)SERCOM5_REGS->I2CM.SERCOM_DATA;
+            sercom5I2CObj.readCount++;
         }
         else
         {
-            /* Do nothing */
+            SERCOM5_I2C_InterruptSlowPath(status);
         }
     }
 
-    return;
-}
\ No newline at end of file
+    SYS_PROF_END(SYS_PROF_ID_SERCOM5_ISR);
+}
@@ -178,6 +178,35 @@ typedef void (*SERCOM_I2C_CALLBACK)
 
 );
 
+// *****************************************************************************
+/* SERCOM I2C Transfer Descriptor
+
+   Summary:
+    SERCOM I2C staged transfer structure.
+
+   Description:
+    This data structure describes a transfer that is staged with the PLib while
+    another transfer is in progress. It is started from the interrupt handler
+    as soon as the ongoing transfer completes.
+
+   Remarks:
+    None.
+*/
+
+typedef struct
+{
+    uint16_t                    address;
+
+    uint8_t*                    writeBuffer;
+
+    uint8_t*                    readBuffer;
+
+    size_t                      writeSize;
+
+    size_t                      readSize;
+
+} SERCOM_I2C_TRANSFER_DESC;
+
 // *****************************************************************************
 /* SERCOM I2C PLib Instance Object
 
@@ -215,12 +244,20 @@ typedef struct
 
     size_t                      readCount;
 
+    /* Read bytes that are only copied out of DATA, without ACK/NAK or stop handling */
+    size_t                      readFastCount;
+
     /* State */
     volatile SERCOM_I2C_STATE   state;
 
     /* Transfer status */
     volatile SERCOM_I2C_ERROR   error;
 
+    /* Transfer started when the ongoing one completes */
+    SERCOM_I2C_TRANSFER_DESC    nextTransfer;
+
+    volatile bool               nextTransferPending;
+
     /* Transfer Event Callback */
     SERCOM_I2C_CALLBACK         callback;
 
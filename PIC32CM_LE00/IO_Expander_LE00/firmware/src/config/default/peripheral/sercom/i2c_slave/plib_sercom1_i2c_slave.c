@@ -0,0 +1,233 @@
+/*******************************************************************************
+  Serial Communication Interface Inter-Integrated Circuit (SERCOM I2C) Library
+  Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_sercom1_i2c_slave.c
+
+  Summary:
+    SERCOM I2C Slave PLIB Implementation file
+
+  Description:
+    This file defines the interface to the SERCOM I2C peripheral library in
+    slave (target) mode. This library provides access to and control of the
+    associated peripheral instance.
+
+*******************************************************************************/
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "interrupts.h"
+#include "plib_sercom1_i2c_slave.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* SERCOM1 I2C 7-bit slave address */
+#define SERCOM1_I2CS_ADDRESS            (0x54U)
+
+static SERCOM_I2C_SLAVE_OBJ sercom1I2CSObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SERCOM1 I2C Slave Implementation
+// *****************************************************************************
+// *****************************************************************************
+// *****************************************************************************
+
+void SERCOM1_I2C_Initialize(void)
+{
+    /* Reset the module */
+    SERCOM1_REGS->I2CS.SERCOM_CTRLA = SERCOM_I2CS_CTRLA_SWRST_Msk ;
+
+    /* Wait for synchronization */
+    while((SERCOM1_REGS->I2CS.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    /* Set Operation Mode (Slave), SDA Hold time and Standard/Fast-mode speed */
+    SERCOM1_REGS->I2CS.SERCOM_CTRLA = SERCOM_I2CS_CTRLA_MODE_I2C_SLAVE | SERCOM_I2CS_CTRLA_SDAHOLD_75NS | SERCOM_I2CS_CTRLA_SPEED(0UL) | SERCOM_I2CS_CTRLA_SCLSM(0UL);
+
+    /* Address match on the 7-bit address only, address and data are ACK'ed by software */
+    SERCOM1_REGS->I2CS.SERCOM_CTRLB = SERCOM_I2CS_CTRLB_AMODE(0UL);
+
+    SERCOM1_REGS->I2CS.SERCOM_ADDR = SERCOM_I2CS_ADDR_ADDR(SERCOM1_I2CS_ADDRESS);
+
+    /* Initialize the SERCOM1 PLib Object */
+    sercom1I2CSObj.isBusy = false;
+    sercom1I2CSObj.isFirstTxPending = false;
+    sercom1I2CSObj.error = SERCOM_I2C_SLAVE_ERROR_NONE;
+
+    /* Enable the address match, data ready, stop and error interrupts */
+    SERCOM1_REGS->I2CS.SERCOM_INTENSET = SERCOM_I2CS_INTENSET_PREC_Msk | SERCOM_I2CS_INTENSET_AMATCH_Msk | SERCOM_I2CS_INTENSET_DRDY_Msk | SERCOM_I2CS_INTENSET_ERROR_Msk;
+
+    /* Enable the module */
+    SERCOM1_REGS->I2CS.SERCOM_CTRLA |= SERCOM_I2CS_CTRLA_ENABLE_Msk;
+
+    /* Wait for synchronization */
+    while((SERCOM1_REGS->I2CS.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+}
+
+void SERCOM1_I2C_CallbackRegister(SERCOM_I2C_SLAVE_CALLBACK callback, uintptr_t contextHandle)
+{
+    sercom1I2CSObj.callback = callback;
+
+    sercom1I2CSObj.context  = contextHandle;
+}
+
+bool SERCOM1_I2C_IsBusy(void)
+{
+    return sercom1I2CSObj.isBusy;
+}
+
+uint8_t SERCOM1_I2C_ReadByte(void)
+{
+    return (uint8_t)SERCOM1_REGS->I2CS.SERCOM_DATA;
+}
+
+void SERCOM1_I2C_WriteByte(uint8_t wrByte)
+{
+    SERCOM1_REGS->I2CS.SERCOM_DATA = wrByte;
+}
+
+SERCOM_I2C_SLAVE_TRANSFER_DIR SERCOM1_I2C_TransferDirGet(void)
+{
+    return ((SERCOM1_REGS->I2CS.SERCOM_STATUS & SERCOM_I2CS_STATUS_DIR_Msk) != 0U) ? SERCOM_I2C_SLAVE_TRANSFER_DIR_READ : SERCOM_I2C_SLAVE_TRANSFER_DIR_WRITE;
+}
+
+SERCOM_I2C_SLAVE_ACK_STATUS SERCOM1_I2C_LastByteAckStatusGet(void)
+{
+    return ((SERCOM1_REGS->I2CS.SERCOM_STATUS & SERCOM_I2CS_STATUS_RXNACK_Msk) != 0U) ? SERCOM_I2C_SLAVE_ACK_STATUS_RECEIVED_NAK : SERCOM_I2C_SLAVE_ACK_STATUS_RECEIVED_ACK;
+}
+
+SERCOM_I2C_SLAVE_ERROR SERCOM1_I2C_ErrorGet(void)
+{
+    SERCOM_I2C_SLAVE_ERROR error = sercom1I2CSObj.error;
+
+    sercom1I2CSObj.error = SERCOM_I2C_SLAVE_ERROR_NONE;
+
+    return error;
+}
+
+static bool SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT event)
+{
+    bool isAck = true;
+
+    if(sercom1I2CSObj.callback != NULL)
+    {
+        isAck = sercom1I2CSObj.callback(event, sercom1I2CSObj.context);
+    }
+
+    return isAck;
+}
+
+static void SERCOM1_I2C_CommandSet(bool isAck, uint32_t command)
+{
+    /* Writing the command clears the AMATCH and DRDY flags and releases SCL */
+    SERCOM1_REGS->I2CS.SERCOM_CTRLB = (SERCOM1_REGS->I2CS.SERCOM_CTRLB & ~(SERCOM_I2CS_CTRLB_ACKACT_Msk | SERCOM_I2CS_CTRLB_CMD_Msk)) |
+                                      SERCOM_I2CS_CTRLB_ACKACT(isAck ? 0UL : 1UL) | SERCOM_I2CS_CTRLB_CMD(command);
+}
+
+void SERCOM1_I2C_InterruptHandler(void)
+{
+    uint8_t intFlags = SERCOM1_REGS->I2CS.SERCOM_INTFLAG;
+    bool isAck;
+
+    if((intFlags & SERCOM_I2CS_INTFLAG_ERROR_Msk) != 0U)
+    {
+        sercom1I2CSObj.error |= ((uint32_t)SERCOM1_REGS->I2CS.SERCOM_STATUS & SERCOM_I2C_SLAVE_ERROR_ALL);
+
+        /* Clear the error status bits and the error flag */
+        SERCOM1_REGS->I2CS.SERCOM_STATUS = (uint16_t)SERCOM_I2C_SLAVE_ERROR_ALL;
+        SERCOM1_REGS->I2CS.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CS_INTFLAG_ERROR_Msk;
+
+        (void)SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT_ERROR);
+    }
+
+    if((intFlags & SERCOM_I2CS_INTFLAG_AMATCH_Msk) != 0U)
+    {
+        sercom1I2CSObj.isBusy = true;
+        sercom1I2CSObj.isFirstTxPending = true;
+
+        isAck = SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT_ADDR_MATCH);
+
+        /* ACK/NAK the address and wait for the first data interrupt */
+        SERCOM1_I2C_CommandSet(isAck, 3UL);
+    }
+    else if((intFlags & SERCOM_I2CS_INTFLAG_DRDY_Msk) != 0U)
+    {
+        if(SERCOM1_I2C_TransferDirGet() == SERCOM_I2C_SLAVE_TRANSFER_DIR_WRITE)
+        {
+            /* The application reads the byte and decides whether to ACK it */
+            isAck = SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT_RX_READY);
+
+            SERCOM1_I2C_CommandSet(isAck, 3UL);
+        }
+        else if((sercom1I2CSObj.isFirstTxPending == true) || (SERCOM1_I2C_LastByteAckStatusGet() == SERCOM_I2C_SLAVE_ACK_STATUS_RECEIVED_ACK))
+        {
+            sercom1I2CSObj.isFirstTxPending = false;
+
+            /* The application provides the next byte to transmit */
+            (void)SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT_TX_READY);
+
+            SERCOM1_I2C_CommandSet(true, 3UL);
+        }
+        else
+        {
+            /* The master NAK'ed the last byte, wait for the stop or a repeated start */
+            SERCOM1_I2C_CommandSet(true, 2UL);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if((intFlags & SERCOM_I2CS_INTFLAG_PREC_Msk) != 0U)
+    {
+        SERCOM1_REGS->I2CS.SERCOM_INTFLAG = (uint8_t)SERCOM_I2CS_INTFLAG_PREC_Msk;
+
+        sercom1I2CSObj.isBusy = false;
+
+        (void)SERCOM1_I2C_EventNotify(SERCOM_I2C_SLAVE_TRANSFER_EVENT_STOP_BIT_RECEIVED);
+    }
+}
@@ -0,0 +1,244 @@
+/*******************************************************************************
+  Serial Communication Interface Inter-Integrated Circuit (SERCOM I2C) Library
+  Instance Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_sercom_i2c_slave_common.h
+
+  Summary
+    SERCOM I2C Slave peripheral library interface.
+
+  Description
+    This file defines the data types of the SERCOM I2C slave peripheral
+    library.
+
+  Remarks:
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_SERCOM_I2C_SLAVE_COMMON_H
+#define PLIB_SERCOM_I2C_SLAVE_COMMON_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+/* This section lists the other files that are included in this file.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* SERCOM I2C Slave Transfer Direction
+
+  Summary:
+    Direction of the transfer as seen from the I2C master.
+
+  Description:
+    This enum is returned by the SERCOMx_I2C_TransferDirGet() function.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* Master writes data, slave receives */
+    SERCOM_I2C_SLAVE_TRANSFER_DIR_WRITE = 0,
+
+    /* Master reads data, slave transmits */
+    SERCOM_I2C_SLAVE_TRANSFER_DIR_READ  = 1,
+
+} SERCOM_I2C_SLAVE_TRANSFER_DIR;
+
+// *****************************************************************************
+/* SERCOM I2C Slave ACK Status
+
+  Summary:
+    ACK or NAK received from the I2C master for the last transmitted byte.
+
+  Description:
+    This enum is returned by the SERCOMx_I2C_LastByteAckStatusGet() function.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    SERCOM_I2C_SLAVE_ACK_STATUS_RECEIVED_ACK = 0,
+
+    SERCOM_I2C_SLAVE_ACK_STATUS_RECEIVED_NAK,
+
+} SERCOM_I2C_SLAVE_ACK_STATUS;
+
+// *****************************************************************************
+/* SERCOM I2C Slave Transfer Event
+
+  Summary:
+    Events reported to the application callback.
+
+  Description:
+    The application callback is called from the interrupt handler with one of
+    these events. For SERCOM_I2C_SLAVE_TRANSFER_EVENT_ADDR_MATCH and
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_RX_READY the callback return value selects
+    whether the address or the received byte is ACK'ed (true) or NAK'ed
+    (false).
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_NONE = 0,
+
+    /* Own address received. SERCOMx_I2C_TransferDirGet() gives the direction. */
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_ADDR_MATCH,
+
+    /* A byte is received, read it with SERCOMx_I2C_ReadByte() */
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_RX_READY,
+
+    /* The master requests a byte, provide it with SERCOMx_I2C_WriteByte() */
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_TX_READY,
+
+    /* The transfer is ended by a stop condition */
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_STOP_BIT_RECEIVED,
+
+    /* Bus error, collision or SCL low timeout, see SERCOMx_I2C_ErrorGet() */
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT_ERROR,
+
+} SERCOM_I2C_SLAVE_TRANSFER_EVENT;
+
+// *****************************************************************************
+/* SERCOM I2C Slave Error
+
+  Summary:
+    Errors reported by the SERCOMx_I2C_ErrorGet() function.
+
+  Description:
+    The values are the corresponding STATUS register bits and may be combined.
+
+  Remarks:
+    None.
+*/
+
+typedef uint32_t SERCOM_I2C_SLAVE_ERROR;
+
+#define SERCOM_I2C_SLAVE_ERROR_NONE         (0UL)
+#define SERCOM_I2C_SLAVE_ERROR_BUSERR       ((uint32_t)SERCOM_I2CS_STATUS_BUSERR_Msk)
+#define SERCOM_I2C_SLAVE_ERROR_COLL         ((uint32_t)SERCOM_I2CS_STATUS_COLL_Msk)
+#define SERCOM_I2C_SLAVE_ERROR_LOWTOUT      ((uint32_t)SERCOM_I2CS_STATUS_LOWTOUT_Msk)
+#define SERCOM_I2C_SLAVE_ERROR_SEXTTOUT     ((uint32_t)SERCOM_I2CS_STATUS_SEXTTOUT_Msk)
+#define SERCOM_I2C_SLAVE_ERROR_ALL          (SERCOM_I2C_SLAVE_ERROR_BUSERR | SERCOM_I2C_SLAVE_ERROR_COLL | \
+                                             SERCOM_I2C_SLAVE_ERROR_LOWTOUT | SERCOM_I2C_SLAVE_ERROR_SEXTTOUT)
+
+// *****************************************************************************
+/* SERCOM I2C Slave Callback
+
+   Summary:
+    SERCOM I2C Slave Callback Function Pointer.
+
+   Description:
+    This data type defines the SERCOM I2C Slave Callback Function Pointer. It
+    is called from the interrupt handler.
+
+   Remarks:
+    None.
+*/
+
+typedef bool (*SERCOM_I2C_SLAVE_CALLBACK)
+(
+    SERCOM_I2C_SLAVE_TRANSFER_EVENT event,
+
+    /*Transfer context*/
+    uintptr_t contextHandle
+
+);
+
+// *****************************************************************************
+/* SERCOM I2C Slave PLib Instance Object
+
+   Summary:
+    SERCOM I2C Slave PLib Object structure.
+
+   Description:
+    This data structure defines the SERCOM I2C Slave PLib Instance Object.
+
+   Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Set from address match until the stop condition */
+    volatile bool               isBusy;
+
+    /* The first byte of a read is requested without a preceding ACK */
+    bool                        isFirstTxPending;
+
+    volatile SERCOM_I2C_SLAVE_ERROR error;
+
+    /* Transfer Event Callback */
+    SERCOM_I2C_SLAVE_CALLBACK   callback;
+
+    /* Transfer context */
+    uintptr_t                   context;
+
+} SERCOM_I2C_SLAVE_OBJ;
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif /* PLIB_SERCOM_I2C_SLAVE_COMMON_H */
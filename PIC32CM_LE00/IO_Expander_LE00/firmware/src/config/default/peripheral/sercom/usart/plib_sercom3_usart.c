@@ -50,6 +50,8 @@
 
 #include "interrupts.h"
 #include "plib_sercom3_usart.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "peripheral/clock/plib_clock.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -61,6 +63,58 @@
 /* SERCOM3 USART baud value for 115200 Hz baud rate */
 #define SERCOM3_USART_INT_BAUD_VALUE            (63019UL)
 
+/* Transmit ring buffer size, one byte is kept free to tell full from empty */
+#define SERCOM3_USART_WRITE_BUFFER_SIZE         (1024U)
+
+/* DMAC channel draining the transmit ring buffer. Remove to fall back to the
+ * DRE interrupt, one interrupt per byte. */
+#define SERCOM3_USART_WRITE_DMA_CHANNEL         DMAC_CHANNEL_0
+
+/* Behavior of SERCOM3_USART_Write when the ring buffer is full */
+#define SERCOM3_USART_WRITE_OVERFLOW_POLICY     SERCOM_USART_WRITE_OVERFLOW_COUNT
+
+/* Receive ring buffer size, one byte is kept free to tell full from empty */
+#define SERCOM3_USART_READ_BUFFER_SIZE          (128U)
+
+static SERCOM_USART_RING_BUFFER_OBJECT sercom3USARTObj;
+
+/* Baud rate generator setting of the last SERCOM3_USART_SerialSetup */
+static USART_BAUD_SETUP sercom3USARTBaudSetup;
+
+/* Baud generation modes tried by SERCOM3_USART_BaudCalculate, the first of
+ * equal error wins */
+typedef struct
+{
+    uint8_t oversampling;
+
+    uint8_t sampleRate;
+
+    bool isFractional;
+
+} SERCOM_USART_BAUD_MODE;
+
+static const SERCOM_USART_BAUD_MODE sercom3USARTBaudModes[] =
+{
+    { 16U, 0U, false },
+    { 16U, 1U, true },
+    { 8U, 2U, false },
+    { 8U, 3U, true },
+    { 3U, 4U, false },
+};
+
+static uint8_t SERCOM3_USART_WriteBuffer[SERCOM3_USART_WRITE_BUFFER_SIZE];
+
+static uint8_t SERCOM3_USART_ReadBuffer[SERCOM3_USART_READ_BUFFER_SIZE];
+
+#if defined(SERCOM3_USART_WRITE_DMA_CHANNEL)
+/* Descriptor for the part of a job from the ring buffer start, linked after
+ * the one from the read index to the end when the queued data wraps */
+static dmac_descriptor_registers_t sercom3USARTTxWrapDesc __ALIGNED(8);
+
+/* Bytes owned by the running DMA job, released from the ring on completion */
+static volatile uint32_t sercom3USARTTxDmaCount;
+#endif
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -91,6 +145,97 @@ void static SERCOM3_USART_ErrorClear( void )
     (void)u8dummyData;
 }
 
+#if defined(SERCOM3_USART_WRITE_DMA_CHANNEL)
+/* Hands everything queued to the DMAC as one job: the bytes from the read
+ * index to the end of the ring, then, if the data wraps, a linked block from
+ * the ring start. Only the last block raises an interrupt. Must not be
+ * preempted by the DMA completion callback. */
+static void SERCOM3_USART_TxDmaStart( void )
+{
+    dmac_descriptor_registers_t txDesc;
+    uint32_t wrInIndex = sercom3USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom3USARTObj.wrOutIndex;
+    uint32_t firstSize;
+    uint32_t wrapSize;
+
+    if ((sercom3USARTTxDmaCount != 0U) || (wrInIndex == wrOutIndex))
+    {
+        return;
+    }
+
+    if (wrInIndex > wrOutIndex)
+    {
+        firstSize = wrInIndex - wrOutIndex;
+        wrapSize = 0U;
+    }
+    else
+    {
+        firstSize = sercom3USARTObj.wrBufferSize - wrOutIndex;
+        wrapSize = wrInIndex;
+    }
+
+    /* Incrementing source addresses are given as the end of the block */
+    txDesc.DMAC_BTCNT = (uint16_t)firstSize;
+    txDesc.DMAC_SRCADDR = (uint32_t)&SERCOM3_USART_WriteBuffer[wrOutIndex] + firstSize;
+    txDesc.DMAC_DSTADDR = (uint32_t)&SERCOM3_REGS->USART_INT.SERCOM_DATA;
+
+    if (wrapSize == 0U)
+    {
+        txDesc.DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+        txDesc.DMAC_DESCADDR = 0U;
+    }
+    else
+    {
+        txDesc.DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+        txDesc.DMAC_DESCADDR = (uint32_t)&sercom3USARTTxWrapDesc;
+
+        sercom3USARTTxWrapDesc.DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+        sercom3USARTTxWrapDesc.DMAC_BTCNT = (uint16_t)wrapSize;
+        sercom3USARTTxWrapDesc.DMAC_SRCADDR = (uint32_t)&SERCOM3_USART_WriteBuffer[0] + wrapSize;
+        sercom3USARTTxWrapDesc.DMAC_DSTADDR = (uint32_t)&SERCOM3_REGS->USART_INT.SERCOM_DATA;
+        sercom3USARTTxWrapDesc.DMAC_DESCADDR = 0U;
+    }
+
+    if (DMAC_ChannelLinkedListTransfer(SERCOM3_USART_WRITE_DMA_CHANNEL, &txDesc) == true)
+    {
+        sercom3USARTTxDmaCount = firstSize + wrapSize;
+    }
+}
+
+/* Runs in the DMAC interrupt: releases the sent bytes and chains the next job */
+static void SERCOM3_USART_TxDmaCallback( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    uint32_t wrOutIndex = sercom3USARTObj.wrOutIndex + sercom3USARTTxDmaCount;
+
+    if (wrOutIndex >= sercom3USARTObj.wrBufferSize)
+    {
+        wrOutIndex -= sercom3USARTObj.wrBufferSize;
+    }
+
+    /* On a transfer error the job is dropped as if it had been sent, so the
+     * ring keeps moving */
+    sercom3USARTObj.wrOutIndex = wrOutIndex;
+
+    sercom3USARTTxDmaCount = 0U;
+
+    SERCOM3_USART_TxDmaStart();
+}
+
+static void SERCOM3_USART_TxDmaKick( void )
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    SERCOM3_USART_TxDmaStart();
+
+    if (primask == 0U)
+    {
+        __enable_irq();
+    }
+}
+#endif
+
 void SERCOM3_USART_Initialize( void )
 {
     /*
@@ -121,6 +266,27 @@ void SERCOM3_USART_Initialize( void )
         /* Do nothing */
     }
 
+    /* Initialize instance object, the DRE interrupt (or the DMA channel) is
+     * started on demand by SERCOM3_USART_Write */
+    sercom3USARTObj.wrCallback = NULL;
+    sercom3USARTObj.wrInIndex = 0U;
+    sercom3USARTObj.wrOutIndex = 0U;
+    sercom3USARTObj.wrBufferSize = SERCOM3_USART_WRITE_BUFFER_SIZE;
+    sercom3USARTObj.isWrNotificationEnabled = false;
+    sercom3USARTObj.wrOverflowPolicy = SERCOM3_USART_WRITE_OVERFLOW_POLICY;
+    sercom3USARTObj.wrOverflowCount = 0U;
+
+    sercom3USARTObj.rdCallback = NULL;
+    sercom3USARTObj.rdInIndex = 0U;
+    sercom3USARTObj.rdOutIndex = 0U;
+    sercom3USARTObj.rdBufferSize = SERCOM3_USART_READ_BUFFER_SIZE;
+    sercom3USARTObj.isRdNotificationEnabled = false;
+    sercom3USARTObj.errorStatus = USART_ERROR_NONE;
+
+#if defined(SERCOM3_USART_WRITE_DMA_CHANNEL)
+    sercom3USARTTxDmaCount = 0U;
+    DMAC_ChannelCallbackRegister(SERCOM3_USART_WRITE_DMA_CHANNEL, SERCOM3_USART_TxDmaCallback, 0U);
+#endif
 
     /* Enable the UART after the configurations */
     SERCOM3_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
@@ -130,45 +296,126 @@ void SERCOM3_USART_Initialize( void )
     {
         /* Do nothing */
     }
+
+    /* Received bytes and receive errors are taken by the interrupt into the
+     * read ring buffer */
+    SERCOM3_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)(SERCOM_USART_INT_INTENSET_RXC_Msk | SERCOM_USART_INT_INTENSET_ERROR_Msk);
 }
 
 uint32_t SERCOM3_USART_FrequencyGet( void )
 {
-    return 48000000UL;
+    /* Generator 0, 48 MHz or 16 MHz */
+    return CLOCK_Gclk0FrequencyGet();
 }
 
-bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency )
+/* Setting for one baud generation mode, false if the rate is out of its range */
+static bool SERCOM3_USART_BaudModeCalculate( const SERCOM_USART_BAUD_MODE* mode, uint32_t baudRate, uint32_t clkFrequency, USART_BAUD_SETUP* setup )
 {
-    bool setupStatus       = false;
-    uint32_t baudValue     = 0U;
-    uint32_t sampleRate    = 0U;
+    uint64_t scaledRate = (uint64_t)mode->oversampling * baudRate;
+    uint64_t rateNumerator;
+    uint64_t rateDenominator;
+    uint32_t increment;
+    uint32_t period;
+    uint32_t errorPpm;
+    bool isJitter;
+
+    if(clkFrequency < scaledRate)
+    {
+        return false;
+    }
 
-    if((serialSetup != NULL) && (serialSetup->baudRate != 0U))
+    if(mode->isFractional == false)
     {
-        if(clkFrequency == 0U)
-        {
-            clkFrequency = SERCOM3_USART_FrequencyGet();
-        }
+        /* The sample clock advances by increment/65536 of a clock */
+        increment = (uint32_t)((((uint64_t)65536U * scaledRate) + (clkFrequency / 2U)) / clkFrequency);
 
-        if(clkFrequency >= (16U * serialSetup->baudRate))
-        {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 16U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 0U;
-        }
-        else if(clkFrequency >= (8U * serialSetup->baudRate))
+        if(increment == 0U)
         {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 8U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 2U;
+            return false;
         }
-        else if(clkFrequency >= (3U * serialSetup->baudRate))
+
+        setup->baudValue = (uint16_t)(65536U - increment);
+        rateNumerator = (uint64_t)clkFrequency * increment;
+        rateDenominator = (uint64_t)65536U * mode->oversampling;
+        isJitter = ((65536U % increment) != 0U);
+    }
+    else
+    {
+        /* The sample period is BAUD + FP/8 clocks */
+        period = (uint32_t)((((uint64_t)8U * clkFrequency) + (scaledRate / 2U)) / scaledRate);
+
+        if((period < 8U) || ((period / 8U) > (SERCOM_USART_INT_BAUD_FRAC_BAUD_Msk >> SERCOM_USART_INT_BAUD_FRAC_BAUD_Pos)))
         {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 3U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 4U;
+            return false;
         }
-        else
+
+        setup->baudValue = (uint16_t)(SERCOM_USART_INT_BAUD_FRAC_BAUD(period / 8U) | SERCOM_USART_INT_BAUD_FRAC_FP(period % 8U));
+        rateNumerator = (uint64_t)8U * clkFrequency;
+        rateDenominator = (uint64_t)period * mode->oversampling;
+        isJitter = ((period % 8U) != 0U);
+    }
+
+    setup->sampleRate = mode->sampleRate;
+    setup->baudRate = (uint32_t)((rateNumerator + (rateDenominator / 2U)) / rateDenominator);
+    setup->errorPpm = (int32_t)((((int64_t)rateNumerator - ((int64_t)rateDenominator * baudRate)) * 1000000) / ((int64_t)rateDenominator * baudRate));
+
+    errorPpm = (setup->errorPpm < 0) ? (uint32_t)(-setup->errorPpm) : (uint32_t)setup->errorPpm;
+    setup->sampleErrorPpm = (errorPpm * 19U) / 2U;
+
+    if(isJitter == true)
+    {
+        setup->sampleErrorPpm += (uint32_t)(((uint64_t)1000000U * baudRate) / clkFrequency);
+    }
+
+    /* A receiver finds the start bit edge to within one sample */
+    setup->sampleErrorPpm += 500000U / mode->oversampling;
+
+    return true;
+}
+
+bool SERCOM3_USART_BaudCalculate( uint32_t baudRate, uint32_t clkFrequency, USART_BAUD_SETUP* setup )
+{
+    USART_BAUD_SETUP candidate;
+    bool isFound = false;
+    uint32_t index;
+
+    if((setup == NULL) || (baudRate == 0U))
+    {
+        return false;
+    }
+
+    if(clkFrequency == 0U)
+    {
+        clkFrequency = SERCOM3_USART_FrequencyGet();
+    }
+
+    for(index = 0U; index < (sizeof(sercom3USARTBaudModes) / sizeof(sercom3USARTBaudModes[0])); index++)
+    {
+        if(SERCOM3_USART_BaudModeCalculate(&sercom3USARTBaudModes[index], baudRate, clkFrequency, &candidate) == true)
         {
-            /* Do nothing */
+            if((isFound == false) || (candidate.sampleErrorPpm < setup->sampleErrorPpm))
+            {
+                *setup = candidate;
+                isFound = true;
+            }
         }
+    }
+
+    return isFound;
+}
+
+void SERCOM3_USART_BaudSetupGet( USART_BAUD_SETUP* setup )
+{
+    *setup = sercom3USARTBaudSetup;
+}
+
+bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency )
+{
+    bool setupStatus       = false;
+    USART_BAUD_SETUP baudSetup;
+
+    if((serialSetup != NULL) && (SERCOM3_USART_BaudCalculate(serialSetup->baudRate, clkFrequency, &baudSetup) == true))
+    {
 
         /* Disable the USART before configurations */
         SERCOM3_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
@@ -180,17 +427,17 @@ bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFr
         }
 
         /* Configure Baud Rate */
-        SERCOM3_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(baudValue);
+        SERCOM3_REGS->USART_INT.SERCOM_BAUD = baudSetup.baudValue;
 
         /* Configure Parity Options */
         if(serialSetup->parity == USART_PARITY_NONE)
         {
-            SERCOM3_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM3_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
+            SERCOM3_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM3_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)baudSetup.sampleRate); 
             SERCOM3_REGS->USART_INT.SERCOM_CTRLB = (SERCOM3_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk)) | ((uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits);
         }
         else
         {
-            SERCOM3_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM3_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x1UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
+            SERCOM3_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM3_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x1UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)baudSetup.sampleRate); 
             SERCOM3_REGS->USART_INT.SERCOM_CTRLB = (SERCOM3_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk | SERCOM_USART_INT_CTRLB_PMODE_Msk)) | (uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits | (uint32_t) serialSetup->parity ;
         }
 
@@ -209,20 +456,20 @@ bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFr
             /* Do nothing */
         }
 
+        sercom3USARTBaudSetup = baudSetup;
         setupStatus = true;
     }
 
     return setupStatus;
 }
 
+/* Errors seen by the receive interrupt since the last call. USART_ERROR_OVERRUN
+ * also reports bytes lost to a full read ring buffer. */
 USART_ERROR SERCOM3_USART_ErrorGet( void )
 {
-    USART_ERROR errorStatus = (USART_ERROR) (SERCOM3_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk ));
+    USART_ERROR errorStatus = sercom3USARTObj.errorStatus;
 
-    if(errorStatus != USART_ERROR_NONE)
-    {
-        SERCOM3_USART_ErrorClear();
-    }
+    sercom3USARTObj.errorStatus = USART_ERROR_NONE;
 
     return errorStatus;
 }
@@ -250,45 +497,194 @@ void SERCOM3_USART_TransmitterDisable( void )
     }
 }
 
-bool SERCOM3_USART_Write( void *buffer, const size_t size )
+/* Only the TX interrupt (or SERCOM3_USART_WriteSpaceWait with interrupts off)
+ * consumes the ring buffer, only SERCOM3_USART_Write fills it. With the DMA
+ * channel configured, the DMA completion callback is the consumer instead. */
+static bool SERCOM3_USART_TxPullByte(uint8_t* pWrByte)
 {
-    bool writeStatus      = false;
-    uint8_t *pu8Data      = (uint8_t*)buffer;
-    uint16_t *pu16Data    = (uint16_t*)buffer;
-    uint32_t u32Index     = 0U;
+    uint32_t wrOutIndex = sercom3USARTObj.wrOutIndex;
+    bool isSuccess = false;
 
-    if(buffer != NULL)
+    if (wrOutIndex != sercom3USARTObj.wrInIndex)
     {
-        /* Blocks while buffer is being transferred */
-        while(u32Index < size)
+        *pWrByte = SERCOM3_USART_WriteBuffer[wrOutIndex];
+
+        wrOutIndex++;
+
+        if (wrOutIndex >= sercom3USARTObj.wrBufferSize)
         {
-            /* Check if USART is ready for new data */
-            while((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
-            {
-                /* Do nothing */
-            }
+            wrOutIndex = 0U;
+        }
 
-            /* Write data to USART module */
-            if (((SERCOM3_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
-            {
-                /* 8-bit mode */
-                SERCOM3_REGS->USART_INT.SERCOM_DATA = pu8Data[u32Index];
-            }
-            else
+        sercom3USARTObj.wrOutIndex = wrOutIndex;
+
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+static inline bool SERCOM3_USART_TxPushByte(uint8_t wrByte)
+{
+    uint32_t wrInIndex = sercom3USARTObj.wrInIndex;
+    uint32_t tempInIndex = wrInIndex + 1U;
+    bool isSuccess = false;
+
+    if (tempInIndex >= sercom3USARTObj.wrBufferSize)
+    {
+        tempInIndex = 0U;
+    }
+
+    if (tempInIndex != sercom3USARTObj.wrOutIndex)
+    {
+        SERCOM3_USART_WriteBuffer[wrInIndex] = wrByte;
+
+        sercom3USARTObj.wrInIndex = tempInIndex;
+
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+static void SERCOM3_USART_ISR_TX_Handler( void )
+{
+    uint8_t wrByte;
+
+    if (SERCOM3_USART_TxPullByte(&wrByte) == true)
+    {
+        SERCOM3_REGS->USART_INT.SERCOM_DATA = wrByte;
+    }
+    else
+    {
+        /* Nothing left to send */
+        SERCOM3_REGS->USART_INT.SERCOM_INTENCLR = (uint8_t)SERCOM_USART_INT_INTENCLR_DRE_Msk;
+    }
+}
+
+/* Ring buffer full under the blocking policy: make room for one byte */
+static void SERCOM3_USART_WriteSpaceWait( void )
+{
+    uint32_t primask = __get_PRIMASK();
+
+#if defined(SERCOM3_USART_WRITE_DMA_CHANNEL)
+    SERCOM3_USART_TxDmaKick();
+
+    if ((primask != 0U) || (__get_IPSR() != 0U))
+    {
+        /* The DMAC interrupt may not get to run, poll the channel to the end
+         * of the running job; the callback releases it and starts the next */
+        while (DMAC_ChannelIsBusy(SERCOM3_USART_WRITE_DMA_CHANNEL) == true)
+        {
+            DMAC_InterruptHandler();
+        }
+    }
+#else
+    SERCOM3_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_DRE_Msk;
+
+    if ((primask != 0U) || (__get_IPSR() != 0U))
+    {
+        /* The TX interrupt may not get to run, feed the transmitter from here
+         * with interrupts off so that the two never consume at once */
+        __disable_irq();
+
+        while((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+        {
+            /* Do nothing */
+        }
+
+        SERCOM3_USART_ISR_TX_Handler();
+
+        if (primask == 0U)
+        {
+            __enable_irq();
+        }
+    }
+#endif
+
+    /* Otherwise the TX (or DMAC) interrupt frees room within one character
+     * time (or one job) */
+}
+
+/* Queues 8-bit characters for the TX interrupt and returns without waiting for
+ * them to go out. Returns the number of bytes queued; under the drop and count
+ * policies, bytes that did not fit are lost. */
+size_t SERCOM3_USART_Write( uint8_t* pWrBuffer, const size_t size )
+{
+    size_t nBytesWritten = 0U;
+
+    if (pWrBuffer == NULL)
+    {
+        return 0U;
+    }
+
+    while (nBytesWritten < size)
+    {
+        if (SERCOM3_USART_TxPushByte(pWrBuffer[nBytesWritten]) == true)
+        {
+            nBytesWritten++;
+        }
+        else if (sercom3USARTObj.wrOverflowPolicy == SERCOM_USART_WRITE_OVERFLOW_BLOCK)
+        {
+            SERCOM3_USART_WriteSpaceWait();
+        }
+        else
+        {
+            if (sercom3USARTObj.wrOverflowPolicy == SERCOM_USART_WRITE_OVERFLOW_COUNT)
             {
-                /* 9-bit mode */
-                SERCOM3_REGS->USART_INT.SERCOM_DATA = pu16Data[u32Index];
+                sercom3USARTObj.wrOverflowCount += (uint32_t)(size - nBytesWritten);
             }
-
-            /* Increment index */
-            u32Index++;
+            break;
         }
-        writeStatus = true;
     }
 
-    return writeStatus;
+    if (nBytesWritten > 0U)
+    {
+        /* Start, or keep, the transmitter draining the ring buffer */
+#if defined(SERCOM3_USART_WRITE_DMA_CHANNEL)
+        SERCOM3_USART_TxDmaKick();
+#else
+        SERCOM3_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_DRE_Msk;
+#endif
+    }
+
+    return nBytesWritten;
 }
 
+/* Bytes queued and not yet handed to the transmitter */
+size_t SERCOM3_USART_WriteCountGet( void )
+{
+    uint32_t wrInIndex = sercom3USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom3USARTObj.wrOutIndex;
+
+    if (wrInIndex >= wrOutIndex)
+    {
+        return wrInIndex - wrOutIndex;
+    }
+
+    return (sercom3USARTObj.wrBufferSize - wrOutIndex) + wrInIndex;
+}
+
+size_t SERCOM3_USART_WriteFreeBufferCountGet( void )
+{
+    return (sercom3USARTObj.wrBufferSize - 1U) - SERCOM3_USART_WriteCountGet();
+}
+
+size_t SERCOM3_USART_WriteBufferSizeGet( void )
+{
+    return (sercom3USARTObj.wrBufferSize - 1U);
+}
+
+void SERCOM3_USART_WriteOverflowPolicySet( SERCOM_USART_WRITE_OVERFLOW_POLICY policy )
+{
+    sercom3USARTObj.wrOverflowPolicy = policy;
+}
+
+/* Bytes dropped under SERCOM_USART_WRITE_OVERFLOW_COUNT */
+uint32_t SERCOM3_USART_WriteOverflowCountGet( void )
+{
+    return sercom3USARTObj.wrOverflowCount;
+}
 
 bool SERCOM3_USART_TransmitterIsReady( void )
 {
@@ -302,15 +698,12 @@ bool SERCOM3_USART_TransmitterIsReady( void )
     return transmitterStatus;
 }
 
+/* Goes through the ring buffer to stay in order with SERCOM3_USART_Write */
 void SERCOM3_USART_WriteByte( int data )
 {
-    /* Check if USART is ready for new data */
-    while((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
-    {
-        /* Do nothing */
-    }
+    uint8_t wrByte = (uint8_t)data;
 
-    SERCOM3_REGS->USART_INT.SERCOM_DATA = (uint16_t)data;
+    (void)SERCOM3_USART_Write(&wrByte, 1U);
 }
 
 bool SERCOM3_USART_TransmitComplete( void )
@@ -347,73 +740,133 @@ void SERCOM3_USART_ReceiverDisable( void )
     }
 }
 
-bool SERCOM3_USART_Read( void *buffer, const size_t size )
+/* Only the RX interrupt fills the read ring buffer, only the read functions
+ * below empty it */
+static void SERCOM3_USART_ISR_RX_Handler( void )
 {
-    bool readStatus         = false;
-    uint8_t* pu8Data        = (uint8_t*)buffer;
-    uint16_t *pu16Data      = (uint16_t*)buffer;
-    uint32_t u32Index       = 0U;
-    USART_ERROR errorStatus = USART_ERROR_NONE;
+    uint32_t rdInIndex;
+    uint32_t tempInIndex;
+    uint8_t rdByte;
 
-    if(buffer != NULL)
+    while((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) != 0U)
     {
+        rdByte = (uint8_t)SERCOM3_REGS->USART_INT.SERCOM_DATA;
 
-        /* Clear error flags and flush out error data that may have been received when no active request was pending */
-        SERCOM3_USART_ErrorClear();
+        rdInIndex = sercom3USARTObj.rdInIndex;
+        tempInIndex = rdInIndex + 1U;
 
-        while(u32Index < size)
+        if (tempInIndex >= sercom3USARTObj.rdBufferSize)
         {
-            /* Check if USART has new data */
-            while((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == 0U)
-            {
-                /* Do nothing */
-            }
+            tempInIndex = 0U;
+        }
 
-            errorStatus = (USART_ERROR) (SERCOM3_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk));
+        if (tempInIndex != sercom3USARTObj.rdOutIndex)
+        {
+            SERCOM3_USART_ReadBuffer[rdInIndex] = rdByte;
+            sercom3USARTObj.rdInIndex = tempInIndex;
+        }
+        else
+        {
+            /* Ring buffer full, the byte is lost */
+            sercom3USARTObj.errorStatus |= USART_ERROR_OVERRUN;
+        }
+    }
+}
 
-            if(errorStatus != USART_ERROR_NONE)
-            {
-                break;
-            }
+static void SERCOM3_USART_ISR_ERR_Handler( void )
+{
+    sercom3USARTObj.errorStatus |= (USART_ERROR) (SERCOM3_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk));
 
-            if (((SERCOM3_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
-            {
-                /* 8-bit mode */
-                pu8Data[u32Index] = (uint8_t)SERCOM3_REGS->USART_INT.SERCOM_DATA;
-            }
-            else
-            {
-                /* 9-bit mode */
-                pu16Data[u32Index] = (uint16_t)SERCOM3_REGS->USART_INT.SERCOM_DATA;
-            }
+    /* Drops the bytes received with the error */
+    SERCOM3_USART_ErrorClear();
+}
 
-            /* Increment index */
-            u32Index++;
-        }
+/* Copies up to size received bytes and returns how many there were, without
+ * waiting for more */
+size_t SERCOM3_USART_Read( uint8_t* pRdBuffer, const size_t size )
+{
+    uint32_t rdOutIndex = sercom3USARTObj.rdOutIndex;
+    uint32_t rdInIndex = sercom3USARTObj.rdInIndex;
+    size_t nBytesRead = 0U;
 
-        if(size == u32Index)
+    if (pRdBuffer == NULL)
+    {
+        return 0U;
+    }
+
+    while ((nBytesRead < size) && (rdOutIndex != rdInIndex))
+    {
+        pRdBuffer[nBytesRead] = SERCOM3_USART_ReadBuffer[rdOutIndex];
+        nBytesRead++;
+
+        rdOutIndex++;
+
+        if (rdOutIndex >= sercom3USARTObj.rdBufferSize)
         {
-            readStatus = true;
+            rdOutIndex = 0U;
         }
     }
 
-    return readStatus;
+    sercom3USARTObj.rdOutIndex = rdOutIndex;
+
+    return nBytesRead;
 }
 
-bool SERCOM3_USART_ReceiverIsReady( void )
+size_t SERCOM3_USART_ReadCountGet( void )
 {
-    bool receiverStatus = false;
+    uint32_t rdInIndex = sercom3USARTObj.rdInIndex;
+    uint32_t rdOutIndex = sercom3USARTObj.rdOutIndex;
 
-    if ((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == SERCOM_USART_INT_INTFLAG_RXC_Msk)
+    if (rdInIndex >= rdOutIndex)
     {
-        receiverStatus = true;
+        return rdInIndex - rdOutIndex;
     }
 
-    return receiverStatus;
+    return (sercom3USARTObj.rdBufferSize - rdOutIndex) + rdInIndex;
+}
+
+size_t SERCOM3_USART_ReadFreeBufferCountGet( void )
+{
+    return (sercom3USARTObj.rdBufferSize - 1U) - SERCOM3_USART_ReadCountGet();
+}
+
+size_t SERCOM3_USART_ReadBufferSizeGet( void )
+{
+    return (sercom3USARTObj.rdBufferSize - 1U);
+}
+
+bool SERCOM3_USART_ReceiverIsReady( void )
+{
+    return (SERCOM3_USART_ReadCountGet() != 0U);
 }
 
+/* Next byte of the read ring buffer, check SERCOM3_USART_ReceiverIsReady first */
 int SERCOM3_USART_ReadByte( void )
 {
-    return (int)SERCOM3_REGS->USART_INT.SERCOM_DATA;
+    uint8_t rdByte = 0U;
+
+    (void)SERCOM3_USART_Read(&rdByte, 1U);
+
+    return (int)rdByte;
 }
 
+void SERCOM3_USART_InterruptHandler( void )
+{
+    if (((SERCOM3_REGS->USART_INT.SERCOM_INTENSET & SERCOM_USART_INT_INTENSET_ERROR_Msk) != 0U) &&
+        ((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_ERROR_Msk) != 0U))
+    {
+        SERCOM3_USART_ISR_ERR_Handler();
+    }
+
+    if (((SERCOM3_REGS->USART_INT.SERCOM_INTENSET & SERCOM_USART_INT_INTENSET_RXC_Msk) != 0U) &&
+        ((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) != 0U))
+    {
+        SERCOM3_USART_ISR_RX_Handler();
+    }
+
+    if (((SERCOM3_REGS->USART_INT.SERCOM_INTENSET & SERCOM_USART_INT_INTENSET_DRE_Msk) != 0U) &&
+        ((SERCOM3_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) != 0U))
+    {
+        SERCOM3_USART_ISR_TX_Handler();
+    }
+}
@@ -71,11 +71,28 @@ void SERCOM3_USART_Initialize( void );
 
 bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency );
 
+/* Picks the oversampling and the arithmetic or fractional baud generation with
+ * the smallest stop bit sample error, without touching the peripheral */
+bool SERCOM3_USART_BaudCalculate( uint32_t baudRate, uint32_t clkFrequency, USART_BAUD_SETUP* setup );
+
+/* Setting of the last SERCOM3_USART_SerialSetup */
+void SERCOM3_USART_BaudSetupGet( USART_BAUD_SETUP* setup );
+
 void SERCOM3_USART_TransmitterEnable( void );
 
 void SERCOM3_USART_TransmitterDisable( void );
 
-bool SERCOM3_USART_Write( void *buffer, const size_t size );
+size_t SERCOM3_USART_Write( uint8_t* pWrBuffer, const size_t size );
+
+size_t SERCOM3_USART_WriteCountGet( void );
+
+size_t SERCOM3_USART_WriteFreeBufferCountGet( void );
+
+size_t SERCOM3_USART_WriteBufferSizeGet( void );
+
+void SERCOM3_USART_WriteOverflowPolicySet( SERCOM_USART_WRITE_OVERFLOW_POLICY policy );
+
+uint32_t SERCOM3_USART_WriteOverflowCountGet( void );
 
 bool SERCOM3_USART_TransmitComplete( void );
 
@@ -89,7 +106,13 @@ void SERCOM3_USART_ReceiverEnable( void );
 
 void SERCOM3_USART_ReceiverDisable( void );
 
-bool SERCOM3_USART_Read( void *buffer, const size_t size );
+size_t SERCOM3_USART_Read( uint8_t* pRdBuffer, const size_t size );
+
+size_t SERCOM3_USART_ReadCountGet( void );
+
+size_t SERCOM3_USART_ReadFreeBufferCountGet( void );
+
+size_t SERCOM3_USART_ReadBufferSizeGet( void );
 
 bool SERCOM3_USART_ReceiverIsReady( void );
 
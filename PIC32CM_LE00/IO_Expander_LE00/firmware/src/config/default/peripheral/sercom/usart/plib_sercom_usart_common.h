@@ -245,6 +245,41 @@ typedef struct
 
 } USART_SERIAL_SETUP;
 
+// *****************************************************************************
+/* USART Baud Setup
+
+  Summary:
+    Defines the data type for a baud rate generator setting.
+
+  Description:
+    This may be used to check the baud rate a serial setup results in.
+    sampleRate is the CTRLA.SAMPR value: 16x, 8x or 3x oversampling, with
+    arithmetic or fractional baud generation.  baudValue is the BAUD
+    register value, with the fractional part in bits 13-15 in fractional
+    mode.
+
+  Remarks:
+    sampleErrorPpm is the worst offset of the stop bit sample from the
+    middle of the bit, in millionths of a bit: the rate error over 9.5 bits,
+    one peripheral clock of sample clock jitter when the sample period is
+    not a whole number of clocks, and half a sample period for finding the
+    start bit edge.
+*/
+
+typedef struct
+{
+    uint32_t baudRate;
+
+    int32_t errorPpm;
+
+    uint32_t sampleErrorPpm;
+
+    uint16_t baudValue;
+
+    uint8_t sampleRate;
+
+} USART_BAUD_SETUP;
+
 // *****************************************************************************
 /* Callback Function Pointer
 
@@ -344,6 +379,33 @@ typedef enum
 
 typedef void (*SERCOM_USART_RING_BUFFER_CALLBACK)(SERCOM_USART_EVENT event, uintptr_t context );
 
+// *****************************************************************************
+/* USART Write Overflow Policy
+
+  Summary:
+    Defines what a ring buffer write does when the transmit buffer is full.
+
+  Description:
+    This may be used to select the behavior of the ring buffer write function
+    when more data is written than there is free space in the transmit buffer.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* Data that does not fit is discarded */
+    SERCOM_USART_WRITE_OVERFLOW_DROP = 0,
+
+    /* The write waits for the transmitter to free up space */
+    SERCOM_USART_WRITE_OVERFLOW_BLOCK,
+
+    /* Data that does not fit is discarded and the dropped bytes are counted */
+    SERCOM_USART_WRITE_OVERFLOW_COUNT,
+
+} SERCOM_USART_WRITE_OVERFLOW_POLICY;
+
 // *****************************************************************************
 /* SERCOM USART Ring Buffer Object
 
@@ -376,6 +438,10 @@ typedef struct
 
     bool                                                isWrNotifyPersistently;
 
+    SERCOM_USART_WRITE_OVERFLOW_POLICY                  wrOverflowPolicy;
+
+    volatile uint32_t                                   wrOverflowCount;
+
     SERCOM_USART_RING_BUFFER_CALLBACK                   rdCallback;
 
     uintptr_t                                           rdContext;
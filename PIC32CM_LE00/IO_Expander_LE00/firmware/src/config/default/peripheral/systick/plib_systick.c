@@ -42,6 +42,9 @@
 #include "interrupts.h"
 #include "plib_systick.h"
 
+/* Counts SYSTICK_PeriodChangeEnd needs before the short period ends */
+#define SYSTICK_PERIOD_CHANGE_MARGIN    (32U)
+
 static SYSTICK_OBJECT systick;
 
 void SYSTICK_TimerInitialize ( void )
@@ -52,6 +55,8 @@ void SYSTICK_TimerInitialize ( void )
     SysTick->CTRL = SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk;
 
     systick.tickCounter = 0U;
+    systick.usCounter = 0U;
+    systick.cycleCounter = 0U;
     systick.callback = NULL;
 }
 
@@ -90,7 +95,7 @@ uint32_t SYSTICK_TimerCounterGet ( void )
 
 uint32_t SYSTICK_TimerFrequencyGet ( void )
 {
-    return (SYSTICK_FREQ);
+    return ((SysTick->LOAD + 1U) * (1000000U / SYSTICK_INTERRUPT_PERIOD_IN_US));
 }
 
 void SYSTICK_DelayMs ( uint32_t delay_ms)
@@ -101,7 +106,7 @@ void SYSTICK_DelayMs ( uint32_t delay_ms)
    period = SysTick->LOAD + 1U;
 
    /* Calculate the count for the given delay */
-   delayCount=(SYSTICK_FREQ/1000U)*delay_ms;
+   delayCount=(SYSTICK_TimerFrequencyGet()/1000U)*delay_ms;
 
    if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == SysTick_CTRL_ENABLE_Msk)
    {
@@ -131,7 +136,7 @@ void SYSTICK_DelayUs ( uint32_t delay_us)
    period = SysTick->LOAD + 1U;
 
     /* Calculate the count for the given delay */
-   delayCount=(SYSTICK_FREQ/1000000U)*delay_us;
+   delayCount=(SYSTICK_TimerFrequencyGet()/1000000U)*delay_us;
 
    if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == SysTick_CTRL_ENABLE_Msk)
    {
@@ -160,6 +165,127 @@ uint32_t SYSTICK_GetTickCounter(void)
 	return systick.tickCounter; 
 }
 
+uint64_t SYSTICK_TimestampUsGet ( void )
+{
+    uint64_t us;
+    uint32_t period;
+    uint32_t tick;
+    uint32_t count;
+    uint32_t countAfter;
+    bool isPending;
+
+    /* Read again if SysTick_Handler ran meanwhile */
+    do
+    {
+        tick = systick.tickCounter;
+        us = systick.usCounter;
+        count = SysTick->VAL;
+        isPending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U);
+        countAfter = SysTick->VAL;
+    } while (tick != systick.tickCounter);
+
+    /* The count reached 0 and the handler has not run yet: interrupts are
+       disabled, or this is a handler SysTick cannot preempt.  The count read
+       after the flag is past that 0; unless still at 0, it has reloaded. */
+    if (isPending == true)
+    {
+        count = countAfter;
+
+        if (count != 0U)
+        {
+            us += SYSTICK_INTERRUPT_PERIOD_IN_US;
+        }
+    }
+
+    period = SysTick->LOAD + 1U;
+
+    return us + (((period - 1U - count) * SYSTICK_INTERRUPT_PERIOD_IN_US) / period);
+}
+
+uint32_t SYSTICK_TimestampUs32Get ( void )
+{
+    return (uint32_t)SYSTICK_TimestampUsGet();
+}
+
+/* In RAM, for SYS_PROF_CyclesGet */
+RAMFUNC uint32_t SYSTICK_TimestampCyclesGet ( void )
+{
+    uint32_t tick;
+    uint32_t cycles;
+    uint32_t period;
+    uint32_t count;
+    uint32_t countAfter;
+    bool isPending;
+
+    /* As SYSTICK_TimestampUsGet */
+    do
+    {
+        tick = systick.tickCounter;
+        cycles = systick.cycleCounter;
+        count = SysTick->VAL;
+        isPending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U);
+        countAfter = SysTick->VAL;
+    } while (tick != systick.tickCounter);
+
+    period = SysTick->LOAD + 1U;
+
+    if (isPending == true)
+    {
+        count = countAfter;
+
+        if (count != 0U)
+        {
+            cycles += period;
+        }
+    }
+
+    return cycles + (period - 1U - count);
+}
+
+void SYSTICK_TickAdvance ( uint32_t ticks )
+{
+    /* Time the counter was stopped, e.g. in standby; the caller has
+       interrupts disabled, so no reader sees the two counters apart */
+    systick.usCounter += (uint64_t)ticks * SYSTICK_INTERRUPT_PERIOD_IN_US;
+    systick.cycleCounter += ticks * (SysTick->LOAD + 1U);
+    systick.tickCounter += ticks;
+}
+
+uint32_t SYSTICK_PeriodChangeBegin ( uint32_t period )
+{
+    uint32_t oldPeriod = SysTick->LOAD + 1U;
+    uint32_t remaining;
+
+    /* Close to the end of the period, let it end; the interrupt is left
+       pending and counts it */
+    do
+    {
+        remaining = (uint32_t)(((uint64_t)SysTick->VAL * period) / oldPeriod);
+    } while (remaining < SYSTICK_PERIOD_CHANGE_MARGIN);
+
+    return remaining;
+}
+
+void SYSTICK_PeriodChangeEnd ( uint32_t remaining, uint32_t period )
+{
+    /* The period ends remaining counts from now, after those counted so far
+       at the old reload, and the interrupt adds a whole new period: the
+       cycles at the last interrupt are moved so that the sum holds */
+    systick.cycleCounter += (SysTick->LOAD - SysTick->VAL) + remaining - period;
+
+    /* Writing VAL reloads it from LOAD on the next count; LOAD then takes
+       the whole period for the reload after this one */
+    SysTick->LOAD = remaining - 1U;
+    SysTick->VAL = 0U;
+
+    while (SysTick->VAL == 0U)
+    {
+        /* Wait for the reload */
+    }
+
+    SysTick->LOAD = period - 1U;
+}
+
 void SYSTICK_StartTimeOut (SYSTICK_TIMEOUT* timeout, uint32_t delay_ms)
 { 
 	timeout->start = SYSTICK_GetTickCounter();
@@ -192,6 +318,8 @@ void SysTick_Handler(void)
 {
    /* Reading control register clears the count flag */
    uint32_t sysCtrl = SysTick->CTRL;
+   systick.usCounter += SYSTICK_INTERRUPT_PERIOD_IN_US;
+   systick.cycleCounter += SysTick->LOAD + 1U;
    systick.tickCounter++;
    if(systick.callback != NULL)
    {
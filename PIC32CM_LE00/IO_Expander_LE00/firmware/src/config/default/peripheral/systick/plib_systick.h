@@ -55,6 +55,8 @@
 // *****************************************************************************
 // *****************************************************************************
 
+/* At reset of the clocks, generator 0 from the DFLL48M; the period follows
+   the clock so that SYSTICK_INTERRUPT_PERIOD_IN_US stays */
 #define SYSTICK_FREQ   48000000U
 
 #define SYSTICK_INTERRUPT_PERIOD_IN_US  (1000U)
@@ -72,6 +74,10 @@ typedef struct
 {
    SYSTICK_CALLBACK          callback;
    uintptr_t                 context;
+   /* Microseconds and clock cycles at the last interrupt; updated before
+      tickCounter */
+   volatile uint64_t         usCounter;
+   volatile uint32_t         cycleCounter;
    volatile uint32_t         tickCounter;
 } SYSTICK_OBJECT ;
 /***************************** SYSTICK API *******************************/
@@ -88,6 +94,22 @@ void SYSTICK_DelayUs ( uint32_t delay_us );
 
 void SYSTICK_TimerCallbackSet ( SYSTICK_CALLBACK callback, uintptr_t context );
 uint32_t SYSTICK_GetTickCounter(void);
+/* Microseconds since SYSTICK_TimerStart, monotonic, callable from any context
+   as long as interrupts are not disabled for a whole SysTick period */
+uint64_t SYSTICK_TimestampUsGet ( void );
+/* Its low 32 bits, wrapping every 71 minutes */
+uint32_t SYSTICK_TimestampUs32Get ( void );
+/* SysTick clock cycles on the same terms, wrapping at 2^32, counted at the
+   clock of the time across a period change; a RAM function */
+uint32_t __attribute__((long_call)) SYSTICK_TimestampCyclesGet ( void );
+/* Adds whole periods to both counters, with interrupts disabled */
+void SYSTICK_TickAdvance ( uint32_t ticks );
+/* A change of the processor clock, with interrupts disabled throughout:
+   Begin, before the clock changes, returns the counts at the new period
+   left in the current interrupt period; End, after it, counts those down
+   and then whole new periods, so that the timestamps run on */
+uint32_t SYSTICK_PeriodChangeBegin ( uint32_t period );
+void SYSTICK_PeriodChangeEnd ( uint32_t remaining, uint32_t period );
 void SYSTICK_StartTimeOut (SYSTICK_TIMEOUT* timeout, uint32_t delay_ms);
 void SYSTICK_ResetTimeOut (SYSTICK_TIMEOUT* timeout);
 bool SYSTICK_IsTimeoutReached (SYSTICK_TIMEOUT* timeout);
@@ -44,31 +44,35 @@ extern int read(int handle, void *buffer, unsigned int len);
 extern int write(int handle, void * buffer, size_t count);
 
 
+/* Returns what the SERCOM3 RX interrupt has buffered, waiting only while there
+ * is nothing yet since stdio takes 0 for end of file. Firmware that must not
+ * wait calls SERCOM3_USART_Read directly. */
 int read(int handle, void *buffer, unsigned int len)
 {
-    int nChars = 0;
-    bool success = false;
-    (void)len;
-    if ((handle == 0)  && (len > 0))
+    size_t nChars = 0U;
+
+    if ((handle == 0)  && (len > 0U))
     {
         do
         {
-            success = SERCOM3_USART_Read(buffer, 1);
-        }while( !success);
-        nChars = 1;
+            nChars = SERCOM3_USART_Read((uint8_t*)buffer, len);
+        }while(nChars == 0U);
     }
-    return nChars;
+    return (int)nChars;
 }
 
+/* Queues the data for the SERCOM3 TX interrupt and returns. Data that does not
+ * fit in the ring buffer is handled by its overflow policy and still reported
+ * as written, so that stdio does not retry or flag an error. */
 int write(int handle, void * buffer, size_t count)
 {
-   bool success = false;
+   SYS_PROF_BEGIN(SYS_PROF_ID_STDIO_WRITE);
+
    if (handle == 1)
    {
-       do
-       {
-           success = SERCOM3_USART_Write(buffer, count);
-       }while( !success);
+       (void)SERCOM3_USART_Write((uint8_t*)buffer, count);
    }
+
+   SYS_PROF_END(SYS_PROF_ID_STDIO_WRITE);
    return count;
 }
\ No newline at end of file
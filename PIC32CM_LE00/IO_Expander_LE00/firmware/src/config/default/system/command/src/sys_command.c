@@ -0,0 +1,430 @@
+/*******************************************************************************
+  Command Processor System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_command.c
+
+  Summary
+    Command processor system service implementation.
+
+  Description
+    Characters are taken from the SYS_CMD_API read function a few at a time,
+    echoed, and edited into a line buffer (backspace and DEL remove the last
+    character).  CR or LF ends the line, which is split at spaces and tabs
+    and dispatched to the registered command of the same name.  Lines longer
+    than SYS_CMD_MAX_LENGTH are discarded up to their end.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "system/command/sys_command.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_CMD_PROMPT                  "> "
+
+#define SYS_CMD_CHAR_BS                 ('\b')
+#define SYS_CMD_CHAR_DEL                (0x7FU)
+
+typedef struct
+{
+    const SYS_CMD_DESCRIPTOR*   pCmdTbl;
+
+    int                         nCmds;
+
+    const char*                 groupName;
+
+    const char*                 menuStr;
+
+} SYS_CMD_GROUP;
+
+typedef struct
+{
+    const SYS_CMD_API*  api;
+
+    SYS_CMD_GROUP       groups[SYS_CMD_GROUPS_MAX];
+
+    uint32_t            groupsNumber;
+
+    /* Line being edited, NUL terminated when dispatched */
+    char                line[SYS_CMD_MAX_LENGTH + 1U];
+
+    uint32_t            lineLength;
+
+    /* The line outgrew the buffer, the rest of it is discarded */
+    bool                isLineOverflow;
+
+    /* An LF right after a CR does not end another line */
+    bool                isLastCR;
+
+    /* Characters read but not processed yet, left over after a command ran */
+    uint8_t             rdBuffer[SYS_CMD_READ_BUDGET];
+
+    uint32_t            rdIndex;
+
+    uint32_t            rdCount;
+
+    uint32_t            droppedCount;
+
+} SYS_CMD_DATA;
+
+static SYS_CMD_DATA sysCmdData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_CMD_Write( const char* buffer, size_t size )
+{
+    if (size == 0U)
+    {
+        return;
+    }
+
+    if (sysCmdData.api->writeFreeBufferCountGet() < size)
+    {
+        sysCmdData.droppedCount++;
+        return;
+    }
+
+    (void)sysCmdData.api->write((uint8_t*)buffer, size);
+}
+
+static void SYS_CMD_Help( void )
+{
+    const SYS_CMD_GROUP* group;
+    uint32_t groupIndex;
+    int cmdIndex;
+
+    SYS_CMD_MESSAGE("help - lists the commands\r\n");
+
+    for (groupIndex = 0U; groupIndex < sysCmdData.groupsNumber; groupIndex++)
+    {
+        group = &sysCmdData.groups[groupIndex];
+
+        SYS_CMD_PRINT("%s: %s\r\n", group->groupName, group->menuStr);
+
+        for (cmdIndex = 0; cmdIndex < group->nCmds; cmdIndex++)
+        {
+            SYS_CMD_PRINT("  %s - %s\r\n", group->pCmdTbl[cmdIndex].cmdStr,
+                group->pCmdTbl[cmdIndex].cmdDescr);
+        }
+    }
+}
+
+static const SYS_CMD_DESCRIPTOR* SYS_CMD_Find( const char* cmdStr )
+{
+    const SYS_CMD_GROUP* group;
+    uint32_t groupIndex;
+    int cmdIndex;
+
+    for (groupIndex = 0U; groupIndex < sysCmdData.groupsNumber; groupIndex++)
+    {
+        group = &sysCmdData.groups[groupIndex];
+
+        for (cmdIndex = 0; cmdIndex < group->nCmds; cmdIndex++)
+        {
+            if (strcmp(group->pCmdTbl[cmdIndex].cmdStr, cmdStr) == 0)
+            {
+                return &group->pCmdTbl[cmdIndex];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Splits the line in place and runs the command */
+static void SYS_CMD_Dispatch( void )
+{
+    char* argv[SYS_CMD_MAX_ARGS];
+    const SYS_CMD_DESCRIPTOR* pCmd;
+    char* pChar = sysCmdData.line;
+    int argc = 0;
+
+    sysCmdData.line[sysCmdData.lineLength] = '\0';
+
+    for (;;)
+    {
+        while ((*pChar == ' ') || (*pChar == '\t'))
+        {
+            *pChar = '\0';
+            pChar++;
+        }
+
+        if (*pChar == '\0')
+        {
+            break;
+        }
+
+        if (argc == (int)SYS_CMD_MAX_ARGS)
+        {
+            SYS_CMD_MESSAGE("*** too many arguments ***\r\n");
+            return;
+        }
+
+        argv[argc] = pChar;
+        argc++;
+
+        while ((*pChar != ' ') && (*pChar != '\t') && (*pChar != '\0'))
+        {
+            pChar++;
+        }
+    }
+
+    if (argc == 0)
+    {
+        return;
+    }
+
+    if (strcmp(argv[0], "help") == 0)
+    {
+        SYS_CMD_Help();
+        return;
+    }
+
+    pCmd = SYS_CMD_Find(argv[0]);
+
+    if (pCmd == NULL)
+    {
+        SYS_CMD_PRINT("*** unknown command: %s ***\r\n", argv[0]);
+        return;
+    }
+
+    pCmd->cmdFnc(argc, argv);
+}
+
+/* Returns true when the character ended a line */
+static bool SYS_CMD_CharProcess( uint8_t rdChar, char* echo, uint32_t* echoLength )
+{
+    bool isLastCR = sysCmdData.isLastCR;
+
+    sysCmdData.isLastCR = (rdChar == (uint8_t)'\r');
+
+    if ((rdChar == (uint8_t)'\r') || (rdChar == (uint8_t)'\n'))
+    {
+        if ((rdChar == (uint8_t)'\n') && (isLastCR == true))
+        {
+            return false;
+        }
+
+        echo[*echoLength] = '\r';
+        echo[*echoLength + 1U] = '\n';
+        *echoLength += 2U;
+
+        return true;
+    }
+
+    if ((rdChar == (uint8_t)SYS_CMD_CHAR_BS) || (rdChar == SYS_CMD_CHAR_DEL))
+    {
+        if ((sysCmdData.lineLength > 0U) && (sysCmdData.isLineOverflow == false))
+        {
+            sysCmdData.lineLength--;
+
+            echo[*echoLength] = '\b';
+            echo[*echoLength + 1U] = ' ';
+            echo[*echoLength + 2U] = '\b';
+            *echoLength += 3U;
+        }
+        return false;
+    }
+
+    if ((rdChar < (uint8_t)' ') || (rdChar > (uint8_t)'~'))
+    {
+        /* Other control and non-ASCII characters are ignored */
+        return false;
+    }
+
+    if (sysCmdData.lineLength >= SYS_CMD_MAX_LENGTH)
+    {
+        sysCmdData.isLineOverflow = true;
+        return false;
+    }
+
+    sysCmdData.line[sysCmdData.lineLength] = (char)rdChar;
+    sysCmdData.lineLength++;
+
+    echo[*echoLength] = (char)rdChar;
+    *echoLength += 1U;
+
+    return false;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_CMD_Initialize( const SYS_CMD_API* api )
+{
+    (void) memset(&sysCmdData, 0, sizeof(sysCmdData));
+
+    if ((api == NULL) || (api->read == NULL) || (api->write == NULL) ||
+        (api->writeFreeBufferCountGet == NULL))
+    {
+        return false;
+    }
+
+    sysCmdData.api = api;
+
+    return true;
+}
+
+bool SYS_CMD_ADDGRP( const SYS_CMD_DESCRIPTOR* pCmdTbl, int nCmds, const char* groupName, const char* menuStr )
+{
+    SYS_CMD_GROUP* group;
+
+    if ((pCmdTbl == NULL) || (nCmds <= 0) || (sysCmdData.groupsNumber >= SYS_CMD_GROUPS_MAX))
+    {
+        return false;
+    }
+
+    group = &sysCmdData.groups[sysCmdData.groupsNumber];
+
+    group->pCmdTbl = pCmdTbl;
+    group->nCmds = nCmds;
+    group->groupName = groupName;
+    group->menuStr = menuStr;
+
+    sysCmdData.groupsNumber++;
+
+    return true;
+}
+
+void SYS_CMD_Tasks( void )
+{
+    /* Worst case three echo characters per character read */
+    char echo[3U * SYS_CMD_READ_BUDGET];
+    uint32_t echoLength = 0U;
+    bool isLineEnd = false;
+
+    if (sysCmdData.api == NULL)
+    {
+        return;
+    }
+
+    if (sysCmdData.rdIndex == sysCmdData.rdCount)
+    {
+        sysCmdData.rdIndex = 0U;
+        sysCmdData.rdCount = (uint32_t)sysCmdData.api->read(sysCmdData.rdBuffer, SYS_CMD_READ_BUDGET);
+    }
+
+    while ((isLineEnd == false) && (sysCmdData.rdIndex < sysCmdData.rdCount))
+    {
+        isLineEnd = SYS_CMD_CharProcess(sysCmdData.rdBuffer[sysCmdData.rdIndex], echo, &echoLength);
+        sysCmdData.rdIndex++;
+    }
+
+    SYS_CMD_Write(echo, echoLength);
+
+    if (isLineEnd == false)
+    {
+        return;
+    }
+
+    if (sysCmdData.isLineOverflow == true)
+    {
+        SYS_CMD_PRINT("*** line longer than %u characters ***\r\n", (unsigned int)SYS_CMD_MAX_LENGTH);
+    }
+    else
+    {
+        SYS_CMD_Dispatch();
+    }
+
+    sysCmdData.lineLength = 0U;
+    sysCmdData.isLineOverflow = false;
+
+    SYS_CMD_MESSAGE(SYS_CMD_PROMPT);
+}
+
+void SYS_CMD_MESSAGE( const char* message )
+{
+    if (sysCmdData.api == NULL)
+    {
+        return;
+    }
+
+    SYS_CMD_Write(message, strlen(message));
+}
+
+void SYS_CMD_PRINT( const char* format, ... )
+{
+    char buffer[SYS_CMD_PRINT_BUFFER_SIZE];
+    va_list args;
+    int length;
+
+    if (sysCmdData.api == NULL)
+    {
+        return;
+    }
+
+    va_start(args, format);
+    length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return;
+    }
+
+    if ((size_t)length >= sizeof(buffer))
+    {
+        /* Truncated to the buffer */
+        length = (int)sizeof(buffer) - 1;
+    }
+
+    SYS_CMD_Write(buffer, (size_t)length);
+}
+
+uint32_t SYS_CMD_IdleUsGet( void )
+{
+    return (sysCmdData.rdIndex == sysCmdData.rdCount) ? UINT32_MAX : 0U;
+}
+
+uint32_t SYS_CMD_DroppedCountGet( void )
+{
+    return sysCmdData.droppedCount;
+}
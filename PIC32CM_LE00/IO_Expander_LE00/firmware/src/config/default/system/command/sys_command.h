@@ -0,0 +1,151 @@
+/*******************************************************************************
+  Command Processor System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_command.h
+
+  Summary
+    Command processor system service library interface.
+
+  Description
+    This file defines the interface to the command processor system service.
+    Received characters are collected into a line, which is split into
+    arguments and dispatched to the command registered under the first one.
+
+  Remarks:
+    The service does no I/O of its own, it reads and writes through the
+    SYS_CMD_API given to SYS_CMD_Initialize.  SYS_CMD_Tasks never waits: it
+    takes at most SYS_CMD_READ_BUDGET characters and runs at most one command
+    per call, and output that does not fit in the transmit buffer is dropped.
+    Command functions must return without waiting as well.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_COMMAND_H    // Guards against multiple inclusion
+#define SYS_COMMAND_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Copies up to size received characters, returns how many without waiting */
+typedef size_t (*SYS_CMD_READ)( uint8_t* pRdBuffer, const size_t size );
+
+/* Queues size characters for transmission */
+typedef size_t (*SYS_CMD_WRITE)( uint8_t* pWrBuffer, const size_t size );
+
+/* Characters that can be queued for transmission right now */
+typedef size_t (*SYS_CMD_WRITE_FREE_GET)( void );
+
+typedef struct
+{
+    SYS_CMD_READ                read;
+
+    SYS_CMD_WRITE               write;
+
+    SYS_CMD_WRITE_FREE_GET      writeFreeBufferCountGet;
+
+} SYS_CMD_API;
+
+/* argv[0] is the command name; the strings live until the function returns */
+typedef void (*SYS_CMD_FNC)( int argc, char** argv );
+
+typedef struct
+{
+    /* Command name, the first word of the line */
+    const char*     cmdStr;
+
+    SYS_CMD_FNC     cmdFnc;
+
+    /* One line of help text */
+    const char*     cmdDescr;
+
+} SYS_CMD_DESCRIPTOR;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_CMD_Initialize( const SYS_CMD_API* api );
+
+/* Registers a table of nCmds commands; the table must stay valid. Returns
+ * false when SYS_CMD_GROUPS_MAX tables are registered already. */
+bool SYS_CMD_ADDGRP( const SYS_CMD_DESCRIPTOR* pCmdTbl, int nCmds, const char* groupName, const char* menuStr );
+
+void SYS_CMD_Tasks( void );
+
+/* 0 while characters read are still to be processed, UINT32_MAX otherwise;
+ * characters not read yet are the reader's to account for */
+uint32_t SYS_CMD_IdleUsGet( void );
+
+/* Queues the message whole, or drops it if the transmit buffer lacks room */
+void SYS_CMD_MESSAGE( const char* message );
+
+/* Formats into a SYS_CMD_PRINT_BUFFER_SIZE buffer, then as SYS_CMD_MESSAGE */
+void SYS_CMD_PRINT( const char* format, ... ) __attribute__((format(printf, 1, 2)));
+
+/* Messages dropped for lack of transmit buffer room */
+uint32_t SYS_CMD_DroppedCountGet( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_COMMAND_H
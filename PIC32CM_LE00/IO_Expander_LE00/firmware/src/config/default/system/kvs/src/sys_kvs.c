@@ -0,0 +1,771 @@
+/*******************************************************************************
+  Key/Value Store System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_kvs.c
+
+  Summary
+    Persistent key/value store system service implementation.
+
+  Description
+    The RAM index holds, for every key, the page of its current record and
+    the value itself, which may be newer: a key is dirty until a record of
+    its value is programmed.  The head is the next page to program; the
+    rows after the head row are counted erased from the scan and kept so as
+    writes and erases go.  A compaction appends the current records of the
+    oldest row with new sequence numbers, then erases it; redone after a
+    reset, it only finds the records not copied yet still current.
+
+    The jobs are not queued as such, SYS_KVS_JobGet works the next one out
+    from the head, the erased rows and the dirty keys.  One flash command
+    is in flight at a time; the NVMCTRL interrupt ends it and the task
+    checks it and starts the next.
+
+    A deleted key keeps a record, flagged deleted, carried forward like any
+    other: the record it replaced may survive an erase cut short.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "system/kvs/sys_kvs.h"
+#include "system/sched/sys_sched.h"
+#include "peripheral/dsu/plib_dsu.h"
+#include "peripheral/nvmctrl/plib_nvmctrl.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_KVS_START                   NVMCTRL_DATAFLASH_START_ADDRESS
+#define SYS_KVS_PAGE_SIZE               NVMCTRL_DATAFLASH_PAGESIZE
+#define SYS_KVS_PAGES_PER_ROW           (NVMCTRL_DATAFLASH_ROWSIZE / NVMCTRL_DATAFLASH_PAGESIZE)
+#define SYS_KVS_ROWS                    (DATAFLASH_SIZE / NVMCTRL_DATAFLASH_ROWSIZE)
+#define SYS_KVS_PAGES                   (SYS_KVS_ROWS * SYS_KVS_PAGES_PER_ROW)
+
+#define SYS_KVS_MAGIC                   (0x4B56U)
+#define SYS_KVS_FLAG_DELETED            (0x01U)
+#define SYS_KVS_PAGE_NONE               (0xFFFFU)
+#define SYS_KVS_ERASED_WORD             (0xFFFFFFFFU)
+#define SYS_KVS_CRC_SEED                (0xFFFFFFFFU)
+
+/* Failed commands in a row before the store stops */
+#define SYS_KVS_ATTEMPTS_MAX            (3U)
+
+/* The record but its CRC */
+#define SYS_KVS_CRC_LENGTH              (SYS_KVS_PAGE_SIZE - 4U)
+
+#if (SYS_KVS_KEYS_NUMBER > 32U)
+#error "The dirty keys are a 32-bit mask"
+#endif
+
+/* A page, written and read whole */
+typedef struct
+{
+    uint16_t    magic;
+
+    uint16_t    key;
+
+    uint8_t     length;
+
+    uint8_t     flags;
+
+    uint16_t    reserved;
+
+    uint32_t    sequence;
+
+    uint8_t     value[SYS_KVS_VALUE_MAX];
+
+    uint32_t    crc;
+
+} SYS_KVS_RECORD;
+
+typedef union
+{
+    SYS_KVS_RECORD  record;
+
+    uint32_t        words[SYS_KVS_PAGE_SIZE / 4U];
+
+} SYS_KVS_PAGE;
+
+typedef struct
+{
+    /* Page of the current record, SYS_KVS_PAGE_NONE without one */
+    uint16_t    page;
+
+    uint8_t     length;
+
+    /* Also set for a key that never had a value */
+    bool        isDeleted;
+
+    /* Of the current record, compared while scanning */
+    uint32_t    sequence;
+
+    uint8_t     value[SYS_KVS_VALUE_MAX];
+
+} SYS_KVS_ENTRY;
+
+typedef enum
+{
+    SYS_KVS_COMMAND_NONE = 0,
+
+    SYS_KVS_COMMAND_ERASE,
+
+    SYS_KVS_COMMAND_WRITE,
+
+} SYS_KVS_COMMAND;
+
+typedef struct
+{
+    SYS_KVS_COMMAND command;
+
+    /* Row to erase, or key to write */
+    uint32_t        index;
+
+    /* A write that moves a record out of a row to erase */
+    bool            isCopy;
+
+} SYS_KVS_JOB;
+
+typedef struct
+{
+    bool            isReady;
+
+    /* Next page to program and sequence number to give */
+    uint32_t        head;
+
+    uint32_t        sequence;
+
+    /* Bit n set while row n is erased */
+    uint32_t        rowsErased[(SYS_KVS_ROWS + 31U) / 32U];
+
+    /* Bit n set while the flash does not hold the value of key n */
+    uint32_t        dirty;
+
+    SYS_KVS_ENTRY   entries[SYS_KVS_KEYS_NUMBER];
+
+    /* The command in flight, its page and the CRC of the record written */
+    SYS_KVS_JOB     job;
+
+    uint32_t        jobPage;
+
+    uint32_t        jobCrc;
+
+    /* Set by the NVMCTRL interrupt */
+    volatile bool   isCommandDone;
+
+    uint32_t        attempts;
+
+    SYS_KVS_PAGE    page;
+
+    SYS_KVS_STATS   stats;
+
+} SYS_KVS_DATA;
+
+static SYS_KVS_DATA sysKvsData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_KVS_CommandDone( uintptr_t context )
+{
+    (void)context;
+
+    sysKvsData.isCommandDone = true;
+}
+
+static uint32_t SYS_KVS_PageAddress( uint32_t page )
+{
+    return SYS_KVS_START + (page * SYS_KVS_PAGE_SIZE);
+}
+
+static bool SYS_KVS_RowIsErased( uint32_t row )
+{
+    return ((sysKvsData.rowsErased[row / 32U] & (1UL << (row % 32U))) != 0U);
+}
+
+static void SYS_KVS_RowErasedSet( uint32_t row, bool isErased )
+{
+    if (isErased == true)
+    {
+        sysKvsData.rowsErased[row / 32U] |= (1UL << (row % 32U));
+    }
+    else
+    {
+        sysKvsData.rowsErased[row / 32U] &= ~(1UL << (row % 32U));
+    }
+}
+
+/* True if a current record, deleted or not, is in row */
+static bool SYS_KVS_RowIsUsed( uint32_t row, uint32_t* key )
+{
+    uint32_t index;
+
+    for (index = 0U; index < SYS_KVS_KEYS_NUMBER; index++)
+    {
+        if ((sysKvsData.entries[index].page != SYS_KVS_PAGE_NONE) &&
+            ((sysKvsData.entries[index].page / SYS_KVS_PAGES_PER_ROW) == row))
+        {
+            *key = index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Reads page into sysKvsData.page; true if every word is erased */
+static bool SYS_KVS_PageRead( uint32_t page )
+{
+    uint32_t index;
+    bool isErased = true;
+
+    (void) NVMCTRL_Read(sysKvsData.page.words, SYS_KVS_PAGE_SIZE, SYS_KVS_PageAddress(page));
+
+    for (index = 0U; index < (SYS_KVS_PAGE_SIZE / 4U); index++)
+    {
+        if (sysKvsData.page.words[index] != SYS_KVS_ERASED_WORD)
+        {
+            isErased = false;
+        }
+    }
+
+    return isErased;
+}
+
+/* The record read into sysKvsData.page, as it is in the flash at page */
+static bool SYS_KVS_RecordIsValid( uint32_t page )
+{
+    const SYS_KVS_RECORD* record = &sysKvsData.page.record;
+    uint32_t crc;
+
+    if ((record->magic != SYS_KVS_MAGIC) || (record->key >= SYS_KVS_KEYS_NUMBER) ||
+        (record->length > SYS_KVS_VALUE_MAX) || ((record->flags & ~SYS_KVS_FLAG_DELETED) != 0U))
+    {
+        return false;
+    }
+
+    return (DSU_CRCCalculate(SYS_KVS_PageAddress(page), SYS_KVS_CRC_LENGTH, SYS_KVS_CRC_SEED, &crc) == true) &&
+        (crc == record->crc);
+}
+
+/* The record read into sysKvsData.page holds the value of entry */
+static bool SYS_KVS_RecordMatches( const SYS_KVS_ENTRY* entry )
+{
+    const SYS_KVS_RECORD* record = &sysKvsData.page.record;
+
+    return (((record->flags & SYS_KVS_FLAG_DELETED) != 0U) == entry->isDeleted) &&
+        (record->length == entry->length) && (memcmp(record->value, entry->value, entry->length) == 0);
+}
+
+/* The next command: the head row erased, then SYS_KVS_RESERVE_ROWS erased
+ * rows after it, then the dirty keys */
+static bool SYS_KVS_JobGet( SYS_KVS_JOB* job )
+{
+    uint32_t headRow = sysKvsData.head / SYS_KVS_PAGES_PER_ROW;
+    uint32_t row;
+    uint32_t erased;
+    uint32_t key;
+
+    job->isCopy = false;
+
+    /* Left so by a reset, SYS_KVS_Initialize found no current record in it */
+    if (((sysKvsData.head % SYS_KVS_PAGES_PER_ROW) == 0U) && (SYS_KVS_RowIsErased(headRow) == false))
+    {
+        job->command = SYS_KVS_COMMAND_ERASE;
+        job->index = headRow;
+        return true;
+    }
+
+    row = (headRow + 1U) % SYS_KVS_ROWS;
+
+    for (erased = 0U; (erased < SYS_KVS_RESERVE_ROWS) && (SYS_KVS_RowIsErased(row) == true); erased++)
+    {
+        row = (row + 1U) % SYS_KVS_ROWS;
+    }
+
+    /* The oldest row; its current records go to the head first */
+    if (erased < SYS_KVS_RESERVE_ROWS)
+    {
+        if (SYS_KVS_RowIsUsed(row, &key) == true)
+        {
+            job->command = SYS_KVS_COMMAND_WRITE;
+            job->index = key;
+            job->isCopy = true;
+        }
+        else
+        {
+            job->command = SYS_KVS_COMMAND_ERASE;
+            job->index = row;
+        }
+
+        return true;
+    }
+
+    for (key = 0U; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        if ((sysKvsData.dirty & (1UL << key)) != 0U)
+        {
+            job->command = SYS_KVS_COMMAND_WRITE;
+            job->index = key;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Programs the head page with the RAM content of key; the page is used up
+ * whether it works or not */
+static bool SYS_KVS_WriteStart( uint32_t key )
+{
+    SYS_KVS_RECORD* record = &sysKvsData.page.record;
+    const SYS_KVS_ENTRY* entry = &sysKvsData.entries[key];
+    uint32_t page = sysKvsData.head;
+
+    (void) memset(record, 0xFF, sizeof(*record));
+
+    record->magic = SYS_KVS_MAGIC;
+    record->key = (uint16_t)key;
+    record->length = entry->length;
+    record->flags = (entry->isDeleted == true) ? SYS_KVS_FLAG_DELETED : 0U;
+    record->sequence = sysKvsData.sequence;
+    (void) memcpy(record->value, entry->value, entry->length);
+
+    if (DSU_CRCCalculate((uint32_t)record, SYS_KVS_CRC_LENGTH, SYS_KVS_CRC_SEED, &record->crc) == false)
+    {
+        return false;
+    }
+
+    SYS_KVS_RowErasedSet(page / SYS_KVS_PAGES_PER_ROW, false);
+    sysKvsData.head = (page + 1U) % SYS_KVS_PAGES;
+    sysKvsData.sequence++;
+    sysKvsData.stats.writes++;
+
+    sysKvsData.jobPage = page;
+    sysKvsData.jobCrc = record->crc;
+
+    /* The record goes to the page buffer here, the RAM copy is free after */
+    (void) NVMCTRL_PageWrite(sysKvsData.page.words, SYS_KVS_PageAddress(page));
+
+    return true;
+}
+
+static bool SYS_KVS_WriteEnd( uint32_t key )
+{
+    SYS_KVS_ENTRY* entry = &sysKvsData.entries[key];
+    uint32_t page = sysKvsData.jobPage;
+    uint32_t crc;
+
+    /* Read back, the CRC of the programmed page against the one written */
+    if ((NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE) || (SYS_KVS_PageRead(page) == true) ||
+        (sysKvsData.page.record.crc != sysKvsData.jobCrc) ||
+        (DSU_CRCCalculate(SYS_KVS_PageAddress(page), SYS_KVS_CRC_LENGTH, SYS_KVS_CRC_SEED, &crc) == false) ||
+        (crc != sysKvsData.jobCrc))
+    {
+        return false;
+    }
+
+    entry->page = (uint16_t)page;
+    entry->sequence = sysKvsData.page.record.sequence;
+
+    /* The value may have changed while it was written */
+    if (SYS_KVS_RecordMatches(entry) == true)
+    {
+        sysKvsData.dirty &= ~(1UL << key);
+    }
+    else
+    {
+        sysKvsData.dirty |= (1UL << key);
+    }
+
+    return true;
+}
+
+static bool SYS_KVS_EraseEnd( uint32_t row )
+{
+    uint32_t page;
+
+    if (NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE)
+    {
+        return false;
+    }
+
+    for (page = row * SYS_KVS_PAGES_PER_ROW; page < ((row + 1U) * SYS_KVS_PAGES_PER_ROW); page++)
+    {
+        if (SYS_KVS_PageRead(page) == false)
+        {
+            return false;
+        }
+    }
+
+    SYS_KVS_RowErasedSet(row, true);
+
+    return true;
+}
+
+static void SYS_KVS_CommandEnd( void )
+{
+    bool isDone;
+
+    if (sysKvsData.job.command == SYS_KVS_COMMAND_ERASE)
+    {
+        isDone = SYS_KVS_EraseEnd(sysKvsData.job.index);
+    }
+    else
+    {
+        isDone = SYS_KVS_WriteEnd(sysKvsData.job.index);
+
+        if ((isDone == true) && (sysKvsData.job.isCopy == true))
+        {
+            sysKvsData.stats.copies++;
+        }
+    }
+
+    sysKvsData.job.command = SYS_KVS_COMMAND_NONE;
+
+    if (isDone == true)
+    {
+        sysKvsData.attempts = 0U;
+        return;
+    }
+
+    sysKvsData.stats.failures++;
+    sysKvsData.attempts++;
+
+    /* The flash keeps failing; what it holds is still consistent */
+    if (sysKvsData.attempts >= SYS_KVS_ATTEMPTS_MAX)
+    {
+        sysKvsData.isReady = false;
+    }
+}
+
+static void SYS_KVS_CommandStart( void )
+{
+    SYS_KVS_JOB job;
+    uint32_t key;
+
+    if (SYS_KVS_JobGet(&job) == false)
+    {
+        return;
+    }
+
+    /* Cleared before the command, the interrupt sets it */
+    sysKvsData.isCommandDone = false;
+    sysKvsData.job = job;
+
+    if (job.command == SYS_KVS_COMMAND_ERASE)
+    {
+        /* Never erases a current record */
+        if (SYS_KVS_RowIsUsed(job.index, &key) == true)
+        {
+            sysKvsData.job.command = SYS_KVS_COMMAND_NONE;
+            sysKvsData.isReady = false;
+            return;
+        }
+
+        sysKvsData.stats.erases++;
+
+        (void) NVMCTRL_RowErase(SYS_KVS_PageAddress(job.index * SYS_KVS_PAGES_PER_ROW));
+    }
+    else if (SYS_KVS_WriteStart(job.index) == false)
+    {
+        sysKvsData.job.command = SYS_KVS_COMMAND_NONE;
+        sysKvsData.stats.failures++;
+    }
+    else
+    {
+        /* Started, ended by the interrupt */
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_KVS_Initialize( void )
+{
+    SYS_KVS_ENTRY* entry;
+    const SYS_KVS_RECORD* record = &sysKvsData.page.record;
+    uint32_t page;
+    uint32_t key;
+    uint32_t newest = SYS_KVS_PAGE_NONE;
+    uint32_t newestSequence = 0U;
+
+    (void) memset(&sysKvsData, 0, sizeof(sysKvsData));
+
+    for (key = 0U; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        sysKvsData.entries[key].page = SYS_KVS_PAGE_NONE;
+        sysKvsData.entries[key].isDeleted = true;
+    }
+
+    NVMCTRL_RegionUnlock(NVMCTRL_MEMORY_REGION_DATA);
+    NVMCTRL_CallbackRegister(SYS_KVS_CommandDone, 0U);
+
+    for (page = 0U; page < SYS_KVS_PAGES; page++)
+    {
+        if ((page % SYS_KVS_PAGES_PER_ROW) == 0U)
+        {
+            SYS_KVS_RowErasedSet(page / SYS_KVS_PAGES_PER_ROW, true);
+        }
+
+        if (SYS_KVS_PageRead(page) == true)
+        {
+            continue;
+        }
+
+        SYS_KVS_RowErasedSet(page / SYS_KVS_PAGES_PER_ROW, false);
+
+        if (SYS_KVS_RecordIsValid(page) == false)
+        {
+            sysKvsData.stats.bootTorn++;
+            continue;
+        }
+
+        sysKvsData.stats.bootRecords++;
+        entry = &sysKvsData.entries[record->key];
+
+        if ((entry->page == SYS_KVS_PAGE_NONE) || ((int32_t)(record->sequence - entry->sequence) > 0))
+        {
+            entry->page = (uint16_t)page;
+            entry->sequence = record->sequence;
+            entry->length = record->length;
+            entry->isDeleted = ((record->flags & SYS_KVS_FLAG_DELETED) != 0U);
+            (void) memcpy(entry->value, record->value, record->length);
+        }
+
+        if ((newest == SYS_KVS_PAGE_NONE) || ((int32_t)(record->sequence - newestSequence) > 0))
+        {
+            newest = page;
+            newestSequence = record->sequence;
+        }
+    }
+
+    if (newest != SYS_KVS_PAGE_NONE)
+    {
+        sysKvsData.head = newest + 1U;
+        sysKvsData.sequence = newestSequence + 1U;
+
+        /* Pages cut short after the newest record are left behind */
+        while (((sysKvsData.head % SYS_KVS_PAGES_PER_ROW) != 0U) && (SYS_KVS_PageRead(sysKvsData.head) == false))
+        {
+            sysKvsData.head++;
+        }
+
+        sysKvsData.head %= SYS_KVS_PAGES;
+    }
+
+    /* A head row not erased may only hold old or torn records */
+    page = sysKvsData.head;
+
+    if (((page % SYS_KVS_PAGES_PER_ROW) == 0U) && (SYS_KVS_RowIsErased(page / SYS_KVS_PAGES_PER_ROW) == false) &&
+        (SYS_KVS_RowIsUsed(page / SYS_KVS_PAGES_PER_ROW, &key) == true))
+    {
+        return false;
+    }
+
+    /* The erases, and a compaction a reset cut short, are left to the task */
+    sysKvsData.isReady = true;
+
+    return true;
+}
+
+void SYS_KVS_Tasks( void )
+{
+    if (sysKvsData.isReady == false)
+    {
+        return;
+    }
+
+    if (sysKvsData.job.command != SYS_KVS_COMMAND_NONE)
+    {
+        if (sysKvsData.isCommandDone == false)
+        {
+            return;
+        }
+
+        SYS_KVS_CommandEnd();
+
+        if (sysKvsData.isReady == false)
+        {
+            return;
+        }
+    }
+
+    SYS_KVS_CommandStart();
+}
+
+uint32_t SYS_KVS_IdleUsGet( void )
+{
+    SYS_KVS_JOB job;
+
+    if (sysKvsData.isReady == false)
+    {
+        return SYS_SCHED_IDLE_FOREVER;
+    }
+
+    /* A command in flight is ended by the NVMCTRL interrupt */
+    if (sysKvsData.job.command != SYS_KVS_COMMAND_NONE)
+    {
+        return (sysKvsData.isCommandDone == true) ? 0U : SYS_SCHED_IDLE_FOREVER;
+    }
+
+    return (SYS_KVS_JobGet(&job) == true) ? 0U : SYS_SCHED_IDLE_FOREVER;
+}
+
+bool SYS_KVS_IsBusy( void )
+{
+    return (sysKvsData.isReady == true) &&
+        ((sysKvsData.job.command != SYS_KVS_COMMAND_NONE) || (sysKvsData.dirty != 0U));
+}
+
+bool SYS_KVS_Get( uint32_t key, void* value, size_t size, size_t* length )
+{
+    const SYS_KVS_ENTRY* entry;
+
+    if ((sysKvsData.isReady == false) || (key >= SYS_KVS_KEYS_NUMBER))
+    {
+        return false;
+    }
+
+    entry = &sysKvsData.entries[key];
+
+    if (entry->isDeleted == true)
+    {
+        return false;
+    }
+
+    (void) memcpy(value, entry->value, (entry->length < size) ? entry->length : size);
+    *length = entry->length;
+
+    return true;
+}
+
+bool SYS_KVS_Set( uint32_t key, const void* value, size_t length )
+{
+    SYS_KVS_ENTRY* entry;
+
+    if ((sysKvsData.isReady == false) || (key >= SYS_KVS_KEYS_NUMBER) ||
+        (length > SYS_KVS_VALUE_MAX) || ((value == NULL) && (length != 0U)))
+    {
+        return false;
+    }
+
+    entry = &sysKvsData.entries[key];
+
+    if ((entry->isDeleted == false) && (entry->length == length) && (memcmp(entry->value, value, length) == 0))
+    {
+        sysKvsData.stats.writesSkipped++;
+        return true;
+    }
+
+    entry->length = (uint8_t)length;
+    entry->isDeleted = false;
+    (void) memcpy(entry->value, value, length);
+
+    sysKvsData.dirty |= (1UL << key);
+
+    return true;
+}
+
+bool SYS_KVS_Delete( uint32_t key )
+{
+    SYS_KVS_ENTRY* entry;
+
+    if ((sysKvsData.isReady == false) || (key >= SYS_KVS_KEYS_NUMBER))
+    {
+        return false;
+    }
+
+    entry = &sysKvsData.entries[key];
+
+    if (entry->isDeleted == true)
+    {
+        return true;
+    }
+
+    entry->length = 0U;
+    entry->isDeleted = true;
+
+    /* Nothing in the flash to cover, unless a write of it is in flight */
+    if (entry->page == SYS_KVS_PAGE_NONE)
+    {
+        sysKvsData.dirty &= ~(1UL << key);
+    }
+    else
+    {
+        sysKvsData.dirty |= (1UL << key);
+    }
+
+    return true;
+}
+
+void SYS_KVS_StatsGet( SYS_KVS_STATS* stats )
+{
+    uint32_t row;
+    uint32_t key;
+
+    *stats = sysKvsData.stats;
+    stats->rowsErased = 0U;
+    stats->pending = 0U;
+
+    for (row = 0U; row < SYS_KVS_ROWS; row++)
+    {
+        if ((SYS_KVS_RowIsErased(row) == true) && (row != (sysKvsData.head / SYS_KVS_PAGES_PER_ROW)))
+        {
+            stats->rowsErased++;
+        }
+    }
+
+    for (key = 0U; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        if ((sysKvsData.dirty & (1UL << key)) != 0U)
+        {
+            stats->pending++;
+        }
+    }
+
+    stats->isStopped = (sysKvsData.isReady == false);
+}
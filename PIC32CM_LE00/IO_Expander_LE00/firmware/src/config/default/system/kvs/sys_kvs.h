@@ -0,0 +1,171 @@
+/*******************************************************************************
+  Key/Value Store System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_kvs.h
+
+  Summary
+    Persistent key/value store system service library interface.
+
+  Description
+    This file defines the interface to the key/value store.  Values of up to
+    SYS_KVS_VALUE_MAX bytes are kept under small integer keys in the data
+    flash, and in RAM: SYS_KVS_Get never reads the flash.
+
+  Remarks:
+    The store is a log over the rows of DATAFLASH, one record per page, each
+    with a sequence number and a CRC32 computed by the DSU.  Records are
+    appended in page order round the region, so every row is erased once
+    per lap and the wear is spread evenly.  SYS_KVS_RESERVE_ROWS rows ahead
+    of the log are kept erased: the current records of the oldest row are
+    copied to the head before it is erased.
+
+    A write is committed once its page is programmed; a page cut short by
+    a reset fails its CRC and is skipped.  SYS_KVS_Initialize scans the
+    region and takes the newest record of every key, and SYS_KVS_Tasks
+    finishes a compaction a reset interrupted, so after a power cut each
+    key holds either its previous or its new value.
+
+    SYS_KVS_Set and SYS_KVS_Delete only change RAM.  SYS_KVS_Tasks starts
+    the flash commands, one at a time, and the NVMCTRL interrupt ends them:
+    no caller waits for an erase or a page write.  SYS_KVS_IsBusy is true
+    until the flash holds every value.  The calls are made from tasks, not
+    interrupt handlers.  The keys are the SYS_KVS_KEY_ values of
+    configuration.h, below SYS_KVS_KEYS_NUMBER.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_KVS_H    // Guards against multiple inclusion
+#define SYS_KVS_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Longest value, what a 64 byte page leaves after the record header */
+#define SYS_KVS_VALUE_MAX       (48U)
+
+typedef struct
+{
+    /* Records appended, compaction copies included, and the copies */
+    uint32_t    writes;
+
+    uint32_t    copies;
+
+    /* Writes left out as the key already held the value */
+    uint32_t    writesSkipped;
+
+    uint32_t    erases;
+
+    /* Pages that failed to program or verify, and flash errors */
+    uint32_t    failures;
+
+    /* Valid records and pages with a bad record found at initialization */
+    uint32_t    bootRecords;
+
+    uint32_t    bootTorn;
+
+    /* Erased rows now, the head row not counted */
+    uint32_t    rowsErased;
+
+    /* Keys whose value is not in the flash yet */
+    uint32_t    pending;
+
+    /* Stopped, three flash commands in a row failed */
+    bool        isStopped;
+
+} SYS_KVS_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* After NVMCTRL_Initialize and DSU_Initialize, with the NVMCTRL interrupt
+ * enabled; reads the region and starts no command.  False if the flash
+ * could not be brought to a usable state, the store then refuses every
+ * call */
+bool SYS_KVS_Initialize( void );
+
+/* Checks the command the interrupt ended and starts the next one */
+void SYS_KVS_Tasks( void );
+
+/* 0 when SYS_KVS_Tasks has a command to check or start */
+uint32_t SYS_KVS_IdleUsGet( void );
+
+/* True while values wait for the flash or a command is in flight */
+bool SYS_KVS_IsBusy( void );
+
+/* Copies the value of key, up to size bytes, from RAM; false if the key has
+ * no value */
+bool SYS_KVS_Get( uint32_t key, void* value, size_t size, size_t* length );
+
+/* Takes a new value for key, unless it already holds it; the flash gets it
+ * from SYS_KVS_Tasks */
+bool SYS_KVS_Set( uint32_t key, const void* value, size_t length );
+
+bool SYS_KVS_Delete( uint32_t key );
+
+void SYS_KVS_StatsGet( SYS_KVS_STATS* stats );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_KVS_H
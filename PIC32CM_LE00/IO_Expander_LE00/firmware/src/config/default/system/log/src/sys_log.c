@@ -0,0 +1,259 @@
+/*******************************************************************************
+  Deferred Log System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_log.c
+
+  Summary
+    Deferred binary log system service implementation.
+
+  Description
+    Log calls store a header word (format ID and argument count) and the raw
+    arguments in a word ring. SYS_LOG_Tasks turns each record into a frame:
+
+        0x1E, ID (2 bytes), argument count (1 byte), arguments (4 bytes each)
+
+    all little endian, and queues it behind the console text on SERCOM3.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "device.h"
+#include "system/log/sys_log.h"
+#include "system/prof/sys_prof.h"
+#include "peripheral/sercom/usart/plib_sercom3_usart.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_LOG_BUFFER_MASK             (SYS_LOG_BUFFER_WORDS - 1U)
+
+#define SYS_LOG_HEADER_ARGS_Pos         (16U)
+
+#define SYS_LOG_FRAME_SIZE_MAX          (4U + (4U * SYS_LOG_ARGS_MAX))
+
+typedef struct
+{
+    volatile uint32_t   inIndex;
+
+    volatile uint32_t   outIndex;
+
+    /* Records lost to a full ring in total, and since the last report */
+    volatile uint32_t   droppedCount;
+
+    uint32_t            droppedPending;
+
+} SYS_LOG_OBJ;
+
+static SYS_LOG_OBJ sysLogObj;
+
+static uint32_t sysLogBuffer[SYS_LOG_BUFFER_WORDS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_LOG_FrameBuild( uint8_t* frame, uint32_t id, uint32_t nArgs, const uint32_t* args )
+{
+    uint32_t size = 0U;
+    uint32_t index;
+
+    frame[size++] = (uint8_t)SYS_LOG_FRAME_MARKER;
+    frame[size++] = (uint8_t)id;
+    frame[size++] = (uint8_t)(id >> 8);
+    frame[size++] = (uint8_t)nArgs;
+
+    for (index = 0U; index < nArgs; index++)
+    {
+        frame[size++] = (uint8_t)args[index];
+        frame[size++] = (uint8_t)(args[index] >> 8);
+        frame[size++] = (uint8_t)(args[index] >> 16);
+        frame[size++] = (uint8_t)(args[index] >> 24);
+    }
+
+    return size;
+}
+
+/* Stores one record, the caller checked for room */
+static uint32_t SYS_LOG_RecordPut( uint32_t inIndex, uint32_t id, uint32_t nArgs, const uint32_t* args )
+{
+    uint32_t index;
+
+    sysLogBuffer[inIndex] = (id & 0xFFFFU) | (nArgs << SYS_LOG_HEADER_ARGS_Pos);
+    inIndex = (inIndex + 1U) & SYS_LOG_BUFFER_MASK;
+
+    for (index = 0U; index < nArgs; index++)
+    {
+        sysLogBuffer[inIndex] = args[index];
+        inIndex = (inIndex + 1U) & SYS_LOG_BUFFER_MASK;
+    }
+
+    return inIndex;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_LOG_Initialize( void )
+{
+    sysLogObj.inIndex = 0U;
+    sysLogObj.outIndex = 0U;
+    sysLogObj.droppedCount = 0U;
+    sysLogObj.droppedPending = 0U;
+}
+
+bool SYS_LOG_Write( uint32_t id, uint32_t nArgs, const uint32_t* args )
+{
+    uint32_t primask;
+    uint32_t inIndex;
+    uint32_t freeWords;
+    uint32_t needWords = nArgs + 1U;
+    bool isSuccess = false;
+    SYS_PROF_BEGIN(SYS_PROF_ID_LOG_WRITE);
+
+    /* Not timed, the call is a bug */
+    if ((nArgs > SYS_LOG_ARGS_MAX) || ((nArgs != 0U) && (args == NULL)))
+    {
+        return false;
+    }
+
+    /* Producers may be interrupts, keep each record in one piece */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    inIndex = sysLogObj.inIndex;
+    freeWords = (sysLogObj.outIndex - inIndex - 1U) & SYS_LOG_BUFFER_MASK;
+
+    if (sysLogObj.droppedPending != 0U)
+    {
+        /* The loss is reported where it happened, ahead of this record */
+        needWords += 2U;
+    }
+
+    if (freeWords >= needWords)
+    {
+        if (sysLogObj.droppedPending != 0U)
+        {
+            inIndex = SYS_LOG_RecordPut(inIndex, SYS_LOG_ID_DROPPED, 1U, &sysLogObj.droppedPending);
+            sysLogObj.droppedPending = 0U;
+        }
+
+        sysLogObj.inIndex = SYS_LOG_RecordPut(inIndex, id, nArgs, args);
+        isSuccess = true;
+    }
+    else
+    {
+        sysLogObj.droppedCount++;
+        sysLogObj.droppedPending++;
+    }
+
+    if (primask == 0U)
+    {
+        __enable_irq();
+    }
+
+    SYS_PROF_END(SYS_PROF_ID_LOG_WRITE);
+
+    return isSuccess;
+}
+
+/* Moves whole records to the SERCOM3 transmit ring while they fit */
+void SYS_LOG_Tasks( void )
+{
+    uint8_t frame[SYS_LOG_FRAME_SIZE_MAX];
+    uint32_t args[SYS_LOG_ARGS_MAX];
+    uint32_t outIndex;
+    uint32_t header;
+    uint32_t nArgs;
+    uint32_t index;
+    uint32_t frameSize;
+
+    outIndex = sysLogObj.outIndex;
+
+    while (outIndex != sysLogObj.inIndex)
+    {
+        header = sysLogBuffer[outIndex];
+        nArgs = header >> SYS_LOG_HEADER_ARGS_Pos;
+
+        if (SERCOM3_USART_WriteFreeBufferCountGet() < (4U + (4U * nArgs)))
+        {
+            break;
+        }
+
+        outIndex = (outIndex + 1U) & SYS_LOG_BUFFER_MASK;
+
+        for (index = 0U; index < nArgs; index++)
+        {
+            args[index] = sysLogBuffer[outIndex];
+            outIndex = (outIndex + 1U) & SYS_LOG_BUFFER_MASK;
+        }
+
+        /* Release the words before the (possibly blocking) UART write */
+        sysLogObj.outIndex = outIndex;
+
+        frameSize = SYS_LOG_FrameBuild(frame, header & 0xFFFFU, nArgs, args);
+        (void)SERCOM3_USART_Write(frame, frameSize);
+    }
+}
+
+uint32_t SYS_LOG_IdleUsGet( void )
+{
+    uint32_t outIndex = sysLogObj.outIndex;
+    uint32_t nArgs;
+
+    if (outIndex == sysLogObj.inIndex)
+    {
+        return UINT32_MAX;
+    }
+
+    /* Transmit room is freed by the DMA interrupt */
+    nArgs = sysLogBuffer[outIndex] >> SYS_LOG_HEADER_ARGS_Pos;
+
+    return (SERCOM3_USART_WriteFreeBufferCountGet() < (4U + (4U * nArgs))) ? UINT32_MAX : 0U;
+}
+
+uint32_t SYS_LOG_DroppedCountGet( void )
+{
+    return sysLogObj.droppedCount;
+}
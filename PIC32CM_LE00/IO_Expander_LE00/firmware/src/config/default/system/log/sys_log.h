@@ -0,0 +1,151 @@
+/*******************************************************************************
+  Deferred Log System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_log.h
+
+  Summary
+    Deferred binary log system service library interface.
+
+  Description
+    This file defines the interface to the deferred log system service. A log
+    call records the ID of its format string and up to four 32-bit arguments
+    into a RAM ring; SYS_LOG_Tasks drains the ring over SERCOM3 and the host
+    rebuilds the text from the format strings kept in the ELF file.
+
+  Remarks:
+    Format strings are placed in the .logfmt section, which the linker script
+    keeps in the ELF file but does not load. The record ID is the offset of
+    the string in that section. Arguments are formatted on the host, so %s
+    prints the pointer value and 64-bit or floating point arguments are not
+    supported.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_LOG_H    // Guards against multiple inclusion
+#define SYS_LOG_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Start of a binary record on the wire, never part of the console text */
+#define SYS_LOG_FRAME_MARKER            (0x1EU)
+
+/* Most arguments a record carries */
+#define SYS_LOG_ARGS_MAX                (4U)
+
+/* Record ID reporting records lost to a full ring, one argument: the count */
+#define SYS_LOG_ID_DROPPED              (0xFFFFU)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_LOG_Initialize( void );
+
+void SYS_LOG_Tasks( void );
+
+/* 0 while a record can be sent, UINT32_MAX once the ring is empty or the
+ * next record waits for transmit room */
+uint32_t SYS_LOG_IdleUsGet( void );
+
+/* Records one message; nArgs words are copied from args. Callable from
+ * interrupts. Returns false if the ring is full and the record was dropped. */
+bool SYS_LOG_Write( uint32_t id, uint32_t nArgs, const uint32_t* args );
+
+uint32_t SYS_LOG_DroppedCountGet( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Logging Macros
+// *****************************************************************************
+// *****************************************************************************
+
+/* The string only exists in the ELF file; its offset in .logfmt is the ID */
+#define SYS_LOG_FMT_DEFINE(fmt) \
+    static const char sysLogFmt[] __attribute__((section(".logfmt"), used)) = (fmt)
+
+#define SYS_LOG_FMT_ID          ((uint32_t)(uintptr_t)sysLogFmt)
+
+#define SYS_LOG0(fmt)                       do { SYS_LOG_FMT_DEFINE(fmt); \
+    (void)SYS_LOG_Write(SYS_LOG_FMT_ID, 0U, NULL); } while (false)
+
+#define SYS_LOG1(fmt, a0)                   do { SYS_LOG_FMT_DEFINE(fmt); \
+    const uint32_t sysLogArgs[1] = { (uint32_t)(a0) }; \
+    (void)SYS_LOG_Write(SYS_LOG_FMT_ID, 1U, sysLogArgs); } while (false)
+
+#define SYS_LOG2(fmt, a0, a1)               do { SYS_LOG_FMT_DEFINE(fmt); \
+    const uint32_t sysLogArgs[2] = { (uint32_t)(a0), (uint32_t)(a1) }; \
+    (void)SYS_LOG_Write(SYS_LOG_FMT_ID, 2U, sysLogArgs); } while (false)
+
+#define SYS_LOG3(fmt, a0, a1, a2)           do { SYS_LOG_FMT_DEFINE(fmt); \
+    const uint32_t sysLogArgs[3] = { (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2) }; \
+    (void)SYS_LOG_Write(SYS_LOG_FMT_ID, 3U, sysLogArgs); } while (false)
+
+#define SYS_LOG4(fmt, a0, a1, a2, a3)       do { SYS_LOG_FMT_DEFINE(fmt); \
+    const uint32_t sysLogArgs[4] = { (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3) }; \
+    (void)SYS_LOG_Write(SYS_LOG_FMT_ID, 4U, sysLogArgs); } while (false)
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_LOG_H
@@ -0,0 +1,520 @@
+/*******************************************************************************
+  Power System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_power.c
+
+  Summary
+    Power system service implementation.
+
+  Description
+    A standby is bracketed by an RTC count and a SysTick timestamp on either
+    side.  SysTick counts the time around the WFI and the RTC all of it; the
+    difference is the time SysTick stood still and is added to it in whole
+    ticks, the rest carried over in 1/32768 us.
+
+    Idle mode needs no correction, SysTick counts through it.
+
+    The governor takes the busy share of a window from the time slept in it;
+    the scheduler sleeps no further than the end of the window, so that the
+    governor runs on time however idle the device is.
+    A level change switches generator 0 between two running oscillators, so
+    the CPU never runs from a clock the flash wait states are not ready for:
+    up, the wait states come before the DFLL48M, down, they follow OSC16M.
+    Both levels run at PL2, which PM_Initialize selects.  SysTick is moved to the new reload at the
+    same point of its period, the GCLK switch costing a few of its counts.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "system/power/sys_power.h"
+#include "system/int/sys_int.h"
+#include "system/sched/sys_sched.h"
+#include "peripheral/clock/plib_clock.h"
+#include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "peripheral/pm/plib_pm.h"
+#include "peripheral/rtc/plib_rtc.h"
+#include "peripheral/systick/plib_systick.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_POWER_RTC_FREQUENCY         (32768U)
+
+/* RTC counts the compare must lie ahead once written, so that it still
+ * matches after the standby entry */
+#define SYS_POWER_RTC_MARGIN            (2)
+
+#define SYS_POWER_WINDOW_US             ((uint64_t)SYS_POWER_GOVERNOR_WINDOW_MS * 1000U)
+
+/* One SysTick period in 1/32768 us */
+#define SYS_POWER_TICK_FRACTIONS        ((int64_t)SYSTICK_INTERRUPT_PERIOD_IN_US * SYS_POWER_RTC_FREQUENCY)
+
+/* Generator 0 at each level; OSC16M as CLOCK_Initialize selects it */
+#define SYS_POWER_HIGH_FREQUENCY        (48000000U)
+#define SYS_POWER_LOW_FREQUENCY         (16000000U)
+
+typedef struct
+{
+    const SYS_POWER_ACTIVE_GET* activeGet;
+
+    size_t              activeNumber;
+
+    const SYS_POWER_CLOCK_CLIENT* clockClients;
+
+    size_t              clockClientsNumber;
+
+    bool                isStandbyEnabled;
+
+    bool                isGovernorEnabled;
+
+    SYS_POWER_LEVEL     level;
+
+    /* Since the level was last changed or the stats cleared */
+    uint64_t            levelStartUs;
+
+    /* Idle and standby time, never cleared, and its value and the time at
+     * the start of the governor window */
+    uint64_t            sleepUs;
+
+    uint64_t            windowSleepUs;
+
+    uint64_t            windowStartUs;
+
+    uint32_t            loadPermille;
+
+    /* Standby time not added to SysTick yet, in 1/32768 us */
+    int64_t             carry;
+
+    uint64_t            statsStartUs;
+
+    SYS_POWER_STATS     stats;
+
+} SYS_POWER_DATA;
+
+static SYS_POWER_DATA sysPowerData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_POWER_CountsToUs( uint32_t counts )
+{
+    return (uint32_t)(((uint64_t)counts * 1000000U) / SYS_POWER_RTC_FREQUENCY);
+}
+
+/* Adds to SysTick the time the RTC counted beyond it */
+static void SYS_POWER_TimeCorrect( uint32_t counts, uint64_t sysTickUs )
+{
+    int64_t fractions = sysPowerData.carry + ((int64_t)counts * 1000000) -
+        ((int64_t)sysTickUs * SYS_POWER_RTC_FREQUENCY);
+    uint32_t ticks;
+
+    if (fractions >= SYS_POWER_TICK_FRACTIONS)
+    {
+        ticks = (uint32_t)(fractions / SYS_POWER_TICK_FRACTIONS);
+        fractions -= (int64_t)ticks * SYS_POWER_TICK_FRACTIONS;
+
+        SYSTICK_TickAdvance(ticks);
+    }
+
+    sysPowerData.carry = fractions;
+}
+
+/* The count just after it changed; at most an RTC period */
+static uint32_t SYS_POWER_RtcEdgeWait( void )
+{
+    uint32_t count = RTC_Timer32CounterGet();
+    uint32_t edge;
+
+    do
+    {
+        edge = RTC_Timer32CounterGet();
+    } while (edge == count);
+
+    return edge;
+}
+
+static bool SYS_POWER_IsActive( void )
+{
+    size_t index;
+
+    for (index = 0U; index < sysPowerData.activeNumber; index++)
+    {
+        if (sysPowerData.activeGet[index]() == true)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t SYS_POWER_Idle( uint32_t maxUs )
+{
+    uint64_t startUs;
+    uint32_t idleUs;
+
+    /* The next SysTick interrupt ends it in any case; no sleep when
+     * something is due before */
+    if (maxUs < (SYSTICK_TimerCounterGet() / (SYSTICK_TimerFrequencyGet() / 1000000U)))
+    {
+        return 0U;
+    }
+
+    startUs = SYSTICK_TimestampUsGet();
+
+    PM_IdleModeEnter();
+
+    idleUs = (uint32_t)(SYSTICK_TimestampUsGet() - startUs);
+
+    sysPowerData.stats.idles++;
+    sysPowerData.stats.idleUs += idleUs;
+    sysPowerData.sleepUs += idleUs;
+
+    return idleUs;
+}
+
+static uint32_t SYS_POWER_Standby( uint32_t maxUs )
+{
+    uint32_t counts;
+    uint32_t start;
+    uint32_t target;
+    uint32_t end;
+    uint64_t startUs;
+    uint64_t endUs;
+
+    if (maxUs > (SYS_POWER_STANDBY_MAX_MS * 1000U))
+    {
+        maxUs = SYS_POWER_STANDBY_MAX_MS * 1000U;
+    }
+
+    /* Rounded down, the wake-up is early rather than late */
+    counts = (uint32_t)(((uint64_t)maxUs * SYS_POWER_RTC_FREQUENCY) / 1000000U);
+
+    /* Both ends are taken on a count edge: with a count read anywhere in
+     * its period, the part lost to the rounding would not cancel out over
+     * the standbys, as SysTick counts the time in between */
+    start = SYS_POWER_RtcEdgeWait();
+    startUs = SYSTICK_TimestampUsGet();
+    target = start + counts;
+
+    RTC_Timer32Compare0Set(target);
+    RTC_Timer32InterruptEnable(RTC_TIMER32_INT_MASK_CMP0);
+
+    /* The compare takes a few RTC periods to synchronize; one already
+     * passed would not match again for 36 hours */
+    if ((int32_t)(target - RTC_Timer32CounterGet()) < SYS_POWER_RTC_MARGIN)
+    {
+        RTC_Timer32InterruptDisable(RTC_TIMER32_INT_MASK_CMP0);
+        return SYS_POWER_Idle(maxUs);
+    }
+
+    PM_StandbyModeEnter();
+
+    end = SYS_POWER_RtcEdgeWait();
+    endUs = SYSTICK_TimestampUsGet();
+
+    /* The match is left pending, RTC_InterruptHandler clears it */
+    RTC_Timer32InterruptDisable(RTC_TIMER32_INT_MASK_CMP0);
+
+    SYS_POWER_TimeCorrect(end - start, endUs - startUs);
+
+    sysPowerData.stats.standbys++;
+    sysPowerData.stats.standbyUs += SYS_POWER_CountsToUs(end - start);
+    sysPowerData.sleepUs += SYS_POWER_CountsToUs(end - start);
+
+    if ((int32_t)(end - target) < 0)
+    {
+        sysPowerData.stats.wakeEarly++;
+    }
+    else if (SYS_POWER_CountsToUs(end - target) > sysPowerData.stats.wakeLatencyMaxUs)
+    {
+        sysPowerData.stats.wakeLatencyMaxUs = SYS_POWER_CountsToUs(end - target);
+    }
+    else
+    {
+        /* Within the longest so far */
+    }
+
+    return SYS_POWER_CountsToUs(end - start);
+}
+
+/* Interrupts disabled */
+static void SYS_POWER_ClockSwitch( CLOCK_GCLK0_SOURCE source, uint32_t frequency )
+{
+    /* SysTick counts the CPU clock, its reload keeps the 1 ms period */
+    uint32_t period = frequency / (1000000U / SYSTICK_INTERRUPT_PERIOD_IN_US);
+    uint32_t remaining;
+
+    remaining = SYSTICK_PeriodChangeBegin(period);
+    CLOCK_Gclk0SourceSet(source);
+    SYSTICK_PeriodChangeEnd(remaining, period);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_POWER_Initialize( const SYS_POWER_INIT* init )
+{
+    (void) memset(&sysPowerData, 0, sizeof(sysPowerData));
+
+    sysPowerData.activeGet = init->activeGet;
+    sysPowerData.activeNumber = init->activeNumber;
+    sysPowerData.clockClients = init->clockClients;
+    sysPowerData.clockClientsNumber = init->clockClientsNumber;
+    sysPowerData.isStandbyEnabled = SYS_POWER_STANDBY_ENABLE;
+    sysPowerData.isGovernorEnabled = SYS_POWER_GOVERNOR_ENABLE;
+    sysPowerData.level = SYS_POWER_LEVEL_HIGH;
+
+    sysPowerData.statsStartUs = SYSTICK_TimestampUsGet();
+    sysPowerData.levelStartUs = sysPowerData.statsStartUs;
+    sysPowerData.windowStartUs = sysPowerData.statsStartUs;
+
+    RTC_Timer32Start();
+}
+
+void SYS_POWER_Tasks( void )
+{
+    uint64_t nowUs = SYSTICK_TimestampUsGet();
+    uint64_t windowUs = nowUs - sysPowerData.windowStartUs;
+    uint64_t sleptUs = sysPowerData.sleepUs - sysPowerData.windowSleepUs;
+    SYS_POWER_LEVEL level = sysPowerData.level;
+
+    if (windowUs < SYS_POWER_WINDOW_US)
+    {
+        return;
+    }
+
+    /* A standby is counted by the RTC and may run a little past the window */
+    sysPowerData.loadPermille = (sleptUs < windowUs) ?
+        (uint32_t)(((windowUs - sleptUs) * 1000U) / windowUs) : 0U;
+
+    sysPowerData.windowStartUs = nowUs;
+    sysPowerData.windowSleepUs = sysPowerData.sleepUs;
+
+    if (sysPowerData.isGovernorEnabled == false)
+    {
+        return;
+    }
+
+    if ((level == SYS_POWER_LEVEL_HIGH) &&
+        (sysPowerData.loadPermille < (SYS_POWER_GOVERNOR_DOWN_PERCENT * 10U)))
+    {
+        level = SYS_POWER_LEVEL_LOW;
+    }
+    else if ((level == SYS_POWER_LEVEL_LOW) &&
+        (sysPowerData.loadPermille > (SYS_POWER_GOVERNOR_UP_PERCENT * 10U)))
+    {
+        level = SYS_POWER_LEVEL_HIGH;
+    }
+    else
+    {
+        return;
+    }
+
+    /* Tried again next window */
+    if (SYS_POWER_LevelSet(level) == false)
+    {
+        sysPowerData.stats.levelChangesHeld++;
+    }
+}
+
+uint32_t SYS_POWER_IdleUsGet( void )
+{
+    uint64_t windowUs;
+
+    /* With the governor off the window may stretch, the load is measured
+     * on the first pass after it */
+    if (sysPowerData.isGovernorEnabled == false)
+    {
+        return SYS_SCHED_IDLE_FOREVER;
+    }
+
+    windowUs = SYSTICK_TimestampUsGet() - sysPowerData.windowStartUs;
+
+    return (windowUs < SYS_POWER_WINDOW_US) ? (uint32_t)(SYS_POWER_WINDOW_US - windowUs) : 0U;
+}
+
+uint32_t SYS_POWER_Sleep( uint32_t maxUs )
+{
+    if ((sysPowerData.isStandbyEnabled == true) && (maxUs >= SYS_POWER_STANDBY_MIN_US) &&
+        (SYS_POWER_IsActive() == false))
+    {
+        return SYS_POWER_Standby(maxUs);
+    }
+
+    return SYS_POWER_Idle(maxUs);
+}
+
+void SYS_POWER_StandbyEnable( bool enable )
+{
+    sysPowerData.isStandbyEnabled = enable;
+}
+
+bool SYS_POWER_StandbyIsEnabled( void )
+{
+    return sysPowerData.isStandbyEnabled;
+}
+
+bool SYS_POWER_LevelSet( SYS_POWER_LEVEL level )
+{
+    uint32_t frequency;
+    uint32_t changeUs;
+    uint64_t startUs;
+    uint64_t endUs;
+    size_t index;
+    bool interruptState;
+
+    if (level >= SYS_POWER_LEVELS_NUMBER)
+    {
+        return false;
+    }
+
+    if (level == sysPowerData.level)
+    {
+        return true;
+    }
+
+    frequency = (level == SYS_POWER_LEVEL_HIGH) ? SYS_POWER_HIGH_FREQUENCY : SYS_POWER_LOW_FREQUENCY;
+
+    for (index = 0U; index < sysPowerData.clockClientsNumber; index++)
+    {
+        if ((sysPowerData.clockClients[index].isSupported != NULL) &&
+            (sysPowerData.clockClients[index].isSupported(frequency) == false))
+        {
+            return false;
+        }
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    /* No transfer or character may straddle the switch */
+    if (SYS_POWER_IsActive() == true)
+    {
+        SYS_INT_Restore(interruptState);
+        return false;
+    }
+
+    startUs = SYSTICK_TimestampUsGet();
+
+    if (level == SYS_POWER_LEVEL_HIGH)
+    {
+        NVMCTRL_ReadWaitStatesSet(SYS_POWER_HIGH_RWS);
+        CLOCK_DFLL48MEnable(true);
+
+        SYS_POWER_ClockSwitch(CLOCK_GCLK0_SOURCE_DFLL48M, frequency);
+    }
+    else
+    {
+        SYS_POWER_ClockSwitch(CLOCK_GCLK0_SOURCE_OSC16M, frequency);
+
+        NVMCTRL_ReadWaitStatesSet(SYS_POWER_LOW_RWS);
+        CLOCK_DFLL48MEnable(false);
+    }
+
+    for (index = 0U; index < sysPowerData.clockClientsNumber; index++)
+    {
+        sysPowerData.clockClients[index].clockChange();
+    }
+
+    endUs = SYSTICK_TimestampUsGet();
+
+    SYS_INT_Restore(interruptState);
+
+    changeUs = (uint32_t)(endUs - startUs);
+
+    sysPowerData.stats.levelUs[sysPowerData.level] += endUs - sysPowerData.levelStartUs;
+    sysPowerData.stats.levelChanges++;
+    sysPowerData.stats.levelChangeTotalUs += changeUs;
+
+    if (changeUs > sysPowerData.stats.levelChangeMaxUs)
+    {
+        sysPowerData.stats.levelChangeMaxUs = changeUs;
+    }
+
+    sysPowerData.levelStartUs = endUs;
+    sysPowerData.level = level;
+
+    return true;
+}
+
+SYS_POWER_LEVEL SYS_POWER_LevelGet( void )
+{
+    return sysPowerData.level;
+}
+
+void SYS_POWER_GovernorEnable( bool enable )
+{
+    sysPowerData.isGovernorEnabled = enable;
+}
+
+bool SYS_POWER_GovernorIsEnabled( void )
+{
+    return sysPowerData.isGovernorEnabled;
+}
+
+uint32_t SYS_POWER_LoadGet( void )
+{
+    return sysPowerData.loadPermille;
+}
+
+void SYS_POWER_StatsGet( SYS_POWER_STATS* stats )
+{
+    uint64_t nowUs = SYSTICK_TimestampUsGet();
+
+    *stats = sysPowerData.stats;
+    stats->elapsedUs = nowUs - sysPowerData.statsStartUs;
+    stats->levelUs[sysPowerData.level] += nowUs - sysPowerData.levelStartUs;
+}
+
+void SYS_POWER_StatsClear( void )
+{
+    (void) memset(&sysPowerData.stats, 0, sizeof(sysPowerData.stats));
+
+    sysPowerData.statsStartUs = SYSTICK_TimestampUsGet();
+    sysPowerData.levelStartUs = sysPowerData.statsStartUs;
+}
@@ -0,0 +1,236 @@
+/*******************************************************************************
+  Power System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_power.h
+
+  Summary
+    Power system service library interface.
+
+  Description
+    This file defines the interface to the power service.  It stops the CPU
+    for the time the task scheduler finds nothing to do: in standby, woken
+    by the RTC, moving the SysTick time base on by the time SysTick did not
+    count, or else in idle mode until the next interrupt.  Its governor
+    runs the device at the low level, from a 16 MHz clock, while the CPU is
+    mostly idle, and at the high one while it is busy.
+
+  Remarks:
+    SYS_POWER_Sleep is the scheduler's sleep function.  Standby stops the
+    CPU, SysTick and every peripheral clocked from GCLK0, the SERCOMs
+    included: an I2C transfer or console byte in flight would stall, and the
+    console and the I2C target hear nothing while the device is in standby.
+    Standby is therefore only entered when none of the activeGet functions
+    reports a transfer under way, and is off unless SYS_POWER_STANDBY_ENABLE
+    or SYS_POWER_StandbyEnable turns it on.
+
+    Idle mode only stops the CPU; SysTick and the peripherals run on, so
+    any interrupt, at the latest the next SysTick one, ends it.
+
+    The RTC counts at 32.768 kHz.  The time standby adds is carried to the
+    microsecond from one standby to the next, so SysTick does not drift
+    against the RTC.
+
+    A level change moves generator 0, which clocks the CPU, SysTick, the
+    SERCOMs and TC0, between the DFLL48M and OSC16M, with the flash wait
+    states in the order each direction needs, all with interrupts disabled.
+    The performance level stays PL2: PL0 does not allow a 16 MHz CPU clock.
+    SysTick keeps its 1 ms period and the clock clients set their rates up
+    again.  It is only made while no module is active and every client can
+    work from the new clock.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_POWER_H    // Guards against multiple inclusion
+#define SYS_POWER_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* True while the module needs the peripheral clocks */
+typedef bool (*SYS_POWER_ACTIVE_GET)( void );
+
+typedef enum
+{
+    /* PL2, generator 0 from OSC16M at 16 MHz, the DFLL48M off */
+    SYS_POWER_LEVEL_LOW = 0,
+
+    /* PL2, generator 0 from the DFLL48M at 48 MHz */
+    SYS_POWER_LEVEL_HIGH,
+
+    SYS_POWER_LEVELS_NUMBER
+
+} SYS_POWER_LEVEL;
+
+/* A module clocked from generator 0 */
+typedef struct
+{
+    /* True if the module can work from generator 0 at frequency; NULL when
+     * any will do */
+    bool (*isSupported)( uint32_t frequency );
+
+    /* Sets the module up for the new frequency, with interrupts disabled */
+    void (*clockChange)( void );
+
+} SYS_POWER_CLOCK_CLIENT;
+
+typedef struct
+{
+    const SYS_POWER_ACTIVE_GET*     activeGet;
+
+    size_t                          activeNumber;
+
+    const SYS_POWER_CLOCK_CLIENT*   clockClients;
+
+    size_t                          clockClientsNumber;
+
+} SYS_POWER_INIT;
+
+typedef struct
+{
+    /* Idle mode entries and the time they lasted */
+    uint32_t    idles;
+
+    uint64_t    idleUs;
+
+    /* Standby entries, including those an interrupt ended at once */
+    uint32_t    standbys;
+
+    /* Standbys ended by another interrupt before the RTC */
+    uint32_t    wakeEarly;
+
+    uint64_t    standbyUs;
+
+    /* Since SYS_POWER_Initialize or SYS_POWER_StatsClear; the CPU ran for
+     * the time neither idle nor in standby */
+    uint64_t    elapsedUs;
+
+    /* From the RTC match to the count read after the wake-up, to the RTC
+     * period */
+    uint32_t    wakeLatencyMaxUs;
+
+    /* Time at each performance level, sleep included */
+    uint64_t    levelUs[SYS_POWER_LEVELS_NUMBER];
+
+    /* Level changes, the time they took with interrupts disabled, and those
+     * the governor wanted but an active module or clock client held off */
+    uint32_t    levelChanges;
+
+    uint32_t    levelChangeMaxUs;
+
+    uint64_t    levelChangeTotalUs;
+
+    uint32_t    levelChangesHeld;
+
+} SYS_POWER_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Starts the RTC; after RTC_Initialize, SYSTICK_TimerStart and
+ * CLOCK_Initialize, which leaves the high level.  The lists must stay
+ * valid. */
+void SYS_POWER_Initialize( const SYS_POWER_INIT* init );
+
+/* A background task; once SYS_POWER_GOVERNOR_WINDOW_MS have passed since
+ * the last window it measures the busy share of the window and, when the
+ * governor is on, changes the level across SYS_POWER_GOVERNOR_DOWN_PERCENT
+ * or SYS_POWER_GOVERNOR_UP_PERCENT */
+void SYS_POWER_Tasks( void );
+
+/* While the governor is on, the microseconds left of the window, 0 once it
+ * is over; SYS_SCHED_IDLE_FOREVER otherwise */
+uint32_t SYS_POWER_IdleUsGet( void );
+
+/* Standby for up to maxUs, woken by the RTC or any interrupt, when it is on,
+ * maxUs is SYS_POWER_STANDBY_MIN_US or more and no module is active.
+ * Otherwise idle mode until an interrupt, when maxUs reaches past the next
+ * SysTick interrupt.  Returns the time slept, 0 when it did not sleep.
+ * Called with interrupts disabled. */
+uint32_t SYS_POWER_Sleep( uint32_t maxUs );
+
+void SYS_POWER_StandbyEnable( bool enable );
+
+bool SYS_POWER_StandbyIsEnabled( void );
+
+/* Changes the level at once; false while a module is active or when a
+ * clock client cannot work from the clock of that level */
+bool SYS_POWER_LevelSet( SYS_POWER_LEVEL level );
+
+SYS_POWER_LEVEL SYS_POWER_LevelGet( void );
+
+void SYS_POWER_GovernorEnable( bool enable );
+
+bool SYS_POWER_GovernorIsEnabled( void );
+
+/* Busy share of the last governor window, in thousandths */
+uint32_t SYS_POWER_LoadGet( void );
+
+void SYS_POWER_StatsGet( SYS_POWER_STATS* stats );
+
+void SYS_POWER_StatsClear( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_POWER_H
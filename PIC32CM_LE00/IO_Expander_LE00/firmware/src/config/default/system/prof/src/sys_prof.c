@@ -0,0 +1,310 @@
+/*******************************************************************************
+  Profiler System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_prof.c
+
+  Summary
+    Code region profiler system service implementation.
+
+  Description
+    The statistics of a region are updated with interrupts disabled, so a
+    pass recorded by an interrupt handler is never half counted.  The
+    histogram bucket is found by halving the range, the Cortex-M23 having
+    no count leading zeros instruction.
+
+    The boot trace is left out of the initialization, it only ever fills up
+    and is zero from reset.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "system/prof/sys_prof.h"
+#include "system/int/sys_int.h"
+#include "peripheral/systick/plib_systick.h"
+
+#if defined(SYS_PROF_ENABLE)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Empty regions timed at initialization, the shortest is the overhead */
+#define SYS_PROF_CALIBRATION_PASSES     (16U)
+
+typedef struct
+{
+    const char* const*  names;
+
+    uint32_t            overheadCycles;
+
+    SYS_PROF_STATS      stats[SYS_PROF_REGIONS_NUMBER];
+
+    const char* const*  bootNames;
+
+    /* Bit id set once phase id is reached, at bootUs[id] */
+    uint32_t            bootReached;
+
+    uint32_t            bootUs[SYS_PROF_BOOT_PHASES_NUMBER];
+
+} SYS_PROF_DATA;
+
+static SYS_PROF_DATA sysProfData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* floor(log2(cycles)), 0 for 0, up to the last bucket; inlined, as
+ * SYS_PROF_Record runs from RAM */
+static inline uint32_t __attribute__((always_inline)) SYS_PROF_BucketGet( uint32_t cycles )
+{
+    uint32_t bucket = 0U;
+
+    if (cycles >= 0x10000U)
+    {
+        cycles >>= 16U;
+        bucket += 16U;
+    }
+
+    if (cycles >= 0x100U)
+    {
+        cycles >>= 8U;
+        bucket += 8U;
+    }
+
+    if (cycles >= 0x10U)
+    {
+        cycles >>= 4U;
+        bucket += 4U;
+    }
+
+    if (cycles >= 0x4U)
+    {
+        cycles >>= 2U;
+        bucket += 2U;
+    }
+
+    if (cycles >= 0x2U)
+    {
+        bucket += 1U;
+    }
+
+    return (bucket < SYS_PROF_BUCKETS) ? bucket : (SYS_PROF_BUCKETS - 1U);
+}
+
+static void SYS_PROF_StatsReset( void )
+{
+    uint32_t id;
+
+    (void) memset(sysProfData.stats, 0, sizeof(sysProfData.stats));
+
+    for (id = 0U; id < SYS_PROF_REGIONS_NUMBER; id++)
+    {
+        sysProfData.stats[id].minCycles = UINT32_MAX;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_PROF_Initialize( const SYS_PROF_INIT* init )
+{
+    uint32_t pass;
+    uint32_t start;
+    uint32_t cycles;
+
+    sysProfData.names = init->names;
+    sysProfData.bootNames = init->bootNames;
+    sysProfData.overheadCycles = UINT32_MAX;
+
+    /* The same two reads as a region, nothing between them */
+    for (pass = 0U; pass < SYS_PROF_CALIBRATION_PASSES; pass++)
+    {
+        start = SYS_PROF_CyclesGet();
+        cycles = SYS_PROF_CyclesGet() - start;
+
+        if (cycles < sysProfData.overheadCycles)
+        {
+            sysProfData.overheadCycles = cycles;
+        }
+    }
+
+    SYS_PROF_StatsReset();
+}
+
+/* In RAM with SYSTICK_TimestampCyclesGet, so that a region in a RAM
+ * function takes no flash wait states */
+RAMFUNC uint32_t SYS_PROF_CyclesGet( void )
+{
+    return SYSTICK_TimestampCyclesGet();
+}
+
+/* In RAM too; SYS_INT_Disable is in flash, PRIMASK is used directly */
+RAMFUNC void SYS_PROF_Record( uint32_t id, uint32_t cycles )
+{
+    SYS_PROF_STATS* stats;
+    uint32_t bucket;
+    uint32_t primask;
+
+    if (id >= SYS_PROF_REGIONS_NUMBER)
+    {
+        return;
+    }
+
+    cycles = (cycles > sysProfData.overheadCycles) ? (cycles - sysProfData.overheadCycles) : 0U;
+    bucket = SYS_PROF_BucketGet(cycles);
+    stats = &sysProfData.stats[id];
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    stats->count++;
+    stats->totalCycles += cycles;
+    stats->histogram[bucket]++;
+
+    if (cycles < stats->minCycles)
+    {
+        stats->minCycles = cycles;
+    }
+
+    if (cycles > stats->maxCycles)
+    {
+        stats->maxCycles = cycles;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+size_t SYS_PROF_RegionsNumberGet( void )
+{
+    return SYS_PROF_REGIONS_NUMBER;
+}
+
+const char* SYS_PROF_NameGet( uint32_t id )
+{
+    return (id < SYS_PROF_REGIONS_NUMBER) ? sysProfData.names[id] : NULL;
+}
+
+uint32_t SYS_PROF_OverheadGet( void )
+{
+    return sysProfData.overheadCycles;
+}
+
+bool SYS_PROF_StatsGet( uint32_t id, SYS_PROF_STATS* stats )
+{
+    bool interruptState;
+
+    if (id >= SYS_PROF_REGIONS_NUMBER)
+    {
+        return false;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    *stats = sysProfData.stats[id];
+
+    SYS_INT_Restore(interruptState);
+
+    if (stats->count == 0U)
+    {
+        stats->minCycles = 0U;
+    }
+
+    return true;
+}
+
+void SYS_PROF_StatsClear( void )
+{
+    bool interruptState = SYS_INT_Disable();
+
+    SYS_PROF_StatsReset();
+
+    SYS_INT_Restore(interruptState);
+}
+
+void SYS_PROF_BootMark( uint32_t id )
+{
+    bool interruptState;
+
+    if (id >= SYS_PROF_BOOT_PHASES_NUMBER)
+    {
+        return;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    if ((sysProfData.bootReached & (1UL << id)) == 0U)
+    {
+        sysProfData.bootUs[id] = (uint32_t)SYSTICK_TimestampUsGet();
+        sysProfData.bootReached |= (1UL << id);
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+size_t SYS_PROF_BootPhasesNumberGet( void )
+{
+    return SYS_PROF_BOOT_PHASES_NUMBER;
+}
+
+const char* SYS_PROF_BootNameGet( uint32_t id )
+{
+    return (id < SYS_PROF_BOOT_PHASES_NUMBER) ? sysProfData.bootNames[id] : NULL;
+}
+
+bool SYS_PROF_BootUsGet( uint32_t id, uint32_t* us )
+{
+    if ((id >= SYS_PROF_BOOT_PHASES_NUMBER) || ((sysProfData.bootReached & (1UL << id)) == 0U))
+    {
+        return false;
+    }
+
+    *us = sysProfData.bootUs[id];
+
+    return true;
+}
+
+#endif // SYS_PROF_ENABLE
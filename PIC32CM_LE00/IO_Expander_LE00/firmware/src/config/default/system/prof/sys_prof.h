@@ -0,0 +1,198 @@
+/*******************************************************************************
+  Profiler System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_prof.h
+
+  Summary
+    Code region profiler system service library interface.
+
+  Description
+    This file defines the interface to the region profiler.  A region is the
+    code between SYS_PROF_BEGIN(id) and SYS_PROF_END(id) in one block; each
+    pass through it is timed in CPU cycles and counted, with its shortest,
+    longest and total time and a histogram of the times by powers of two.
+
+  Remarks:
+    The regions are built in only when SYS_PROF_ENABLE is defined; otherwise
+    the two macros expand to nothing and the service is left out.  The ids
+    are the SYS_PROF_ID_ values of configuration.h, below
+    SYS_PROF_REGIONS_NUMBER.
+
+    The time is read from SysTick, a region may run in a task or an
+    interrupt handler, RAM functions included (the reads and the record run
+    from RAM as well), and may be entered again by an interrupt before it
+    ends: each pass keeps its own start time.  An interrupt taken inside a
+    region counts in its time, and a region across a performance level
+    change counts the cycles run at each clock.  The cost of an empty
+    region, measured at initialization, is taken off every pass.
+
+    Bucket 0 of the histogram holds the passes of 0 or 1 cycle, bucket n
+    those of 2^n to 2^(n+1) - 1 cycles, and the last bucket all the longer
+    ones.
+
+    The boot trace keeps, in RAM, the SysTick time at which each boot phase
+    was first reached, for the SYS_PROF_BOOT_ID_ values of configuration.h.
+    The time counts from SYSTICK_TimerStart, once the 48 MHz clock is up;
+    a phase may be marked from an interrupt handler.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_PROF_H    // Guards against multiple inclusion
+#define SYS_PROF_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Region names, SYS_PROF_REGIONS_NUMBER of them, in id order */
+    const char* const*  names;
+
+    /* Boot phase names, SYS_PROF_BOOT_PHASES_NUMBER of them, in id order */
+    const char* const*  bootNames;
+
+} SYS_PROF_INIT;
+
+typedef struct
+{
+    uint32_t    count;
+
+    /* In CPU cycles, the empty region cost taken off */
+    uint32_t    minCycles;
+
+    uint32_t    maxCycles;
+
+    uint64_t    totalCycles;
+
+    uint32_t    histogram[SYS_PROF_BUCKETS];
+
+} SYS_PROF_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Region Macros
+// *****************************************************************************
+// *****************************************************************************
+
+#if defined(SYS_PROF_ENABLE)
+
+/* Opens region id; a declaration, so it follows those of the block */
+#define SYS_PROF_BEGIN(id)      uint32_t sysProfStart##id = SYS_PROF_CyclesGet()
+
+/* Closes region id, in the block SYS_PROF_BEGIN opened it in */
+#define SYS_PROF_END(id)        SYS_PROF_Record((id), SYS_PROF_CyclesGet() - sysProfStart##id)
+
+/* Records the time boot phase id is reached, the first time only */
+#define SYS_PROF_BOOT_MARK(id)  SYS_PROF_BootMark(id)
+
+#else
+
+#define SYS_PROF_BEGIN(id)
+
+#define SYS_PROF_END(id)
+
+#define SYS_PROF_BOOT_MARK(id)
+
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* After SYSTICK_TimerStart; the names must stay valid */
+void SYS_PROF_Initialize( const SYS_PROF_INIT* init );
+
+/* SysTick cycles, wrapping at 2^32; a RAM function, as is SYS_PROF_Record,
+ * so that regions in RAM functions stay out of flash */
+uint32_t __attribute__((long_call)) SYS_PROF_CyclesGet( void );
+
+/* Adds a pass of the region; from any context */
+void __attribute__((long_call)) SYS_PROF_Record( uint32_t id, uint32_t cycles );
+
+size_t SYS_PROF_RegionsNumberGet( void );
+
+const char* SYS_PROF_NameGet( uint32_t id );
+
+/* Cost of an empty region, taken off every pass */
+uint32_t SYS_PROF_OverheadGet( void );
+
+/* A consistent copy; false for an id out of range */
+bool SYS_PROF_StatsGet( uint32_t id, SYS_PROF_STATS* stats );
+
+void SYS_PROF_StatsClear( void );
+
+/* From any context; the trace is not cleared with the stats */
+void SYS_PROF_BootMark( uint32_t id );
+
+size_t SYS_PROF_BootPhasesNumberGet( void );
+
+const char* SYS_PROF_BootNameGet( uint32_t id );
+
+/* Microseconds from SYSTICK_TimerStart to phase id; false for an id out of
+ * range or a phase not reached */
+bool SYS_PROF_BootUsGet( uint32_t id, uint32_t* us );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_PROF_H
@@ -0,0 +1,403 @@
+/*******************************************************************************
+  Task Scheduler System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_sched.c
+
+  Summary
+    Cooperative task scheduler system service implementation.
+
+  Description
+    Every periodic task keeps the time of its next release.  A pass walks
+    the background tasks in table order; before each one, and once more at
+    the end, the released periodic tasks are run earliest deadline first,
+    each at most once.  After a run the release moves on by one period, or
+    by as many as it takes to get within a period of the present.
+
+    At the end of a pass the shortest idle time of all tasks is worked out,
+    once with interrupts enabled and, when it is worth sleeping, again with
+    them disabled up to the sleep, so that work an interrupt brings in
+    between is not slept through.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "system/sched/sys_sched.h"
+#include "system/int/sys_int.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_SCHED_TASK_NONE             (SYS_SCHED_TASKS_MAX)
+
+#if (SYS_SCHED_TASKS_MAX > 32U)
+#error "SYS_SCHED_TASKS_MAX is limited by the 32-bit mask of tasks run"
+#endif
+
+typedef struct
+{
+    const SYS_SCHED_TASK*   tasks;
+
+    size_t                  tasksNumber;
+
+    SYS_SCHED_TIME_GET      timeGet;
+
+    SYS_SCHED_SLEEP         sleep;
+
+    /* Next release of a periodic task, last start of a background one */
+    uint32_t                release[SYS_SCHED_TASKS_MAX];
+
+    /* A background task has no previous start to measure from yet */
+    bool                    isStarted[SYS_SCHED_TASKS_MAX];
+
+    SYS_SCHED_STATS         stats[SYS_SCHED_TASKS_MAX];
+
+} SYS_SCHED_OBJ;
+
+static SYS_SCHED_OBJ sysSchedObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_SCHED_DeadlineGet( const SYS_SCHED_TASK* task )
+{
+    return (task->deadlineUs != 0U) ? task->deadlineUs : task->periodUs;
+}
+
+/* Runs the task and updates its statistics; jitter is measured from since */
+static void SYS_SCHED_Run( size_t index, uint32_t since, bool isJitterValid )
+{
+    const SYS_SCHED_TASK* task = &sysSchedObj.tasks[index];
+    SYS_SCHED_STATS* stats = &sysSchedObj.stats[index];
+    uint32_t start = sysSchedObj.timeGet();
+    uint32_t runUs;
+    uint32_t jitterUs;
+
+    task->taskFnc();
+
+    runUs = sysSchedObj.timeGet() - start;
+    jitterUs = isJitterValid ? (start - since) : 0U;
+
+    stats->runs++;
+    stats->runTotalUs += runUs;
+    stats->jitterTotalUs += jitterUs;
+
+    if (runUs > stats->runMaxUs)
+    {
+        stats->runMaxUs = runUs;
+    }
+
+    if (jitterUs > stats->jitterMaxUs)
+    {
+        stats->jitterMaxUs = jitterUs;
+    }
+
+    if ((task->budgetUs != 0U) && (runUs > task->budgetUs))
+    {
+        stats->overruns++;
+    }
+
+    if (task->periodUs == 0U)
+    {
+        sysSchedObj.release[index] = start;
+        sysSchedObj.isStarted[index] = true;
+    }
+    else if ((start + runUs - since) > SYS_SCHED_DeadlineGet(task))
+    {
+        stats->deadlineMisses++;
+    }
+}
+
+/* The released periodic task with the earliest deadline, if any, leaving out
+ * the tasks in the ran mask */
+static size_t SYS_SCHED_NextGet( uint32_t now, uint32_t ran )
+{
+    const SYS_SCHED_TASK* task;
+    size_t next = SYS_SCHED_TASK_NONE;
+    uint32_t nextDeadline = 0U;
+    uint32_t deadline;
+    size_t index;
+
+    for (index = 0U; index < sysSchedObj.tasksNumber; index++)
+    {
+        task = &sysSchedObj.tasks[index];
+
+        if ((task->periodUs == 0U) || ((ran & (1UL << index)) != 0U) ||
+            ((int32_t)(now - sysSchedObj.release[index]) < 0))
+        {
+            continue;
+        }
+
+        deadline = sysSchedObj.release[index] + SYS_SCHED_DeadlineGet(task);
+
+        if ((next == SYS_SCHED_TASK_NONE) || ((int32_t)(deadline - nextDeadline) < 0))
+        {
+            next = index;
+            nextDeadline = deadline;
+        }
+    }
+
+    return next;
+}
+
+/* Every periodic task runs at most once per call, so the background tasks
+ * still get their turn when the periodic ones take all the time there is */
+static void SYS_SCHED_PeriodicRun( void )
+{
+    uint32_t ran = 0U;
+    size_t index = SYS_SCHED_NextGet(sysSchedObj.timeGet(), ran);
+    uint32_t periodUs;
+    uint32_t lateUs;
+    uint32_t skipped;
+
+    while (index != SYS_SCHED_TASK_NONE)
+    {
+        periodUs = sysSchedObj.tasks[index].periodUs;
+
+        SYS_SCHED_Run(index, sysSchedObj.release[index], true);
+
+        ran |= (1UL << index);
+
+        sysSchedObj.release[index] += periodUs;
+
+        /* Releases a whole period or more in the past are dropped rather
+         * than run back to back */
+        lateUs = sysSchedObj.timeGet() - sysSchedObj.release[index];
+
+        if (((int32_t)lateUs > 0) && (lateUs >= periodUs))
+        {
+            skipped = lateUs / periodUs;
+            sysSchedObj.release[index] += skipped * periodUs;
+            sysSchedObj.stats[index].releasesSkipped += skipped;
+        }
+
+        index = SYS_SCHED_NextGet(sysSchedObj.timeGet(), ran);
+    }
+}
+
+/* The time before any task has work, 0 as soon as one has */
+static uint32_t SYS_SCHED_IdleUsGet( void )
+{
+    const SYS_SCHED_TASK* task;
+    uint32_t now = sysSchedObj.timeGet();
+    uint32_t idleUs = SYS_SCHED_IDLE_FOREVER;
+    uint32_t taskIdleUs;
+    size_t index;
+
+    for (index = 0U; (index < sysSchedObj.tasksNumber) && (idleUs != 0U); index++)
+    {
+        task = &sysSchedObj.tasks[index];
+
+        if (task->idleUsGet != NULL)
+        {
+            taskIdleUs = task->idleUsGet();
+        }
+        else if (task->periodUs == 0U)
+        {
+            taskIdleUs = 0U;
+        }
+        else if ((int32_t)(sysSchedObj.release[index] - now) > 0)
+        {
+            taskIdleUs = sysSchedObj.release[index] - now;
+        }
+        else
+        {
+            taskIdleUs = 0U;
+        }
+
+        if (taskIdleUs < idleUs)
+        {
+            idleUs = taskIdleUs;
+        }
+    }
+
+    return idleUs;
+}
+
+static void SYS_SCHED_Sleep( void )
+{
+    uint32_t periodUs;
+    uint32_t lateUs;
+    uint32_t now;
+    size_t index;
+    bool interruptState;
+
+    if ((sysSchedObj.sleep == NULL) || (SYS_SCHED_IdleUsGet() == 0U))
+    {
+        return;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    if (sysSchedObj.sleep(SYS_SCHED_IdleUsGet()) != 0U)
+    {
+        now = sysSchedObj.timeGet();
+
+        /* The tasks that allowed sleeping through their releases go on as if
+         * they had run on each and found nothing to do: the next release is
+         * the first one from now, none is counted as skipped or late */
+        for (index = 0U; index < sysSchedObj.tasksNumber; index++)
+        {
+            periodUs = sysSchedObj.tasks[index].periodUs;
+            lateUs = now - sysSchedObj.release[index];
+
+            if ((periodUs != 0U) && (sysSchedObj.tasks[index].idleUsGet != NULL) &&
+                ((int32_t)lateUs > 0))
+            {
+                sysSchedObj.release[index] += ((lateUs + periodUs - 1U) / periodUs) * periodUs;
+            }
+        }
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_SCHED_Initialize( const SYS_SCHED_INIT* init )
+{
+    uint32_t now;
+    size_t index;
+
+    (void) memset(&sysSchedObj, 0, sizeof(sysSchedObj));
+
+    if ((init == NULL) || (init->tasksNumber > SYS_SCHED_TASKS_MAX) || (init->timeGet == NULL))
+    {
+        return false;
+    }
+
+    sysSchedObj.tasks = init->tasks;
+    sysSchedObj.tasksNumber = init->tasksNumber;
+    sysSchedObj.timeGet = init->timeGet;
+    sysSchedObj.sleep = init->sleep;
+
+    now = init->timeGet();
+
+    for (index = 0U; index < init->tasksNumber; index++)
+    {
+        sysSchedObj.release[index] = now + init->tasks[index].phaseUs;
+    }
+
+    return true;
+}
+
+void SYS_SCHED_Tasks( void )
+{
+    size_t index;
+
+    if (sysSchedObj.timeGet == NULL)
+    {
+        /* SYS_SCHED_Initialize failed */
+        return;
+    }
+
+    for (index = 0U; index < sysSchedObj.tasksNumber; index++)
+    {
+        if (sysSchedObj.tasks[index].periodUs != 0U)
+        {
+            continue;
+        }
+
+        SYS_SCHED_PeriodicRun();
+
+        SYS_SCHED_Run(index, sysSchedObj.release[index], sysSchedObj.isStarted[index]);
+    }
+
+    SYS_SCHED_PeriodicRun();
+
+    SYS_SCHED_Sleep();
+}
+
+size_t SYS_SCHED_TasksNumberGet( void )
+{
+    return sysSchedObj.tasksNumber;
+}
+
+const SYS_SCHED_TASK* SYS_SCHED_TaskGet( size_t index )
+{
+    return (index < sysSchedObj.tasksNumber) ? &sysSchedObj.tasks[index] : NULL;
+}
+
+bool SYS_SCHED_StatsGet( size_t index, SYS_SCHED_STATS* stats )
+{
+    if (index >= sysSchedObj.tasksNumber)
+    {
+        return false;
+    }
+
+    *stats = sysSchedObj.stats[index];
+
+    return true;
+}
+
+void SYS_SCHED_StatsClear( void )
+{
+    size_t index;
+
+    (void) memset(sysSchedObj.stats, 0, sizeof(sysSchedObj.stats));
+
+    /* The next gap would span the clear */
+    for (index = 0U; index < sysSchedObj.tasksNumber; index++)
+    {
+        sysSchedObj.isStarted[index] = false;
+    }
+}
+
+uint32_t SYS_SCHED_MsPeriodIdleUsGet( uint32_t startMs, uint32_t nowMs, uint32_t periodMs )
+{
+    uint32_t elapsedMs = nowMs - startMs;
+    uint32_t leftMs;
+
+    if (elapsedMs >= periodMs)
+    {
+        return 0U;
+    }
+
+    leftMs = periodMs - elapsedMs - 1U;
+
+    return (leftMs < (SYS_SCHED_IDLE_FOREVER / 1000U)) ? (leftMs * 1000U) : (SYS_SCHED_IDLE_FOREVER - 1U);
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+  Task Scheduler System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_sched.h
+
+  Summary
+    Cooperative task scheduler system service library interface.
+
+  Description
+    This file defines the interface to the cooperative task scheduler.  The
+    tasks are listed in a constant table given to SYS_SCHED_Initialize.  A
+    periodic task is released every periodUs, phaseUs after initialization,
+    and should finish within deadlineUs of its release.  A task with no
+    period is a background task and runs once per pass of the main loop.
+
+  Remarks:
+    Tasks are not preempted.  Before each background task and at the end of
+    every pass, the released periodic tasks run once each, the one with the
+    earliest deadline first.  A periodic task later than a whole period
+    loses the releases it missed rather than running them back to back, so
+    it keeps its phase.
+
+    Run time, release jitter, budget overruns and deadline misses are kept
+    for every task.  Times are 32-bit microsecond counts, compared modulo
+    2^32, so periods and run times must stay under 2^31 us.
+
+    When every task is idle the time left before the next one has work is
+    handed to the sleep function, if one is given.  A background task is
+    idle when its idleUsGet says so; a periodic task until its next release,
+    or for as long as its idleUsGet says, sleeping through the releases.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_SCHED_H    // Guards against multiple inclusion
+#define SYS_SCHED_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef void (*SYS_SCHED_TASK_FNC)( void );
+
+/* Free running microsecond count */
+typedef uint32_t (*SYS_SCHED_TIME_GET)( void );
+
+/* Microseconds the task has nothing to do for, 0 when it has work now; a
+ * task waiting for an interrupt is idle, the interrupt ends any sleep */
+typedef uint32_t (*SYS_SCHED_IDLE_GET)( void );
+
+/* Sleeps up to maxUs and returns the time slept, 0 when it did not sleep.
+ * Called and returns with interrupts disabled; any interrupt ends it. */
+typedef uint32_t (*SYS_SCHED_SLEEP)( uint32_t maxUs );
+
+/* Idle until an interrupt gives the task work */
+#define SYS_SCHED_IDLE_FOREVER          (UINT32_MAX)
+
+typedef struct
+{
+    /* Short name for the statistics */
+    const char*         name;
+
+    SYS_SCHED_TASK_FNC  taskFnc;
+
+    /* Release period, 0 for a background task */
+    uint32_t            periodUs;
+
+    /* First release, after SYS_SCHED_Initialize */
+    uint32_t            phaseUs;
+
+    /* Latest finish after a release, 0 for the period */
+    uint32_t            deadlineUs;
+
+    /* Longest expected run, 0 for no limit */
+    uint32_t            budgetUs;
+
+    /* NULL: a background task is never idle, a periodic one is until its
+     * next release */
+    SYS_SCHED_IDLE_GET  idleUsGet;
+
+} SYS_SCHED_TASK;
+
+typedef struct
+{
+    const SYS_SCHED_TASK*   tasks;
+
+    size_t                  tasksNumber;
+
+    SYS_SCHED_TIME_GET      timeGet;
+
+    /* NULL to never sleep; timeGet must count the time slept */
+    SYS_SCHED_SLEEP         sleep;
+
+} SYS_SCHED_INIT;
+
+typedef struct
+{
+    uint32_t    runs;
+
+    uint32_t    runMaxUs;
+
+    uint64_t    runTotalUs;
+
+    /* Start after the release; for a background task, the time between two
+     * starts */
+    uint32_t    jitterMaxUs;
+
+    uint64_t    jitterTotalUs;
+
+    /* Runs longer than the budget */
+    uint32_t    overruns;
+
+    /* Runs finished after the deadline */
+    uint32_t    deadlineMisses;
+
+    /* Releases dropped because the task was a whole period late */
+    uint32_t    releasesSkipped;
+
+} SYS_SCHED_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* The table must stay valid.  Returns false when it has more than
+ * SYS_SCHED_TASKS_MAX tasks or no time source. */
+bool SYS_SCHED_Initialize( const SYS_SCHED_INIT* init );
+
+/* One pass over the table; called from SYS_Tasks */
+void SYS_SCHED_Tasks( void );
+
+size_t SYS_SCHED_TasksNumberGet( void );
+
+/* Returns NULL for an index past the table */
+const SYS_SCHED_TASK* SYS_SCHED_TaskGet( size_t index );
+
+bool SYS_SCHED_StatsGet( size_t index, SYS_SCHED_STATS* stats );
+
+void SYS_SCHED_StatsClear( void );
+
+/* For an idleUsGet hook: microseconds left of a periodMs period started at
+ * tick startMs of the 1 ms tick, now at nowMs; 0 once it is over.  The
+ * current tick counts as gone, it may end at any time. */
+uint32_t SYS_SCHED_MsPeriodIdleUsGet( uint32_t startMs, uint32_t nowMs, uint32_t periodMs );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_SCHED_H
@@ -0,0 +1,536 @@
+/*******************************************************************************
+  Timer System Service Implementation
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_tmr.c
+
+  Summary
+    Software timer system service implementation.
+
+  Description
+    The timer objects are a fixed pool linked into doubly linked lists by
+    index.  Level 0 of the wheel has one list per tick for the next 64
+    ticks; level n has one list per 64^n ticks.  Each tick, the level 0 list
+    of that tick expires; when the level 0 index wraps to 0, the next
+    level 1 list is cascaded, that is, its timers are put back into the
+    wheel nearer the present, and so on up the levels.
+
+    Timers further than the wheel reaches are parked in the furthest level
+    3 slot and cascade round again.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "system/tmr/sys_tmr.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_TMR_WHEEL_BITS              (6U)
+#define SYS_TMR_WHEEL_SLOTS             (1UL << SYS_TMR_WHEEL_BITS)
+#define SYS_TMR_WHEEL_MASK              (SYS_TMR_WHEEL_SLOTS - 1U)
+#define SYS_TMR_WHEEL_LEVELS            (4U)
+
+/* Furthest tick the wheel holds, from the tick being processed */
+#define SYS_TMR_WHEEL_REACH             ((1UL << (SYS_TMR_WHEEL_BITS * SYS_TMR_WHEEL_LEVELS)) - 1U)
+
+#define SYS_TMR_INDEX_NONE              (0xFFFFU)
+
+#if (SYS_TMR_MAX_CLIENT_OBJECTS >= SYS_TMR_INDEX_NONE)
+#error "SYS_TMR_MAX_CLIENT_OBJECTS must fit a 16-bit index"
+#endif
+
+typedef enum
+{
+    SYS_TMR_STATE_FREE = 0,
+
+    /* Created, stopped or expired */
+    SYS_TMR_STATE_IDLE,
+
+    /* In a wheel list */
+    SYS_TMR_STATE_RUNNING,
+
+} SYS_TMR_STATE;
+
+typedef struct
+{
+    SYS_TMR_CALLBACK    callback;
+
+    uintptr_t           context;
+
+    uint32_t            expires;
+
+    uint32_t            periodMs;
+
+    /* Wheel list links, or the free list link in next */
+    uint16_t            next;
+
+    uint16_t            prev;
+
+    /* Wheel list the object is in, level * SYS_TMR_WHEEL_SLOTS + slot */
+    uint16_t            list;
+
+    /* Changed on delete, so that stale handles are recognized */
+    uint16_t            generation;
+
+    uint8_t             flags;
+
+    uint8_t             state;
+
+} SYS_TMR_OBJ;
+
+typedef struct
+{
+    SYS_TMR_TICK_GET    tickGet;
+
+    /* Next tick to process */
+    uint32_t            base;
+
+    /* Tick SYS_TMR_Tasks is catching up to */
+    uint32_t            tick;
+
+    uint16_t            wheel[SYS_TMR_WHEEL_LEVELS * SYS_TMR_WHEEL_SLOTS];
+
+    uint16_t            freeHead;
+
+    uint32_t            used;
+
+    uint32_t            usedMax;
+
+    SYS_TMR_OBJ         objects[SYS_TMR_MAX_CLIENT_OBJECTS];
+
+} SYS_TMR_DATA;
+
+static SYS_TMR_DATA sysTmrData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static SYS_TMR_OBJ* SYS_TMR_ObjectGet( SYS_TMR_HANDLE handle )
+{
+    uint32_t index = (handle & 0xFFFFU) - 1U;
+    SYS_TMR_OBJ* object;
+
+    if (index >= SYS_TMR_MAX_CLIENT_OBJECTS)
+    {
+        return NULL;
+    }
+
+    object = &sysTmrData.objects[index];
+
+    if ((object->state == (uint8_t)SYS_TMR_STATE_FREE) || (object->generation != (uint16_t)(handle >> 16)))
+    {
+        return NULL;
+    }
+
+    return object;
+}
+
+static void SYS_TMR_Link( uint16_t index )
+{
+    SYS_TMR_OBJ* object = &sysTmrData.objects[index];
+    uint32_t delta = object->expires - sysTmrData.base;
+    uint32_t expires = object->expires;
+    uint32_t level;
+    uint32_t list;
+
+    if ((int32_t)delta < 0)
+    {
+        /* Overdue, expires on the tick being processed */
+        delta = 0U;
+        expires = sysTmrData.base;
+    }
+    else if (delta > SYS_TMR_WHEEL_REACH)
+    {
+        delta = SYS_TMR_WHEEL_REACH;
+        expires = sysTmrData.base + SYS_TMR_WHEEL_REACH;
+    }
+    else
+    {
+        /* Within reach */
+    }
+
+    for (level = 0U; level < (SYS_TMR_WHEEL_LEVELS - 1U); level++)
+    {
+        if (delta < (1UL << (SYS_TMR_WHEEL_BITS * (level + 1U))))
+        {
+            break;
+        }
+    }
+
+    list = (level * SYS_TMR_WHEEL_SLOTS) + ((expires >> (SYS_TMR_WHEEL_BITS * level)) & SYS_TMR_WHEEL_MASK);
+
+    object->list = (uint16_t)list;
+    object->prev = SYS_TMR_INDEX_NONE;
+    object->next = sysTmrData.wheel[list];
+
+    if (object->next != SYS_TMR_INDEX_NONE)
+    {
+        sysTmrData.objects[object->next].prev = index;
+    }
+
+    sysTmrData.wheel[list] = index;
+    object->state = (uint8_t)SYS_TMR_STATE_RUNNING;
+}
+
+static void SYS_TMR_Unlink( uint16_t index )
+{
+    SYS_TMR_OBJ* object = &sysTmrData.objects[index];
+
+    if (object->prev == SYS_TMR_INDEX_NONE)
+    {
+        sysTmrData.wheel[object->list] = object->next;
+    }
+    else
+    {
+        sysTmrData.objects[object->prev].next = object->next;
+    }
+
+    if (object->next != SYS_TMR_INDEX_NONE)
+    {
+        sysTmrData.objects[object->next].prev = object->prev;
+    }
+
+    object->state = (uint8_t)SYS_TMR_STATE_IDLE;
+}
+
+static void SYS_TMR_Free( uint16_t index )
+{
+    SYS_TMR_OBJ* object = &sysTmrData.objects[index];
+
+    object->state = (uint8_t)SYS_TMR_STATE_FREE;
+    object->generation++;
+    object->next = sysTmrData.freeHead;
+    sysTmrData.freeHead = index;
+    sysTmrData.used--;
+}
+
+/* Puts the timers of a higher level list back into the wheel */
+static void SYS_TMR_Cascade( uint32_t list )
+{
+    uint16_t index = sysTmrData.wheel[list];
+    uint16_t next;
+
+    sysTmrData.wheel[list] = SYS_TMR_INDEX_NONE;
+
+    while (index != SYS_TMR_INDEX_NONE)
+    {
+        next = sysTmrData.objects[index].next;
+        SYS_TMR_Link(index);
+        index = next;
+    }
+}
+
+static void SYS_TMR_Expire( uint16_t index )
+{
+    SYS_TMR_OBJ* object = &sysTmrData.objects[index];
+    SYS_TMR_CALLBACK callback = object->callback;
+    uintptr_t context = object->context;
+
+    SYS_TMR_Unlink(index);
+
+    /* Settled before the call, so that the callback may change the timer */
+    if ((object->flags & (uint8_t)SYS_TMR_FLAG_SINGLE) == 0U)
+    {
+        object->expires += object->periodMs;
+
+        /* After a long wait for SYS_TMR_Tasks, skip the periods missed
+         * rather than run them all on the way */
+        if ((int32_t)(object->expires - sysTmrData.tick) <= 0)
+        {
+            object->expires += (((sysTmrData.tick - object->expires) / object->periodMs) + 1U) * object->periodMs;
+        }
+
+        SYS_TMR_Link(index);
+    }
+    else if ((object->flags & (uint8_t)SYS_TMR_FLAG_AUTO_DELETE) != 0U)
+    {
+        SYS_TMR_Free(index);
+    }
+    else
+    {
+        /* Stays idle until reloaded */
+    }
+
+    if (callback != NULL)
+    {
+        callback(context, sysTmrData.base);
+    }
+}
+
+static void SYS_TMR_TickProcess( void )
+{
+    uint32_t index = sysTmrData.base & SYS_TMR_WHEEL_MASK;
+    uint32_t list = index;
+    uint32_t level;
+
+    for (level = 1U; (level < SYS_TMR_WHEEL_LEVELS) && (index == 0U); level++)
+    {
+        index = (sysTmrData.base >> (SYS_TMR_WHEEL_BITS * level)) & SYS_TMR_WHEEL_MASK;
+        SYS_TMR_Cascade((level * SYS_TMR_WHEEL_SLOTS) + index);
+    }
+
+    /* Callbacks may add timers to this list, for this tick too */
+    while (sysTmrData.wheel[list] != SYS_TMR_INDEX_NONE)
+    {
+        SYS_TMR_Expire(sysTmrData.wheel[list]);
+    }
+
+    sysTmrData.base++;
+}
+
+static void SYS_TMR_Start( SYS_TMR_OBJ* object, uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback )
+{
+    uint16_t index = (uint16_t)(object - sysTmrData.objects);
+
+    if (object->state == (uint8_t)SYS_TMR_STATE_RUNNING)
+    {
+        SYS_TMR_Unlink(index);
+    }
+
+    object->callback = callback;
+    object->context = context;
+    object->periodMs = periodMs;
+    object->expires = sysTmrData.tickGet() + periodMs;
+
+    SYS_TMR_Link(index);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_TMR_Initialize( const SYS_TMR_INIT* init )
+{
+    uint32_t index;
+
+    (void) memset(&sysTmrData, 0, sizeof(sysTmrData));
+
+    sysTmrData.tickGet = init->tickGet;
+    sysTmrData.base = init->tickGet();
+    sysTmrData.tick = sysTmrData.base;
+
+    for (index = 0U; index < (SYS_TMR_WHEEL_LEVELS * SYS_TMR_WHEEL_SLOTS); index++)
+    {
+        sysTmrData.wheel[index] = SYS_TMR_INDEX_NONE;
+    }
+
+    sysTmrData.freeHead = SYS_TMR_INDEX_NONE;
+
+    for (index = SYS_TMR_MAX_CLIENT_OBJECTS; index > 0U; index--)
+    {
+        sysTmrData.objects[index - 1U].next = sysTmrData.freeHead;
+        sysTmrData.freeHead = (uint16_t)(index - 1U);
+    }
+}
+
+void SYS_TMR_Tasks( void )
+{
+    sysTmrData.tick = sysTmrData.tickGet();
+
+    while ((int32_t)(sysTmrData.tick - sysTmrData.base) >= 0)
+    {
+        SYS_TMR_TickProcess();
+    }
+}
+
+uint32_t SYS_TMR_IdleUsGet( void )
+{
+    uint32_t base = sysTmrData.base;
+    uint32_t due = 0U;
+    bool isFound = false;
+    uint32_t level;
+    uint32_t span;
+    uint32_t first;
+    uint32_t at;
+    uint32_t offset;
+    uint32_t ticks;
+
+    /* The first level holds the next 64 ticks, one slot each */
+    for (offset = 0U; offset < SYS_TMR_WHEEL_SLOTS; offset++)
+    {
+        if (sysTmrData.wheel[(base + offset) & SYS_TMR_WHEEL_MASK] != SYS_TMR_INDEX_NONE)
+        {
+            due = base + offset;
+            isFound = true;
+            break;
+        }
+    }
+
+    /* A list higher up is due when it cascades, at the start of its span */
+    for (level = 1U; level < SYS_TMR_WHEEL_LEVELS; level++)
+    {
+        span = 1UL << (SYS_TMR_WHEEL_BITS * level);
+        first = (base + span - 1U) & ~(span - 1U);
+
+        for (offset = 0U; offset < SYS_TMR_WHEEL_SLOTS; offset++)
+        {
+            at = first + (offset * span);
+
+            if ((isFound == true) && ((int32_t)(at - due) >= 0))
+            {
+                break;
+            }
+
+            if (sysTmrData.wheel[(level * SYS_TMR_WHEEL_SLOTS) + ((at >> (SYS_TMR_WHEEL_BITS * level)) & SYS_TMR_WHEEL_MASK)] != SYS_TMR_INDEX_NONE)
+            {
+                due = at;
+                isFound = true;
+                break;
+            }
+        }
+    }
+
+    if (isFound == false)
+    {
+        return UINT32_MAX;
+    }
+
+    ticks = due - sysTmrData.tickGet();
+
+    if ((int32_t)ticks <= 0)
+    {
+        return 0U;
+    }
+
+    /* The next tick may come at any time, so count one less */
+    ticks--;
+
+    return (ticks < (UINT32_MAX / 1000U)) ? (ticks * 1000U) : (UINT32_MAX - 1U);
+}
+
+SYS_TMR_HANDLE SYS_TMR_ObjectCreate( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback, SYS_TMR_FLAGS flags )
+{
+    uint16_t index = sysTmrData.freeHead;
+    SYS_TMR_OBJ* object;
+
+    if ((index == SYS_TMR_INDEX_NONE) || (periodMs == 0U) || (periodMs > SYS_TMR_PERIOD_MAX))
+    {
+        return SYS_TMR_HANDLE_INVALID;
+    }
+
+    object = &sysTmrData.objects[index];
+    sysTmrData.freeHead = object->next;
+
+    sysTmrData.used++;
+    if (sysTmrData.used > sysTmrData.usedMax)
+    {
+        sysTmrData.usedMax = sysTmrData.used;
+    }
+
+    object->flags = (uint8_t)flags;
+    object->state = (uint8_t)SYS_TMR_STATE_IDLE;
+
+    SYS_TMR_Start(object, periodMs, context, callback);
+
+    return ((uint32_t)object->generation << 16) | ((uint32_t)index + 1U);
+}
+
+bool SYS_TMR_ObjectReload( SYS_TMR_HANDLE handle, uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback )
+{
+    SYS_TMR_OBJ* object = SYS_TMR_ObjectGet(handle);
+
+    if ((object == NULL) || (periodMs == 0U) || (periodMs > SYS_TMR_PERIOD_MAX))
+    {
+        return false;
+    }
+
+    SYS_TMR_Start(object, periodMs, context, callback);
+
+    return true;
+}
+
+bool SYS_TMR_ObjectStop( SYS_TMR_HANDLE handle )
+{
+    SYS_TMR_OBJ* object = SYS_TMR_ObjectGet(handle);
+
+    if (object == NULL)
+    {
+        return false;
+    }
+
+    if (object->state == (uint8_t)SYS_TMR_STATE_RUNNING)
+    {
+        SYS_TMR_Unlink((uint16_t)(object - sysTmrData.objects));
+    }
+
+    return true;
+}
+
+void SYS_TMR_ObjectDelete( SYS_TMR_HANDLE handle )
+{
+    if (SYS_TMR_ObjectStop(handle) == true)
+    {
+        SYS_TMR_Free((uint16_t)((handle & 0xFFFFU) - 1U));
+    }
+}
+
+bool SYS_TMR_ObjectIsRunning( SYS_TMR_HANDLE handle )
+{
+    SYS_TMR_OBJ* object = SYS_TMR_ObjectGet(handle);
+
+    return (object != NULL) && (object->state == (uint8_t)SYS_TMR_STATE_RUNNING);
+}
+
+SYS_TMR_HANDLE SYS_TMR_CallbackPeriodic( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback )
+{
+    return SYS_TMR_ObjectCreate(periodMs, context, callback, SYS_TMR_FLAG_PERIODIC);
+}
+
+SYS_TMR_HANDLE SYS_TMR_CallbackSingle( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback )
+{
+    return SYS_TMR_ObjectCreate(periodMs, context, callback,
+        (SYS_TMR_FLAGS)((uint8_t)SYS_TMR_FLAG_SINGLE | (uint8_t)SYS_TMR_FLAG_AUTO_DELETE));
+}
+
+uint32_t SYS_TMR_ObjectsUsedGet( void )
+{
+    return sysTmrData.used;
+}
+
+uint32_t SYS_TMR_ObjectsUsedMaxGet( void )
+{
+    return sysTmrData.usedMax;
+}
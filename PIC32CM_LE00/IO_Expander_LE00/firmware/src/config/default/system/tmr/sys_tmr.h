@@ -0,0 +1,171 @@
+/*******************************************************************************
+  Timer System Service Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_tmr.h
+
+  Summary
+    Software timer system service library interface.
+
+  Description
+    This file defines the interface to the software timer service.  Any
+    number of one-shot and periodic timers, up to SYS_TMR_MAX_CLIENT_OBJECTS,
+    run from the 1 ms system tick and call back when they expire.
+
+  Remarks:
+    The timers are kept in a hierarchical timing wheel of four levels of 64
+    slots each.  Starting, stopping and expiring a timer take constant time
+    whatever the number of timers; a timer more than 64 ticks away moves
+    down a level every 64, 4096 or 262144 ticks.
+
+    Callbacks are made from SYS_TMR_Tasks, in task context, and may create,
+    reload, stop or delete any timer, their own included.  A periodic timer
+    keeps its phase.  When SYS_TMR_Tasks is called late, each timer due
+    calls back once, on the tick it was due, and a periodic one skips the
+    periods that have passed since.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_TMR_H    // Guards against multiple inclusion
+#define SYS_TMR_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef uint32_t SYS_TMR_HANDLE;
+
+#define SYS_TMR_HANDLE_INVALID          ((SYS_TMR_HANDLE)0U)
+
+/* Longest period, in ticks */
+#define SYS_TMR_PERIOD_MAX              (0x7FFFFFFFU)
+
+/* currTick is the tick the timer expired on */
+typedef void (*SYS_TMR_CALLBACK)( uintptr_t context, uint32_t currTick );
+
+/* Free running 1 ms tick count */
+typedef uint32_t (*SYS_TMR_TICK_GET)( void );
+
+typedef enum
+{
+    /* Runs again every period until stopped */
+    SYS_TMR_FLAG_PERIODIC       = 0x00U,
+
+    /* Runs once; the object stays and can be reloaded */
+    SYS_TMR_FLAG_SINGLE         = 0x01U,
+
+    /* With SYS_TMR_FLAG_SINGLE: the object is deleted when it expires */
+    SYS_TMR_FLAG_AUTO_DELETE    = 0x02U,
+
+} SYS_TMR_FLAGS;
+
+typedef struct
+{
+    SYS_TMR_TICK_GET    tickGet;
+
+} SYS_TMR_INIT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_TMR_Initialize( const SYS_TMR_INIT* init );
+
+/* Expires the timers due up to the current tick; called from SYS_Tasks */
+void SYS_TMR_Tasks( void );
+
+/* Microseconds before a timer can expire or a list moves down the wheel,
+ * rounded down to the tick; 0 when one is due, UINT32_MAX when none runs */
+uint32_t SYS_TMR_IdleUsGet( void );
+
+/* Creates a timer and starts it, to expire periodMs ticks from now.  Returns
+ * SYS_TMR_HANDLE_INVALID when all objects are in use or the period is 0 or
+ * over SYS_TMR_PERIOD_MAX. */
+SYS_TMR_HANDLE SYS_TMR_ObjectCreate( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback, SYS_TMR_FLAGS flags );
+
+/* Restarts a timer, running or not, with a new period, context and
+ * callback; false for a stale handle or a period out of range */
+bool SYS_TMR_ObjectReload( SYS_TMR_HANDLE handle, uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback );
+
+/* Stops a timer without deleting it; false for a stale handle */
+bool SYS_TMR_ObjectStop( SYS_TMR_HANDLE handle );
+
+/* A stale handle is ignored */
+void SYS_TMR_ObjectDelete( SYS_TMR_HANDLE handle );
+
+/* True while the timer is started and has not expired */
+bool SYS_TMR_ObjectIsRunning( SYS_TMR_HANDLE handle );
+
+/* Periodic timer */
+SYS_TMR_HANDLE SYS_TMR_CallbackPeriodic( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback );
+
+/* One-shot timer, deleted once it has called back */
+SYS_TMR_HANDLE SYS_TMR_CallbackSingle( uint32_t periodMs, uintptr_t context, SYS_TMR_CALLBACK callback );
+
+/* Objects in use now, and at most since SYS_TMR_Initialize */
+uint32_t SYS_TMR_ObjectsUsedGet( void );
+
+uint32_t SYS_TMR_ObjectsUsedMaxGet( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_TMR_H
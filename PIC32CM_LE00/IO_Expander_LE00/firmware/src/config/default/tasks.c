@@ -71,22 +71,9 @@
 */
 void SYS_Tasks ( void )
 {
-    /* Maintain system services */
-    
-
-    /* Maintain Device Drivers */
-    
-
-    /* Maintain Middleware & Other Libraries */
-    
-
-    /* Maintain the application's state machine. */
-        /* Call Application task APP. */
-    APP_Tasks();
-
-
-
-
+    /* Maintain system services, the device drivers and the application's
+     * state machines; the task table is in initialization.c */
+    SYS_SCHED_Tasks();
 }
 
 /*******************************************************************************
@@ -43,6 +43,10 @@ extern "C" {
 #define NO_INIT        __attribute__((section(".no_init")))
 #define SECTION(a)     __attribute__((__section__(a)))
 
+/* Function run from RAM: XC32 places it there and its data initialization
+ * copies it at start-up; calls to it from flash need the long call */
+#define RAMFUNC        __attribute__((ramfunc, long_call, noinline))
+
 #define CACHE_LINE_SIZE    (4u)
 #define CACHE_ALIGN
 
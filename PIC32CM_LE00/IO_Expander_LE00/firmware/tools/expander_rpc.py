@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Read and write the expander ports through the binary request frames.
+
+Requests and replies are COBS framed like the telemetry; see src/app_rpc.h
+for the layout. Up to WINDOW requests are kept outstanding and replies are
+matched by sequence number, so the serial link and the I2C buses stay busy.
+
+Usage:
+    expander_rpc.py DEVICE read EXPANDER...
+    expander_rpc.py DEVICE write EXPANDER=PORT...
+    expander_rpc.py DEVICE script STEP...
+    expander_rpc.py DEVICE baud RATE
+    expander_rpc.py DEVICE bench [--op read|write] [--batch N] [--window N]
+                                 [--seconds S]
+
+DEVICE is a serial device already set up with stty (921600 baud, raw).
+A script STEP is EXPANDER:rREGISTER:LENGTH to read or
+EXPANDER:wREGISTER:BYTE[,BYTE...] to write, e.g. 0:w0x00:0x00,0x00 makes
+all pins of expander 0 outputs. Telemetry frames, log records and console
+text on the same stream are skipped.
+
+baud changes the console rate on both ends: the device answers at the old
+rate, the device is switched and the request is repeated at the new rate to
+confirm it. Without the confirmation the device goes back to the old rate
+after a second.
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import telemetry_decode  # noqa: E402
+
+OP_WRITE_PORTS = 0x01
+OP_READ_PORTS = 0x02
+OP_SCRIPT = 0x03
+OP_BAUD_SET = 0x04
+
+SCRIPT_READ = 0x80
+SCRIPT_LENGTH_MAX = 16
+
+REQUESTS_MAX = 4
+ITEMS_MAX = 32
+
+RESULTS = {0x00: "ok", 0x01: "item failed", 0x80: "malformed", 0x81: "busy", 0x82: "unknown op"}
+STATUSES = {0x00: "ok", 0x01: "i2c error", 0x02: "no expander", 0x03: "not queued", 0x04: "refused"}
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte:
+            out.append(byte)
+            code += 1
+        if not byte or code == 0xFF:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+class Request:
+    def __init__(self, op, items):
+        self.op = op
+        self.items = items
+        self.sequence = None
+        self.sent = None
+
+
+class Client:
+    """Keeps up to `window` requests outstanding on a file descriptor."""
+
+    def __init__(self, fd, window=REQUESTS_MAX, timeout=1.0):
+        self.fd = fd
+        self.window = window
+        self.timeout = timeout
+        self.sequence = 0
+        self.pending = {}
+        self.splitter = telemetry_decode.Splitter(None)
+        self.round_trips = []
+        self.completed = 0
+        self.completed_items = 0
+        self.failed = 0
+
+    def frame(self, request):
+        payload = bytearray([request.sequence, request.op, len(request.items)])
+        for item in request.items:
+            if request.op == OP_WRITE_PORTS:
+                payload += struct.pack("<BH", item[0], item[1])
+            elif request.op == OP_READ_PORTS:
+                payload.append(item)
+            elif request.op == OP_BAUD_SET:
+                payload += struct.pack("<I", item)
+            else:
+                expander, is_read, register, data = item
+                if is_read:
+                    payload += bytes([expander, SCRIPT_READ | data, register])
+                else:
+                    payload += bytes([expander, len(data), register]) + bytes(data)
+        payload += struct.pack("<H", telemetry_decode.crc16(payload))
+        return b"\x00" + cobs_encode(payload) + b"\x00"
+
+    def submit(self, request):
+        while len(self.pending) >= self.window:
+            self.poll()
+        request.sequence = self.sequence
+        self.sequence = (self.sequence + 1) & 0xFF
+        request.sent = time.monotonic()
+        self.pending[request.sequence] = request
+        os.write(self.fd, self.frame(request))
+
+    def poll(self):
+        """Waits for data and returns the completed requests."""
+        done = []
+        ready, _, _ = select.select([self.fd], [], [], self.timeout)
+        if not ready:
+            raise TimeoutError("no reply to %u requests" % len(self.pending))
+        for record in self.splitter.feed(os.read(self.fd, 4096)):
+            if record.get("type") != "rpc" or record["seq"] not in self.pending:
+                continue
+            request = self.pending.pop(record["seq"])
+            self.round_trips.append(time.monotonic() - request.sent)
+            request.result = record["result"]
+            request.replies = self.parse(request, record["body"])
+            self.completed += 1
+            self.completed_items += len(request.items)
+            self.failed += request.result != 0
+            done.append(request)
+        return done
+
+    def drain(self):
+        done = []
+        while self.pending:
+            done += self.poll()
+        return done
+
+    @staticmethod
+    def parse(request, body):
+        replies = []
+        offset = 0
+        for item in request.items:
+            if offset >= len(body):
+                break
+            status = body[offset]
+            offset += 1
+            value = None
+            if request.op == OP_READ_PORTS:
+                value, = struct.unpack_from("<H", body, offset)
+                offset += 2
+            elif request.op == OP_SCRIPT and item[1]:
+                value = list(body[offset:offset + item[3]])
+                offset += item[3]
+            elif request.op == OP_BAUD_SET:
+                value = struct.unpack_from("<IiI", body, offset)
+                offset += 12
+            replies.append((STATUSES.get(status, status), value))
+        return replies
+
+
+def number(text):
+    return int(text, 0)
+
+
+def script_step(text):
+    expander, action, rest = text.split(":", 2)
+    register = number(action[1:])
+    if action[0] == "r":
+        length = number(rest)
+        if not 1 <= length <= SCRIPT_LENGTH_MAX:
+            raise argparse.ArgumentTypeError("read length 1-%u" % SCRIPT_LENGTH_MAX)
+        return (number(expander), True, register, length)
+    data = [number(byte) for byte in rest.split(",")]
+    if not 1 <= len(data) <= SCRIPT_LENGTH_MAX:
+        raise argparse.ArgumentTypeError("write length 1-%u" % SCRIPT_LENGTH_MAX)
+    return (number(expander), False, register, data)
+
+
+def show(request):
+    print("%s: %s" % ({OP_WRITE_PORTS: "write", OP_READ_PORTS: "read", OP_SCRIPT: "script",
+                       OP_BAUD_SET: "baud"}[request.op],
+                      RESULTS.get(request.result, request.result)))
+    if request.op == OP_BAUD_SET:
+        for status, value in request.replies:
+            print("  %s: made %u (%d ppm), stop bit sample error %.2f%%" %
+                  (status, value[0], value[1], value[2] / 1e4))
+        return
+    for item, (status, value) in zip(request.items, request.replies):
+        expander = item if request.op == OP_READ_PORTS else item[0]
+        if isinstance(value, int):
+            print("  expander %u: %s 0x%04X" % (expander, status, value))
+        elif value is not None:
+            print("  expander %u: %s %s" % (expander, status, " ".join("%02X" % b for b in value)))
+        else:
+            print("  expander %u: %s" % (expander, status))
+
+
+def bench(client, op, batch, seconds):
+    start = time.monotonic()
+    index = 0
+
+    while time.monotonic() - start < seconds:
+        if op == OP_READ_PORTS:
+            request = Request(op, [(index + n) % 16 for n in range(batch)])
+        else:
+            request = Request(op, [((index + n) % 16, (index + n) & 0xFFFF) for n in range(batch)])
+        index += batch
+        client.submit(request)
+    client.drain()
+
+    elapsed = time.monotonic() - start
+    trips = sorted(client.round_trips)
+    print("%u requests, %u ops in %.2f s: %.0f requests/s, %.0f ops/s" %
+          (client.completed, client.completed_items, elapsed,
+           client.completed / elapsed, client.completed_items / elapsed))
+    print("round trip ms: median %.2f, 99th %.2f; %u requests with failures" %
+          (1000 * trips[len(trips) // 2], 1000 * trips[int(len(trips) * 0.99)], client.failed))
+
+
+def baud(client, rate):
+    """Switches the device and then the local port, and confirms the rate."""
+    speed = getattr(termios, "B%u" % rate, None)
+    if speed is None:
+        raise SystemExit("%u baud is not a termios rate" % rate)
+
+    request = Request(OP_BAUD_SET, [rate])
+    client.submit(request)
+    client.drain()
+    show(request)
+    if request.result != 0:
+        return request
+
+    attributes = termios.tcgetattr(client.fd)
+    attributes[4] = attributes[5] = speed
+    termios.tcsetattr(client.fd, termios.TCSADRAIN, attributes)
+    termios.tcflush(client.fd, termios.TCIFLUSH)
+
+    # The device switches once its transmitter is idle
+    time.sleep(0.02)
+    confirm = Request(OP_BAUD_SET, [rate])
+    client.submit(confirm)
+    client.drain()
+    show(confirm)
+    return confirm
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("device")
+    parser.add_argument("--window", type=int, default=REQUESTS_MAX,
+                        help="requests outstanding, at most %u" % REQUESTS_MAX)
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("read").add_argument("expanders", type=number, nargs="+")
+    commands.add_parser("write").add_argument("ports", nargs="+")
+    commands.add_parser("script").add_argument("steps", type=script_step, nargs="+")
+    commands.add_parser("baud").add_argument("rate", type=number)
+    bench_parser = commands.add_parser("bench")
+    bench_parser.add_argument("--op", choices=("read", "write"), default="read")
+    bench_parser.add_argument("--batch", type=int, default=16)
+    bench_parser.add_argument("--seconds", type=float, default=5.0)
+    options = parser.parse_args(argv[1:])
+
+    fd = os.open(options.device, os.O_RDWR | os.O_NOCTTY)
+    client = Client(fd, min(options.window, REQUESTS_MAX))
+
+    if options.command == "bench":
+        bench(client, OP_READ_PORTS if options.op == "read" else OP_WRITE_PORTS,
+              min(options.batch, ITEMS_MAX), options.seconds)
+        return 0
+
+    if options.command == "baud":
+        return 0 if baud(client, options.rate).result == 0 else 1
+
+    if options.command == "read":
+        request = Request(OP_READ_PORTS, options.expanders)
+    elif options.command == "write":
+        request = Request(OP_WRITE_PORTS, [tuple(number(part) for part in port.split("="))
+                                           for port in options.ports])
+    else:
+        request = Request(OP_SCRIPT, options.steps)
+
+    client.submit(request)
+    client.drain()
+    show(request)
+    return 0 if request.result == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,276 @@
+/*******************************************************************************
+  Expander polling two bus host test
+
+  Runs app_expander.c for one simulated second against two modelled I2C
+  buses.  Each read, a 2-byte write/read, takes 48 bit times at 400 kHz,
+  with 3.8 us between two chained transfers on a bus and 4 us per pass of
+  the tasks.
+
+  Uniform weights, the default: all 16 expanders on one bus, then split
+  across both as APP_EXPANDER_Initialize does.  Weights 4 for 4 expanders,
+  2 for 4 and 1 for 8: split by weight, then 8 and 8 in table order.
+
+  Checked: every read completes with the expander online; two buses read
+  close to twice as many expanders per second as one; split by weight,
+  the read rates follow the weights and the buses complete more cycles
+  than with the split in table order.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_expander.h"
+#include "app_target.h"
+#include "app_telemetry.h"
+
+/* The runs write the weight table */
+#define const
+#include "app_expander.c"
+#undef const
+
+#define TEST_RUN_US             1000000ULL
+#define TEST_PASS_US            4ULL
+
+/* 48 bit times at 400 kHz, and the gap between chained transfers */
+#define TEST_READ_NS            120000ULL
+#define TEST_GAP_NS             3800ULL
+
+#define TEST_QUEUE_SIZE         APP_TARGET_EXPANDERS_NUMBER
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("  %s:%d: %s\n", __FILE__, __LINE__, #condition); testFailures++; } } while (0)
+
+typedef struct
+{
+    DRV_I2C_TRANSFER_EVENT_HANDLER  handler;
+
+    uintptr_t                       context;
+
+    DRV_I2C_TRANSFER_HANDLE         queue[TEST_QUEUE_SIZE];
+
+    uint32_t                        queueHead;
+
+    uint32_t                        queueNumber;
+
+    /* When the transfer at the head of the queue completes */
+    uint64_t                        doneNs;
+
+} TEST_BUS;
+
+static TEST_BUS testBus[APP_EXPANDER_BUSES_NUMBER];
+static uint64_t testNowNs;
+static uint32_t testNextHandle;
+static unsigned long testFailures;
+static uint32_t testReads[APP_TARGET_EXPANDERS_NUMBER];
+static uint32_t testCycles;
+
+static const uint8_t testUniformWeight[APP_TARGET_EXPANDERS_NUMBER] =
+{
+    4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U,
+    4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U,
+};
+
+static const uint8_t testMixedWeight[APP_TARGET_EXPANDERS_NUMBER] =
+{
+    4U, 4U, 4U, 4U, 2U, 2U, 2U, 2U,
+    1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U,
+};
+
+uint32_t SYSTICK_GetTickCounter( void )
+{
+    return (uint32_t)(testNowNs / 1000000ULL);
+}
+
+uint32_t SYS_SCHED_MsPeriodIdleUsGet( uint32_t startTick, uint32_t nowTick, uint32_t periodMs )
+{
+    return 0U;
+}
+
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+bool SYS_LOG_Write( uint32_t id, uint32_t nArgs, const uint32_t* args )
+{
+    return true;
+}
+
+DRV_HANDLE DRV_I2C_Open( const SYS_MODULE_INDEX drvIndex, const DRV_IO_INTENT ioIntent )
+{
+    return (DRV_HANDLE)drvIndex;
+}
+
+void DRV_I2C_TransferEventHandlerSet( const DRV_HANDLE handle, const DRV_I2C_TRANSFER_EVENT_HANDLER eventHandler, const uintptr_t context )
+{
+    testBus[handle].handler = eventHandler;
+    testBus[handle].context = context;
+}
+
+void DRV_I2C_WriteReadTransferAdd( const DRV_HANDLE handle, const uint16_t address, void * const writeBuffer, const size_t writeSize,
+                                   void * const readBuffer, const size_t readSize, DRV_I2C_TRANSFER_HANDLE * const transferHandle )
+{
+    TEST_BUS* bus = &testBus[handle];
+
+    if (bus->queueNumber >= TEST_QUEUE_SIZE)
+    {
+        *transferHandle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+        return;
+    }
+
+    if (bus->queueNumber == 0U)
+    {
+        bus->doneNs = testNowNs + TEST_READ_NS;
+    }
+
+    testNextHandle++;
+    *transferHandle = testNextHandle;
+
+    bus->queue[(bus->queueHead + bus->queueNumber) % TEST_QUEUE_SIZE] = testNextHandle;
+    bus->queueNumber++;
+}
+
+void APP_TARGET_InputsUpdate( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline )
+{
+    TEST_CHECK(isOnline == true);
+
+    testReads[index]++;
+}
+
+void APP_TARGET_CycleComplete( void )
+{
+    testCycles++;
+}
+
+void APP_TELEMETRY_InputsUpdate( uint8_t index, uint8_t gpioA, uint8_t gpioB, bool isOnline )
+{
+}
+
+void APP_TELEMETRY_CycleComplete( void )
+{
+}
+
+/* The transfer interrupts up to now */
+static void TEST_BusesRun( void )
+{
+    uint32_t busIndex;
+    TEST_BUS* bus;
+    DRV_I2C_TRANSFER_HANDLE handle;
+
+    for (busIndex = 0U; busIndex < APP_EXPANDER_BUSES_NUMBER; busIndex++)
+    {
+        bus = &testBus[busIndex];
+
+        while ((bus->queueNumber > 0U) && (bus->doneNs <= testNowNs))
+        {
+            handle = bus->queue[bus->queueHead];
+            bus->queueHead = (bus->queueHead + 1U) % TEST_QUEUE_SIZE;
+            bus->queueNumber--;
+
+            if (bus->queueNumber > 0U)
+            {
+                bus->doneNs += TEST_GAP_NS + TEST_READ_NS;
+            }
+
+            bus->handler(DRV_I2C_TRANSFER_EVENT_COMPLETE, handle, bus->context);
+        }
+    }
+}
+
+/* One second from APP_EXPANDER_Initialize; with oneBus, every expander is
+ * moved to bus 0, with inOrder the first half to bus 0 and the rest to bus
+ * 1.  Returns the reads per second of all expanders. */
+static uint32_t TEST_Run( const char* name, const uint8_t* weight, bool oneBus, bool inOrder )
+{
+    uint32_t index;
+    uint32_t reads = 0U;
+    uint8_t busIndex;
+    uint8_t address;
+
+    memcpy(appExpanderWeight, weight, sizeof(appExpanderWeight));
+    memset(testBus, 0, sizeof(testBus));
+    memset(testReads, 0, sizeof(testReads));
+    testCycles = 0U;
+    testNowNs = 0U;
+
+    APP_EXPANDER_Initialize();
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        if (oneBus == true)
+        {
+            appExpanderData.device[index].bus = 0U;
+        }
+        else if (inOrder == true)
+        {
+            appExpanderData.device[index].bus = (uint8_t)((index * APP_EXPANDER_BUSES_NUMBER) / APP_TARGET_EXPANDERS_NUMBER);
+        }
+        else
+        {
+            /* As assigned */
+        }
+    }
+
+    while (testNowNs < (TEST_RUN_US * 1000ULL))
+    {
+        TEST_BusesRun();
+        APP_EXPANDER_Tasks();
+        testNowNs += TEST_PASS_US * 1000ULL;
+    }
+
+    printf("%-28s %5u cycles/s, reads/s", name, testCycles);
+
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        TEST_CHECK(APP_EXPANDER_DeviceGet((uint8_t)index, &busIndex, &address) == true);
+        TEST_CHECK(appExpanderData.device[index].transferHandle == DRV_I2C_TRANSFER_HANDLE_INVALID ||
+                   appExpanderData.bus[busIndex].state == APP_EXPANDER_STATE_WAIT);
+
+        printf("%c%u", (index == 0U) ? ' ' : ',', testReads[index]);
+        reads += testReads[index];
+    }
+
+    printf("\n");
+
+    return reads;
+}
+
+int main( void )
+{
+    uint32_t oneBusReads;
+    uint32_t twoBusReads;
+    uint32_t balancedCycles;
+    uint32_t index;
+
+    oneBusReads = TEST_Run("uniform, one bus", testUniformWeight, true, false);
+    twoBusReads = TEST_Run("uniform, split by weight", testUniformWeight, false, false);
+
+    TEST_CHECK((twoBusReads * 100U) >= (oneBusReads * 195U));
+
+    (void)TEST_Run("mixed, split by weight", testMixedWeight, false, false);
+    balancedCycles = testCycles;
+
+    /* Read in proportion to the weights, within 1% */
+    for (index = 0U; index < APP_TARGET_EXPANDERS_NUMBER; index++)
+    {
+        TEST_CHECK((testReads[index] * 4U * 100U) >= (testCycles * testMixedWeight[index] * 99U));
+        TEST_CHECK((testReads[index] * 4U * 100U) <= (testCycles * testMixedWeight[index] * 101U));
+    }
+
+    (void)TEST_Run("mixed, split in table order", testMixedWeight, false, true);
+
+    TEST_CHECK((balancedCycles * 100U) >= (testCycles * 140U));
+
+    if (testFailures != 0UL)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
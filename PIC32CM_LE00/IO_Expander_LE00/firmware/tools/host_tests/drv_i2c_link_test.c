@@ -0,0 +1,345 @@
+/*******************************************************************************
+  I2C driver link quality host test
+
+  Runs drv_i2c.c on a model PLIB that ends each transfer as soon as it
+  starts, failed or not by the error rate of the target at the clock speed
+  the driver set up for it.  The target at 0x20 never fails; the one at
+  0x21 fails 3% of its transfers at 400 kHz, 0.2% at 200 kHz and none at
+  100 kHz.  A transfer is a 1-byte write and 2-byte read, 48 bit times.
+
+  200000 transfers alternating between the two, then 50000 more with the
+  link of 0x21 repaired.
+
+  Checked: 0x20 is never tracked and always runs at 400 kHz; 0x21 settles
+  at 100 kHz and only probes the faster clocks at longer and longer
+  intervals, so few of its transfers fail and the bus time is well below
+  running both targets at 100 kHz; once repaired, 0x21 climbs back to
+  400 kHz and its entry is released.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "driver/i2c/src/drv_i2c.c"
+
+#define TEST_TRANSFERS          200000UL
+#define TEST_REPAIRED_TRANSFERS 50000UL
+#define TEST_ADDRESS_CLEAN      0x20U
+#define TEST_ADDRESS_NOISY      0x21U
+#define TEST_BITS_PER_TRANSFER  48U
+#define TEST_SPEEDS_NUMBER      3U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("transfer %lu: %s:%d: %s\n", testTransfer, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+static unsigned long testTransfer;
+
+/* The PLIB model: the transfer in flight, the clock speed set up and the
+ * callback */
+static bool testIsBusy;
+static uint16_t testAddress;
+/* SERCOM5_I2C_Initialize sets the configured speed */
+static uint32_t testClockSpeed = DRV_I2C_CLOCK_SPEED_IDX0;
+static DRV_I2C_ERROR testError;
+static DRV_I2C_PLIB_CALLBACK testCallback;
+static uintptr_t testCallbackContext;
+
+/* Failures in 100000 of 0x21 at 400, 200 and 100 kHz */
+static uint32_t testNoisyRate[TEST_SPEEDS_NUMBER] = { 3000U, 200U, 0U };
+
+/* Transfers and failures per target and speed, bus time in ns */
+static unsigned long testTransfers[2][TEST_SPEEDS_NUMBER];
+static unsigned long testFailures[2][TEST_SPEEDS_NUMBER];
+static unsigned long testEvents;
+static uint64_t testBusNs;
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+#if defined(SYS_PROF_ENABLE)
+uint32_t SYS_PROF_CyclesGet( void )
+{
+    return 0U;
+}
+
+void SYS_PROF_Record( uint32_t id, uint32_t cycles )
+{
+}
+#endif
+
+/* The harness only ends a transfer between driver calls */
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+bool SYS_INT_SourceDisable( INT_SOURCE source )
+{
+    return true;
+}
+
+void SYS_INT_SourceRestore( INT_SOURCE source, bool state )
+{
+}
+
+static bool TEST_PlibStart( uint16_t address )
+{
+    TEST_CHECK(testIsBusy == false);
+
+    testIsBusy = true;
+    testAddress = address;
+
+    return true;
+}
+
+static bool TEST_PlibRead( uint16_t address, uint8_t* rdData, uint32_t rdLength )
+{
+    return TEST_PlibStart(address);
+}
+
+static bool TEST_PlibWrite( uint16_t address, uint8_t* wrData, uint32_t wrLength )
+{
+    return TEST_PlibStart(address);
+}
+
+static bool TEST_PlibWriteRead( uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength )
+{
+    return TEST_PlibStart(address);
+}
+
+static void TEST_PlibTransferAbort( void )
+{
+}
+
+static DRV_I2C_ERROR TEST_PlibErrorGet( void )
+{
+    return testError;
+}
+
+static bool TEST_PlibTransferSetup( DRV_I2C_TRANSFER_SETUP* setup, uint32_t srcClkFreq )
+{
+    TEST_CHECK(testIsBusy == false);
+
+    testClockSpeed = setup->clockSpeed;
+
+    return true;
+}
+
+static void TEST_PlibCallbackRegister( DRV_I2C_PLIB_CALLBACK callback, uintptr_t context )
+{
+    testCallback = callback;
+    testCallbackContext = context;
+}
+
+static DRV_I2C_CLIENT_OBJ testDrvClientObjPool[DRV_I2C_CLIENTS_NUMBER_IDX0];
+static DRV_I2C_TRANSFER_OBJ testDrvTransferObj[DRV_I2C_QUEUE_SIZE_IDX0];
+
+/* No chaining, every transfer is started with its own clock speed */
+static const DRV_I2C_PLIB_INTERFACE testDrvPLibAPI =
+{
+    .read = TEST_PlibRead,
+    .write = TEST_PlibWrite,
+    .writeRead = TEST_PlibWriteRead,
+    .transferAbort = TEST_PlibTransferAbort,
+    .errorGet = TEST_PlibErrorGet,
+    .transferSetup = TEST_PlibTransferSetup,
+    .callbackRegister = TEST_PlibCallbackRegister,
+    .nextTransferSet = NULL,
+};
+
+static const DRV_I2C_INTERRUPT_SOURCES testDrvInterruptSources =
+{
+    .isSingleIntSrc = false,
+    .intSources.multi.i2cInt0 = SERCOM5_0_IRQn,
+    .intSources.multi.i2cInt1 = SERCOM5_1_IRQn,
+    .intSources.multi.i2cInt2 = SERCOM5_2_IRQn,
+    .intSources.multi.i2cInt3 = SERCOM5_OTHER_IRQn,
+};
+
+static const DRV_I2C_INIT testDrvInitData =
+{
+    .i2cPlib = &testDrvPLibAPI,
+    .numClients = DRV_I2C_CLIENTS_NUMBER_IDX0,
+    .clientObjPool = (uintptr_t)&testDrvClientObjPool[0],
+    .transferObjPoolSize = DRV_I2C_QUEUE_SIZE_IDX0,
+    .transferObjPool = (uintptr_t)&testDrvTransferObj[0],
+    .interruptSources = &testDrvInterruptSources,
+    .clockSpeed = DRV_I2C_CLOCK_SPEED_IDX0,
+};
+
+static void TEST_TransferEvent( DRV_I2C_TRANSFER_EVENT event, DRV_I2C_TRANSFER_HANDLE transferHandle, uintptr_t context )
+{
+    TEST_CHECK(event == ((testError == DRV_I2C_ERROR_NONE) ? DRV_I2C_TRANSFER_EVENT_COMPLETE : DRV_I2C_TRANSFER_EVENT_ERROR));
+
+    testEvents++;
+}
+
+static uint32_t TEST_SpeedIndex( uint32_t clockSpeed )
+{
+    uint32_t speedIndex = 0U;
+
+    while ((speedIndex < (TEST_SPEEDS_NUMBER - 1U)) && ((DRV_I2C_CLOCK_SPEED_IDX0 >> speedIndex) != clockSpeed))
+    {
+        speedIndex++;
+    }
+
+    TEST_CHECK((DRV_I2C_CLOCK_SPEED_IDX0 >> speedIndex) == clockSpeed);
+
+    return speedIndex;
+}
+
+static bool TEST_LinkIsTracked( uint16_t address )
+{
+    uint32_t linkIndex;
+
+    for (linkIndex = 0U; linkIndex < DRV_I2C_LINKS_NUMBER; linkIndex++)
+    {
+        if (gDrvI2CObj[DRV_I2C_INDEX_0].links[linkIndex].address == address)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* One write/read to address, ended by the model PLIB */
+static void TEST_TransferRun( DRV_HANDLE handle, uint16_t address )
+{
+    static uint8_t writeData[1];
+    static uint8_t readData[2];
+    DRV_I2C_TRANSFER_HANDLE transferHandle;
+    uint32_t speedIndex;
+    uint32_t targetIndex = (address == TEST_ADDRESS_NOISY) ? 1U : 0U;
+    unsigned long events = testEvents;
+
+    DRV_I2C_WriteReadTransferAdd(handle, address, writeData, sizeof(writeData), readData, sizeof(readData), &transferHandle);
+
+    TEST_CHECK(transferHandle != DRV_I2C_TRANSFER_HANDLE_INVALID);
+    TEST_CHECK(testIsBusy == true);
+    TEST_CHECK(testAddress == address);
+
+    speedIndex = TEST_SpeedIndex(testClockSpeed);
+
+    testError = DRV_I2C_ERROR_NONE;
+
+    if ((targetIndex == 1U) && ((TEST_Random() % 100000U) < testNoisyRate[speedIndex]))
+    {
+        testError = ((TEST_Random() % 2U) == 0U) ? DRV_I2C_ERROR_NACK : DRV_I2C_ERROR_BUS;
+        testFailures[targetIndex][speedIndex]++;
+    }
+
+    testTransfers[targetIndex][speedIndex]++;
+    testBusNs += (TEST_BITS_PER_TRANSFER * 1000000000ULL) / testClockSpeed;
+
+    testIsBusy = false;
+    testCallback(testCallbackContext);
+
+    TEST_CHECK(testEvents == (events + 1UL));
+}
+
+int main( void )
+{
+    DRV_HANDLE handle;
+    unsigned long failures = 0UL;
+    unsigned long transfers = 0UL;
+    unsigned long noisyProbesFirst = 0UL;
+    unsigned long noisyProbes = 0UL;
+    uint32_t lastNoisySpeed = DRV_I2C_CLOCK_SPEED_IDX0;
+    uint32_t speedIndex;
+    uint32_t targetIndex;
+    uint64_t slowBusNs;
+    uint32_t noisySpeed;
+
+    (void)DRV_I2C_Initialize(DRV_I2C_INDEX_0, (SYS_MODULE_INIT *)&testDrvInitData);
+
+    handle = DRV_I2C_Open(DRV_I2C_INDEX_0, DRV_IO_INTENT_READWRITE);
+    TEST_CHECK(handle != DRV_HANDLE_INVALID);
+
+    DRV_I2C_TransferEventHandlerSet(handle, TEST_TransferEvent, 0U);
+
+    for (testTransfer = 0UL; testTransfer < TEST_TRANSFERS; testTransfer++)
+    {
+        TEST_TransferRun(handle, ((testTransfer % 2UL) == 0UL) ? TEST_ADDRESS_CLEAN : TEST_ADDRESS_NOISY);
+
+        TEST_CHECK(TEST_LinkIsTracked(TEST_ADDRESS_CLEAN) == false);
+        TEST_CHECK(DRV_I2C_LinkClockSpeedGet(handle, TEST_ADDRESS_CLEAN) == DRV_I2C_CLOCK_SPEED_IDX0);
+
+        /* A probe: the noisy target moved up a level */
+        noisySpeed = DRV_I2C_LinkClockSpeedGet(handle, TEST_ADDRESS_NOISY);
+
+        if (noisySpeed > lastNoisySpeed)
+        {
+            noisyProbes++;
+
+            if (testTransfer < (TEST_TRANSFERS / 2UL))
+            {
+                noisyProbesFirst++;
+            }
+        }
+        lastNoisySpeed = noisySpeed;
+    }
+
+    for (targetIndex = 0U; targetIndex < 2U; targetIndex++)
+    {
+        printf("0x%02X:", (targetIndex == 0U) ? TEST_ADDRESS_CLEAN : TEST_ADDRESS_NOISY);
+
+        for (speedIndex = 0U; speedIndex < TEST_SPEEDS_NUMBER; speedIndex++)
+        {
+            printf("%s %lu (%lu failed) at %u kHz", (speedIndex == 0U) ? "" : ",", testTransfers[targetIndex][speedIndex], testFailures[targetIndex][speedIndex],
+                   (DRV_I2C_CLOCK_SPEED_IDX0 >> speedIndex) / 1000U);
+            failures += testFailures[targetIndex][speedIndex];
+            transfers += testTransfers[targetIndex][speedIndex];
+        }
+
+        printf("\n");
+    }
+
+    slowBusNs = (uint64_t)transfers * ((TEST_BITS_PER_TRANSFER * 1000000000ULL) / (DRV_I2C_CLOCK_SPEED_IDX0 >> 2U));
+
+    printf("%lu transfers, %lu.%03lu%% failed, %lu probes (%lu in the first half), bus time %lu ms, %lu ms with both at 100 kHz\n",
+           transfers, (failures * 100UL) / transfers, ((failures * 100000UL) / transfers) % 1000UL,
+           noisyProbes, noisyProbesFirst, (unsigned long)(testBusNs / 1000000ULL), (unsigned long)(slowBusNs / 1000000ULL));
+
+    TEST_CHECK(transfers == TEST_TRANSFERS);
+    TEST_CHECK(testTransfers[0][0] == (TEST_TRANSFERS / 2UL));
+
+    /* Settled at 100 kHz, probing less often as time goes on */
+    TEST_CHECK((testTransfers[1][2] * 10UL) >= ((TEST_TRANSFERS / 2UL) * 7UL));
+    TEST_CHECK(noisyProbes > 0UL);
+    TEST_CHECK((noisyProbes - noisyProbesFirst) < noisyProbesFirst);
+
+    /* Under 0.1% failed, and the bus time at least 1.5 times lower */
+    TEST_CHECK((failures * 1000UL) < transfers);
+    TEST_CHECK((testBusNs * 3ULL) < (slowBusNs * 2ULL));
+
+    /* Repaired: back to the client speed and no longer tracked */
+    testNoisyRate[0] = 0U;
+    testNoisyRate[1] = 0U;
+
+    for (; testTransfer < (TEST_TRANSFERS + TEST_REPAIRED_TRANSFERS); testTransfer++)
+    {
+        TEST_TransferRun(handle, TEST_ADDRESS_NOISY);
+    }
+
+    TEST_CHECK(DRV_I2C_LinkClockSpeedGet(handle, TEST_ADDRESS_NOISY) == DRV_I2C_CLOCK_SPEED_IDX0);
+    TEST_CHECK(TEST_LinkIsTracked(TEST_ADDRESS_NOISY) == false);
+
+    printf("repaired: 0x%02X back at %u kHz, no longer tracked\n", TEST_ADDRESS_NOISY, DRV_I2C_CLOCK_SPEED_IDX0 / 1000U);
+
+    printf("PASS\n");
+
+    return 0;
+}
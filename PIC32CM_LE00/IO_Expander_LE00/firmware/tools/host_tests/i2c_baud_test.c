@@ -0,0 +1,244 @@
+/*******************************************************************************
+  SERCOM5 I2C baud value host test
+
+  Builds plib_sercom5_i2c_master.c against fake registers and compares its
+  integer baud calculation, the compile-time table included, with the float
+  formula it replaced and with an exact rational reference, over every
+  fGCLK of 1 MHz to 48 MHz in 250 kHz steps and every fSCL of 10 kHz to
+  3.4 MHz (1 kHz steps up to 1 MHz, 10 kHz steps above).
+
+  The float formula is evaluated in IEEE single precision as the soft-float
+  library does it, with the saturating float to unsigned conversion of
+  __aeabi_f2uiz. It is off by one where fGCLK / fSCL - fGCLK * 100ns - 10 is
+  a whole number that single precision cannot hold exactly; 26 MHz and
+  42 MHz at 625 kHz are the only such pairs in the sweep.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "definitions.h"
+
+static sercom_registers_t fakeSercom5;
+#undef SERCOM5_REGS
+#define SERCOM5_REGS (&fakeSercom5)
+
+#include "peripheral/sercom/i2c_master/plib_sercom5_i2c_master.c"
+
+uint32_t CLOCK_Gclk0FrequencyGet( void )
+{
+    return 48000000U;
+}
+
+#if defined(SYS_PROF_ENABLE)
+uint32_t SYS_PROF_CyclesGet( void )
+{
+    return 0U;
+}
+
+void SYS_PROF_Record( uint32_t id, uint32_t cycles )
+{
+}
+#endif
+
+/* float to uint32_t conversion of the Arm run time ABI: truncates toward
+ * zero, negative values and NaN give 0, values of 2^32 and above saturate */
+static uint32_t AEABI_f2uiz( float value )
+{
+    if (!(value > 0.0f))
+    {
+        return 0U;
+    }
+
+    if (value >= 4294967296.0f)
+    {
+        return UINT32_MAX;
+    }
+
+    return (uint32_t)value;
+}
+
+/* SERCOM5_I2C_CalculateBaudValue before the integer rewrite */
+static bool FloatBaudValue( uint32_t srcClkFreq, uint32_t i2cClkSpeed, uint32_t* baudVal )
+{
+    uint32_t baudValue;
+    uint32_t hsBaudValue = 0U;
+    uint32_t hsBaudHigh;
+    volatile float fSrcClkFreq = (float)srcClkFreq;
+    volatile float fI2cClkSpeed = (float)i2cClkSpeed;
+    volatile float fBaudValue;
+
+    if (srcClkFreq < (2U * i2cClkSpeed))
+    {
+        return false;
+    }
+
+    if (i2cClkSpeed > 3400000U)
+    {
+        return false;
+    }
+
+    if (i2cClkSpeed > 1000000U)
+    {
+        hsBaudValue = (srcClkFreq + i2cClkSpeed - 1U) / i2cClkSpeed;
+
+        if (hsBaudValue < (2U + 3U))
+        {
+            return false;
+        }
+
+        hsBaudValue -= 2U;
+
+        if (hsBaudValue > (0xFFU + 0x7FU))
+        {
+            hsBaudValue = 0xFFU + 0x7FU;
+        }
+
+        hsBaudHigh = hsBaudValue / 3U;
+        hsBaudValue = SERCOM_I2CM_BAUD_HSBAUD(hsBaudHigh) | SERCOM_I2CM_BAUD_HSBAUDLOW(hsBaudValue - hsBaudHigh);
+
+        i2cClkSpeed = SERCOM5_I2CM_HS_MASTER_CODE_SPEED_HZ;
+        fI2cClkSpeed = (float)i2cClkSpeed;
+    }
+
+    /* Each operation rounded to single precision, as the soft-float calls do */
+    fBaudValue = (fSrcClkFreq / fI2cClkSpeed) - ((fSrcClkFreq * (100.0f / 1000000000.0f)) + 10.0f);
+    baudValue = AEABI_f2uiz(fBaudValue);
+
+    if (i2cClkSpeed <= 400000U)
+    {
+        baudValue = (baudValue > (0xFFU * 2U)) ? 0xFFU : ((baudValue <= 1U) ? 1U : (baudValue / 2U));
+    }
+    else if (baudValue >= 382U)
+    {
+        baudValue = (0xFFUL << 8U) | 0x7FU;
+    }
+    else if (baudValue <= 3U)
+    {
+        baudValue = (2UL << 8U) | 1U;
+    }
+    else
+    {
+        baudValue = (((baudValue * 2U) / 3U) << 8U) | (baudValue / 3U);
+    }
+
+    *baudVal = baudValue | hsBaudValue;
+
+    return true;
+}
+
+/* floor(fGCLK / fSCL - fGCLK * 100ns - 10), 0 if negative, in exact rationals */
+static uint32_t ExactRaw( uint32_t srcClkFreq, uint32_t i2cClkSpeed )
+{
+    int64_t num = ((int64_t)srcClkFreq * 10000000) - ((int64_t)srcClkFreq * i2cClkSpeed) - ((int64_t)i2cClkSpeed * 100000000);
+    int64_t den = (int64_t)i2cClkSpeed * 10000000;
+
+    return (num < 0) ? 0U : (uint32_t)(num / den);
+}
+
+static bool IsKnownException( uint32_t srcClkFreq, uint32_t i2cClkSpeed )
+{
+    return (((srcClkFreq == 26000000U) || (srcClkFreq == 42000000U)) && (i2cClkSpeed == 625000U));
+}
+
+int main( void )
+{
+    unsigned long pairs = 0UL;
+    unsigned long rejected = 0UL;
+    unsigned long exceptions = 0UL;
+    int failures = 0;
+    uint32_t srcClkFreq;
+    uint32_t i2cClkSpeed;
+    uint32_t oldValue;
+    uint32_t newValue;
+    uint32_t raw;
+    bool oldResult;
+    bool newResult;
+    size_t index;
+
+    for (srcClkFreq = 1000000U; srcClkFreq <= 48000000U; srcClkFreq += 250000U)
+    {
+        for (i2cClkSpeed = 10000U; i2cClkSpeed <= 3400000U; i2cClkSpeed += ((i2cClkSpeed < 1000000U) ? 1000U : 10000U))
+        {
+            oldValue = 0U;
+            newValue = 0U;
+            oldResult = FloatBaudValue(srcClkFreq, i2cClkSpeed, &oldValue);
+            newResult = SERCOM5_I2C_CalculateBaudValue(srcClkFreq, i2cClkSpeed, &newValue);
+            pairs++;
+
+            if (oldResult != newResult)
+            {
+                printf("%u Hz / %u Hz: accepted %d, was %d\n", srcClkFreq, i2cClkSpeed, newResult, oldResult);
+                failures++;
+                continue;
+            }
+
+            if (newResult == false)
+            {
+                rejected++;
+                continue;
+            }
+
+            /* The raw value behind BAUD must be exact for SM/FM/FM+ */
+            if ((i2cClkSpeed <= 1000000U) && (SERCOM5_I2CM_BAUD_RAW(srcClkFreq, i2cClkSpeed) != ExactRaw(srcClkFreq, i2cClkSpeed)))
+            {
+                printf("%u Hz / %u Hz: raw %u, exact %u\n", srcClkFreq, i2cClkSpeed,
+                       (unsigned int)SERCOM5_I2CM_BAUD_RAW(srcClkFreq, i2cClkSpeed), ExactRaw(srcClkFreq, i2cClkSpeed));
+                failures++;
+            }
+
+            if (oldValue == newValue)
+            {
+                continue;
+            }
+
+            raw = ExactRaw(srcClkFreq, i2cClkSpeed);
+
+            if ((IsKnownException(srcClkFreq, i2cClkSpeed) == true) &&
+                (AEABI_f2uiz((float)srcClkFreq / (float)i2cClkSpeed - ((float)srcClkFreq * (100.0f / 1000000000.0f) + 10.0f)) == (raw - 1U)))
+            {
+                printf("%u Hz / %u Hz: 0x%08X, float formula 0x%08X (raw %u, float %u)\n",
+                       srcClkFreq, i2cClkSpeed, newValue, oldValue, raw, raw - 1U);
+                exceptions++;
+                continue;
+            }
+
+            printf("%u Hz / %u Hz: 0x%08X, float formula 0x%08X\n", srcClkFreq, i2cClkSpeed, newValue, oldValue);
+            failures++;
+        }
+    }
+
+    if (exceptions != 2UL)
+    {
+        printf("expected the two known float roundings, found %lu\n", exceptions);
+        failures++;
+    }
+
+    /* The table is only looked up, so it must hold what the macros give at run time */
+    for (index = 0U; index < (sizeof(sercom5I2CBaudTable) / sizeof(sercom5I2CBaudTable[0])); index++)
+    {
+        srcClkFreq = sercom5I2CBaudTable[index].srcClkFreq;
+        i2cClkSpeed = sercom5I2CBaudTable[index].i2cClkSpeed;
+        oldResult = FloatBaudValue(srcClkFreq, i2cClkSpeed, &oldValue);
+
+        if ((oldResult == false) || (oldValue != sercom5I2CBaudTable[index].baudValue) ||
+            (SERCOM5_I2CM_BAUD(srcClkFreq, i2cClkSpeed) != sercom5I2CBaudTable[index].baudValue))
+        {
+            printf("table %u Hz / %u Hz: 0x%08X, float formula 0x%08X\n", srcClkFreq, i2cClkSpeed,
+                   sercom5I2CBaudTable[index].baudValue, oldValue);
+            failures++;
+        }
+    }
+
+    /* Reset value of Initialize */
+    if (SERCOM5_I2CM_BAUD(48000000U, SERCOM5_I2CM_SPEED_HZ) != SERCOM5_I2CM_BAUD_VALUE)
+    {
+        printf("SERCOM5_I2CM_BAUD_VALUE 0x%02X, 0x%02X at 48 MHz\n", SERCOM5_I2CM_BAUD_VALUE,
+               (unsigned int)SERCOM5_I2CM_BAUD(48000000U, SERCOM5_I2CM_SPEED_HZ));
+        failures++;
+    }
+
+    printf("%lu pairs, %lu rejected, %lu known float roundings: %s\n", pairs, rejected, exceptions,
+           (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
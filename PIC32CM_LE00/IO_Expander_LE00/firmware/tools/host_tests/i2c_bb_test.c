@@ -0,0 +1,738 @@
+/*******************************************************************************
+  Bit-banged I2C lanes host test
+
+  Runs plib_i2c_bb.c on a model of the PORT pins and of TC0: SCL and each
+  SDA line are wired-AND, low while the master drives the pin as an output
+  or the target on that lane pulls it.  Each lane has a target at 0x20
+  with 32 registers, written and read through a register pointer as on the
+  MCP23017; it follows the lines edge by edge, START and STOP included, and
+  stretches SCL by 1 to 25 ticks after one byte in 8.
+
+  2000000 timer ticks on both lanes at once, each lane starting a write,
+  write/read or read of up to 4 bytes, to 0x27 one time in 8, at a random
+  tick, often while the other lane is in the middle of a byte, or from the
+  completion callback.  Then SCL is held low until the lanes give up.
+
+  Checked: every transfer completes once, with the registers the target
+  holds and the bytes it sent, and fails with a NAK exactly when nobody
+  answers; the target sees one START, one repeated START before a read
+  after a write, and one STOP per transfer; the timer runs only while a
+  lane is busy; the TC0 period follows the clock speed, and is not changed
+  under a busy lane; held SCL fails every busy lane with a bus error once
+  I2C_BB_STRETCH_TICKS_MAX have passed, and stops the timer.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "peripheral/i2c_bb/plib_i2c_bb.c"
+
+#define TEST_TICKS              2000000UL
+#define TEST_LENGTH_MAX         4U
+#define TEST_REGISTERS_NUMBER   32U
+#define TEST_ADDRESS_PRESENT    0x20U
+#define TEST_ADDRESS_ABSENT     0x27U
+#define TEST_STRETCH_TICKS_MAX  25U
+#define TEST_TC0_FREQUENCY      48000000U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("tick %lu: %s:%d: %s\n", testTick, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+typedef enum
+{
+    TEST_TARGET_IDLE = 0,
+
+    /* Receiving the address byte, or acknowledging it */
+    TEST_TARGET_ADDRESS,
+
+    TEST_TARGET_RECEIVE,
+
+    TEST_TARGET_TRANSMIT,
+
+    /* Not addressed, or NAKed by the master: waits for a START or STOP */
+    TEST_TARGET_IGNORE,
+
+} TEST_TARGET_PHASE;
+
+typedef enum
+{
+    TEST_OP_WRITE = 0,
+
+    TEST_OP_WRITE_READ,
+
+    TEST_OP_READ,
+
+} TEST_OP;
+
+typedef struct
+{
+    TEST_TARGET_PHASE   phase;
+
+    /* SCL rising edges in the byte, 9 once the ACK slot was clocked */
+    uint32_t            bits;
+
+    uint8_t             shift;
+
+    bool                isRead;
+
+    /* The next byte written sets the register pointer */
+    bool                isPointerNext;
+
+    bool                isMasterAck;
+
+    bool                pullSda;
+
+    uint32_t            stretchLeft;
+
+    uint8_t             pointer;
+
+    uint8_t             reg[TEST_REGISTERS_NUMBER];
+
+    unsigned long       starts;
+
+    unsigned long       stops;
+
+} TEST_TARGET;
+
+typedef struct
+{
+    TEST_OP             op;
+
+    uint16_t            address;
+
+    uint8_t             writeData[1U + TEST_LENGTH_MAX];
+
+    uint32_t            writeSize;
+
+    uint8_t             readData[TEST_LENGTH_MAX];
+
+    uint32_t            readSize;
+
+    bool                isBusy;
+
+    /* START and STOP conditions the target must have seen once the STOP of
+     * the last transfer is on the lines */
+    unsigned long       starts;
+
+    unsigned long       stops;
+
+    bool                isCheckPending;
+
+    /* What the target holds, as the test expects it */
+    uint8_t             reg[TEST_REGISTERS_NUMBER];
+
+    uint8_t             pointer;
+
+} TEST_LANE;
+
+static unsigned long testTick;
+
+/* Transfers are only started during the random run */
+static bool testIsRandomRun;
+static TEST_TARGET testTarget[I2C_BB_LANES_NUMBER];
+static TEST_LANE testLane[I2C_BB_LANES_NUMBER];
+
+/* PORT pins driven low, the latch, and the lines after the last tick */
+static uint32_t testDir;
+static uint32_t testLatch;
+static uint32_t testLines;
+static bool testSclHeld;
+
+static TC_TIMER_CALLBACK testTimerCallback;
+static uintptr_t testTimerContext;
+static bool testTimerRunning;
+static uint16_t testTimerPeriod;
+
+static unsigned long testCompleted;
+static unsigned long testNaks;
+static unsigned long testRestarts;
+static unsigned long testStretches;
+static unsigned long testMidByteStarts;
+static unsigned long testCallbackStarts;
+static unsigned long testBusyTicks;
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+void PORT_GroupWrite( PORT_GROUP group, uint32_t mask, uint32_t value )
+{
+    TEST_CHECK(group == I2C_BB_PORT_GROUP);
+
+    testLatch = (testLatch & ~mask) | (value & mask);
+}
+
+void PORT_GroupOutputEnable( PORT_GROUP group, uint32_t mask )
+{
+    TEST_CHECK(group == I2C_BB_PORT_GROUP);
+
+    testDir |= mask;
+}
+
+void PORT_GroupInputEnable( PORT_GROUP group, uint32_t mask )
+{
+    TEST_CHECK(group == I2C_BB_PORT_GROUP);
+
+    testDir &= ~mask;
+}
+
+uint32_t PORT_GroupRead( PORT_GROUP group )
+{
+    TEST_CHECK(group == I2C_BB_PORT_GROUP);
+
+    return testLines;
+}
+
+void TC0_TimerStart( void )
+{
+    testTimerRunning = true;
+}
+
+void TC0_TimerStop( void )
+{
+    testTimerRunning = false;
+}
+
+uint32_t TC0_TimerFrequencyGet( void )
+{
+    return TEST_TC0_FREQUENCY;
+}
+
+void TC0_Timer16bitPeriodSet( uint16_t period )
+{
+    testTimerPeriod = period;
+}
+
+void TC0_TimerCallbackRegister( TC_TIMER_CALLBACK callback, uintptr_t context )
+{
+    testTimerCallback = callback;
+    testTimerContext = context;
+}
+
+/* The line levels: a line is high unless something pulls it */
+static uint32_t TEST_LinesGet( void )
+{
+    uint32_t lines = I2C_BB_SCL_MASK;
+    uint32_t laneIndex;
+
+    /* The latch stays low, a driven pin pulls its line */
+    TEST_CHECK((testLatch & (I2C_BB_SCL_MASK | I2C_BB_SDA0_MASK | I2C_BB_SDA1_MASK)) == 0U);
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        lines |= i2cBBSdaMask[laneIndex];
+
+        if (testTarget[laneIndex].pullSda == true)
+        {
+            lines &= ~i2cBBSdaMask[laneIndex];
+        }
+
+        if (testTarget[laneIndex].stretchLeft > 0U)
+        {
+            lines &= ~I2C_BB_SCL_MASK;
+        }
+    }
+
+    if (testSclHeld == true)
+    {
+        lines &= ~I2C_BB_SCL_MASK;
+    }
+
+    return lines & ~testDir;
+}
+
+static void TEST_TargetByteLoad( TEST_TARGET* target )
+{
+    target->shift = target->reg[target->pointer];
+    target->pointer = (uint8_t)((target->pointer + 1U) % TEST_REGISTERS_NUMBER);
+    target->pullSda = ((target->shift & 0x80U) == 0U);
+    target->bits = 0U;
+}
+
+static void TEST_TargetSclRise( TEST_TARGET* target, bool isSdaHigh )
+{
+    switch (target->phase)
+    {
+        case TEST_TARGET_ADDRESS:
+        case TEST_TARGET_RECEIVE:
+            if (target->bits < 8U)
+            {
+                target->shift = (uint8_t)((uint32_t)target->shift << 1U) | (isSdaHigh ? 1U : 0U);
+            }
+            target->bits++;
+            break;
+
+        case TEST_TARGET_TRANSMIT:
+            if (target->bits == 8U)
+            {
+                target->isMasterAck = (isSdaHigh == false);
+            }
+            target->bits++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void TEST_TargetSclFall( TEST_TARGET* target )
+{
+    switch (target->phase)
+    {
+        case TEST_TARGET_ADDRESS:
+            if (target->bits == 8U)
+            {
+                if ((target->shift >> 1U) == TEST_ADDRESS_PRESENT)
+                {
+                    target->isRead = ((target->shift & 0x01U) != 0U);
+                    target->pullSda = true;
+                }
+                else
+                {
+                    target->phase = TEST_TARGET_IGNORE;
+                }
+            }
+            else if (target->bits == 9U)
+            {
+                if (target->isRead == true)
+                {
+                    target->phase = TEST_TARGET_TRANSMIT;
+                    TEST_TargetByteLoad(target);
+                }
+                else
+                {
+                    target->phase = TEST_TARGET_RECEIVE;
+                    target->isPointerNext = true;
+                    target->pullSda = false;
+                    target->bits = 0U;
+                }
+            }
+            else
+            {
+                /* Address bits */
+            }
+            break;
+
+        case TEST_TARGET_RECEIVE:
+            if (target->bits == 8U)
+            {
+                if (target->isPointerNext == true)
+                {
+                    target->pointer = (uint8_t)(target->shift % TEST_REGISTERS_NUMBER);
+                    target->isPointerNext = false;
+                }
+                else
+                {
+                    target->reg[target->pointer] = target->shift;
+                    target->pointer = (uint8_t)((target->pointer + 1U) % TEST_REGISTERS_NUMBER);
+                }
+                target->pullSda = true;
+            }
+            else if (target->bits == 9U)
+            {
+                target->pullSda = false;
+                target->bits = 0U;
+            }
+            else
+            {
+                /* Data bits */
+            }
+            break;
+
+        case TEST_TARGET_TRANSMIT:
+            if (target->bits < 8U)
+            {
+                target->pullSda = ((target->shift & (0x80U >> target->bits)) == 0U);
+            }
+            else if (target->bits == 8U)
+            {
+                /* The ACK slot belongs to the master */
+                target->pullSda = false;
+            }
+            else if (target->isMasterAck == true)
+            {
+                TEST_TargetByteLoad(target);
+            }
+            else
+            {
+                target->phase = TEST_TARGET_IGNORE;
+                target->pullSda = false;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    /* Hold SCL after one byte in 8 */
+    if ((target->bits == 0U) && (target->phase != TEST_TARGET_IGNORE) && ((TEST_Random() % 8U) == 0U))
+    {
+        target->stretchLeft = 1U + (TEST_Random() % TEST_STRETCH_TICKS_MAX);
+        testStretches++;
+    }
+}
+
+/* Moves the targets on by the edges of the last tick */
+static void TEST_LinesUpdate( void )
+{
+    uint32_t lines = TEST_LinesGet();
+    uint32_t laneIndex;
+    bool wasSclHigh = ((testLines & I2C_BB_SCL_MASK) != 0U);
+    bool isSclHigh = ((lines & I2C_BB_SCL_MASK) != 0U);
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        TEST_TARGET* target = &testTarget[laneIndex];
+        bool wasSdaHigh = ((testLines & i2cBBSdaMask[laneIndex]) != 0U);
+        bool isSdaHigh = ((lines & i2cBBSdaMask[laneIndex]) != 0U);
+
+        if ((wasSclHigh == true) && (isSclHigh == true) && (wasSdaHigh != isSdaHigh))
+        {
+            /* SDA only changes under a high SCL for a START or a STOP */
+            if (isSdaHigh == false)
+            {
+                target->phase = TEST_TARGET_ADDRESS;
+                target->bits = 0U;
+                target->starts++;
+            }
+            else
+            {
+                target->phase = TEST_TARGET_IDLE;
+                target->stops++;
+            }
+            target->pullSda = false;
+        }
+        else if ((wasSclHigh == false) && (isSclHigh == true))
+        {
+            TEST_TargetSclRise(target, isSdaHigh);
+        }
+        else if ((wasSclHigh == true) && (isSclHigh == false))
+        {
+            TEST_TargetSclFall(target);
+        }
+        else
+        {
+            /* No edge for this target */
+        }
+    }
+
+    /* Target changes happen under a low SCL, they are not edges */
+    testLines = TEST_LinesGet();
+}
+
+static void TEST_Tick( void )
+{
+    uint32_t laneIndex;
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        if (testTarget[laneIndex].stretchLeft > 0U)
+        {
+            testTarget[laneIndex].stretchLeft--;
+        }
+    }
+
+    TEST_CHECK(I2C_BB_IsActive() == testTimerRunning);
+
+    if (testTimerRunning == true)
+    {
+        testTimerCallback(TC_TIMER_STATUS_NONE, testTimerContext);
+        testBusyTicks++;
+    }
+
+    TEST_LinesUpdate();
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        if (testLane[laneIndex].isCheckPending == true)
+        {
+            TEST_CHECK(testTarget[laneIndex].phase == TEST_TARGET_IDLE);
+            TEST_CHECK(testTarget[laneIndex].starts == testLane[laneIndex].starts);
+            TEST_CHECK(testTarget[laneIndex].stops == testLane[laneIndex].stops);
+            testLane[laneIndex].isCheckPending = false;
+        }
+    }
+
+    if (testTimerRunning == false)
+    {
+        /* Idle, every line released */
+        TEST_CHECK(testDir == 0U);
+
+        for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+        {
+            TEST_CHECK(testLane[laneIndex].isBusy == false);
+        }
+    }
+}
+
+static void TEST_TransferStart( uint32_t laneIndex )
+{
+    TEST_LANE* lane = &testLane[laneIndex];
+    uint32_t otherIndex = (laneIndex + 1U) % I2C_BB_LANES_NUMBER;
+    uint32_t index;
+    bool isStarted;
+
+    lane->op = (TEST_OP)(TEST_Random() % 3U);
+    lane->address = ((TEST_Random() % 8U) == 0U) ? TEST_ADDRESS_ABSENT : TEST_ADDRESS_PRESENT;
+    lane->writeSize = 0U;
+    lane->readSize = 0U;
+    memset(lane->readData, 0, sizeof(lane->readData));
+
+    if (lane->op != TEST_OP_READ)
+    {
+        lane->writeData[0] = (uint8_t)(TEST_Random() % TEST_REGISTERS_NUMBER);
+        lane->writeSize = 1U;
+    }
+
+    if (lane->op == TEST_OP_WRITE)
+    {
+        lane->writeSize += TEST_Random() % (TEST_LENGTH_MAX + 1U);
+
+        for (index = 1U; index < lane->writeSize; index++)
+        {
+            lane->writeData[index] = (uint8_t)TEST_Random();
+        }
+    }
+    else
+    {
+        lane->readSize = 1U + (TEST_Random() % TEST_LENGTH_MAX);
+    }
+
+    lane->isBusy = true;
+
+    if ((testTarget[otherIndex].phase != TEST_TARGET_IDLE) && (testTarget[otherIndex].bits != 0U))
+    {
+        testMidByteStarts++;
+    }
+
+    switch (lane->op)
+    {
+        case TEST_OP_WRITE:
+            isStarted = I2C_BB_Write(laneIndex, lane->address, lane->writeData, lane->writeSize);
+            break;
+
+        case TEST_OP_WRITE_READ:
+            isStarted = I2C_BB_WriteRead(laneIndex, lane->address, lane->writeData, lane->writeSize, lane->readData, lane->readSize);
+            break;
+
+        default:
+            isStarted = I2C_BB_Read(laneIndex, lane->address, lane->readData, lane->readSize);
+            break;
+    }
+
+    TEST_CHECK(isStarted == true);
+    TEST_CHECK(I2C_BB_IsBusy(laneIndex) == true);
+
+    /* A lane takes one transfer at a time */
+    TEST_CHECK(I2C_BB_Read(laneIndex, lane->address, lane->readData, 1U) == false);
+}
+
+static void TEST_TransferDone( uintptr_t context )
+{
+    uint32_t laneIndex = (uint32_t)context;
+    TEST_LANE* lane = &testLane[laneIndex];
+    TEST_TARGET* target = &testTarget[laneIndex];
+    I2C_BB_ERROR error = I2C_BB_ErrorGet(laneIndex);
+    unsigned long starts = 1UL;
+    uint32_t index;
+
+    TEST_CHECK(laneIndex < I2C_BB_LANES_NUMBER);
+    TEST_CHECK(lane->isBusy == true);
+    TEST_CHECK(I2C_BB_IsBusy(laneIndex) == false);
+
+    lane->isBusy = false;
+    testCompleted++;
+
+    if (lane->address == TEST_ADDRESS_ABSENT)
+    {
+        TEST_CHECK(error == I2C_BB_ERROR_NAK);
+        testNaks++;
+    }
+    else
+    {
+        TEST_CHECK(error == I2C_BB_ERROR_NONE);
+
+        if (lane->op != TEST_OP_READ)
+        {
+            lane->pointer = lane->writeData[0];
+        }
+
+        for (index = 1U; index < lane->writeSize; index++)
+        {
+            lane->reg[lane->pointer] = lane->writeData[index];
+            lane->pointer = (uint8_t)((lane->pointer + 1U) % TEST_REGISTERS_NUMBER);
+        }
+
+        for (index = 0U; index < lane->readSize; index++)
+        {
+            TEST_CHECK(lane->readData[index] == lane->reg[lane->pointer]);
+            lane->pointer = (uint8_t)((lane->pointer + 1U) % TEST_REGISTERS_NUMBER);
+        }
+
+        if (lane->op == TEST_OP_WRITE_READ)
+        {
+            starts++;
+            testRestarts++;
+        }
+
+        TEST_CHECK(target->pointer == lane->pointer);
+    }
+
+    TEST_CHECK(memcmp(target->reg, lane->reg, sizeof(lane->reg)) == 0);
+
+    /* The STOP is on the lines when the tick returns */
+    lane->isCheckPending = true;
+    lane->starts += starts;
+    lane->stops++;
+
+    /* Queue the next one from the interrupt now and then, as the driver does */
+    if ((testIsRandomRun == true) && ((TEST_Random() % 4U) == 0U))
+    {
+        TEST_TransferStart(laneIndex);
+        testCallbackStarts++;
+    }
+}
+
+/* The TC0 period at the default speed and after a change, and no change
+ * under a busy lane */
+static void TEST_SetupCheck( void )
+{
+    I2C_BB_TRANSFER_SETUP setup;
+
+    TEST_CHECK(testTimerPeriod == ((TEST_TC0_FREQUENCY / (4U * I2C_BB_CLOCK_SPEED_DEFAULT)) - 1U));
+    TEST_CHECK(I2C_BB_ClockIsSupported(TEST_TC0_FREQUENCY) == true);
+    TEST_CHECK(I2C_BB_ClockIsSupported(16000000U) == false);
+
+    setup.clkSpeed = I2C_BB_CLOCK_SPEED_MAX + 1U;
+    TEST_CHECK(I2C_BB_TransferSetup(0U, &setup, 0U) == false);
+
+    setup.clkSpeed = 25000U;
+    testLane[1].writeData[0] = 0U;
+    TEST_CHECK(I2C_BB_Write(1U, TEST_ADDRESS_PRESENT, testLane[1].writeData, 1U) == true);
+    testLane[1].op = TEST_OP_WRITE;
+    testLane[1].address = TEST_ADDRESS_PRESENT;
+    testLane[1].writeSize = 1U;
+    testLane[1].readSize = 0U;
+    testLane[1].isBusy = true;
+    TEST_CHECK(I2C_BB_TransferSetup(0U, &setup, 0U) == false);
+
+    while (testTimerRunning == true)
+    {
+        TEST_CHECK(testTick < 1000UL);
+        TEST_Tick();
+        testTick++;
+    }
+
+    TEST_CHECK(I2C_BB_TransferSetup(0U, &setup, 0U) == true);
+    TEST_CHECK(testTimerPeriod == ((TEST_TC0_FREQUENCY / (4U * 25000U)) - 1U));
+
+    /* The power service moving generator 0 to 16 MHz and back */
+    TEST_CHECK(I2C_BB_ClockIsSupported(16000000U) == true);
+    setup.clkSpeed = I2C_BB_CLOCK_SPEED_DEFAULT;
+    TEST_CHECK(I2C_BB_TransferSetup(1U, &setup, 0U) == true);
+    I2C_BB_ClockChange();
+    TEST_CHECK(testTimerPeriod == ((TEST_TC0_FREQUENCY / (4U * I2C_BB_CLOCK_SPEED_DEFAULT)) - 1U));
+}
+
+/* SCL held low: every busy lane fails with a bus error */
+static void TEST_SclHeldCheck( void )
+{
+    unsigned long heldTicks = 0UL;
+    uint32_t laneIndex;
+
+    testSclHeld = true;
+
+    /* No callbacks, the lanes are checked once the timer stops */
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_CallbackRegister(laneIndex, NULL, 0U);
+        testLane[laneIndex].writeData[0] = 0U;
+        TEST_CHECK(I2C_BB_Write(laneIndex, TEST_ADDRESS_PRESENT, testLane[laneIndex].writeData, 1U) == true);
+    }
+
+    while (testTimerRunning == true)
+    {
+        TEST_CHECK(heldTicks <= (I2C_BB_STRETCH_TICKS_MAX + 4UL));
+        TEST_Tick();
+        testTick++;
+        heldTicks++;
+    }
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        TEST_CHECK(I2C_BB_ErrorGet(laneIndex) == I2C_BB_ERROR_BUS);
+        TEST_CHECK(I2C_BB_IsBusy(laneIndex) == false);
+    }
+
+    TEST_CHECK(heldTicks > I2C_BB_STRETCH_TICKS_MAX);
+    TEST_CHECK(testDir == 0U);
+    TEST_CHECK(I2C_BB_IsActive() == false);
+
+    printf("SCL held: both lanes failed after %lu ticks\n", heldTicks);
+}
+
+int main( void )
+{
+    uint32_t laneIndex;
+    unsigned long drainTicks = 0UL;
+
+    testLines = TEST_LinesGet();
+
+    I2C_BB_Initialize();
+
+    for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+    {
+        I2C_BB_CallbackRegister(laneIndex, TEST_TransferDone, (uintptr_t)laneIndex);
+    }
+
+    TEST_SetupCheck();
+
+    testIsRandomRun = true;
+
+    for (; testTick < TEST_TICKS; testTick++)
+    {
+        for (laneIndex = 0U; laneIndex < I2C_BB_LANES_NUMBER; laneIndex++)
+        {
+            if ((testLane[laneIndex].isBusy == false) && ((TEST_Random() % 64U) == 0U))
+            {
+                TEST_TransferStart(laneIndex);
+            }
+        }
+
+        TEST_Tick();
+    }
+
+    testIsRandomRun = false;
+
+    while (testTimerRunning == true)
+    {
+        TEST_CHECK(drainTicks < 1000UL);
+        TEST_Tick();
+        testTick++;
+        drainTicks++;
+    }
+
+    printf("%lu ticks, %lu%% busy, %lu transfers completed, %lu NAKs, %lu repeated STARTs, %lu stretches, "
+           "%lu STARTs while the other lane was in a byte, %lu from the callback\n",
+           TEST_TICKS, (testBusyTicks * 100UL) / TEST_TICKS, testCompleted, testNaks, testRestarts, testStretches,
+           testMidByteStarts, testCallbackStarts);
+
+    TEST_SclHeldCheck();
+
+    if ((testNaks == 0UL) || (testRestarts == 0UL) || (testStretches == 0UL) ||
+        (testMidByteStarts == 0UL) || (testCallbackStarts == 0UL))
+    {
+        printf("FAIL, a case was not reached\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,649 @@
+/*******************************************************************************
+  SERCOM5 I2C staged transfer host test
+
+  Runs the I2C driver on plib_sercom5_i2c_master.c, built against a model
+  of the SERCOM5 registers and of the bus it drives.  Every register access
+  moves the model on: a write to ADDR gives a START, or a repeated START
+  while the master owns the bus, a STOP command takes 0 to 12 accesses to
+  go out and BUSSTATE reads owner until it has.  The harness raises the
+  interrupt for each address and byte; the targets at three addresses
+  answer one address phase in 16 with a NAK or a bus error, the one at a
+  fourth address never answers.
+
+  2000000 steps, each either queuing a write, read or write/read of up to
+  6 bytes with the driver, to the address of the one before half of the
+  time, or moving the bus on by one interrupt.
+
+  Checked: every transfer completes once, in order, with the bytes the
+  targets sent and took, and fails exactly when its address phase did;
+  the master ACKs every read byte but the last one, and a STOP or repeated
+  START only follows the NAK of the last one; after a transfer completes,
+  the interrupt returns, and a staged transfer starts, only once its STOP
+  is out; a transfer staged behind a failed one is put back in the queue
+  and run later.  A START written while the STOP after a failure goes out
+  is held by the hardware until the bus is idle; those are counted.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+static sercom_registers_t testSercom5;
+static sercom_registers_t* TEST_Sercom5Access( void );
+
+#undef SERCOM5_REGS
+#define SERCOM5_REGS (TEST_Sercom5Access())
+
+#include "peripheral/sercom/i2c_master/plib_sercom5_i2c_master.c"
+
+#define TEST_STEPS              2000000UL
+#define TEST_QUEUED_MAX         6U
+#define TEST_LENGTH_MAX         6U
+#define TEST_STOP_ACCESSES_MAX  12U
+#define TEST_ADDRESS_ABSENT     0x27U
+
+/* ADDR and DATA hold this until the PLIB writes them */
+#define TEST_NONE               0xFFFFFFFFUL
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("step %lu: %s:%d: %s\n", testStep, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+typedef enum
+{
+    TEST_BUS_IDLE = 0,
+
+    /* START and address sent, waiting for the target */
+    TEST_BUS_ADDRESS,
+
+    TEST_BUS_WRITE,
+
+    TEST_BUS_READ,
+
+    /* Address phase answered with a NAK or a bus error, the master owns
+     * the bus until its STOP */
+    TEST_BUS_FAILED,
+
+    TEST_BUS_STOP,
+
+} TEST_BUS_PHASE;
+
+typedef struct
+{
+    TEST_BUS_PHASE  phase;
+
+    uint32_t        addrByte;
+
+    /* A repeated START reading back the address just written is never
+     * failed, so a failed transfer never changed a target */
+    bool            mayFail;
+
+    bool            stopAfterFailure;
+
+    uint32_t        stopAccesses;
+
+    /* START written while the STOP after a failure went out */
+    bool            startHeld;
+
+    uint32_t        heldAddr;
+
+    /* Since the interrupt was raised: ACKACT seen set, DATA writes,
+     * commands and START conditions */
+    bool            ackActSeen;
+
+    uint32_t        events;
+
+    bool            inInterrupt;
+
+} TEST_BUS;
+
+typedef struct
+{
+    DRV_I2C_TRANSFER_HANDLE handle;
+
+    uint16_t        address;
+
+    uint8_t         writeData[TEST_LENGTH_MAX];
+
+    size_t          writeSize;
+
+    uint8_t         readData[TEST_LENGTH_MAX];
+
+    size_t          readSize;
+
+    bool            failExpected;
+
+} TEST_TRANSFER;
+
+static const uint16_t testAddresses[] = { 0x20U, 0x21U, 0x22U, TEST_ADDRESS_ABSENT };
+
+static TEST_BUS testBus;
+static unsigned long testStep;
+
+/* Bytes taken and sent by the targets, and what the completed transfers
+ * say they should be */
+static uint32_t testTargetWriteHash[128];
+static uint32_t testTargetReadIndex[128];
+static uint32_t testWriteHash[128];
+static uint32_t testReadIndex[128];
+
+/* Queued with the driver, the oldest first */
+static TEST_TRANSFER testQueued[TEST_QUEUED_MAX];
+static uint32_t testQueuedHead;
+static uint32_t testQueuedNumber;
+static uint16_t testLastAddress = 0x20U;
+
+static unsigned long testCompleted;
+static unsigned long testFailed;
+static unsigned long testRestarts;
+static unsigned long testRestartsAfterRead;
+static unsigned long testIdleStarts;
+static unsigned long testStopPolls;
+static unsigned long testReverts;
+static unsigned long testHeldStarts;
+
+static DRV_I2C_CLIENT_OBJ testDrvClientObjPool[DRV_I2C_CLIENTS_NUMBER_IDX0];
+static DRV_I2C_TRANSFER_OBJ testDrvTransferObj[DRV_I2C_QUEUE_SIZE_IDX0];
+
+static const DRV_I2C_PLIB_INTERFACE testDrvPLibAPI =
+{
+    .read = (DRV_I2C_PLIB_READ)SERCOM5_I2C_Read,
+    .write = (DRV_I2C_PLIB_WRITE)SERCOM5_I2C_Write,
+    .writeRead = (DRV_I2C_PLIB_WRITE_READ)SERCOM5_I2C_WriteRead,
+    .transferAbort = (DRV_I2C_PLIB_TRANSFER_ABORT)SERCOM5_I2C_TransferAbort,
+    .errorGet = (DRV_I2C_PLIB_ERROR_GET)SERCOM5_I2C_ErrorGet,
+    .transferSetup = (DRV_I2C_PLIB_TRANSFER_SETUP)SERCOM5_I2C_TransferSetup,
+    .callbackRegister = (DRV_I2C_PLIB_CALLBACK_REGISTER)SERCOM5_I2C_CallbackRegister,
+    .nextTransferSet = (DRV_I2C_PLIB_NEXT_TRANSFER_SET)SERCOM5_I2C_NextTransferSet,
+};
+
+static const DRV_I2C_INTERRUPT_SOURCES testDrvInterruptSources =
+{
+    .isSingleIntSrc = false,
+    .intSources.multi.i2cInt0 = SERCOM5_0_IRQn,
+    .intSources.multi.i2cInt1 = SERCOM5_1_IRQn,
+    .intSources.multi.i2cInt2 = SERCOM5_2_IRQn,
+    .intSources.multi.i2cInt3 = SERCOM5_OTHER_IRQn,
+};
+
+static const DRV_I2C_INIT testDrvInitData =
+{
+    .i2cPlib = &testDrvPLibAPI,
+    .numClients = DRV_I2C_CLIENTS_NUMBER_IDX0,
+    .clientObjPool = (uintptr_t)&testDrvClientObjPool[0],
+    .transferObjPoolSize = DRV_I2C_QUEUE_SIZE_IDX0,
+    .transferObjPool = (uintptr_t)&testDrvTransferObj[0],
+    .interruptSources = &testDrvInterruptSources,
+    .clockSpeed = DRV_I2C_CLOCK_SPEED_IDX0,
+};
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+uint32_t CLOCK_Gclk0FrequencyGet( void )
+{
+    return 48000000U;
+}
+
+#if defined(SYS_PROF_ENABLE)
+uint32_t SYS_PROF_CyclesGet( void )
+{
+    return 0U;
+}
+
+void SYS_PROF_Record( uint32_t id, uint32_t cycles )
+{
+}
+#endif
+
+/* The harness only raises the interrupt between driver calls */
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+bool SYS_INT_SourceDisable( INT_SOURCE source )
+{
+    return true;
+}
+
+void SYS_INT_SourceRestore( INT_SOURCE source, bool state )
+{
+}
+
+static uint8_t TEST_TargetByte( uint16_t address, uint32_t index )
+{
+    return (uint8_t)((address * 29U) + (index * 73U) + (index >> 8));
+}
+
+static uint32_t TEST_Hash( uint32_t hash, uint8_t value )
+{
+    return (hash * 31U) + value + 1U;
+}
+
+static void TEST_BusStart( uint32_t addr )
+{
+    bool isRead = ((addr & 0x01U) != 0U);
+
+    TEST_CHECK((addr & SERCOM_I2CM_ADDR_HS_Msk) == 0U);
+
+    testBus.events++;
+
+    if (testBus.phase == TEST_BUS_STOP)
+    {
+        /* The START after a completed transfer must wait for its STOP */
+        TEST_CHECK(testBus.stopAfterFailure == true);
+        TEST_CHECK(testBus.startHeld == false);
+
+        testBus.startHeld = true;
+        testBus.heldAddr = addr;
+        testHeldStarts++;
+        return;
+    }
+
+    if (testBus.phase == TEST_BUS_IDLE)
+    {
+        testBus.mayFail = true;
+
+        if (testBus.inInterrupt == true)
+        {
+            testIdleStarts++;
+        }
+    }
+    else
+    {
+        /* Repeated START, only from the middle of a transfer */
+        TEST_CHECK((testBus.phase == TEST_BUS_WRITE) || (testBus.phase == TEST_BUS_READ));
+
+        testBus.mayFail = !(isRead && ((addr >> 1U) == (testBus.addrByte >> 1U)) && (testBus.phase == TEST_BUS_WRITE));
+        testRestarts++;
+
+        if (testBus.phase == TEST_BUS_READ)
+        {
+            testRestartsAfterRead++;
+        }
+    }
+
+    testBus.addrByte = addr & 0xFFU;
+    testBus.phase = TEST_BUS_ADDRESS;
+}
+
+static void TEST_BusStop( void )
+{
+    TEST_CHECK((testBus.phase == TEST_BUS_WRITE) || (testBus.phase == TEST_BUS_READ) || (testBus.phase == TEST_BUS_FAILED));
+
+    testBus.events++;
+    testBus.stopAfterFailure = (testBus.phase == TEST_BUS_FAILED);
+    testBus.stopAccesses = TEST_Random() % (TEST_STOP_ACCESSES_MAX + 1U);
+    testBus.phase = TEST_BUS_STOP;
+}
+
+/* Called ahead of every register access of the PLIB, so it sees what the
+ * one before wrote */
+static sercom_registers_t* TEST_Sercom5Access( void )
+{
+    sercom_i2cm_registers_t* regs = &testSercom5.I2CM;
+    uint32_t command;
+
+    if ((regs->SERCOM_CTRLA & SERCOM_I2CM_CTRLA_ENABLE_Msk) == 0U)
+    {
+        /* Disabled for a new baud value, only between transfers; the
+         * lines are released at once */
+        TEST_CHECK((testBus.phase == TEST_BUS_IDLE) || (testBus.phase == TEST_BUS_STOP));
+
+        if (testBus.phase == TEST_BUS_STOP)
+        {
+            testBus.stopAccesses = 0U;
+        }
+    }
+
+    if ((regs->SERCOM_CTRLB & SERCOM_I2CM_CTRLB_ACKACT_Msk) != 0U)
+    {
+        testBus.ackActSeen = true;
+    }
+
+    if ((testBus.phase == TEST_BUS_WRITE) && (regs->SERCOM_DATA != TEST_NONE))
+    {
+        testTargetWriteHash[testBus.addrByte >> 1U] = TEST_Hash(testTargetWriteHash[testBus.addrByte >> 1U], (uint8_t)regs->SERCOM_DATA);
+        regs->SERCOM_DATA = TEST_NONE;
+        testBus.events++;
+    }
+
+    command = (regs->SERCOM_CTRLB & SERCOM_I2CM_CTRLB_CMD_Msk) >> SERCOM_I2CM_CTRLB_CMD_Pos;
+
+    if (command != 0U)
+    {
+        /* Only the STOP command is used, smart mode does the rest */
+        TEST_CHECK(command == 3U);
+
+        regs->SERCOM_CTRLB &= ~SERCOM_I2CM_CTRLB_CMD_Msk;
+        TEST_BusStop();
+    }
+
+    if (regs->SERCOM_ADDR != TEST_NONE)
+    {
+        uint32_t addr = regs->SERCOM_ADDR;
+
+        regs->SERCOM_ADDR = TEST_NONE;
+        TEST_BusStart(addr);
+    }
+
+    if (testBus.phase == TEST_BUS_STOP)
+    {
+        if ((testBus.inInterrupt == true) && (testBus.stopAfterFailure == false))
+        {
+            testStopPolls++;
+        }
+
+        if (testBus.stopAccesses == 0U)
+        {
+            testBus.phase = TEST_BUS_IDLE;
+
+            if (testBus.startHeld == true)
+            {
+                testBus.startHeld = false;
+                TEST_BusStart(testBus.heldAddr);
+            }
+        }
+        else
+        {
+            testBus.stopAccesses--;
+        }
+    }
+
+    regs->SERCOM_STATUS = (uint16_t)((regs->SERCOM_STATUS & ~SERCOM_I2CM_STATUS_BUSSTATE_Msk) |
+                          SERCOM_I2CM_STATUS_BUSSTATE((testBus.phase == TEST_BUS_IDLE) ? 1U : 2U));
+
+    return &testSercom5;
+}
+
+/* The transfer on the bus is always the oldest queued one: the callback of
+ * the one before runs in the interrupt that starts the next */
+static TEST_TRANSFER* TEST_TransferOnBus( void )
+{
+    TEST_CHECK(testQueuedNumber > 0U);
+
+    return &testQueued[testQueuedHead];
+}
+
+static void TEST_AddressAnswer( void )
+{
+    sercom_i2cm_registers_t* regs = &testSercom5.I2CM;
+    uint16_t address = (uint16_t)(testBus.addrByte >> 1U);
+
+    TEST_CHECK(TEST_TransferOnBus()->address == address);
+
+    if ((address == TEST_ADDRESS_ABSENT) || ((testBus.mayFail == true) && ((TEST_Random() % 16U) == 0U)))
+    {
+        TEST_TransferOnBus()->failExpected = true;
+
+        regs->SERCOM_STATUS |= ((TEST_Random() % 2U) == 0U) ? SERCOM_I2CM_STATUS_RXNACK_Msk : SERCOM_I2CM_STATUS_BUSERR_Msk;
+        regs->SERCOM_INTFLAG = SERCOM_I2CM_INTFLAG_MB_Msk;
+        testBus.phase = TEST_BUS_FAILED;
+    }
+    else if ((testBus.addrByte & 0x01U) != 0U)
+    {
+        regs->SERCOM_DATA = TEST_TargetByte(address, testTargetReadIndex[address]);
+        testTargetReadIndex[address]++;
+        regs->SERCOM_INTFLAG = SERCOM_I2CM_INTFLAG_SB_Msk;
+        testBus.phase = TEST_BUS_READ;
+    }
+    else
+    {
+        regs->SERCOM_DATA = TEST_NONE;
+        regs->SERCOM_INTFLAG = SERCOM_I2CM_INTFLAG_MB_Msk;
+        testBus.phase = TEST_BUS_WRITE;
+    }
+}
+
+static void TEST_Interrupt( void )
+{
+    sercom_i2cm_registers_t* regs = &testSercom5.I2CM;
+    TEST_BUS_PHASE phase = testBus.phase;
+    uint16_t address = (uint16_t)(testBus.addrByte >> 1U);
+    bool wasStaged = sercom5I2CObj.nextTransferPending;
+
+    testBus.ackActSeen = false;
+    testBus.events = 0U;
+    testBus.inInterrupt = true;
+
+    SERCOM5_I2C_InterruptHandler();
+
+    /* What the handler wrote after its last access */
+    (void)TEST_Sercom5Access();
+
+    testBus.inInterrupt = false;
+
+    regs->SERCOM_STATUS &= ~(SERCOM_I2CM_STATUS_RXNACK_Msk | SERCOM_I2CM_STATUS_BUSERR_Msk);
+    regs->SERCOM_INTFLAG = 0U;
+
+    /* A completed transfer's STOP is out before the handler returns */
+    TEST_CHECK((testBus.phase != TEST_BUS_STOP) || (testBus.stopAfterFailure == true));
+
+    switch (phase)
+    {
+        case TEST_BUS_FAILED:
+            TEST_CHECK(testBus.phase != TEST_BUS_FAILED);
+
+            if (wasStaged == true)
+            {
+                testReverts++;
+            }
+            break;
+
+        case TEST_BUS_WRITE:
+            /* A byte, the STOP or a repeated START */
+            TEST_CHECK(testBus.events != 0U);
+            break;
+
+        case TEST_BUS_READ:
+            if (testBus.phase == TEST_BUS_READ)
+            {
+                /* ACKed, the target sends the next byte */
+                TEST_CHECK(testBus.ackActSeen == false);
+
+                regs->SERCOM_DATA = TEST_TargetByte(address, testTargetReadIndex[address]);
+                testTargetReadIndex[address]++;
+            }
+            else
+            {
+                /* The last byte is NAKed ahead of the STOP or repeated START */
+                TEST_CHECK(testBus.ackActSeen == true);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void TEST_BusStep( void )
+{
+    switch (testBus.phase)
+    {
+        case TEST_BUS_IDLE:
+            break;
+
+        case TEST_BUS_STOP:
+            /* Time passes outside the handler */
+            while (testBus.phase == TEST_BUS_STOP)
+            {
+                (void)TEST_Sercom5Access();
+            }
+            break;
+
+        case TEST_BUS_ADDRESS:
+            TEST_AddressAnswer();
+            TEST_Interrupt();
+            break;
+
+        case TEST_BUS_WRITE:
+            testSercom5.I2CM.SERCOM_INTFLAG = SERCOM_I2CM_INTFLAG_MB_Msk;
+            TEST_Interrupt();
+            break;
+
+        case TEST_BUS_READ:
+            testSercom5.I2CM.SERCOM_INTFLAG = SERCOM_I2CM_INTFLAG_SB_Msk;
+            TEST_Interrupt();
+            break;
+
+        default:
+            /* A failed address phase is always ended by the handler */
+            TEST_CHECK(false);
+            break;
+    }
+}
+
+static void TEST_TransferEvent( DRV_I2C_TRANSFER_EVENT event, DRV_I2C_TRANSFER_HANDLE transferHandle, uintptr_t context )
+{
+    TEST_TRANSFER* transfer;
+    size_t index;
+
+    TEST_CHECK(testQueuedNumber > 0U);
+
+    transfer = &testQueued[testQueuedHead];
+
+    TEST_CHECK(transferHandle == transfer->handle);
+
+    if (transfer->failExpected == true)
+    {
+        TEST_CHECK(event == DRV_I2C_TRANSFER_EVENT_ERROR);
+        testFailed++;
+    }
+    else
+    {
+        TEST_CHECK(event == DRV_I2C_TRANSFER_EVENT_COMPLETE);
+
+        for (index = 0U; index < transfer->writeSize; index++)
+        {
+            testWriteHash[transfer->address] = TEST_Hash(testWriteHash[transfer->address], transfer->writeData[index]);
+        }
+
+        for (index = 0U; index < transfer->readSize; index++)
+        {
+            TEST_CHECK(transfer->readData[index] == TEST_TargetByte(transfer->address, testReadIndex[transfer->address]));
+            testReadIndex[transfer->address]++;
+        }
+
+        testCompleted++;
+    }
+
+    testQueuedHead = (testQueuedHead + 1U) % TEST_QUEUED_MAX;
+    testQueuedNumber--;
+}
+
+static void TEST_TransferQueue( DRV_HANDLE handle )
+{
+    TEST_TRANSFER* transfer = &testQueued[(testQueuedHead + testQueuedNumber) % TEST_QUEUED_MAX];
+    uint32_t kind = TEST_Random() % 3U;
+    size_t index;
+
+    if ((TEST_Random() % 2U) != 0U)
+    {
+        testLastAddress = testAddresses[TEST_Random() % (sizeof(testAddresses) / sizeof(testAddresses[0]))];
+    }
+
+    transfer->address = testLastAddress;
+    transfer->writeSize = (kind != 1U) ? (1U + (TEST_Random() % TEST_LENGTH_MAX)) : 0U;
+    transfer->readSize = (kind != 0U) ? (1U + (TEST_Random() % TEST_LENGTH_MAX)) : 0U;
+    transfer->failExpected = false;
+    transfer->handle = DRV_I2C_TRANSFER_HANDLE_INVALID;
+
+    for (index = 0U; index < transfer->writeSize; index++)
+    {
+        transfer->writeData[index] = (uint8_t)TEST_Random();
+    }
+
+    memset(transfer->readData, 0, sizeof(transfer->readData));
+
+    testQueuedNumber++;
+
+    switch (kind)
+    {
+        case 0U:
+            DRV_I2C_WriteTransferAdd(handle, transfer->address, transfer->writeData, transfer->writeSize, &transfer->handle);
+            break;
+
+        case 1U:
+            DRV_I2C_ReadTransferAdd(handle, transfer->address, transfer->readData, transfer->readSize, &transfer->handle);
+            break;
+
+        default:
+            DRV_I2C_WriteReadTransferAdd(handle, transfer->address, transfer->writeData, transfer->writeSize,
+                                         transfer->readData, transfer->readSize, &transfer->handle);
+            break;
+    }
+
+    TEST_CHECK(transfer->handle != DRV_I2C_TRANSFER_HANDLE_INVALID);
+}
+
+int main( void )
+{
+    DRV_HANDLE handle;
+    uint32_t address;
+    unsigned long drainSteps = 0UL;
+
+    testSercom5.I2CM.SERCOM_ADDR = TEST_NONE;
+    testSercom5.I2CM.SERCOM_DATA = TEST_NONE;
+
+    SERCOM5_I2C_Initialize();
+
+    (void)DRV_I2C_Initialize(DRV_I2C_INDEX_0, (SYS_MODULE_INIT *)&testDrvInitData);
+
+    handle = DRV_I2C_Open(DRV_I2C_INDEX_0, DRV_IO_INTENT_READWRITE);
+    TEST_CHECK(handle != DRV_HANDLE_INVALID);
+
+    DRV_I2C_TransferEventHandlerSet(handle, TEST_TransferEvent, 0U);
+
+    for (testStep = 0UL; testStep < TEST_STEPS; testStep++)
+    {
+        if ((testQueuedNumber < TEST_QUEUED_MAX) && ((TEST_Random() % 3U) == 0U))
+        {
+            TEST_TransferQueue(handle);
+        }
+        else
+        {
+            TEST_BusStep();
+        }
+    }
+
+    while ((testQueuedNumber > 0U) || (testBus.phase != TEST_BUS_IDLE))
+    {
+        TEST_CHECK(drainSteps < 1000UL);
+        TEST_BusStep();
+        drainSteps++;
+    }
+
+    for (address = 0U; address < 128U; address++)
+    {
+        TEST_CHECK(testTargetWriteHash[address] == testWriteHash[address]);
+        TEST_CHECK(testTargetReadIndex[address] == testReadIndex[address]);
+    }
+
+    printf("%lu steps, %lu transfers completed, %lu failed, %lu repeated STARTs (%lu after a read), "
+           "%lu STARTs from the interrupt after %lu STOP polls, %lu staged transfers put back, %lu STARTs held: ",
+           TEST_STEPS, testCompleted, testFailed, testRestarts, testRestartsAfterRead,
+           testIdleStarts, testStopPolls, testReverts, testHeldStarts);
+
+    if ((testCompleted == 0UL) || (testFailed == 0UL) || (testRestartsAfterRead == 0UL) ||
+        (testIdleStarts == 0UL) || (testStopPolls == 0UL) || (testReverts == 0UL))
+    {
+        printf("FAIL, a case was not reached\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
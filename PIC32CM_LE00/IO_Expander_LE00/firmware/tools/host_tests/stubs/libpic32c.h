@@ -0,0 +1,7 @@
+/* Host build stand-in for the XC32 runtime header included by the startup code */
+#ifndef LIBPIC32C_H
+#define LIBPIC32C_H
+
+void __pic32c_data_initialization(void);
+
+#endif /* LIBPIC32C_H */
@@ -0,0 +1,346 @@
+/*******************************************************************************
+  Command processor host test
+
+  Runs sys_command.c against an in-memory console and a test command table
+  ("pin" and "stats", both logging their arguments) and plays the scripts
+  given on the command line. Script lines:
+
+    # text          comment
+    in: text        queue console input
+    in*N: text      queue text N times
+    free: N         room the console reports for output
+    run             call SYS_CMD_Tasks until the input is read, plus 16 calls
+    log: text       handler calls of the last run, "[argc:argv0,argv1,...]" each
+    calls: N        number of handler calls of the last run
+    out~: text      output of the last run contains text
+    out!: text      output of the last run does not contain text
+    dropped+        the last run dropped output
+
+  The text of in and out lines takes the C escapes \r \n \t \b \\ and \xHH.
+
+  Every run also checks that SYS_CMD_Tasks reads at most SYS_CMD_READ_BUDGET
+  characters and runs at most one command per call.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system/command/sys_command.h"
+
+#define TEST_INPUT_SIZE     4096U
+#define TEST_OUTPUT_SIZE    8192U
+#define TEST_LOG_SIZE       4096U
+
+static char testInput[TEST_INPUT_SIZE];
+static size_t testInputLength;
+static size_t testInputPosition;
+static char testOutput[TEST_OUTPUT_SIZE];
+static size_t testOutputLength;
+static size_t testFreeRoom = TEST_OUTPUT_SIZE;
+static size_t testReadMax;
+static char testLog[TEST_LOG_SIZE];
+static unsigned int testCalls;
+static uint32_t testDroppedStart;
+
+static size_t TEST_Read( uint8_t* pRdBuffer, const size_t size )
+{
+    size_t count = 0U;
+
+    while ((count < size) && (testInputPosition < testInputLength))
+    {
+        pRdBuffer[count++] = (uint8_t)testInput[testInputPosition++];
+    }
+
+    if (count > testReadMax)
+    {
+        testReadMax = count;
+    }
+
+    return count;
+}
+
+static size_t TEST_Write( uint8_t* pWrBuffer, const size_t size )
+{
+    size_t count = (size < (TEST_OUTPUT_SIZE - 1U - testOutputLength)) ? size : (TEST_OUTPUT_SIZE - 1U - testOutputLength);
+
+    memcpy(&testOutput[testOutputLength], pWrBuffer, count);
+    testOutputLength += count;
+    testOutput[testOutputLength] = '\0';
+
+    return count;
+}
+
+static size_t TEST_WriteFreeGet( void )
+{
+    return testFreeRoom;
+}
+
+static void TEST_Command( int argc, char** argv )
+{
+    size_t length = strlen(testLog);
+    int index;
+
+    length += (size_t)snprintf(&testLog[length], TEST_LOG_SIZE - length, "[%d:", argc);
+
+    for (index = 0; index < argc; index++)
+    {
+        length += (size_t)snprintf(&testLog[length], TEST_LOG_SIZE - length, "%s%s", (index == 0) ? "" : ",", argv[index]);
+    }
+
+    (void)snprintf(&testLog[length], TEST_LOG_SIZE - length, "]");
+    testCalls++;
+}
+
+static const SYS_CMD_API testApi =
+{
+    TEST_Read,
+    TEST_Write,
+    TEST_WriteFreeGet,
+};
+
+static const SYS_CMD_DESCRIPTOR testCommands[] =
+{
+    { "pin",   TEST_Command, "pin commands" },
+    { "stats", TEST_Command, "statistics" },
+};
+
+/* Decodes the C escapes of text into decoded, NUL terminated */
+static bool TEST_Decode( const char* text, char* decoded, size_t size, size_t* length )
+{
+    unsigned int value;
+
+    *length = 0U;
+
+    while (*text != '\0')
+    {
+        if (*length >= (size - 1U))
+        {
+            return false;
+        }
+
+        if (*text != '\\')
+        {
+            decoded[(*length)++] = *text++;
+            continue;
+        }
+
+        text++;
+
+        switch (*text)
+        {
+            case 'r':  decoded[(*length)++] = '\r'; break;
+            case 'n':  decoded[(*length)++] = '\n'; break;
+            case 't':  decoded[(*length)++] = '\t'; break;
+            case 'b':  decoded[(*length)++] = '\b'; break;
+            case '\\': decoded[(*length)++] = '\\'; break;
+            case 'x':
+                if (sscanf(text + 1, "%2x", &value) != 1)
+                {
+                    return false;
+                }
+                decoded[(*length)++] = (char)value;
+                text += 2;
+                break;
+            default:
+                return false;
+        }
+
+        text++;
+    }
+
+    decoded[*length] = '\0';
+
+    return true;
+}
+
+static bool TEST_InputQueue( const char* text, unsigned long count )
+{
+    char decoded[TEST_INPUT_SIZE];
+    size_t length;
+
+    if (TEST_Decode(text, decoded, sizeof(decoded), &length) == false)
+    {
+        return false;
+    }
+
+    while (count-- > 0UL)
+    {
+        if ((testInputLength + length) > TEST_INPUT_SIZE)
+        {
+            return false;
+        }
+
+        memcpy(&testInput[testInputLength], decoded, length);
+        testInputLength += length;
+    }
+
+    return true;
+}
+
+static bool TEST_Run( void )
+{
+    unsigned int spare = 16U;
+    unsigned int callsBefore;
+
+    testLog[0] = '\0';
+    testCalls = 0U;
+    testOutputLength = 0U;
+    testOutput[0] = '\0';
+    testReadMax = 0U;
+    testDroppedStart = SYS_CMD_DroppedCountGet();
+
+    while ((testInputPosition < testInputLength) || (spare-- > 0U))
+    {
+        callsBefore = testCalls;
+
+        SYS_CMD_Tasks();
+
+        if ((testCalls - callsBefore) > 1U)
+        {
+            printf("  %u commands in one call\n", testCalls - callsBefore);
+            return false;
+        }
+    }
+
+    testInputLength = 0U;
+    testInputPosition = 0U;
+
+    if (testReadMax > SYS_CMD_READ_BUDGET)
+    {
+        printf("  %zu characters read in one call\n", testReadMax);
+        return false;
+    }
+
+    return true;
+}
+
+static bool TEST_Line( char* line )
+{
+    char decoded[TEST_LOG_SIZE];
+    unsigned long count;
+    size_t length;
+    char* text;
+
+    line[strcspn(line, "\r\n")] = '\0';
+
+    if ((line[0] == '#') || (line[0] == '\0'))
+    {
+        return true;
+    }
+
+    if (strcmp(line, "run") == 0)
+    {
+        return TEST_Run();
+    }
+
+    if (strcmp(line, "dropped+") == 0)
+    {
+        return (SYS_CMD_DroppedCountGet() > testDroppedStart);
+    }
+
+    text = strstr(line, ": ");
+
+    if (text == NULL)
+    {
+        return false;
+    }
+
+    *text = '\0';
+    text += 2;
+
+    if (strcmp(line, "in") == 0)
+    {
+        return TEST_InputQueue(text, 1UL);
+    }
+
+    if (sscanf(line, "in*%lu", &count) == 1)
+    {
+        return TEST_InputQueue(text, count);
+    }
+
+    if (strcmp(line, "free") == 0)
+    {
+        testFreeRoom = strtoul(text, NULL, 0);
+        return true;
+    }
+
+    if (strcmp(line, "log") == 0)
+    {
+        return (strcmp(testLog, text) == 0);
+    }
+
+    if (strcmp(line, "calls") == 0)
+    {
+        return (testCalls == strtoul(text, NULL, 0));
+    }
+
+    if (TEST_Decode(text, decoded, sizeof(decoded), &length) == false)
+    {
+        return false;
+    }
+
+    if (strcmp(line, "out~") == 0)
+    {
+        return (strstr(testOutput, decoded) != NULL);
+    }
+
+    if (strcmp(line, "out!") == 0)
+    {
+        return (strstr(testOutput, decoded) == NULL);
+    }
+
+    return false;
+}
+
+int main( int argc, char** argv )
+{
+    char line[512];
+    unsigned int lineNumber;
+    int failures = 0;
+    int index;
+    FILE* script;
+
+    if (argc < 2)
+    {
+        printf("usage: %s <script>...\n", argv[0]);
+        return 1;
+    }
+
+    if ((SYS_CMD_Initialize(&testApi) == false) ||
+        (SYS_CMD_ADDGRP(testCommands, (int)(sizeof(testCommands) / sizeof(testCommands[0])), "test", "test commands") == false))
+    {
+        printf("initialization failed\n");
+        return 1;
+    }
+
+    for (index = 1; index < argc; index++)
+    {
+        script = fopen(argv[index], "r");
+
+        if (script == NULL)
+        {
+            printf("%s: cannot open\n", argv[index]);
+            failures++;
+            continue;
+        }
+
+        lineNumber = 0U;
+
+        while (fgets(line, sizeof(line), script) != NULL)
+        {
+            lineNumber++;
+
+            if (TEST_Line(line) == false)
+            {
+                printf("%s:%u: failed\n  log: %s\n  output: %s\n", argv[index], lineNumber, testLog, testOutput);
+                failures++;
+            }
+        }
+
+        fclose(script);
+    }
+
+    printf("%d scripts: %s\n", argc - 1, (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,362 @@
+/*******************************************************************************
+  Key/value store interrupt driven host test
+
+  Runs sys_kvs.c on the data flash model of sys_kvs_test, but a command
+  only starts when it is given: it completes, and the NVMCTRL interrupt
+  calls the store back, when the modelled scheduler sleeps, which it does
+  whenever SYS_KVS_IdleUsGet lets it.
+
+  200000 random operations on 12 of the 16 keys, each setting or deleting
+  one key up to three times, the later values given while the write of an
+  earlier one is in flight. One operation in 20 runs with a 30% chance of
+  a power cut at every interrupt, recovery included: the command in flight
+  stops half done and the store is initialized again.
+
+  Checked: no command is given and no data flash read made while one is in
+  flight; the store never keeps the scheduler awake while it waits for the
+  interrupt, nor lets it sleep with work to do; once it is no longer busy
+  the flash holds the last value of every key, after a clean
+  initialization too; after a cut each key holds its previous value or one
+  of those given since.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "configuration.h"
+
+#include "system/kvs/src/sys_kvs.c"
+
+#define TEST_OPERATIONS     200000UL
+#define TEST_KEYS_USED      12U
+#define TEST_CHANGES_MAX    3U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("operation %lu: %s:%d: %s\n", testOperation, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+typedef enum
+{
+    TEST_COMMAND_NONE = 0,
+    TEST_COMMAND_WRITE,
+    TEST_COMMAND_ERASE,
+
+} TEST_COMMAND;
+
+typedef struct
+{
+    /* -1 for a deleted key */
+    int         length;
+
+    uint8_t     value[SYS_KVS_VALUE_MAX];
+
+} TEST_VALUE;
+
+static uint8_t testFlash[DATAFLASH_SIZE];
+static NVMCTRL_CALLBACK testCallback;
+static TEST_COMMAND testCommand;
+static uint32_t testCommandOffset;
+static uint8_t testPageBuffer[NVMCTRL_DATAFLASH_PAGESIZE];
+static uint32_t testCutPercent;
+static jmp_buf testCut;
+static unsigned long testOperation;
+static unsigned long testCuts;
+static unsigned long testCommands;
+static unsigned long testSleeps;
+static TEST_VALUE testCommitted[SYS_KVS_KEYS_NUMBER];
+
+/* The values given to the key of the operation, the last one first */
+static TEST_VALUE testGiven[TEST_CHANGES_MAX];
+static uint32_t testGivenNumber;
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context )
+{
+    testCallback = callback;
+}
+
+void NVMCTRL_RegionUnlock( NVMCTRL_MEMORY_REGION region )
+{
+}
+
+NVMCTRL_ERROR NVMCTRL_ErrorGet( void )
+{
+    return NVMCTRL_ERROR_NONE;
+}
+
+bool NVMCTRL_Read( uint32_t* data, uint32_t length, const uint32_t address )
+{
+    TEST_CHECK(testCommand == TEST_COMMAND_NONE);
+
+    memcpy(data, &testFlash[address - NVMCTRL_DATAFLASH_START_ADDRESS], length);
+
+    return true;
+}
+
+bool NVMCTRL_PageWrite( uint32_t* data, const uint32_t address )
+{
+    TEST_CHECK(testCommand == TEST_COMMAND_NONE);
+
+    /* The page buffer is loaded here, the store may reuse its RAM copy */
+    memcpy(testPageBuffer, data, sizeof(testPageBuffer));
+    testCommand = TEST_COMMAND_WRITE;
+    testCommandOffset = address - NVMCTRL_DATAFLASH_START_ADDRESS;
+    testCommands++;
+
+    return true;
+}
+
+bool NVMCTRL_RowErase( uint32_t address )
+{
+    TEST_CHECK(testCommand == TEST_COMMAND_NONE);
+
+    testCommand = TEST_COMMAND_ERASE;
+    testCommandOffset = address - NVMCTRL_DATAFLASH_START_ADDRESS;
+    testCommands++;
+
+    return true;
+}
+
+bool DSU_CRCCalculate( uint32_t addr, uint32_t length, uint32_t seed, uint32_t* crc )
+{
+    const uint8_t* bytes;
+    uint32_t value = seed;
+    uint32_t index;
+    uint32_t bit;
+
+    if (addr == (uint32_t)(uintptr_t)&sysKvsData.page.record)
+    {
+        bytes = (const uint8_t*)&sysKvsData.page.record;
+    }
+    else
+    {
+        TEST_CHECK(testCommand == TEST_COMMAND_NONE);
+        bytes = &testFlash[addr - NVMCTRL_DATAFLASH_START_ADDRESS];
+    }
+
+    for (index = 0U; index < length; index++)
+    {
+        value ^= bytes[index];
+
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            value = (value >> 1) ^ (0xEDB88320U & (0U - (value & 1U)));
+        }
+    }
+
+    *crc = value;
+
+    return true;
+}
+
+/* The command in flight completes and interrupts, or the power goes first
+ * and it is done in part */
+static void TEST_Interrupt( void )
+{
+    uint8_t* bytes = &testFlash[testCommandOffset];
+    uint32_t size = (testCommand == TEST_COMMAND_WRITE) ? NVMCTRL_DATAFLASH_PAGESIZE : NVMCTRL_DATAFLASH_ROWSIZE;
+    uint8_t mask = 0U;
+    bool isCut = ((TEST_Random() % 100U) < testCutPercent);
+    uint32_t index;
+
+    for (index = 0U; index < size; index++)
+    {
+        if (isCut == true)
+        {
+            mask = (uint8_t)TEST_Random();
+        }
+
+        bytes[index] = (testCommand == TEST_COMMAND_WRITE) ? (bytes[index] & (testPageBuffer[index] | mask)) :
+                                                             (bytes[index] | (uint8_t)~mask);
+    }
+
+    testCommand = TEST_COMMAND_NONE;
+
+    if (isCut == true)
+    {
+        testCuts++;
+        longjmp(testCut, 1);
+    }
+
+    testCallback(0U);
+}
+
+/* The scheduler: the task while the store has work, asleep until the
+ * interrupt otherwise */
+static void TEST_Run( void )
+{
+    uint32_t passes = 0U;
+
+    while (true)
+    {
+        TEST_CHECK(++passes < 1000U);
+
+        if (SYS_KVS_IdleUsGet() == 0U)
+        {
+            SYS_KVS_Tasks();
+        }
+        else if (testCommand != TEST_COMMAND_NONE)
+        {
+            testSleeps++;
+            TEST_Interrupt();
+        }
+        else
+        {
+            /* Idle with nothing in flight: the flash holds every value */
+            TEST_CHECK(SYS_KVS_IsBusy() == false);
+            return;
+        }
+    }
+}
+
+static void TEST_Boot( void )
+{
+    while (true)
+    {
+        testCommand = TEST_COMMAND_NONE;
+
+        if (setjmp(testCut) == 0)
+        {
+            TEST_CHECK(SYS_KVS_Initialize() == true);
+            TEST_Run();
+            return;
+        }
+    }
+}
+
+static bool TEST_Matches( uint32_t key, const TEST_VALUE* expected )
+{
+    uint8_t value[SYS_KVS_VALUE_MAX];
+    size_t length;
+
+    if (SYS_KVS_Get(key, value, sizeof(value), &length) == false)
+    {
+        return (expected->length < 0);
+    }
+
+    return ((int)length == expected->length) && (memcmp(value, expected->value, length) == 0);
+}
+
+/* Every key holds its committed value; key may also hold a given one */
+static void TEST_ValuesCheck( uint32_t key )
+{
+    uint32_t index;
+    uint32_t given;
+
+    for (index = 0U; index < SYS_KVS_KEYS_NUMBER; index++)
+    {
+        for (given = 0U; (index == key) && (given < testGivenNumber); given++)
+        {
+            if (TEST_Matches(index, &testGiven[given]) == true)
+            {
+                testCommitted[index] = testGiven[given];
+                break;
+            }
+        }
+
+        TEST_CHECK(TEST_Matches(index, &testCommitted[index]) == true);
+    }
+}
+
+static void TEST_ValueGive( uint32_t key )
+{
+    TEST_VALUE* value;
+    uint32_t index;
+
+    memmove(&testGiven[1], &testGiven[0], (TEST_CHANGES_MAX - 1U) * sizeof(testGiven[0]));
+    value = &testGiven[0];
+    testGivenNumber++;
+
+    if ((TEST_Random() % 10U) == 0U)
+    {
+        value->length = -1;
+        TEST_CHECK(SYS_KVS_Delete(key) == true);
+        return;
+    }
+
+    value->length = (int)(TEST_Random() % (SYS_KVS_VALUE_MAX + 1U));
+
+    for (index = 0U; index < (uint32_t)value->length; index++)
+    {
+        value->value[index] = (uint8_t)TEST_Random();
+    }
+
+    TEST_CHECK(SYS_KVS_Set(key, value->value, (size_t)value->length) == true);
+}
+
+int main( void )
+{
+    SYS_KVS_STATS stats;
+    uint32_t key;
+    uint32_t changes;
+    uint32_t change;
+
+    memset(testFlash, 0xFF, sizeof(testFlash));
+
+    for (key = 0U; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        testCommitted[key].length = -1;
+    }
+
+    TEST_Boot();
+
+    for (testOperation = 0UL; testOperation < TEST_OPERATIONS; testOperation++)
+    {
+        key = TEST_Random() % TEST_KEYS_USED;
+        changes = 1U + (TEST_Random() % TEST_CHANGES_MAX);
+        testCutPercent = ((TEST_Random() % 20U) == 0U) ? 30U : 0U;
+        testGivenNumber = 0U;
+
+        if (setjmp(testCut) == 0)
+        {
+            for (change = 0U; change < changes; change++)
+            {
+                TEST_ValueGive(key);
+
+                /* The write starts, the next value comes while it is in flight */
+                if ((change + 1U) < changes)
+                {
+                    SYS_KVS_Tasks();
+                }
+            }
+
+            TEST_Run();
+
+            testCommitted[key] = testGiven[0];
+            TEST_ValuesCheck(SYS_KVS_KEYS_NUMBER);
+        }
+        else
+        {
+            /* With the same chance of a cut in the recovery */
+            TEST_Boot();
+            TEST_ValuesCheck(key);
+        }
+
+        if ((testOperation % 1000UL) == 0UL)
+        {
+            testCutPercent = 0U;
+            TEST_Boot();
+            TEST_ValuesCheck(SYS_KVS_KEYS_NUMBER);
+        }
+    }
+
+    SYS_KVS_StatsGet(&stats);
+
+    printf("%lu operations, %lu commands, %lu interrupts slept for, %lu cuts, last boot %u records %u torn, %u failures: ",
+           TEST_OPERATIONS, testCommands, testSleeps, testCuts, stats.bootRecords, stats.bootTorn, stats.failures);
+
+    TEST_CHECK(stats.failures == 0U);
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*******************************************************************************
+  Key/value store power cut host test
+
+  Runs sys_kvs.c on a model of the 16 KB data flash: a page write can only
+  clear bits, a row erase sets them all, the DSU CRC is the CRC32 of the
+  bytes. Every NVMCTRL command completes at once, the interrupt called
+  before the command returns.
+
+  300000 random sets and deletes on 12 of the 16 keys. One operation in 50
+  arms a power cut a few commands on: that command stops half done, a page
+  with some of its bits cleared towards the record, a row with some of its
+  bits set, and the store is initialized again as after the reset, with a
+  chance of another cut during the recovery.
+
+  Checked: after every operation the store holds every value, after a clean
+  initialization too; after a cut each key holds its previous or its new
+  value, the keys never written stay deleted, and initialization never
+  fails; the rows are erased in turn, a row erased more often than another
+  only by a lap and the erases a cut in it caused.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "configuration.h"
+
+#include "system/kvs/src/sys_kvs.c"
+
+#define TEST_OPERATIONS     300000UL
+#define TEST_KEYS_USED      12U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("operation %lu: %s:%d: %s\n", testOperation, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+typedef struct
+{
+    /* -1 for a deleted key */
+    int         length;
+
+    uint8_t     value[SYS_KVS_VALUE_MAX];
+
+} TEST_VALUE;
+
+static uint8_t testFlash[DATAFLASH_SIZE];
+static NVMCTRL_CALLBACK testCallback;
+static long testCutIn = -1;
+static jmp_buf testCut;
+static unsigned long testOperation;
+static unsigned long testCuts;
+static uint32_t testRowErases[SYS_KVS_ROWS];
+
+/* Cut commands in each row, each may cost the row one more erase */
+static uint32_t testRowCuts[SYS_KVS_ROWS];
+static TEST_VALUE testCommitted[SYS_KVS_KEYS_NUMBER];
+static TEST_VALUE testNew;
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+/* The power goes during this command: part of it is done */
+static void TEST_CutCheck( uint8_t* bytes, const uint8_t* target, uint32_t size )
+{
+    uint32_t index;
+
+    if ((testCutIn < 0) || (testCutIn-- != 0))
+    {
+        return;
+    }
+
+    testRowCuts[(uint32_t)(bytes - testFlash) / NVMCTRL_DATAFLASH_ROWSIZE]++;
+
+    for (index = 0U; index < size; index++)
+    {
+        bytes[index] = (target != NULL) ? (bytes[index] & (target[index] | (uint8_t)TEST_Random())) :
+                                          (bytes[index] | (uint8_t)TEST_Random());
+    }
+
+    testCutIn = -1;
+    testCuts++;
+    longjmp(testCut, 1);
+}
+
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context )
+{
+    testCallback = callback;
+}
+
+void NVMCTRL_RegionUnlock( NVMCTRL_MEMORY_REGION region )
+{
+}
+
+NVMCTRL_ERROR NVMCTRL_ErrorGet( void )
+{
+    return NVMCTRL_ERROR_NONE;
+}
+
+bool NVMCTRL_Read( uint32_t* data, uint32_t length, const uint32_t address )
+{
+    memcpy(data, &testFlash[address - NVMCTRL_DATAFLASH_START_ADDRESS], length);
+
+    return true;
+}
+
+bool NVMCTRL_PageWrite( uint32_t* data, const uint32_t address )
+{
+    uint8_t* bytes = &testFlash[address - NVMCTRL_DATAFLASH_START_ADDRESS];
+    uint32_t index;
+
+    TEST_CutCheck(bytes, (const uint8_t*)data, NVMCTRL_DATAFLASH_PAGESIZE);
+
+    for (index = 0U; index < NVMCTRL_DATAFLASH_PAGESIZE; index++)
+    {
+        bytes[index] &= ((const uint8_t*)data)[index];
+    }
+
+    testCallback(0U);
+
+    return true;
+}
+
+bool NVMCTRL_RowErase( uint32_t address )
+{
+    uint32_t offset = address - NVMCTRL_DATAFLASH_START_ADDRESS;
+
+    testRowErases[offset / NVMCTRL_DATAFLASH_ROWSIZE]++;
+    TEST_CutCheck(&testFlash[offset], NULL, NVMCTRL_DATAFLASH_ROWSIZE);
+
+    memset(&testFlash[offset], 0xFF, NVMCTRL_DATAFLASH_ROWSIZE);
+
+    testCallback(0U);
+
+    return true;
+}
+
+/* The store computes the CRC of a data flash page or of its RAM record */
+bool DSU_CRCCalculate( uint32_t addr, uint32_t length, uint32_t seed, uint32_t* crc )
+{
+    const uint8_t* bytes = (addr == (uint32_t)(uintptr_t)&sysKvsData.page.record) ?
+        (const uint8_t*)&sysKvsData.page.record : &testFlash[addr - NVMCTRL_DATAFLASH_START_ADDRESS];
+    uint32_t value = seed;
+    uint32_t index;
+    uint32_t bit;
+
+    for (index = 0U; index < length; index++)
+    {
+        value ^= bytes[index];
+
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            value = (value >> 1) ^ (0xEDB88320U & (0U - (value & 1U)));
+        }
+    }
+
+    *crc = value;
+
+    return true;
+}
+
+static bool TEST_Matches( uint32_t key, const TEST_VALUE* expected )
+{
+    uint8_t value[SYS_KVS_VALUE_MAX];
+    size_t length;
+
+    if (SYS_KVS_Get(key, value, sizeof(value), &length) == false)
+    {
+        return (expected->length < 0);
+    }
+
+    return ((int)length == expected->length) && (memcmp(value, expected->value, length) == 0);
+}
+
+/* Every key holds its committed value; key may also hold testNew */
+static void TEST_ValuesCheck( uint32_t key )
+{
+    uint32_t index;
+
+    for (index = 0U; index < SYS_KVS_KEYS_NUMBER; index++)
+    {
+        if ((index == key) && (TEST_Matches(index, &testNew) == true))
+        {
+            testCommitted[index] = testNew;
+        }
+
+        TEST_CHECK(TEST_Matches(index, &testCommitted[index]) == true);
+    }
+}
+
+/* The scheduler runs the task while it has work */
+static void TEST_Run( void )
+{
+    uint32_t passes = 0U;
+
+    while ((SYS_KVS_IsBusy() == true) || (SYS_KVS_IdleUsGet() == 0U))
+    {
+        SYS_KVS_Tasks();
+        TEST_CHECK(++passes < 1000U);
+    }
+}
+
+/* As after a reset, cut again one time in four */
+static void TEST_Boot( bool isCutAllowed )
+{
+    while (true)
+    {
+        if (isCutAllowed && ((TEST_Random() % 4U) == 0U))
+        {
+            testCutIn = (long)(TEST_Random() % 4U);
+        }
+
+        if (setjmp(testCut) == 0)
+        {
+            TEST_CHECK(SYS_KVS_Initialize() == true);
+            TEST_Run();
+            testCutIn = -1;
+            return;
+        }
+    }
+}
+
+int main( void )
+{
+    SYS_KVS_STATS stats;
+    uint32_t key;
+    uint32_t index;
+    uint32_t erasesMin = UINT32_MAX;
+    uint32_t lapsMax = 0U;
+
+    memset(testFlash, 0xFF, sizeof(testFlash));
+
+    for (key = 0U; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        testCommitted[key].length = -1;
+    }
+
+    TEST_Boot(false);
+
+    for (testOperation = 0UL; testOperation < TEST_OPERATIONS; testOperation++)
+    {
+        key = TEST_Random() % TEST_KEYS_USED;
+
+        if ((TEST_Random() % 10U) == 0U)
+        {
+            testNew.length = -1;
+        }
+        else if (((TEST_Random() % 4U) == 0U) && (testCommitted[key].length >= 0))
+        {
+            /* The same value again, no write */
+            testNew = testCommitted[key];
+        }
+        else
+        {
+            testNew.length = (int)(TEST_Random() % (SYS_KVS_VALUE_MAX + 1U));
+
+            for (index = 0U; index < (uint32_t)testNew.length; index++)
+            {
+                testNew.value[index] = (uint8_t)TEST_Random();
+            }
+        }
+
+        if ((TEST_Random() % 50U) == 0U)
+        {
+            testCutIn = (long)(TEST_Random() % 6U);
+        }
+
+        if (setjmp(testCut) == 0)
+        {
+            TEST_CHECK(((testNew.length < 0) ? SYS_KVS_Delete(key) :
+                        SYS_KVS_Set(key, testNew.value, (size_t)testNew.length)) == true);
+            TEST_Run();
+            testCutIn = -1;
+
+            testCommitted[key] = testNew;
+            TEST_ValuesCheck(key);
+        }
+        else
+        {
+            TEST_Boot(true);
+            TEST_ValuesCheck(key);
+        }
+
+        if ((testOperation % 1000UL) == 0UL)
+        {
+            TEST_Boot(false);
+            TEST_ValuesCheck(SYS_KVS_KEYS_NUMBER);
+        }
+    }
+
+    for (key = TEST_KEYS_USED; key < SYS_KVS_KEYS_NUMBER; key++)
+    {
+        TEST_CHECK(testCommitted[key].length < 0);
+    }
+
+    for (index = 0U; index < SYS_KVS_ROWS; index++)
+    {
+        erasesMin = (testRowErases[index] < erasesMin) ? testRowErases[index] : erasesMin;
+
+        /* Erases not owed to a cut, at least the laps of the row */
+        if ((testRowErases[index] > testRowCuts[index]) && ((testRowErases[index] - testRowCuts[index]) > lapsMax))
+        {
+            lapsMax = testRowErases[index] - testRowCuts[index];
+        }
+    }
+
+    SYS_KVS_StatsGet(&stats);
+
+    printf("%lu operations, %lu cuts, rows erased %u times at least, %u at most less the cuts in the row, last boot %u records %u torn: ",
+           TEST_OPERATIONS, testCuts, erasesMin, lapsMax, stats.bootRecords, stats.bootTorn);
+
+    TEST_CHECK(lapsMax <= (erasesMin + 1U));
+
+    printf("PASS\n");
+
+    return 0;
+}
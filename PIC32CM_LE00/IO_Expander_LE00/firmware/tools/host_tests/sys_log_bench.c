@@ -0,0 +1,105 @@
+/*******************************************************************************
+  Deferred log host benchmark
+
+  Time of SYS_LOG3 for the expander address message of app_expander.c,
+  against snprintf of the same text into a buffer, the formatting part of
+  the printf it replaced. SYS_LOG_Tasks, which the log call defers the
+  frame building to, is timed separately, with a SERCOM3 stand-in that
+  takes the frames and discards them. Each figure is the best batch of
+  BENCH_CALLS calls out of BENCH_BATCHES, in ns per call on this host;
+  the device figure is the "log write" region of "prof".
+
+  Not run by "make check"; "make bench" builds and runs it.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "configuration.h"
+
+/* The regions would time themselves here */
+#undef SYS_PROF_ENABLE
+
+#define __get_PRIMASK()     0U
+#define __disable_irq()
+#define __enable_irq()
+
+#include "system/log/src/sys_log.c"
+
+#define BENCH_BATCHES       20000U
+#define BENCH_CALLS         16U
+#define BENCH_TEXT_SIZE     64U
+
+static volatile uint32_t benchFrameBytes;
+static char benchText[BENCH_TEXT_SIZE];
+
+size_t SERCOM3_USART_WriteFreeBufferCountGet( void )
+{
+    return SYS_LOG_FRAME_SIZE_MAX;
+}
+
+size_t SERCOM3_USART_Write( uint8_t* pWrBuffer, const size_t size )
+{
+    benchFrameBytes = (uint32_t)size;
+
+    return size;
+}
+
+static double BENCH_NsGet( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double)now.tv_sec * 1e9) + (double)now.tv_nsec;
+}
+
+int main( void )
+{
+    uint32_t batch;
+    uint32_t call;
+    uint32_t address = 0x20U;
+    int textSize = 0;
+    double start;
+    double ns;
+    double logNs = 1e30;
+    double tasksNs = 1e30;
+    double textNs = 1e30;
+
+    SYS_LOG_Initialize();
+
+    for (batch = 0U; batch < BENCH_BATCHES; batch++)
+    {
+        start = BENCH_NsGet();
+
+        for (call = 0U; call < BENCH_CALLS; call++)
+        {
+            SYS_LOG3("APP_EXPANDER: expander %u on bus %u at 0x%02X", call, batch & 1U, address);
+        }
+
+        ns = BENCH_NsGet() - start;
+        logNs = (ns < logNs) ? ns : logNs;
+
+        start = BENCH_NsGet();
+        SYS_LOG_Tasks();
+        ns = BENCH_NsGet() - start;
+        tasksNs = (ns < tasksNs) ? ns : tasksNs;
+
+        start = BENCH_NsGet();
+
+        for (call = 0U; call < BENCH_CALLS; call++)
+        {
+            textSize = snprintf(benchText, sizeof(benchText), "APP_EXPANDER: expander %u on bus %u at 0x%02X\r\n",
+                                (unsigned int)call, (unsigned int)(batch & 1U), (unsigned int)address);
+        }
+
+        ns = BENCH_NsGet() - start;
+        textNs = (ns < textNs) ? ns : textNs;
+    }
+
+    printf("%-34s %8.1f ns/call\n", "SYS_LOG3", logNs / BENCH_CALLS);
+    printf("%-34s %8.1f ns/record, %u bytes\n", "SYS_LOG_Tasks, deferred", tasksNs / BENCH_CALLS,
+           (unsigned int)benchFrameBytes);
+    printf("%-34s %8.1f ns/call, %d bytes\n", "snprintf", textNs / BENCH_CALLS, textSize);
+
+    return (SYS_LOG_DroppedCountGet() == 0U) ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/*******************************************************************************
+  Power governor host test
+
+  Runs sys_sched.c and sys_power.c together, as the firmware's task table
+  does, on a virtual microsecond clock: a 1 ms periodic task costing a
+  number of CPU cycles, the power task in the background, SYS_POWER_Sleep
+  as the sleep hook. Idle mode lasts to the next 1 ms SysTick interrupt,
+  every scheduler pass costs 2 us, and the CPU clock follows the generator
+  0 source the level change selects.
+
+  Checked: with the governor on and a light load the device sleeps and the
+  governor drops to the low level at the end of the first window, by
+  itself; a heavy load brings it back up within a window, a load between
+  the two thresholds leaves the level alone; with the governor off the
+  window may stretch but the load is still measured.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "definitions.h"
+#include "system/sched/sys_sched.h"
+#include "system/power/sys_power.h"
+
+#define TEST_PASS_US        2U
+#define TEST_CHANGES_MAX    8U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("  %s:%d: %s\n", __FILE__, __LINE__, #condition); testFailures++; } } while (0)
+
+static uint64_t testUs;
+static uint32_t testMHz = 48U;
+static uint32_t testWorkCycles;
+static uint64_t testChangeUs[TEST_CHANGES_MAX];
+static SYS_POWER_LEVEL testChangeLevel[TEST_CHANGES_MAX];
+static uint32_t testChanges;
+static int testFailures;
+
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+uint64_t SYSTICK_TimestampUsGet( void )
+{
+    return testUs;
+}
+
+uint32_t SYSTICK_TimerCounterGet( void )
+{
+    return ((1000U - (uint32_t)(testUs % 1000U)) * testMHz) - 1U;
+}
+
+uint32_t SYSTICK_TimerFrequencyGet( void )
+{
+    return testMHz * 1000000U;
+}
+
+void SYSTICK_TickAdvance( uint32_t ticks )
+{
+}
+
+uint32_t SYSTICK_PeriodChangeBegin( uint32_t period )
+{
+    return period;
+}
+
+void SYSTICK_PeriodChangeEnd( uint32_t remaining, uint32_t period )
+{
+}
+
+/* The next SysTick interrupt ends it */
+void PM_IdleModeEnter( void )
+{
+    testUs = ((testUs / 1000U) + 1U) * 1000U;
+}
+
+void PM_StandbyModeEnter( void )
+{
+}
+
+void NVMCTRL_ReadWaitStatesSet( uint32_t waitStates )
+{
+}
+
+void CLOCK_DFLL48MEnable( bool enable )
+{
+}
+
+void CLOCK_Gclk0SourceSet( CLOCK_GCLK0_SOURCE source )
+{
+    testMHz = (source == CLOCK_GCLK0_SOURCE_DFLL48M) ? 48U : 16U;
+}
+
+void RTC_Timer32Start( void )
+{
+}
+
+uint32_t RTC_Timer32CounterGet( void )
+{
+    return 0U;
+}
+
+void RTC_Timer32Compare0Set( uint32_t compareValue )
+{
+}
+
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interrupt )
+{
+}
+
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interrupt )
+{
+}
+
+static uint32_t TEST_TimeGet( void )
+{
+    return (uint32_t)testUs;
+}
+
+static void TEST_Work( void )
+{
+    testUs += testWorkCycles / testMHz;
+}
+
+static void TEST_ClockChange( void )
+{
+    if (testChanges < TEST_CHANGES_MAX)
+    {
+        testChangeUs[testChanges] = testUs;
+        testChangeLevel[testChanges] = (testMHz == 48U) ? SYS_POWER_LEVEL_HIGH : SYS_POWER_LEVEL_LOW;
+    }
+
+    testChanges++;
+}
+
+static const SYS_SCHED_TASK testTasks[] =
+{
+    { "work",   TEST_Work,          1000U, 0U, 1000U, 500U, NULL },
+    { "power",  SYS_POWER_Tasks,    0U,    0U, 0U,    300U, SYS_POWER_IdleUsGet },
+};
+
+static const SYS_POWER_CLOCK_CLIENT testClients[] =
+{
+    { NULL, TEST_ClockChange },
+};
+
+static void TEST_Run( uint32_t workCycles, uint32_t durationMs )
+{
+    uint64_t endUs = testUs + ((uint64_t)durationMs * 1000U);
+
+    testWorkCycles = workCycles;
+
+    while (testUs < endUs)
+    {
+        SYS_SCHED_Tasks();
+        testUs += TEST_PASS_US;
+    }
+}
+
+static void TEST_Report( const char* title )
+{
+    SYS_POWER_STATS stats;
+
+    SYS_POWER_StatsGet(&stats);
+
+    printf("%-44s %s, load %3u.%u%%, %u changes, %5u idles of %4llu ms in %5llu ms\n", title,
+           (SYS_POWER_LevelGet() == SYS_POWER_LEVEL_HIGH) ? "high" : "low ",
+           SYS_POWER_LoadGet() / 10U, SYS_POWER_LoadGet() % 10U, stats.levelChanges, stats.idles,
+           (unsigned long long)(stats.idleUs / 1000U), (unsigned long long)(stats.elapsedUs / 1000U));
+}
+
+int main( void )
+{
+    SYS_SCHED_INIT schedInit = { testTasks, 2U, TEST_TimeGet, SYS_POWER_Sleep };
+    SYS_POWER_INIT powerInit = { NULL, 0U, testClients, 1U };
+    SYS_POWER_STATS stats;
+    uint64_t startUs;
+
+    SYS_POWER_Initialize(&powerInit);
+    SYS_POWER_GovernorEnable(true);
+    TEST_CHECK(SYS_SCHED_Initialize(&schedInit) == true);
+
+    /* 2400 cycles a millisecond: 5% busy at 48 MHz, 15% at 16 MHz */
+    startUs = testUs;
+    TEST_Run(2400U, 1000U);
+    TEST_Report("light load, 1 s from the high level");
+
+    SYS_POWER_StatsGet(&stats);
+    TEST_CHECK(testChanges == 1U);
+    TEST_CHECK(testChangeLevel[0] == SYS_POWER_LEVEL_LOW);
+    TEST_CHECK((testChangeUs[0] - startUs) >= 100000U);
+    TEST_CHECK((testChangeUs[0] - startUs) < 102000U);
+    TEST_CHECK(SYS_POWER_LevelGet() == SYS_POWER_LEVEL_LOW);
+    TEST_CHECK(stats.idles > 900U);
+    TEST_CHECK((SYS_POWER_LoadGet() >= 150U) && (SYS_POWER_LoadGet() < 200U));
+
+    /* 14400 cycles: 90% busy at 16 MHz, 30% at 48 MHz */
+    startUs = testUs;
+    TEST_Run(14400U, 1000U);
+    TEST_Report("heavy load, 1 s from the low level");
+
+    TEST_CHECK(testChanges == 2U);
+    TEST_CHECK(testChangeLevel[1] == SYS_POWER_LEVEL_HIGH);
+    TEST_CHECK((testChangeUs[1] - startUs) < 202000U);
+    TEST_CHECK(SYS_POWER_LevelGet() == SYS_POWER_LEVEL_HIGH);
+    TEST_CHECK((SYS_POWER_LoadGet() >= 300U) && (SYS_POWER_LoadGet() < 350U));
+
+    /* Off, nothing wakes the device for the window */
+    SYS_POWER_GovernorEnable(false);
+    TEST_CHECK(SYS_POWER_IdleUsGet() == SYS_SCHED_IDLE_FOREVER);
+    TEST_Run(2400U, 1000U);
+    TEST_Report("light load, 1 s with the governor off");
+
+    TEST_CHECK(testChanges == 2U);
+    TEST_CHECK((SYS_POWER_LoadGet() >= 50U) && (SYS_POWER_LoadGet() < 100U));
+
+    printf("%s\n", (testFailures == 0) ? "PASS" : "FAIL");
+
+    return (testFailures == 0) ? 0 : 1;
+}
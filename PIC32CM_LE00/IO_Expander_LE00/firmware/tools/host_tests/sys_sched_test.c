@@ -0,0 +1,331 @@
+/*******************************************************************************
+  Scheduler host test
+
+  Runs sys_sched.c on a virtual microsecond clock. Each test task records
+  when it started and advances the clock by its run time; the sleep hook
+  advances it by the time asked for.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "system/sched/sys_sched.h"
+
+#define TEST_TASKS          5U
+#define TEST_STARTS_MAX     4096U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("  %s:%d: %s\n", __FILE__, __LINE__, #condition); testFailures++; } } while (0)
+
+static uint32_t testClock;
+static uint32_t testCost[TEST_TASKS];
+static uint32_t testStarts[TEST_TASKS][TEST_STARTS_MAX];
+static uint32_t testStartsNumber[TEST_TASKS];
+static char testOrder[TEST_STARTS_MAX];
+static uint32_t testOrderNumber;
+static uint32_t testIdleUs = SYS_SCHED_IDLE_FOREVER;
+static uint32_t testSleeps;
+static uint32_t testSleptUs;
+static int testFailures;
+
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+static uint32_t TEST_TimeGet( void )
+{
+    return testClock;
+}
+
+static uint32_t TEST_Sleep( uint32_t maxUs )
+{
+    testSleeps++;
+    testSleptUs += maxUs;
+    testClock += maxUs;
+
+    return maxUs;
+}
+
+static uint32_t TEST_IdleUsGet( void )
+{
+    return testIdleUs;
+}
+
+static void TEST_Task( uint32_t index )
+{
+    testStarts[index][testStartsNumber[index] % TEST_STARTS_MAX] = testClock;
+    testStartsNumber[index]++;
+    testOrder[testOrderNumber % (TEST_STARTS_MAX - 1U)] = (char)('0' + index);
+    testOrderNumber++;
+    testClock += testCost[index];
+}
+
+static void TEST_Task0( void ) { TEST_Task(0U); }
+static void TEST_Task1( void ) { TEST_Task(1U); }
+static void TEST_Task2( void ) { TEST_Task(2U); }
+static void TEST_Task3( void ) { TEST_Task(3U); }
+
+static void TEST_Reset( uint32_t start )
+{
+    testClock = start;
+    testOrderNumber = 0U;
+    testSleeps = 0U;
+    testSleptUs = 0U;
+    memset(testStartsNumber, 0, sizeof(testStartsNumber));
+    memset(testOrder, 0, sizeof(testOrder));
+}
+
+static void TEST_Report( const char* title )
+{
+    const SYS_SCHED_TASK* task;
+    SYS_SCHED_STATS stats;
+    size_t index;
+
+    printf("%s\n", title);
+
+    for (index = 0U; index < SYS_SCHED_TasksNumberGet(); index++)
+    {
+        task = SYS_SCHED_TaskGet(index);
+        (void)SYS_SCHED_StatsGet(index, &stats);
+
+        printf("  %-4s period %5u runs %6u run max %4u jitter avg %4u max %5u over %3u late %3u skip %3u\n",
+               task->name, task->periodUs, stats.runs, stats.runMaxUs,
+               (stats.runs != 0U) ? (unsigned int)(stats.jitterTotalUs / stats.runs) : 0U, stats.jitterMaxUs,
+               stats.overruns, stats.deadlineMisses, stats.releasesSkipped);
+    }
+}
+
+/* Light load for 1 s across the wrap of the 32-bit clock: every release on
+ * time within the background run time, the phase kept */
+static void TEST_Wrap( void )
+{
+    static const SYS_SCHED_TASK tasks[] =
+    {
+        { "bg",  TEST_Task0,     0U,   0U,    0U,  100U, NULL },
+        { "p1",  TEST_Task1,  1000U,   0U,  500U,   50U, NULL },
+        { "p2",  TEST_Task2,  2000U, 250U, 2000U, 1000U, NULL },
+        { "p10", TEST_Task3, 10000U, 500U, 5000U,  200U, NULL },
+    };
+    SYS_SCHED_INIT init = { tasks, 4U, TEST_TimeGet, NULL };
+    SYS_SCHED_STATS stats;
+    uint32_t start = 0xFFFF0000U;
+    uint32_t index;
+
+    TEST_Reset(start);
+    testCost[0] = 30U;
+    testCost[1] = 20U;
+    testCost[2] = 100U;
+    testCost[3] = 150U;
+
+    TEST_CHECK(SYS_SCHED_Initialize(&init) == true);
+
+    while ((testClock - start) < 1000000U)
+    {
+        SYS_SCHED_Tasks();
+    }
+
+    TEST_Report("light load, 1 s across the 32-bit wrap");
+
+    for (index = 0U; index < testStartsNumber[3]; index++)
+    {
+        /* Release k * 10 ms + 500 us, started within 200 us */
+        TEST_CHECK(((testStarts[3][index] - start - 500U) % 10000U) < 200U);
+    }
+
+    TEST_CHECK(testStartsNumber[3] == 100U);
+
+    for (index = 1U; index <= 3U; index++)
+    {
+        (void)SYS_SCHED_StatsGet(index, &stats);
+        TEST_CHECK((stats.deadlineMisses == 0U) && (stats.releasesSkipped == 0U) && (stats.jitterMaxUs < 200U));
+    }
+
+    (void)SYS_SCHED_StatsGet(1U, &stats);
+    TEST_CHECK((stats.runs == 1000U) || (stats.runs == 1001U));
+}
+
+/* Three tasks released together run earliest deadline first */
+static void TEST_DeadlineOrder( void )
+{
+    static const SYS_SCHED_TASK tasks[] =
+    {
+        { "a", TEST_Task1, 5000U, 0U, 4000U, 0U, NULL },
+        { "b", TEST_Task2, 5000U, 0U, 1000U, 0U, NULL },
+        { "c", TEST_Task3, 5000U, 0U, 2500U, 0U, NULL },
+    };
+    SYS_SCHED_INIT init = { tasks, 3U, TEST_TimeGet, NULL };
+
+    TEST_Reset(100U);
+    testCost[1] = 10U;
+    testCost[2] = 10U;
+    testCost[3] = 10U;
+
+    TEST_CHECK(SYS_SCHED_Initialize(&init) == true);
+
+    SYS_SCHED_Tasks();
+
+    printf("same release, deadlines 4/1/2.5 ms: order %s\n", testOrder);
+    TEST_CHECK(strcmp(testOrder, "231") == 0);
+}
+
+/* One 3.5 ms background run: overrun, late and skipped releases */
+static void TEST_Overrun( void )
+{
+    static const SYS_SCHED_TASK tasks[] =
+    {
+        { "bg",   TEST_Task0,    0U, 0U,    0U,  100U, NULL },
+        { "p1",   TEST_Task1, 1000U, 0U,  500U,   50U, NULL },
+        { "slow", TEST_Task2, 2000U, 0U, 2000U, 1000U, NULL },
+    };
+    SYS_SCHED_INIT init = { tasks, 3U, TEST_TimeGet, NULL };
+    SYS_SCHED_STATS stats;
+    bool isHogged = false;
+
+    TEST_Reset(0U);
+    testCost[0] = 30U;
+    testCost[1] = 20U;
+    testCost[2] = 100U;
+
+    TEST_CHECK(SYS_SCHED_Initialize(&init) == true);
+
+    while (testClock < 1000000U)
+    {
+        testCost[0] = ((testClock > 500000U) && (isHogged == false)) ? 3500U : 30U;
+        isHogged = isHogged || (testCost[0] != 30U);
+
+        SYS_SCHED_Tasks();
+    }
+
+    TEST_Report("one 3.5 ms background run at 0.5 s");
+
+    (void)SYS_SCHED_StatsGet(0U, &stats);
+    TEST_CHECK(stats.overruns == 1U);
+    (void)SYS_SCHED_StatsGet(1U, &stats);
+    TEST_CHECK((stats.deadlineMisses == 2U) && (stats.releasesSkipped == 1U));
+    (void)SYS_SCHED_StatsGet(2U, &stats);
+    TEST_CHECK((stats.deadlineMisses == 0U) && (stats.releasesSkipped == 0U));
+}
+
+/* A periodic task taking more than its period still lets each pass return
+ * and the background task run */
+static void TEST_Overload( void )
+{
+    static const SYS_SCHED_TASK tasks[] =
+    {
+        { "bg", TEST_Task0,    0U, 0U, 0U, 0U, NULL },
+        { "p",  TEST_Task1, 1000U, 0U, 0U, 0U, NULL },
+    };
+    SYS_SCHED_INIT init = { tasks, 2U, TEST_TimeGet, NULL };
+    SYS_SCHED_STATS stats;
+    uint32_t pass;
+
+    TEST_Reset(0U);
+    testCost[0] = 10U;
+    testCost[1] = 1500U;
+
+    TEST_CHECK(SYS_SCHED_Initialize(&init) == true);
+
+    for (pass = 0U; pass < 100U; pass++)
+    {
+        SYS_SCHED_Tasks();
+    }
+
+    TEST_Report("periodic task of 1.5 ms every 1 ms");
+
+    (void)SYS_SCHED_StatsGet(0U, &stats);
+    TEST_CHECK(stats.runs == 100U);
+}
+
+/* Sleeping: for the time to the earliest release of a task without an idle
+ * hook, through the releases of the tasks that have one */
+static void TEST_SleepThrough( void )
+{
+    static const SYS_SCHED_TASK tasks[] =
+    {
+        { "idle", TEST_Task0,     0U, 0U, 0U, 0U, TEST_IdleUsGet },
+        { "p10",  TEST_Task1, 10000U, 0U, 0U, 0U, NULL },
+        { "p1",   TEST_Task2,  1000U, 0U, 0U, 0U, TEST_IdleUsGet },
+    };
+    SYS_SCHED_INIT init = { tasks, 3U, TEST_TimeGet, TEST_Sleep };
+    SYS_SCHED_STATS stats;
+
+    TEST_Reset(0xFFFFF000U);
+    testCost[0] = 5U;
+    testCost[1] = 40U;
+    testCost[2] = 5U;
+    testIdleUs = SYS_SCHED_IDLE_FOREVER;
+
+    TEST_CHECK(SYS_SCHED_Initialize(&init) == true);
+
+    while ((testClock - 0xFFFFF000U) < 1000000U)
+    {
+        SYS_SCHED_Tasks();
+    }
+
+    TEST_Report("idle tasks, 1 s of sleeps to a 10 ms release");
+
+    printf("  %u sleeps, %u us\n", testSleeps, testSleptUs);
+
+    /* One sleep per 10 ms release, the p1 releases slept through */
+    TEST_CHECK((testSleeps >= 99U) && (testSleeps <= 101U));
+    TEST_CHECK(testSleptUs > 990000U);
+    (void)SYS_SCHED_StatsGet(1U, &stats);
+    TEST_CHECK((stats.runs >= 100U) && (stats.releasesSkipped == 0U) && (stats.jitterMaxUs <= testCost[0]));
+    (void)SYS_SCHED_StatsGet(2U, &stats);
+    TEST_CHECK((stats.releasesSkipped == 0U) && (stats.deadlineMisses == 0U));
+
+    /* Work on an idle task: no sleep at all */
+    testIdleUs = 0U;
+    testSleeps = 0U;
+    SYS_SCHED_Tasks();
+    SYS_SCHED_Tasks();
+    TEST_CHECK(testSleeps == 0U);
+    testIdleUs = SYS_SCHED_IDLE_FOREVER;
+}
+
+/* Time left of a millisecond period, the current tick counted as gone */
+static void TEST_MsPeriod( void )
+{
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(100U, 100U, 10U) == 9000U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(100U, 109U, 10U) == 0U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(100U, 110U, 10U) == 0U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(100U, 5000U, 10U) == 0U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(0xFFFFFFFEU, 3U, 10U) == 4000U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(0U, 0U, 0U) == 0U);
+    TEST_CHECK(SYS_SCHED_MsPeriodIdleUsGet(0U, 0U, 0x7FFFFFFFU) == (SYS_SCHED_IDLE_FOREVER - 1U));
+}
+
+static void TEST_Limits( void )
+{
+    static const SYS_SCHED_TASK tasks[SYS_SCHED_TASKS_MAX + 1U] =
+    {
+        { "bg", TEST_Task0, 0U, 0U, 0U, 0U, NULL },
+    };
+    SYS_SCHED_INIT tooMany = { tasks, SYS_SCHED_TASKS_MAX + 1U, TEST_TimeGet, NULL };
+    SYS_SCHED_INIT noTime = { tasks, 1U, NULL, NULL };
+
+    TEST_CHECK(SYS_SCHED_Initialize(&tooMany) == false);
+    TEST_CHECK(SYS_SCHED_Initialize(&noTime) == false);
+    TEST_CHECK((SYS_SCHED_TaskGet(0U) == NULL) && (SYS_SCHED_TasksNumberGet() == 0U));
+
+    /* A failed initialization leaves nothing to run */
+    SYS_SCHED_Tasks();
+}
+
+int main( void )
+{
+    TEST_Wrap();
+    TEST_DeadlineOrder();
+    TEST_Overrun();
+    TEST_Overload();
+    TEST_SleepThrough();
+    TEST_MsPeriod();
+    TEST_Limits();
+
+    printf("%s\n", (testFailures == 0) ? "PASS" : "FAIL");
+
+    return (testFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,510 @@
+/*******************************************************************************
+  Tickless standby host test
+
+  Runs sys_sched.c, sys_power.c and sys_tmr.c with the firmware's task
+  table for a minute at each expander poll period, standby on at 10, 100
+  and 1000 ms, then off at 0, 10 and 100 ms for idle mode alone. The tasks
+  without work here, log, rpc, shell, baud, cmd, app and kvs, are idle
+  for ever. The others are modelled as the firmware's modules:
+
+  - expander: a round of 16 reads on two buses, 8 x 123.8 us, every poll
+    period from its start tick; active while the reads are in flight
+  - telemetry: a 12-byte frame after each round and a 40-byte STATS
+    frame every 1000 ms, sent at 921600 baud; the console keeps rpc
+    active while they go out
+  - tmr: SYS_TMR with one periodic 250 ms timer
+
+  SysTick stops in standby and the RTC, counting true time at 32768 Hz,
+  wakes the device 40 us after its match. Idle mode lasts to the next
+  SysTick interrupt or transfer interrupt. Every scheduler pass costs
+  2 us, an RTC read 1 us, a round start 20 us and a frame 30 us.
+
+  Checked: no deadline is missed and no release skipped; the rounds, the
+  STATS frames and the 250 ms timer are at most a tick late; standby is
+  never entered with a transfer or a frame in flight, and the wake-up
+  latency stays within an RTC count of the modelled one; SysTick stays
+  within an RTC count of true time, the carried part of a tick aside;
+  the standby share grows with the poll period. With standby off: it is
+  never entered, each delta frame starts within 100 us of its round's
+  transfer interrupt, and the CPU is idle most of the time between the
+  rounds.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "definitions.h"
+#include "system/sched/sys_sched.h"
+#include "system/power/sys_power.h"
+#include "system/tmr/sys_tmr.h"
+
+#define TEST_RUN_MS             60000U
+#define TEST_PASS_US            2U
+#define TEST_WAKE_US            40U
+#define TEST_RTC_FREQUENCY      32768U
+
+#define TEST_ROUND_US           990U
+#define TEST_ROUND_START_US     20U
+#define TEST_FRAME_US           30U
+#define TEST_BYTE_NS            10850U
+#define TEST_DELTA_BYTES        12U
+#define TEST_STATS_BYTES        40U
+#define TEST_STATS_MS           1000U
+#define TEST_TIMER_MS           250U
+#define TEST_REACTION_MAX_US    100U
+
+#define TEST_NONE               UINT64_MAX
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("  %s:%d: %s\n", __FILE__, __LINE__, #condition); testFailures++; } } while (0)
+
+typedef struct
+{
+    uint32_t    pollMs;
+
+    /* 0 while polling, the round otherwise */
+    uint64_t    roundEndUs;
+
+    uint32_t    roundTick;
+
+    bool        isStarted;
+
+    uint32_t    rounds;
+
+    uint32_t    roundLateMaxMs;
+
+    /* The transfer interrupt of the last round */
+    uint64_t    roundEndedUs;
+
+} TEST_EXPANDER;
+
+typedef struct
+{
+    bool        isCyclePending;
+
+    uint32_t    statsTick;
+
+    uint32_t    statsLateMaxMs;
+
+    uint64_t    txEndUs;
+
+    uint64_t    reactionSumUs;
+
+    uint32_t    reactionMaxUs;
+
+} TEST_TELEMETRY;
+
+/* True time, and SysTick's, which stops in standby */
+static uint64_t testUs;
+static uint64_t testSysTickUs;
+static uint32_t testRtcCompare;
+static TEST_EXPANDER testExpander;
+static TEST_TELEMETRY testTelemetry;
+static uint32_t testTimerDue;
+static uint32_t testTimerLateMaxMs;
+static uint32_t testTimerRuns;
+static int64_t testLagMinUs;
+static int64_t testLagMaxUs;
+static int testFailures;
+
+/* The CPU runs, SysTick with it */
+static void TEST_Elapse( uint32_t us )
+{
+    testUs += us;
+    testSysTickUs += us;
+}
+
+bool SYS_INT_Disable( void )
+{
+    return true;
+}
+
+void SYS_INT_Restore( bool state )
+{
+}
+
+uint64_t SYSTICK_TimestampUsGet( void )
+{
+    return testSysTickUs;
+}
+
+uint32_t SYSTICK_GetTickCounter( void )
+{
+    return (uint32_t)(testSysTickUs / 1000U);
+}
+
+uint32_t SYSTICK_TimerCounterGet( void )
+{
+    return ((1000U - (uint32_t)(testSysTickUs % 1000U)) * 48U) - 1U;
+}
+
+uint32_t SYSTICK_TimerFrequencyGet( void )
+{
+    return 48000000U;
+}
+
+void SYSTICK_TickAdvance( uint32_t ticks )
+{
+    testSysTickUs += (uint64_t)ticks * 1000U;
+}
+
+uint32_t SYSTICK_PeriodChangeBegin( uint32_t period )
+{
+    return period;
+}
+
+void SYSTICK_PeriodChangeEnd( uint32_t remaining, uint32_t period )
+{
+}
+
+void NVMCTRL_ReadWaitStatesSet( uint32_t waitStates )
+{
+}
+
+void CLOCK_DFLL48MEnable( bool enable )
+{
+}
+
+void CLOCK_Gclk0SourceSet( CLOCK_GCLK0_SOURCE source )
+{
+}
+
+void RTC_Timer32Start( void )
+{
+}
+
+/* A read takes a microsecond */
+uint32_t RTC_Timer32CounterGet( void )
+{
+    TEST_Elapse(1U);
+
+    return (uint32_t)((testUs * TEST_RTC_FREQUENCY) / 1000000U);
+}
+
+void RTC_Timer32Compare0Set( uint32_t compareValue )
+{
+    testRtcCompare = compareValue;
+}
+
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interrupt )
+{
+}
+
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interrupt )
+{
+}
+
+/* The next transfer or DMA interrupt */
+static uint64_t TEST_EventUsGet( void )
+{
+    uint64_t eventUs = TEST_NONE;
+
+    if (testExpander.roundEndUs != 0U)
+    {
+        eventUs = testExpander.roundEndUs;
+    }
+
+    if ((testTelemetry.txEndUs > testUs) && (testTelemetry.txEndUs < eventUs))
+    {
+        eventUs = testTelemetry.txEndUs;
+    }
+
+    return eventUs;
+}
+
+static void TEST_EventsRun( void )
+{
+    if ((testExpander.roundEndUs != 0U) && (testExpander.roundEndUs <= testUs))
+    {
+        testExpander.roundEndedUs = testExpander.roundEndUs;
+        testExpander.roundEndUs = 0U;
+        testExpander.rounds++;
+        testTelemetry.isCyclePending = true;
+    }
+}
+
+/* The next SysTick or transfer interrupt ends it */
+void PM_IdleModeEnter( void )
+{
+    uint64_t wakeUs = testUs + (1000U - (testSysTickUs % 1000U));
+    uint64_t eventUs = TEST_EventUsGet();
+
+    if (eventUs < wakeUs)
+    {
+        wakeUs = eventUs;
+    }
+
+    TEST_Elapse((uint32_t)(wakeUs - testUs));
+}
+
+/* SysTick stops; the RTC match ends it */
+void PM_StandbyModeEnter( void )
+{
+    uint64_t matchUs = (((uint64_t)testRtcCompare * 1000000U) + TEST_RTC_FREQUENCY - 1U) / TEST_RTC_FREQUENCY;
+
+    TEST_CHECK(TEST_EventUsGet() == TEST_NONE);
+    TEST_CHECK(matchUs > testUs);
+
+    testUs = matchUs + TEST_WAKE_US;
+}
+
+static uint32_t TEST_TimeGet( void )
+{
+    return (uint32_t)testSysTickUs;
+}
+
+static void TEST_Nothing( void )
+{
+}
+
+static uint32_t TEST_IdleForever( void )
+{
+    return SYS_SCHED_IDLE_FOREVER;
+}
+
+static void TEST_ExpanderTasks( void )
+{
+    uint32_t tick = SYSTICK_GetTickCounter();
+    uint32_t lateMs;
+
+    if ((testExpander.roundEndUs != 0U) ||
+        ((testExpander.isStarted == true) && ((tick - testExpander.roundTick) < testExpander.pollMs)))
+    {
+        return;
+    }
+
+    if (testExpander.isStarted == true)
+    {
+        lateMs = tick - testExpander.roundTick - testExpander.pollMs;
+        testExpander.roundLateMaxMs = (lateMs > testExpander.roundLateMaxMs) ? lateMs : testExpander.roundLateMaxMs;
+    }
+
+    testExpander.isStarted = true;
+    testExpander.roundTick = tick;
+    TEST_Elapse(TEST_ROUND_START_US);
+    testExpander.roundEndUs = testUs + TEST_ROUND_US;
+}
+
+/* As APP_EXPANDER_IdleUsGet */
+static uint32_t TEST_ExpanderIdleUsGet( void )
+{
+    if (testExpander.roundEndUs != 0U)
+    {
+        return SYS_SCHED_IDLE_FOREVER;
+    }
+
+    if (testExpander.isStarted == false)
+    {
+        return 0U;
+    }
+
+    return SYS_SCHED_MsPeriodIdleUsGet(testExpander.roundTick, SYSTICK_GetTickCounter(), testExpander.pollMs);
+}
+
+static bool TEST_ExpanderIsActive( void )
+{
+    return (testExpander.roundEndUs != 0U);
+}
+
+static void TEST_FrameSend( uint32_t bytes )
+{
+    uint64_t startUs = (testTelemetry.txEndUs > testUs) ? testTelemetry.txEndUs : testUs;
+
+    TEST_Elapse(TEST_FRAME_US);
+    testTelemetry.txEndUs = startUs + (((uint64_t)bytes * TEST_BYTE_NS) / 1000U);
+}
+
+static void TEST_TelemetryTasks( void )
+{
+    uint32_t tick = SYSTICK_GetTickCounter();
+    uint32_t lateMs;
+    uint32_t reactionUs;
+
+    if (testTelemetry.isCyclePending == true)
+    {
+        reactionUs = (uint32_t)(testUs - testExpander.roundEndedUs);
+        testTelemetry.reactionSumUs += reactionUs;
+        testTelemetry.reactionMaxUs = (reactionUs > testTelemetry.reactionMaxUs) ? reactionUs : testTelemetry.reactionMaxUs;
+        testTelemetry.isCyclePending = false;
+        TEST_FrameSend(TEST_DELTA_BYTES);
+    }
+
+    if ((tick - testTelemetry.statsTick) >= TEST_STATS_MS)
+    {
+        lateMs = tick - testTelemetry.statsTick - TEST_STATS_MS;
+        testTelemetry.statsLateMaxMs = (lateMs > testTelemetry.statsLateMaxMs) ? lateMs : testTelemetry.statsLateMaxMs;
+        testTelemetry.statsTick = tick;
+        TEST_FrameSend(TEST_STATS_BYTES);
+    }
+}
+
+/* As APP_TELEMETRY_IdleUsGet */
+static uint32_t TEST_TelemetryIdleUsGet( void )
+{
+    if (testTelemetry.isCyclePending == true)
+    {
+        return 0U;
+    }
+
+    return SYS_SCHED_MsPeriodIdleUsGet(testTelemetry.statsTick, SYSTICK_GetTickCounter(), TEST_STATS_MS);
+}
+
+/* Bytes still going out, as APP_RPC_IsActive */
+static bool TEST_RpcIsActive( void )
+{
+    return (testTelemetry.txEndUs > testUs);
+}
+
+static void TEST_TimerCallback( uintptr_t context, uint32_t currTick )
+{
+    uint32_t lateMs = SYSTICK_GetTickCounter() - testTimerDue;
+
+    TEST_CHECK((int32_t)lateMs >= 0);
+    testTimerLateMaxMs = (lateMs > testTimerLateMaxMs) ? lateMs : testTimerLateMaxMs;
+    testTimerDue += TEST_TIMER_MS;
+    testTimerRuns++;
+}
+
+static const SYS_SCHED_TASK testTasks[] =
+{
+    /* name         task                    period  phase   deadline budget  idle */
+    { "log",        TEST_Nothing,           0U,     0U,     0U,     200U,   TEST_IdleForever },
+    { "rpc",        TEST_Nothing,           0U,     0U,     0U,     300U,   TEST_IdleForever },
+    { "expander",   TEST_ExpanderTasks,     0U,     0U,     0U,     100U,   TEST_ExpanderIdleUsGet },
+    { "telemetry",  TEST_TelemetryTasks,    0U,     0U,     0U,     300U,   TEST_TelemetryIdleUsGet },
+    { "shell",      TEST_Nothing,           0U,     0U,     0U,     50U,    TEST_IdleForever },
+    { "tmr",        SYS_TMR_Tasks,          1000U,  0U,     1000U,  100U,   SYS_TMR_IdleUsGet },
+    { "baud",       TEST_Nothing,           1000U,  0U,     500U,   50U,    TEST_IdleForever },
+    { "cmd",        TEST_Nothing,           2000U,  250U,   2000U,  1000U,  TEST_IdleForever },
+    { "app",        TEST_Nothing,           10000U, 500U,   5000U,  200U,   TEST_IdleForever },
+    { "kvs",        TEST_Nothing,           0U,     0U,     0U,     100U,   TEST_IdleForever },
+    { "power",      SYS_POWER_Tasks,        0U,     0U,     0U,     300U,   SYS_POWER_IdleUsGet },
+};
+
+static const SYS_POWER_ACTIVE_GET testActive[] =
+{
+    TEST_ExpanderIsActive,
+    TEST_RpcIsActive,
+};
+
+/* A minute at pollMs; returns the standby share in 0.1% */
+static uint32_t TEST_Run( uint32_t pollMs, bool isStandby )
+{
+    SYS_SCHED_INIT schedInit = { testTasks, sizeof(testTasks) / sizeof(testTasks[0]), TEST_TimeGet, SYS_POWER_Sleep };
+    SYS_POWER_INIT powerInit = { testActive, sizeof(testActive) / sizeof(testActive[0]), NULL, 0U };
+    SYS_TMR_INIT tmrInit = { SYSTICK_GetTickCounter };
+    SYS_SCHED_STATS schedStats;
+    SYS_POWER_STATS stats;
+    uint64_t endUs = testUs + ((uint64_t)TEST_RUN_MS * 1000U);
+    uint32_t deadlineMisses = 0U;
+    uint32_t releasesSkipped = 0U;
+    uint32_t standbyPermille;
+    uint32_t idlePermille;
+    uint32_t busyPermille;
+    int64_t lagUs;
+    size_t index;
+
+    /* As from a reset, no carried part of a tick */
+    testUs = testSysTickUs;
+
+    (void) memset(&testExpander, 0, sizeof(testExpander));
+    (void) memset(&testTelemetry, 0, sizeof(testTelemetry));
+    testExpander.pollMs = pollMs;
+    testTelemetry.statsTick = SYSTICK_GetTickCounter();
+    testTimerLateMaxMs = 0U;
+    testTimerRuns = 0U;
+    testLagMinUs = INT64_MAX;
+    testLagMaxUs = INT64_MIN;
+
+    SYS_TMR_Initialize(&tmrInit);
+    testTimerDue = SYSTICK_GetTickCounter() + TEST_TIMER_MS;
+    TEST_CHECK(SYS_TMR_CallbackPeriodic(TEST_TIMER_MS, 0U, TEST_TimerCallback) != SYS_TMR_HANDLE_INVALID);
+
+    SYS_POWER_Initialize(&powerInit);
+    SYS_POWER_StandbyEnable(isStandby);
+    TEST_CHECK(SYS_SCHED_Initialize(&schedInit) == true);
+
+    while (testUs < endUs)
+    {
+        SYS_SCHED_Tasks();
+        TEST_EventsRun();
+        TEST_Elapse(TEST_PASS_US);
+        TEST_EventsRun();
+
+        lagUs = (int64_t)(testUs - testSysTickUs);
+        testLagMinUs = (lagUs < testLagMinUs) ? lagUs : testLagMinUs;
+        testLagMaxUs = (lagUs > testLagMaxUs) ? lagUs : testLagMaxUs;
+    }
+
+    SYS_POWER_StatsGet(&stats);
+
+    for (index = 0U; index < SYS_SCHED_TasksNumberGet(); index++)
+    {
+        (void) SYS_SCHED_StatsGet(index, &schedStats);
+        deadlineMisses += schedStats.deadlineMisses;
+        releasesSkipped += schedStats.releasesSkipped;
+    }
+
+    standbyPermille = (uint32_t)((stats.standbyUs * 1000U) / stats.elapsedUs);
+    idlePermille = (uint32_t)((stats.idleUs * 1000U) / stats.elapsedUs);
+    busyPermille = 1000U - standbyPermille - idlePermille;
+
+    TEST_CHECK(deadlineMisses == 0U);
+    TEST_CHECK(releasesSkipped == 0U);
+    /* At poll 0 the rounds run back to back, with a pass between them */
+    TEST_CHECK(testExpander.rounds >= (((TEST_RUN_MS * 1000U) / ((pollMs * 1000U) + TEST_ROUND_US + TEST_ROUND_START_US + 50U)) - 1U));
+    TEST_CHECK((pollMs == 0U) || (testExpander.roundLateMaxMs <= 1U));
+    TEST_CHECK(testTelemetry.statsLateMaxMs <= 1U);
+    TEST_CHECK(testTimerRuns >= ((TEST_RUN_MS / TEST_TIMER_MS) - 1U));
+    TEST_CHECK(testTimerLateMaxMs <= 1U);
+
+    if (isStandby == false)
+    {
+        printf("poll %4u ms, standby off: %3u.%u%% busy, %3u.%u%% idle, %5u rounds/s, "
+               "delta frame %u/%u us after the round\n", pollMs,
+               busyPermille / 10U, busyPermille % 10U, idlePermille / 10U, idlePermille % 10U,
+               testExpander.rounds / (TEST_RUN_MS / 1000U),
+               (uint32_t)(testTelemetry.reactionSumUs / testExpander.rounds), testTelemetry.reactionMaxUs);
+
+        TEST_CHECK(stats.standbys == 0U);
+        TEST_CHECK(testTelemetry.reactionMaxUs <= TEST_REACTION_MAX_US);
+        TEST_CHECK(idlePermille >= 800U);
+
+        return idlePermille;
+    }
+
+    printf("poll %4u ms: %3u.%u%% standby, %3u.%u%% idle, %4u standbys, wake-up %u us, %4u rounds, "
+           "late %u/%u/%u ms, SysTick %lld to %lld us behind\n", pollMs,
+           standbyPermille / 10U, standbyPermille % 10U, idlePermille / 10U, idlePermille % 10U,
+           stats.standbys, stats.wakeLatencyMaxUs, testExpander.rounds, testExpander.roundLateMaxMs,
+           testTelemetry.statsLateMaxMs, testTimerLateMaxMs, (long long)testLagMinUs, (long long)testLagMaxUs);
+
+    TEST_CHECK(stats.standbys > 0U);
+    TEST_CHECK(stats.wakeLatencyMaxUs <= (TEST_WAKE_US + (1000000U / TEST_RTC_FREQUENCY)));
+
+    /* The carry, less than a tick, and an RTC count either way */
+    TEST_CHECK(testLagMinUs > -31);
+    TEST_CHECK(testLagMaxUs < (1000 + 31));
+
+    return standbyPermille;
+}
+
+int main( void )
+{
+    uint32_t standby10;
+    uint32_t standby100;
+    uint32_t standby1000;
+
+    standby10 = TEST_Run(10U, true);
+    standby100 = TEST_Run(100U, true);
+    standby1000 = TEST_Run(1000U, true);
+    (void) TEST_Run(0U, false);
+    (void) TEST_Run(10U, false);
+    (void) TEST_Run(100U, false);
+
+    TEST_CHECK(standby10 >= 700U);
+    TEST_CHECK(standby100 > standby10);
+    TEST_CHECK(standby1000 > standby100);
+
+    printf("%s\n", (testFailures == 0) ? "PASS" : "FAIL");
+
+    return (testFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+/*******************************************************************************
+  Software timer host benchmark
+
+  Time per tick of the timer wheel against a sorted doubly linked list, the
+  usual alternative, for 16, 256 and 1024 timers. Each tick reloads 4
+  random timers and expires the ones due; half the timers are periodic.
+  Workloads: mixed periods of 1-5000 ms, and debounce windows of 20-50 ms
+  reloaded at random.
+
+  Not run by "make check"; "make bench" builds and runs it.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "configuration.h"
+
+#undef SYS_TMR_MAX_CLIENT_OBJECTS
+#define SYS_TMR_MAX_CLIENT_OBJECTS      1024U
+
+#include "system/tmr/src/sys_tmr.c"
+
+#define BENCH_TICKS         200000U
+#define BENCH_RELOADS       4U
+#define BENCH_NONE          (-1)
+
+typedef struct
+{
+    uint32_t    expires;
+
+    uint32_t    periodMs;
+
+    int         prev;
+
+    int         next;
+
+    bool        isLinked;
+
+} BENCH_LIST_OBJ;
+
+static uint32_t benchTick;
+static unsigned long benchFired;
+static BENCH_LIST_OBJ benchList[SYS_TMR_MAX_CLIENT_OBJECTS];
+static int benchListHead = BENCH_NONE;
+
+static uint32_t BENCH_TickGet( void )
+{
+    return benchTick;
+}
+
+static uint32_t BENCH_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+static void BENCH_Callback( uintptr_t context, uint32_t currTick )
+{
+    benchFired++;
+}
+
+static uint32_t BENCH_PeriodGet( bool isDebounce )
+{
+    return isDebounce ? (20U + (BENCH_Random() % 31U)) : (1U + (BENCH_Random() % 5000U));
+}
+
+static double BENCH_NsGet( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double)now.tv_sec * 1e9) + (double)now.tv_nsec;
+}
+
+static void BENCH_ListUnlink( int index )
+{
+    BENCH_LIST_OBJ* object = &benchList[index];
+
+    if (object->prev == BENCH_NONE)
+    {
+        benchListHead = object->next;
+    }
+    else
+    {
+        benchList[object->prev].next = object->next;
+    }
+
+    if (object->next != BENCH_NONE)
+    {
+        benchList[object->next].prev = object->prev;
+    }
+
+    object->isLinked = false;
+}
+
+/* Insertion scans from the head, after the timers due at the same tick */
+static void BENCH_ListLink( int index )
+{
+    BENCH_LIST_OBJ* object = &benchList[index];
+    int prev = BENCH_NONE;
+    int next = benchListHead;
+
+    while ((next != BENCH_NONE) && ((int32_t)(benchList[next].expires - object->expires) <= 0))
+    {
+        prev = next;
+        next = benchList[next].next;
+    }
+
+    object->prev = prev;
+    object->next = next;
+
+    if (prev == BENCH_NONE)
+    {
+        benchListHead = index;
+    }
+    else
+    {
+        benchList[prev].next = index;
+    }
+
+    if (next != BENCH_NONE)
+    {
+        benchList[next].prev = index;
+    }
+
+    object->isLinked = true;
+}
+
+static void BENCH_ListReload( int index, uint32_t periodMs )
+{
+    if (benchList[index].isLinked == true)
+    {
+        BENCH_ListUnlink(index);
+    }
+
+    benchList[index].periodMs = periodMs;
+    benchList[index].expires = benchTick + periodMs;
+    BENCH_ListLink(index);
+}
+
+static void BENCH_ListTasks( void )
+{
+    int index;
+
+    while ((benchListHead != BENCH_NONE) && ((int32_t)(benchTick - benchList[benchListHead].expires) >= 0))
+    {
+        index = benchListHead;
+        BENCH_ListUnlink(index);
+
+        if ((index & 1) != 0)
+        {
+            benchList[index].expires += benchList[index].periodMs;
+            BENCH_ListLink(index);
+        }
+
+        BENCH_Callback(0U, benchTick);
+    }
+}
+
+int main( void )
+{
+    static const int sizes[] = { 16, 256, 1024 };
+    static SYS_TMR_HANDLE handles[SYS_TMR_MAX_CLIENT_OBJECTS];
+    SYS_TMR_INIT init = { BENCH_TickGet };
+    unsigned long wheelFired;
+    double wheelNs;
+    double listNs;
+    double start;
+    uint32_t tick;
+    uint32_t reload;
+    size_t sizeIndex;
+    int timers;
+    int index;
+    int workload;
+
+    printf("%6s %-9s %14s %14s\n", "timers", "workload", "wheel ns/tick", "list ns/tick");
+
+    for (workload = 0; workload < 2; workload++)
+    {
+        for (sizeIndex = 0U; sizeIndex < (sizeof(sizes) / sizeof(sizes[0])); sizeIndex++)
+        {
+            timers = sizes[sizeIndex];
+
+            benchTick = 0U;
+            SYS_TMR_Initialize(&init);
+
+            for (index = 0; index < timers; index++)
+            {
+                handles[index] = SYS_TMR_ObjectCreate(BENCH_PeriodGet(workload != 0), 0U, BENCH_Callback,
+                                                      ((index & 1) != 0) ? SYS_TMR_FLAG_PERIODIC : SYS_TMR_FLAG_SINGLE);
+            }
+
+            start = BENCH_NsGet();
+
+            for (tick = 0U; tick < BENCH_TICKS; tick++)
+            {
+                benchTick++;
+
+                for (reload = 0U; reload < BENCH_RELOADS; reload++)
+                {
+                    (void)SYS_TMR_ObjectReload(handles[BENCH_Random() % (uint32_t)timers], BENCH_PeriodGet(workload != 0), 0U, BENCH_Callback);
+                }
+
+                SYS_TMR_Tasks();
+            }
+
+            wheelNs = (BENCH_NsGet() - start) / BENCH_TICKS;
+            wheelFired = benchFired;
+            benchFired = 0UL;
+
+            benchTick = 0U;
+            benchListHead = BENCH_NONE;
+
+            for (index = 0; index < timers; index++)
+            {
+                benchList[index].isLinked = false;
+                BENCH_ListReload(index, BENCH_PeriodGet(workload != 0));
+            }
+
+            start = BENCH_NsGet();
+
+            for (tick = 0U; tick < BENCH_TICKS; tick++)
+            {
+                benchTick++;
+
+                for (reload = 0U; reload < BENCH_RELOADS; reload++)
+                {
+                    BENCH_ListReload((int)(BENCH_Random() % (uint32_t)timers), BENCH_PeriodGet(workload != 0));
+                }
+
+                BENCH_ListTasks();
+            }
+
+            listNs = (BENCH_NsGet() - start) / BENCH_TICKS;
+
+            printf("%6d %-9s %14.0f %14.0f   (%lu/%lu expiries)\n", timers, (workload != 0) ? "debounce" : "mixed",
+                   wheelNs, listNs, wheelFired, benchFired);
+
+            benchFired = 0UL;
+        }
+    }
+
+    return 0;
+}
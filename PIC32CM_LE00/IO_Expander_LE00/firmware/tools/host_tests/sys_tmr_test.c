@@ -0,0 +1,245 @@
+/*******************************************************************************
+  Software timer host test
+
+  40M random steps on a pool of 1024 timers and a virtual 1 ms tick: create
+  periodic and one-shot timers, reload, delete, advance the tick by 1-3,
+  jump by 2^24 ticks, and sleep for SYS_TMR_IdleUsGet as the scheduler
+  would. The tick starts at 0xFFFFF000 so that it wraps, periods go up to
+  2^25 ticks so that timers cascade round the last wheel level.
+
+  Checked: every callback comes on the tick its timer was due, periodic
+  timers skip the periods missed by a late SYS_TMR_Tasks and keep their
+  phase, stale handles are refused, no timer is left overdue, and
+  SYS_TMR_IdleUsGet never reaches past the next expiry.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "configuration.h"
+
+/* A pool far larger than the firmware's, to fill the wheel */
+#undef SYS_TMR_MAX_CLIENT_OBJECTS
+#define SYS_TMR_MAX_CLIENT_OBJECTS      1024U
+
+#include "system/tmr/src/sys_tmr.c"
+
+#define TEST_STEPS          40000000UL
+#define TEST_TIMERS         SYS_TMR_MAX_CLIENT_OBJECTS
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("step %lu: %s:%d: %s\n", testStep, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+typedef enum
+{
+    TEST_TIMER_NONE = 0,
+    TEST_TIMER_PERIODIC,
+    TEST_TIMER_SINGLE,
+
+} TEST_TIMER_KIND;
+
+static uint32_t testTick;
+static unsigned long testStep;
+static SYS_TMR_HANDLE testHandle[TEST_TIMERS];
+static uint32_t testExpires[TEST_TIMERS];
+static uint32_t testPeriod[TEST_TIMERS];
+static TEST_TIMER_KIND testKind[TEST_TIMERS];
+static unsigned long testFired;
+static unsigned long testSleeps;
+
+static uint32_t TEST_TickGet( void )
+{
+    return testTick;
+}
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+static uint32_t TEST_PeriodGet( void )
+{
+    uint32_t choice = TEST_Random() % 100U;
+
+    if (choice < 60U)
+    {
+        return 1U + (TEST_Random() % 64U);
+    }
+
+    if (choice < 90U)
+    {
+        return 1U + (TEST_Random() % 5000U);
+    }
+
+    if (choice < 99U)
+    {
+        return 1U + (TEST_Random() % 300000U);
+    }
+
+    return (1UL << 24) + (TEST_Random() % (1UL << 25));
+}
+
+static void TEST_Callback( uintptr_t context, uint32_t currTick )
+{
+    uint32_t index;
+
+    testFired++;
+
+    TEST_CHECK(currTick == testExpires[context]);
+    TEST_CHECK((int32_t)(testTick - currTick) >= 0);
+
+    if (testKind[context] == TEST_TIMER_PERIODIC)
+    {
+        testExpires[context] += testPeriod[context];
+
+        /* SYS_TMR_Tasks ran late: the periods already past are skipped */
+        if ((int32_t)(testExpires[context] - testTick) <= 0)
+        {
+            testExpires[context] += (((testTick - testExpires[context]) / testPeriod[context]) + 1U) * testPeriod[context];
+        }
+    }
+    else
+    {
+        testKind[context] = TEST_TIMER_NONE;
+        testHandle[context] = SYS_TMR_HANDLE_INVALID;
+    }
+
+    /* Callbacks restart other timers, and their own */
+    if ((TEST_Random() % 8U) == 0U)
+    {
+        index = TEST_Random() % TEST_TIMERS;
+
+        if (testKind[index] != TEST_TIMER_NONE)
+        {
+            testPeriod[index] = TEST_PeriodGet();
+            TEST_CHECK(SYS_TMR_ObjectReload(testHandle[index], testPeriod[index], index, TEST_Callback) == true);
+            testExpires[index] = testTick + testPeriod[index];
+        }
+    }
+}
+
+/* The idle time must end before the earliest expiry */
+static void TEST_IdleCheck( void )
+{
+    uint32_t idleUs = SYS_TMR_IdleUsGet();
+    uint32_t index;
+
+    for (index = 0U; index < TEST_TIMERS; index++)
+    {
+        if (testKind[index] != TEST_TIMER_NONE)
+        {
+            TEST_CHECK((idleUs / 1000U) < (testExpires[index] - testTick));
+        }
+    }
+}
+
+int main( void )
+{
+    SYS_TMR_INIT init = { TEST_TickGet };
+    SYS_TMR_HANDLE handle;
+    unsigned long pending = 0UL;
+    uint32_t operation;
+    uint32_t index;
+    uint32_t idleUs;
+
+    testTick = 0xFFFFF000U;
+    SYS_TMR_Initialize(&init);
+
+    for (testStep = 0UL; testStep < TEST_STEPS; testStep++)
+    {
+        operation = TEST_Random() % 16U;
+        index = TEST_Random() % TEST_TIMERS;
+
+        if (operation < 3U)
+        {
+            if (testKind[index] == TEST_TIMER_NONE)
+            {
+                testPeriod[index] = TEST_PeriodGet();
+                testKind[index] = ((TEST_Random() & 1U) != 0U) ? TEST_TIMER_PERIODIC : TEST_TIMER_SINGLE;
+                testHandle[index] = (testKind[index] == TEST_TIMER_PERIODIC) ?
+                    SYS_TMR_CallbackPeriodic(testPeriod[index], index, TEST_Callback) :
+                    SYS_TMR_CallbackSingle(testPeriod[index], index, TEST_Callback);
+                TEST_CHECK(testHandle[index] != SYS_TMR_HANDLE_INVALID);
+                testExpires[index] = testTick + testPeriod[index];
+            }
+        }
+        else if (operation == 3U)
+        {
+            if (testKind[index] != TEST_TIMER_NONE)
+            {
+                handle = testHandle[index];
+                SYS_TMR_ObjectDelete(handle);
+                testKind[index] = TEST_TIMER_NONE;
+                TEST_CHECK(SYS_TMR_ObjectIsRunning(handle) == false);
+                TEST_CHECK(SYS_TMR_ObjectReload(handle, 5U, index, TEST_Callback) == false);
+            }
+        }
+        else if (operation == 4U)
+        {
+            if (testKind[index] != TEST_TIMER_NONE)
+            {
+                testPeriod[index] = TEST_PeriodGet();
+                TEST_CHECK(SYS_TMR_ObjectReload(testHandle[index], testPeriod[index], index, TEST_Callback) == true);
+                testExpires[index] = testTick + testPeriod[index];
+            }
+        }
+        else if (operation == 5U)
+        {
+            if ((TEST_Random() % 64U) == 0U)
+            {
+                /* Sleep as long as the timers allow, then catch up */
+                TEST_IdleCheck();
+                idleUs = SYS_TMR_IdleUsGet();
+
+                if (idleUs != UINT32_MAX)
+                {
+                    testTick += idleUs / 1000U;
+                    testSleeps++;
+                }
+
+                SYS_TMR_Tasks();
+            }
+        }
+        else
+        {
+            if (operation >= 14U)
+            {
+                testTick += 1U + (TEST_Random() % 3U);
+            }
+            else if ((operation == 13U) && ((TEST_Random() % 100000U) == 0U))
+            {
+                testTick += 1UL << 24;
+            }
+            else
+            {
+                /* Tasks without a tick */
+            }
+
+            SYS_TMR_Tasks();
+        }
+    }
+
+    SYS_TMR_Tasks();
+
+    for (index = 0U; index < TEST_TIMERS; index++)
+    {
+        if (testKind[index] != TEST_TIMER_NONE)
+        {
+            TEST_CHECK((int32_t)(testExpires[index] - testTick) > 0);
+            TEST_CHECK(SYS_TMR_ObjectIsRunning(testHandle[index]) == true);
+            pending++;
+        }
+    }
+
+    TEST_CHECK(SYS_TMR_ObjectCreate(0U, 0U, TEST_Callback, SYS_TMR_FLAG_PERIODIC) == SYS_TMR_HANDLE_INVALID);
+    TEST_CHECK(SYS_TMR_ObjectCreate(SYS_TMR_PERIOD_MAX + 1U, 0U, TEST_Callback, SYS_TMR_FLAG_PERIODIC) == SYS_TMR_HANDLE_INVALID);
+
+    printf("%lu callbacks on the expected tick, %lu sleeps, %lu timers pending, %u objects used at most, tick 0x%08X: PASS\n",
+           testFired, testSleeps, pending, SYS_TMR_ObjectsUsedMaxGet(), testTick);
+
+    return 0;
+}
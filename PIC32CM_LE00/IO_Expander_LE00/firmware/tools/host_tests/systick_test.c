@@ -0,0 +1,271 @@
+/*******************************************************************************
+  SysTick timestamp host test
+
+  Builds plib_systick.c against a cycle model of SysTick: the counter
+  counts down one per cycle and reloads from LOAD on the cycle after 0,
+  and reaching 0 pends the interrupt. An access to SysTick or SCB takes
+  0 to 2 counter cycles, so two reads may also see the same count.
+  SysTick_Handler is taken between two accesses, 15 cycles after the
+  interrupt is pended, unless interrupts are masked; masking stands for
+  PRIMASK and for handlers SysTick cannot preempt. A section is never
+  masked for a whole period.
+
+  SYSTICK_TimestampUsGet and SYSTICK_TimestampCyclesGet are read from
+  random points, masked or not, with the interrupt pending or not, then
+  at each cycle from 1000 before the counter reaches 0 to 1000 after,
+  and 200 times more at each of the 8 cycles on either side.
+
+  Checked: the timestamps never go back, and each is the count of SysTick
+  cycles since the start, in cycles or microseconds, at some point
+  between the call and its return.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "definitions.h"
+
+static SysTick_Type fakeSysTick;
+static SCB_Type fakeScb;
+static SysTick_Type* TEST_SysTickGet( void );
+static SCB_Type* TEST_ScbGet( void );
+
+#undef SysTick
+#define SysTick     TEST_SysTickGet()
+#undef SCB
+#define SCB         TEST_ScbGet()
+
+#include "peripheral/systick/plib_systick.c"
+
+#define TEST_PERIOD             48000U
+#define TEST_RUN_CYCLES         (10ULL * 48000000ULL)
+#define TEST_ENTRY_CYCLES       15U
+#define TEST_ALIGN_CYCLES       1000U
+#define TEST_NEAR_CYCLES        8U
+#define TEST_NEAR_REPEATS       200U
+
+#define TEST_CHECK(condition)   do { if (!(condition)) { printf("read %lu: %s:%d: %s\n", testReads, __FILE__, __LINE__, #condition); exit(1); } } while (0)
+
+static uint32_t testCount;
+static uint32_t testValWritten;
+static bool testIsPending;
+static bool testIsMasked;
+static bool testIsInHandler;
+static bool testIsStarted;
+/* SysTick cycles since the first reload */
+static uint64_t testCycles;
+static unsigned long testReads;
+static unsigned long testMaskedReads;
+static unsigned long testPendingReads;
+static uint64_t testLastUs;
+static uint32_t testLastCycles;
+
+static uint32_t TEST_Random( void )
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (uint32_t)state;
+}
+
+static void TEST_CounterStep( void )
+{
+    if ((fakeSysTick.CTRL & SysTick_CTRL_ENABLE_Msk) == 0U)
+    {
+        return;
+    }
+
+    if (testCount == 0U)
+    {
+        testCount = fakeSysTick.LOAD;
+
+        if (testIsStarted == true)
+        {
+            testCycles++;
+        }
+
+        testIsStarted = true;
+    }
+    else
+    {
+        testCount--;
+        testCycles++;
+
+        if ((testCount == 0U) && ((fakeSysTick.CTRL & SysTick_CTRL_TICKINT_Msk) != 0U))
+        {
+            testIsPending = true;
+        }
+    }
+}
+
+/* One cycle, then the exception if it can be taken */
+static void TEST_Step( void )
+{
+    uint32_t cycle;
+
+    TEST_CounterStep();
+
+    if ((testIsPending == true) && (testIsMasked == false) && (testIsInHandler == false))
+    {
+        testIsInHandler = true;
+        testIsPending = false;
+
+        for (cycle = 0U; cycle < TEST_ENTRY_CYCLES; cycle++)
+        {
+            TEST_CounterStep();
+        }
+
+        SysTick_Handler();
+        testIsInHandler = false;
+    }
+}
+
+static void TEST_Advance( uint32_t cycles )
+{
+    while (cycles-- > 0U)
+    {
+        TEST_Step();
+    }
+}
+
+static SysTick_Type* TEST_SysTickGet( void )
+{
+    /* A write clears the counter, it reloads on the next cycle */
+    if (fakeSysTick.VAL != testValWritten)
+    {
+        testCount = 0U;
+    }
+
+    TEST_Advance(TEST_Random() % 3U);
+
+    fakeSysTick.VAL = testCount;
+    testValWritten = testCount;
+
+    return &fakeSysTick;
+}
+
+static SCB_Type* TEST_ScbGet( void )
+{
+    TEST_Advance(TEST_Random() % 3U);
+
+    fakeScb.ICSR = (testIsPending == true) ? SCB_ICSR_PENDSTSET_Msk : 0U;
+
+    return &fakeScb;
+}
+
+/* Reads both timestamps and checks them against the model */
+static void TEST_Read( void )
+{
+    uint64_t startCycles;
+    uint64_t us;
+    uint32_t cycles;
+
+    testReads++;
+    testMaskedReads += (testIsMasked == true) ? 1UL : 0UL;
+    testPendingReads += (testIsPending == true) ? 1UL : 0UL;
+
+    startCycles = testCycles;
+    us = SYSTICK_TimestampUsGet();
+
+    TEST_CHECK(us >= ((startCycles * SYSTICK_INTERRUPT_PERIOD_IN_US) / TEST_PERIOD));
+    TEST_CHECK(us <= ((testCycles * SYSTICK_INTERRUPT_PERIOD_IN_US) / TEST_PERIOD));
+    TEST_CHECK(us >= testLastUs);
+    testLastUs = us;
+
+    startCycles = testCycles;
+    cycles = SYSTICK_TimestampCyclesGet();
+
+    TEST_CHECK(cycles >= (uint32_t)startCycles);
+    TEST_CHECK(cycles <= (uint32_t)testCycles);
+    TEST_CHECK(cycles >= testLastCycles);
+    testLastCycles = cycles;
+}
+
+/* A read offset cycles after the count passed TEST_ALIGN_CYCLES, the
+ * interrupt masked over it or not */
+static void TEST_AlignedRead( uint32_t offset, bool isMasked )
+{
+    /* Nothing happens on the way, skip there */
+    if (testCount > TEST_ALIGN_CYCLES)
+    {
+        testCycles += testCount - TEST_ALIGN_CYCLES;
+        testCount = TEST_ALIGN_CYCLES;
+    }
+
+    while (testCount != TEST_ALIGN_CYCLES)
+    {
+        TEST_Step();
+    }
+
+    testIsMasked = isMasked;
+    TEST_Advance(offset);
+    TEST_Read();
+    testIsMasked = false;
+    TEST_Step();
+}
+
+int main( void )
+{
+    uint32_t offset;
+    uint32_t choice;
+    uint32_t repeat;
+
+    SYSTICK_TimerInitialize();
+    SYSTICK_TimerStart();
+
+    TEST_CHECK(fakeSysTick.LOAD == (TEST_PERIOD - 1U));
+
+    while (testCycles < TEST_RUN_CYCLES)
+    {
+        TEST_Advance(TEST_Random() % 5000U);
+        choice = TEST_Random() % 4U;
+
+        if (choice == 0U)
+        {
+            /* Masked from a random point, for less than a period */
+            testIsMasked = true;
+            TEST_Advance(TEST_Random() % (TEST_PERIOD - 8000U));
+            TEST_Read();
+            TEST_Advance(TEST_Random() % 1000U);
+
+            /* A pending interrupt is taken as soon as they are enabled */
+            testIsMasked = false;
+            TEST_Step();
+        }
+        else
+        {
+            TEST_Read();
+        }
+    }
+
+    printf("%lu random reads over %llu ms, %lu masked, %lu with the tick pending\n", testReads,
+           (unsigned long long)(testCycles / (TEST_PERIOD / SYSTICK_INTERRUPT_PERIOD_IN_US) / 1000ULL),
+           testMaskedReads, testPendingReads);
+
+    testReads = 0UL;
+    testMaskedReads = 0UL;
+    testPendingReads = 0UL;
+
+    for (offset = 0U; offset < (2U * TEST_ALIGN_CYCLES); offset++)
+    {
+        TEST_AlignedRead(offset, false);
+        TEST_AlignedRead(offset, true);
+    }
+
+    for (repeat = 0U; repeat < TEST_NEAR_REPEATS; repeat++)
+    {
+        for (offset = TEST_ALIGN_CYCLES - TEST_NEAR_CYCLES; offset < (TEST_ALIGN_CYCLES + TEST_NEAR_CYCLES); offset++)
+        {
+            TEST_AlignedRead(offset, false);
+            TEST_AlignedRead(offset, true);
+        }
+    }
+
+    printf("%lu reads aligned on the reload, %lu masked, %lu with the tick pending\n", testReads,
+           testMaskedReads, testPendingReads);
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Telemetry decoder host test
+
+Runs telemetry_decode.py on the capture scripts given on the command line,
+one decoder per script. The frames in the scripts were written by
+app_telemetry.c. Script lines:
+
+    # text          comment
+    in: HH HH ...   capture bytes, in hex
+    text: text      capture bytes, console text with the escapes \\r \\n \\xHH
+    out: json       next decoded record, all of it
+    out~: json      next decoded record has these fields
+    end             end of the capture, the text left is flushed
+
+At the end of a script the text left is flushed and every decoded record
+must have been matched.
+"""
+
+import codecs
+import json
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import telemetry_decode  # noqa: E402
+
+
+def record_json(record):
+    """The record as main() writes it, read back."""
+    if "body" in record:
+        record = dict(record, body=record["body"].hex())
+    return json.loads(json.dumps(record))
+
+
+def script_run(path):
+    """Returns the number of records checked; raises AssertionError."""
+    splitter = telemetry_decode.Splitter(None)
+    records = []
+    checked = 0
+
+    with open(path) as script:
+        for number, line in enumerate(script, 1):
+            line = line.rstrip("\n")
+            where = "%s:%d" % (path, number)
+
+            if not line or line.startswith("#"):
+                continue
+            key, _, value = line.partition(":")
+            value = value.strip()
+
+            if line == "end":
+                splitter.flush_text(records, force=True)
+            elif key == "in":
+                records += splitter.feed(bytes.fromhex(value))
+            elif key == "text":
+                records += splitter.feed(codecs.escape_decode(value.encode("latin-1"))[0])
+            elif key in ("out", "out~"):
+                expected = json.loads(value)
+                if not records:
+                    raise AssertionError("%s: no record decoded, expected %s" % (where, value))
+                record = record_json(records.pop(0))
+                if key == "out~":
+                    record = {name: record.get(name) for name in expected}
+                if record != expected:
+                    raise AssertionError("%s: decoded %s" % (where, json.dumps(record)))
+                checked += 1
+            else:
+                raise AssertionError("%s: bad line" % where)
+
+    splitter.flush_text(records, force=True)
+    if records:
+        raise AssertionError("%s: record not checked: %s" % (path, json.dumps(record_json(records[0]))))
+    return checked
+
+
+def main(argv):
+    failures = 0
+
+    for path in argv[1:]:
+        try:
+            print("%s: %d records" % (path, script_run(path)))
+        except AssertionError as error:
+            print(error)
+            failures += 1
+
+    print("FAIL" if failures else "PASS")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,248 @@
+/*******************************************************************************
+  SERCOM3 USART baud selection host test
+
+  Builds plib_sercom3_usart.c against fake registers, sets up each console
+  rate at both generator 0 frequencies (48 MHz DFLL, 16 MHz OSC16M) and
+  checks the chosen BAUD and CTRLA.SAMPR with a clock level model of the
+  baud generator:
+
+  - the registers hold what SERCOM3_USART_BaudSetupGet reports
+  - no other mode of SERCOM3_USART_BaudModeCalculate has a lower
+    sampleErrorPpm
+  - the rate of the modelled sample clock matches baudRate and errorPpm
+  - the modelled stop bit sample stays within sampleErrorPpm, less the
+    start bit detection term the model does not have
+
+  The table printed next to it is the setting of the previous SerialSetup,
+  the first of 16x, 8x and 3x arithmetic that fits, with BAUD truncated.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "definitions.h"
+
+static sercom_registers_t fakeSercom3;
+#undef SERCOM3_REGS
+#define SERCOM3_REGS (&fakeSercom3)
+
+#define __get_PRIMASK()     0U
+#define __get_IPSR()        0U
+#define __disable_irq()
+#define __enable_irq()
+
+#include "peripheral/sercom/usart/plib_sercom3_usart.c"
+
+#define TEST_FRAMES         4000U
+#define TEST_FRAME_BITS     10U
+
+static uint32_t testClkFrequency;
+
+uint32_t CLOCK_Gclk0FrequencyGet( void )
+{
+    return testClkFrequency;
+}
+
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context )
+{
+}
+
+bool DMAC_ChannelLinkedListTransfer( DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc )
+{
+    return true;
+}
+
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel )
+{
+    return false;
+}
+
+void DMAC_InterruptHandler( void )
+{
+}
+
+/* Runs the baud generator for TEST_FRAMES back to back 8N1 frames. Returns
+ * the worst offset of the stop bit middle from where an ideal receiver
+ * samples it, in bits, and the rate of the generated bits. */
+static double TEST_SampleClockModel( uint16_t baudValue, uint32_t sampleRate, uint32_t baudRate, double* modelRate )
+{
+    uint32_t oversampling = (sampleRate <= 1U) ? 16U : ((sampleRate <= 3U) ? 8U : 3U);
+    bool isFractional = ((sampleRate == 1U) || (sampleRate == 3U));
+    double bitClocks = (double)testClkFrequency / baudRate;
+    double worst = 0.0;
+    double offset;
+    double edge[TEST_FRAME_BITS + 1U];
+    uint64_t clocks = 0U;
+    uint64_t frameStart;
+    uint32_t accumulator = 0U;
+    uint32_t fpPhase = 0U;
+    uint32_t frame;
+    uint32_t bit;
+    uint32_t sample;
+
+    for (frame = 0U; frame < TEST_FRAMES; frame++)
+    {
+        /* A frame starts on a sample tick, the generator phase carries over */
+        frameStart = clocks;
+
+        for (bit = 0U; bit < TEST_FRAME_BITS; bit++)
+        {
+            edge[bit] = (double)(clocks - frameStart);
+
+            for (sample = 0U; sample < oversampling; sample++)
+            {
+                if (isFractional == false)
+                {
+                    /* A sample tick when the 16-bit accumulator overflows */
+                    do
+                    {
+                        clocks++;
+                        accumulator += 65536U - baudValue;
+                    } while (accumulator < 65536U);
+
+                    accumulator -= 65536U;
+                }
+                else
+                {
+                    /* BAUD clocks, one more on FP of every 8 ticks */
+                    clocks += baudValue & 0x1FFFU;
+                    fpPhase += (uint32_t)baudValue >> 13;
+
+                    if (fpPhase >= 8U)
+                    {
+                        fpPhase -= 8U;
+                        clocks++;
+                    }
+                }
+            }
+        }
+
+        edge[TEST_FRAME_BITS] = (double)(clocks - frameStart);
+
+        /* The stop bit is bit 9, sampled 9.5 bits after the start bit edge */
+        offset = fabs((9.5 * bitClocks) - ((edge[9] + edge[10]) / 2.0)) / bitClocks;
+
+        if (offset > worst)
+        {
+            worst = offset;
+        }
+    }
+
+    *modelRate = ((double)TEST_FRAMES * TEST_FRAME_BITS * testClkFrequency) / (double)clocks;
+
+    return worst;
+}
+
+static int TEST_Rate( uint32_t baudRate )
+{
+    static const char* modeNames[] = { "16x arith", "16x frac", "8x arith", "8x frac", "3x arith" };
+    USART_SERIAL_SETUP serialSetup = { baudRate, USART_PARITY_NONE, USART_DATA_8_BIT, USART_STOP_1_BIT };
+    USART_BAUD_SETUP setup;
+    USART_BAUD_SETUP candidate;
+    uint32_t sampleRate;
+    uint32_t oversampling;
+    uint32_t txBound;
+    uint32_t oldOversampling;
+    uint32_t oldBaud;
+    uint32_t index;
+    double modelRate;
+    double modelPpm;
+    double clockPpm;
+    double worst;
+    double oldRate;
+    double oldWorst;
+    int failures = 0;
+
+    fakeSercom3.USART_INT.SERCOM_CTRLA = 0U;
+    fakeSercom3.USART_INT.SERCOM_BAUD = 0U;
+
+    if (SERCOM3_USART_SerialSetup(&serialSetup, 0U) == false)
+    {
+        printf("%9u | rejected\n", baudRate);
+        return (baudRate <= (testClkFrequency / 3U)) ? 1 : 0;
+    }
+
+    SERCOM3_USART_BaudSetupGet(&setup);
+    sampleRate = (fakeSercom3.USART_INT.SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_SAMPR_Msk) >> SERCOM_USART_INT_CTRLA_SAMPR_Pos;
+    oversampling = (sampleRate <= 1U) ? 16U : ((sampleRate <= 3U) ? 8U : 3U);
+
+    if ((fakeSercom3.USART_INT.SERCOM_BAUD != setup.baudValue) || (sampleRate != setup.sampleRate))
+    {
+        printf("  registers 0x%04X/%u, setup 0x%04X/%u\n", fakeSercom3.USART_INT.SERCOM_BAUD, sampleRate,
+               setup.baudValue, setup.sampleRate);
+        failures++;
+    }
+
+    for (index = 0U; index < (sizeof(sercom3USARTBaudModes) / sizeof(sercom3USARTBaudModes[0])); index++)
+    {
+        if ((SERCOM3_USART_BaudModeCalculate(&sercom3USARTBaudModes[index], baudRate, testClkFrequency, &candidate) == true) &&
+            (candidate.sampleErrorPpm < setup.sampleErrorPpm))
+        {
+            printf("  %s has %u ppm, %s chosen with %u ppm\n", modeNames[index], candidate.sampleErrorPpm,
+                   modeNames[setup.sampleRate], setup.sampleErrorPpm);
+            failures++;
+        }
+    }
+
+    worst = TEST_SampleClockModel(fakeSercom3.USART_INT.SERCOM_BAUD, sampleRate, baudRate, &modelRate);
+    modelPpm = ((modelRate - baudRate) * 1e6) / baudRate;
+
+    /* The model stops on a sample tick, so its rate is off by up to one
+     * clock over the run; errorPpm is truncated and baudRate rounded */
+    clockPpm = (modelRate * 1e6) / ((double)TEST_FRAMES * TEST_FRAME_BITS * testClkFrequency);
+
+    if ((fabs(modelPpm - setup.errorPpm) > (1.0 + clockPpm)) ||
+        (fabs(modelRate - setup.baudRate) > (0.5 + ((clockPpm * baudRate) / 1e6))))
+    {
+        printf("  model %.1f Hz %.1f ppm, setup %u Hz %d ppm\n", modelRate, modelPpm, setup.baudRate, setup.errorPpm);
+        failures++;
+    }
+
+    txBound = setup.sampleErrorPpm - (500000U / oversampling);
+
+    if ((worst * 1e6) > (txBound + 1U))
+    {
+        printf("  model %.0f ppm of a bit, bound %u\n", worst * 1e6, txBound);
+        failures++;
+    }
+
+    oldOversampling = (testClkFrequency >= (16ULL * baudRate)) ? 16U : ((testClkFrequency >= (8ULL * baudRate)) ? 8U : 3U);
+    oldBaud = 65536U - (uint32_t)((65536ULL * oldOversampling * baudRate) / testClkFrequency);
+    oldWorst = TEST_SampleClockModel((uint16_t)oldBaud, (oldOversampling == 16U) ? 0U : ((oldOversampling == 8U) ? 2U : 4U), baudRate, &oldRate);
+
+    printf("%9u | %-9s 0x%04X %9u %8d %8.3f %8.3f | %-9s %8.0f %8.3f\n", baudRate, modeNames[setup.sampleRate],
+           setup.baudValue, setup.baudRate, setup.errorPpm, setup.sampleErrorPpm / 1e4, worst * 100.0,
+           modeNames[(oldOversampling == 16U) ? 0U : ((oldOversampling == 8U) ? 2U : 4U)],
+           ((oldRate - baudRate) * 1e6) / baudRate, oldWorst * 100.0);
+
+    return failures;
+}
+
+int main( void )
+{
+    static const uint32_t clkFrequencies[] = { 48000000U, 16000000U };
+    static const uint32_t baudRates[] =
+    {
+        9600U, 19200U, 38400U, 57600U, 115200U, 230400U, 250000U, 460800U, 500000U, 576000U,
+        921600U, 1000000U, 1152000U, 1500000U, 2000000U, 2500000U, 3000000U, 4000000U, 16000000U, 17000000U
+    };
+    uint32_t clkIndex;
+    uint32_t rateIndex;
+    int failures = 0;
+
+    for (clkIndex = 0U; clkIndex < (sizeof(clkFrequencies) / sizeof(clkFrequencies[0])); clkIndex++)
+    {
+        testClkFrequency = clkFrequencies[clkIndex];
+
+        printf("GCLK %u Hz\n%9s | %-9s %6s %9s %8s %8s %8s | %-9s %8s %8s\n", testClkFrequency, "rate", "mode", "BAUD",
+               "actual", "ppm", "bound%", "model%", "old mode", "old ppm", "old mod%");
+
+        for (rateIndex = 0U; rateIndex < (sizeof(baudRates) / sizeof(baudRates[0])); rateIndex++)
+        {
+            failures += TEST_Rate(baudRates[rateIndex]);
+        }
+    }
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
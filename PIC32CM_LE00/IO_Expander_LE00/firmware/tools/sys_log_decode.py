@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Decode the SERCOM3 console stream of the IO Expander firmware.
+
+Console text is passed through unchanged. Deferred log records (SYS_LOG) are
+binary frames:
+
+    0x1E, ID (u16), argument count (u8), arguments (u32 each), little endian
+
+The ID is the offset of the format string in the .logfmt section of the ELF
+file the firmware was built from; the string is formatted here with the
+recorded arguments.
+
+Usage:
+    sys_log_decode.py firmware.elf [capture]
+
+Reads the capture file (or a serial device already set up with stty, or
+standard input when omitted) and writes the decoded text to standard output.
+"""
+
+import re
+import struct
+import sys
+
+FRAME_MARKER = 0x1E
+ID_DROPPED = 0xFFFF
+ARGS_MAX = 4
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?(hh|h|ll|l|z|t|j)?([diouxXcsp%])")
+
+
+def logfmt_section(path):
+    """Returns (address, bytes) of the .logfmt section of an ELF file."""
+    with open(path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % path)
+
+    is64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        header = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        header = endian + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(header, elf, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx]
+
+    for name, _type, _flags, addr, offset, size, *_ in sections:
+        start = names[4] + name
+        if elf[start:elf.index(b"\0", start)] == b".logfmt":
+            return addr, elf[offset:offset + size]
+
+    raise ValueError("%s has no .logfmt section" % path)
+
+
+def format_record(fmt, args):
+    """printf for 32-bit integer arguments, as recorded by the target."""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, _length, conv = match.groups()
+
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(args.pop(0) if args else 0)
+
+        value = args.pop(0) if args else 0
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+
+        if conv in "di":
+            return (spec + "d") % (value - (1 << 32) if value & 0x80000000 else value)
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv in "ps":
+            # Only the pointer made it off the target
+            return (spec + "s") % ("0x%08x" % value)
+        return (spec + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, elf_path):
+        self.base, self.strings = logfmt_section(elf_path)
+        self.pending = bytearray()
+        self.line_start = True
+
+    def format_string(self, record_id):
+        offset = (record_id - self.base) & 0xFFFF
+        end = self.strings.find(b"\0", offset)
+        if offset >= len(self.strings) or end < 0:
+            return None
+        return self.strings[offset:end].decode("latin-1")
+
+    def text(self, out, data):
+        """Console bytes, passed through."""
+        if data:
+            out.append(data.decode("latin-1"))
+            self.line_start = data.endswith((b"\n", b"\r"))
+
+    def record(self, out, text):
+        """A record on a line of its own, after any partial console line."""
+        out.append(("" if self.line_start else "\n") + text + "\n")
+        self.line_start = True
+
+    def feed(self, data):
+        """Returns the text decoded from data, keeping partial frames."""
+        out = []
+        self.pending += data
+
+        while self.pending:
+            marker = self.pending.find(FRAME_MARKER)
+            if marker < 0:
+                self.text(out, bytes(self.pending))
+                self.pending.clear()
+                break
+
+            self.text(out, bytes(self.pending[:marker]))
+            del self.pending[:marker]
+
+            if len(self.pending) < 4:
+                break
+
+            record_id, count = struct.unpack_from("<HB", self.pending, 1)
+            if count > ARGS_MAX:
+                # Not a frame after all, pass the marker through
+                self.text(out, bytes(self.pending[:1]))
+                del self.pending[:1]
+                continue
+
+            size = 4 + 4 * count
+            if len(self.pending) < size:
+                break
+
+            args = struct.unpack_from("<%dI" % count, self.pending, 4)
+            del self.pending[:size]
+
+            if record_id == ID_DROPPED:
+                self.record(out, "<%u log records dropped>" % (args[0] if args else 0))
+                continue
+
+            fmt = self.format_string(record_id)
+            if fmt is None:
+                self.record(out, "<unknown log record 0x%04x %s>" % (record_id, " ".join("0x%x" % a for a in args)))
+            else:
+                self.record(out, format_record(fmt, args))
+
+        return "".join(out)
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 2
+
+    decoder = Decoder(argv[1])
+    stream = open(argv[2], "rb", buffering=0) if len(argv) == 3 else sys.stdin.buffer
+
+    read = getattr(stream, "read1", stream.read)
+
+    while True:
+        data = read(256)
+        if not data:
+            break
+        sys.stdout.write(decoder.feed(data))
+        sys.stdout.flush()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+"""Decode the pin-state telemetry in a SERCOM3 console stream or capture.
+
+Telemetry frames are COBS encoded between 0x00 delimiters and end in a
+CRC-16/CCITT-FALSE of the payload; see src/app_telemetry.h for the layout.
+The stream also carries console text and SYS_LOG records, which are passed
+through (formatted when the firmware ELF file is given).
+
+Usage:
+    telemetry_decode.py [--elf firmware.elf] [capture]
+
+Writes one JSON object per line to standard output: frames ("snapshot",
+"delta", "stats", and "rpc" for request replies, see expander_rpc.py), frame
+errors ("error"), console lines ("text") and log records ("log"). Reads the
+capture file (or a serial device already set up with stty, or standard input
+when omitted).
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import sys_log_decode  # noqa: E402
+
+FRAME_SNAPSHOT = 0x01
+FRAME_DELTA = 0x02
+FRAME_STATS = 0x03
+FRAME_RPC_REPLY = 0x10
+DELTA_ONLINE = 0x01
+
+EXPANDERS = 16
+FRAME_SIZE_MAX = 256
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE."""
+    crc = 0xFFFF
+    for byte in data:
+        x = ((crc >> 8) ^ byte) & 0xFF
+        x ^= x >> 4
+        crc = ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            raise ValueError("bad COBS code")
+        out += data[index + 1:index + code]
+        index += code
+        if code != 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Telemetry:
+    """Rebuilds the port state from SNAPSHOT and DELTA frames."""
+
+    def __init__(self):
+        self.ports = None
+        self.online = None
+        self.sequence = None
+        self.time_high = 0
+        self.time_last = None
+
+    def timestamp(self, t_us):
+        """Extends the 32-bit target timestamp to 64 bits."""
+        if self.time_last is not None and t_us < self.time_last:
+            self.time_high += 1 << 32
+        self.time_last = t_us
+        return self.time_high + t_us
+
+    def frame(self, payload):
+        if len(payload) < 8:
+            return {"type": "error", "error": "short frame", "size": len(payload)}
+        if crc16(payload[:-2]) != struct.unpack_from("<H", payload, len(payload) - 2)[0]:
+            return {"type": "error", "error": "crc"}
+
+        body = payload[:-2]
+        kind, sequence, t_us = struct.unpack_from("<BBI", body, 0)
+        record = {"seq": sequence, "t_us": self.timestamp(t_us)}
+
+        # Replies to host requests carry the request sequence
+        if kind == FRAME_RPC_REPLY:
+            if len(body) < 9:
+                return {"type": "error", "error": "truncated frame", "seq": sequence}
+            record.update(type="rpc", op=body[6], result=body[7], count=body[8], body=body[9:])
+            return record
+
+        # A gap means a frame was lost on the way, the state is stale
+        if self.sequence is not None and sequence != (self.sequence + 1) & 0xFF:
+            record["lost"] = (sequence - self.sequence - 1) & 0xFF
+            self.ports = None
+        self.sequence = sequence
+
+        try:
+            if kind == FRAME_SNAPSHOT:
+                return self.snapshot(record, body)
+            if kind == FRAME_DELTA:
+                return self.delta(record, body)
+            if kind == FRAME_STATS:
+                return self.stats(record, body)
+        except struct.error:
+            return {"type": "error", "error": "truncated frame", "seq": sequence}
+
+        return {"type": "error", "error": "unknown frame type %u" % kind, "seq": sequence}
+
+    def snapshot(self, record, body):
+        cycle, online = struct.unpack_from("<IH", body, 6)
+        self.ports = list(struct.unpack_from("<%dH" % EXPANDERS, body, 12))
+        self.online = online
+        record.update(type="snapshot", cycle=cycle, online=online, ports=list(self.ports))
+        return record
+
+    def delta(self, record, body):
+        flags, changed = struct.unpack_from("<BH", body, 6)
+        offset = 9
+        record["type"] = "delta"
+
+        if flags & DELTA_ONLINE:
+            self.online, = struct.unpack_from("<H", body, offset)
+            offset += 2
+            record["online"] = self.online
+
+        events = []
+        changes = {}
+        for port in range(EXPANDERS):
+            if not changed & (1 << port):
+                continue
+            value, = struct.unpack_from("<H", body, offset)
+            offset += 2
+            changes[port] = value
+
+            if self.ports is not None:
+                diff = self.ports[port] ^ value
+                for pin in range(16):
+                    if diff & (1 << pin):
+                        events.append({"port": port, "pin": pin, "level": (value >> pin) & 1})
+                self.ports[port] = value
+
+        record["changes"] = changes
+        if self.ports is not None:
+            record["events"] = events
+            record["ports"] = list(self.ports)
+        else:
+            record["synced"] = False
+        return record
+
+    def stats(self, record, body):
+        cycles, frames_dropped, console_dropped, log_dropped = struct.unpack_from("<4I", body, 6)
+        record.update(type="stats", cycles=cycles, frames_dropped=frames_dropped,
+                      console_bytes_dropped=console_dropped, log_records_dropped=log_dropped,
+                      read_errors=list(struct.unpack_from("<%dH" % EXPANDERS, body, 22)))
+        return record
+
+
+class Splitter:
+    """Separates console text, SYS_LOG records and telemetry frames."""
+
+    def __init__(self, log_decoder):
+        self.log = log_decoder
+        self.telemetry = Telemetry()
+        self.pending = bytearray()
+        self.text = bytearray()
+        self.in_frame = False
+
+    def flush_text(self, out, force=False):
+        while True:
+            end = self.text.find(b"\n")
+            if end < 0:
+                break
+            line = self.text[:end].decode("latin-1").strip("\r")
+            del self.text[:end + 1]
+            if line:
+                out.append({"type": "text", "text": line})
+        if force and self.text.strip(b"\r"):
+            out.append({"type": "text", "text": self.text.decode("latin-1").strip("\r")})
+            self.text.clear()
+
+    def feed(self, data):
+        out = []
+        self.pending += data
+
+        while self.pending:
+            if self.in_frame:
+                end = self.pending.find(0)
+                if end < 0:
+                    if len(self.pending) > FRAME_SIZE_MAX:
+                        out.append({"type": "error", "error": "frame too long"})
+                        self.pending.clear()
+                        self.in_frame = False
+                    break
+                encoded = bytes(self.pending[:end])
+                del self.pending[:end + 1]
+                if not encoded:
+                    # Back-to-back delimiters, keep looking for a frame
+                    continue
+                self.in_frame = False
+                try:
+                    out.append(self.telemetry.frame(cobs_decode(encoded)))
+                except ValueError as error:
+                    out.append({"type": "error", "error": str(error)})
+                continue
+
+            byte = self.pending[0]
+
+            if byte == 0x00:
+                self.flush_text(out, force=True)
+                del self.pending[:1]
+                self.in_frame = True
+            elif byte == sys_log_decode.FRAME_MARKER:
+                if len(self.pending) < 4:
+                    break
+                record_id, count = struct.unpack_from("<HB", self.pending, 1)
+                if count > sys_log_decode.ARGS_MAX:
+                    self.text.append(byte)
+                    del self.pending[:1]
+                    continue
+                size = 4 + 4 * count
+                if len(self.pending) < size:
+                    break
+                args = struct.unpack_from("<%dI" % count, self.pending, 4)
+                del self.pending[:size]
+                self.flush_text(out, force=True)
+                out.append(self.log_record(record_id, args))
+            else:
+                self.text.append(byte)
+                del self.pending[:1]
+
+        self.flush_text(out)
+        return out
+
+    def log_record(self, record_id, args):
+        record = {"type": "log", "id": record_id, "args": list(args)}
+        if record_id == sys_log_decode.ID_DROPPED:
+            record["text"] = "<%u log records dropped>" % (args[0] if args else 0)
+        elif self.log is not None:
+            fmt = self.log.format_string(record_id)
+            if fmt is not None:
+                record["text"] = sys_log_decode.format_record(fmt, args)
+        return record
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", help="firmware ELF file, to format SYS_LOG records")
+    parser.add_argument("capture", nargs="?", help="capture file or serial device")
+    options = parser.parse_args(argv[1:])
+
+    def dump(record):
+        if "body" in record:
+            record = dict(record, body=record["body"].hex())
+        return json.dumps(record) + "\n"
+
+    splitter = Splitter(sys_log_decode.Decoder(options.elf) if options.elf else None)
+    stream = open(options.capture, "rb", buffering=0) if options.capture else sys.stdin.buffer
+    read = getattr(stream, "read1", stream.read)
+
+    while True:
+        data = read(4096)
+        if not data:
+            break
+        for record in splitter.feed(data):
+            sys.stdout.write(dump(record))
+        sys.stdout.flush()
+
+    records = []
+    splitter.flush_text(records, force=True)
+    for record in records:
+        sys.stdout.write(dump(record))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))